@@ -710,30 +710,51 @@ void CFileItem::Archive(CArchive& ar)
 
 void CFileItem::Serialize(CVariant& value) const
 {
-  //CGUIListItem::Serialize(value["CGUIListItem"]);
+  Serialize(value, nullptr);
+}
+
+void CFileItem::SerializeFields(CVariant& value, const std::set<std::string>& fields) const
+{
+  Serialize(value, &fields);
+}
 
-  value["strPath"] = m_strPath;
-  value["dateTime"] = (m_dateTime.IsValid()) ? m_dateTime.GetAsRFC1123DateTime() : "";
-  value["lastmodified"] = m_dateTime.IsValid() ? m_dateTime.GetAsDBDateTime() : "";
-  value["size"] = m_dwSize;
-  value["DVDLabel"] = m_strDVDLabel;
-  value["title"] = m_strTitle;
-  value["mimetype"] = m_mimetype;
-  value["extrainfo"] = m_extrainfo;
+void CFileItem::Serialize(CVariant& value, const std::set<std::string>* fields) const
+{
+  //CGUIListItem::Serialize(value["CGUIListItem"]);
 
-  if (m_musicInfoTag)
+  const auto wanted = [fields](const char* field)
+  { return fields == nullptr || fields->find(field) != fields->end(); };
+
+  if (wanted("strPath"))
+    value["strPath"] = m_strPath;
+  if (wanted("dateTime"))
+    value["dateTime"] = (m_dateTime.IsValid()) ? m_dateTime.GetAsRFC1123DateTime() : "";
+  if (wanted("lastmodified"))
+    value["lastmodified"] = m_dateTime.IsValid() ? m_dateTime.GetAsDBDateTime() : "";
+  if (wanted("size"))
+    value["size"] = m_dwSize;
+  if (wanted("DVDLabel"))
+    value["DVDLabel"] = m_strDVDLabel;
+  if (wanted("title"))
+    value["title"] = m_strTitle;
+  if (wanted("mimetype"))
+    value["mimetype"] = m_mimetype;
+  if (wanted("extrainfo"))
+    value["extrainfo"] = m_extrainfo;
+
+  if (m_musicInfoTag && wanted("musicInfoTag"))
     (*m_musicInfoTag).Serialize(value["musicInfoTag"]);
 
-  if (m_videoInfoTag)
+  if (m_videoInfoTag && wanted("videoInfoTag"))
     (*m_videoInfoTag).Serialize(value["videoInfoTag"]);
 
-  if (m_pictureInfoTag)
+  if (m_pictureInfoTag && wanted("pictureInfoTag"))
     (*m_pictureInfoTag).Serialize(value["pictureInfoTag"]);
 
-  if (m_gameInfoTag)
+  if (m_gameInfoTag && wanted("gameInfoTag"))
     (*m_gameInfoTag).Serialize(value["gameInfoTag"]);
 
-  if (!m_mapProperties.empty())
+  if (!m_mapProperties.empty() && wanted("customproperties"))
   {
     auto& customProperties = value["customproperties"];
     for (const auto& prop : m_mapProperties)
@@ -24,6 +24,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -150,6 +151,7 @@ public:
   CFileItem& operator=(const CFileItem& item);
   void Archive(CArchive& ar) override;
   void Serialize(CVariant& value) const override;
+  void SerializeFields(CVariant& value, const std::set<std::string>& fields) const override;
   void ToSortable(SortItem &sortable, Field field) const override;
   void ToSortable(SortItem &sortable, const Fields &fields) const;
   bool IsFileItem() const override { return true; }
@@ -646,6 +648,10 @@ private:
    */
   void UpdateMimeType(bool lookup = true);
 
+  /*! \brief Serialize the given fields, or everything if fields is nullptr.
+   */
+  void Serialize(CVariant& value, const std::set<std::string>* fields) const;
+
   /*!
    \brief Return the current resume point for this item.
    \return The resume point.
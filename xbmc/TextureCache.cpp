@@ -16,6 +16,7 @@
 #include "filesystem/IFileTypes.h"
 #include "guilib/Texture.h"
 #include "profiles/ProfileManager.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/Crc32.h"
 #include "utils/Job.h"
@@ -116,6 +117,37 @@ std::string CTextureCache::CheckCachedImage(const std::string &url, bool &needsR
   return "";
 }
 
+std::string CTextureCache::CheckCachedTexture(const std::string& url, bool& needsRecaching)
+{
+  CTextureDetails details;
+  std::string path(GetCachedImage(url, details, true));
+  needsRecaching = !details.hash.empty();
+  if (!path.empty())
+    return GetDecodedImage(path, details);
+  return "";
+}
+
+std::string CTextureCache::GetDecodedImage(const std::string& cachedImage,
+                                           const CTextureDetails& details)
+{
+  const unsigned int useCount = CServiceBroker::GetSettingsComponent()
+                                    ->GetAdvancedSettings()
+                                    ->m_imageDecodedCacheUseCount;
+  if (useCount == 0 || details.useCount < useCount || details.file.empty())
+    return cachedImage;
+
+  // an image which needs checking for updates may be replaced soon, keep decoding it
+  if (!details.hash.empty())
+    return cachedImage;
+
+  const std::string decodedImage = URIUtils::ReplaceExtension(cachedImage, ".dds");
+  if (CFile::Exists(decodedImage))
+    return decodedImage;
+
+  AddJob(new CTextureDDSJob(cachedImage));
+  return cachedImage;
+}
+
 void CTextureCache::BackgroundCacheImage(const std::string &url)
 {
   if (url.empty())
@@ -211,15 +243,21 @@ void CTextureCache::ClearCachedImage(const std::string& image, bool deleteSource
 {
   //! @todo This can be removed when the texture cache covers everything.
   const std::string url = CTextureUtils::UnwrapImageURL(image);
-  std::string path = deleteSource ? url : "";
   std::string cachedFile;
   if (ClearCachedTexture(url, cachedFile))
-    path = GetCachedPath(cachedFile);
-  if (CFile::Exists(path))
-    CFile::Delete(path);
-  path = URIUtils::ReplaceExtension(path, ".dds");
-  if (CFile::Exists(path))
-    CFile::Delete(path);
+  {
+    DeleteCachedFile(cachedFile);
+    return;
+  }
+
+  if (deleteSource)
+  {
+    if (CFile::Exists(url))
+      CFile::Delete(url);
+    const std::string path = URIUtils::ReplaceExtension(url, ".dds");
+    if (CFile::Exists(path))
+      CFile::Delete(path);
+  }
 }
 
 bool CTextureCache::ClearCachedImage(int id)
@@ -227,17 +265,30 @@ bool CTextureCache::ClearCachedImage(int id)
   std::string cachedFile;
   if (ClearCachedTexture(id, cachedFile))
   {
-    cachedFile = GetCachedPath(cachedFile);
-    if (CFile::Exists(cachedFile))
-      CFile::Delete(cachedFile);
-    cachedFile = URIUtils::ReplaceExtension(cachedFile, ".dds");
-    if (CFile::Exists(cachedFile))
-      CFile::Delete(cachedFile);
+    DeleteCachedFile(cachedFile);
     return true;
   }
   return false;
 }
 
+void CTextureCache::DeleteCachedFile(const std::string& cachedFile)
+{
+  if (cachedFile.empty())
+    return;
+
+  // a caching job may share the file at any time, keep it locked until it is gone
+  std::unique_lock<CCriticalSection> lock(m_databaseSection);
+  if (m_database.IsCachedFileReferenced(cachedFile))
+    return;
+
+  std::string path = GetCachedPath(cachedFile);
+  if (CFile::Exists(path))
+    CFile::Delete(path);
+  path = URIUtils::ReplaceExtension(path, ".dds");
+  if (CFile::Exists(path))
+    CFile::Delete(path);
+}
+
 bool CTextureCache::GetCachedTexture(const std::string &url, CTextureDetails &details)
 {
   std::unique_lock<CCriticalSection> lock(m_databaseSection);
@@ -250,6 +301,13 @@ bool CTextureCache::AddCachedTexture(const std::string &url, const CTextureDetai
   return m_database.AddCachedTexture(url, details);
 }
 
+bool CTextureCache::GetCachedTextureByContent(const std::string& contentHash,
+                                              CTextureDetails& details)
+{
+  std::unique_lock<CCriticalSection> lock(m_databaseSection);
+  return m_database.GetCachedTextureByContent(contentHash, details);
+}
+
 void CTextureCache::IncrementUseCount(const CTextureDetails &details)
 {
   static const size_t count_before_update = 100;
@@ -303,7 +361,20 @@ void CTextureCache::OnCachingComplete(bool success, CTextureCacheJob *job)
     if (job->m_details.hashRevalidated)
       SetCachedTextureValid(job->m_url, job->m_details.updateable);
     else
-      AddCachedTexture(job->m_url, job->m_details);
+    {
+      std::unique_lock<CCriticalSection> lock(m_databaseSection);
+
+      // a shared cached file may have been deleted since the job found it
+      if (CFile::Exists(GetCachedPath(job->m_details.file)))
+      {
+        // a recached image may have moved to a different cached file
+        CTextureDetails previous;
+        const bool hadPrevious = GetCachedTexture(job->m_url, previous);
+        AddCachedTexture(job->m_url, job->m_details);
+        if (hadPrevious && previous.file != job->m_details.file)
+          DeleteCachedFile(previous.file);
+      }
+    }
   }
 
   { // remove from our processing list
@@ -59,6 +59,16 @@ public:
    */
   std::string CheckCachedImage(const std::string &image, bool &needsRecaching);
 
+  /*! \brief Check whether we already have this image cached, for loading it into a texture
+   As CheckCachedImage, but returns the pre-decoded version of frequently used images once it
+   exists. Only for loading textures for display, other users need the original cached image.
+   \param image url of the image to check
+   \param needsRecaching [out] whether the image needs recaching.
+   \return cached url of this image, possibly a .dds file
+   \sa CheckCachedImage
+   */
+  std::string CheckCachedTexture(const std::string& image, bool& needsRecaching);
+
   /*! \brief Cache image (if required) using a background job
 
    Checks firstly whether an image is already cached, and return URL if so [see CheckCacheImage]
@@ -150,6 +160,15 @@ public:
    */
   bool AddCachedTexture(const std::string &image, const CTextureDetails &details);
 
+  /*! \brief Get a cached texture with the given content
+   Allows images referenced via different URLs to share a single cached file.
+   \param contentHash hash of the encoded image and the options used for caching it.
+   \param details [out] details of the cached texture.
+   \return true if a cached texture with this content exists, false otherwise.
+   \sa CTextureCacheJob
+   */
+  bool GetCachedTextureByContent(const std::string& contentHash, CTextureDetails& details);
+
   /*! \brief Export a (possibly) cached image to a file
    \param image url of the original image
    \param destination url of the destination image, excluding extension.
@@ -209,6 +228,23 @@ private:
    */
   bool SetCachedTextureValid(const std::string &url, bool updateable);
 
+  /*! \brief Delete a cached file once no texture references it anymore
+   Cached files are shared between textures with identical content.
+   \param cachedFile the cached file, relative to the thumbnails folder.
+   */
+  void DeleteCachedFile(const std::string& cachedFile);
+
+  /*! \brief Get the pre-decoded version of a frequently used cached image
+   Images used more often than configured via advancedsettings.xml are additionally stored
+   pre-decoded, so they can be uploaded to the GPU without decoding them first. The pre-decoded
+   version is created in the background on first use after reaching the use count.
+   \param cachedImage full path of the cached image.
+   \param details the details of the cached image.
+   \return the path of the pre-decoded image if available, cachedImage otherwise.
+   \sa CTextureDDSJob
+   */
+  std::string GetDecodedImage(const std::string& cachedImage, const CTextureDetails& details);
+
   void OnJobComplete(unsigned int jobID, bool success, CJob *job) override;
 
   /*! \brief Called when a caching job has completed.
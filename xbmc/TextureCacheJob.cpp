@@ -16,6 +16,7 @@
 #include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/audiodecoder.h"
 #include "commons/ilog.h"
 #include "filesystem/File.h"
+#include "guilib/DDSImage.h"
 #include "guilib/Texture.h"
 #include "imagefiles/SpecialImageLoaderFactory.h"
 #include "pictures/Picture.h"
@@ -23,6 +24,7 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "settings/Settings.h"
+#include "utils/Digest.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
@@ -144,13 +146,51 @@ bool CTextureCacheJob::CacheTexture(std::unique_ptr<CTexture>* out_texture)
   }
 #endif
 
-  std::unique_ptr<CTexture> texture = LoadImage(image, width, height, additional_info, true);
+  std::unique_ptr<CTexture> texture;
+  std::vector<uint8_t> encoded;
+  std::string mimeType;
+  if (LoadEncodedImage(image, additional_info, encoded, mimeType))
+  {
+    // the same image may have been cached already via a different URL, e.g. embedded art
+    // shared by all tracks of an album, in which case we share its cached file
+    m_details.contentHash =
+        GetContentHash(encoded, width, height, scalingAlgorithm, IsControl(additional_info));
+    CTextureDetails shared;
+    if (CServiceBroker::GetTextureCache()->GetCachedTextureByContent(m_details.contentHash,
+                                                                     shared) &&
+        XFILE::CFile::Exists(CTextureCache::GetCachedPath(shared.file)))
+    {
+      CLog::Log(LOGDEBUG, "{} image '{}' shares '{}'", m_oldHash.empty() ? "Caching" : "Recaching",
+                CURL::GetRedacted(image), shared.file);
+      m_details.file = shared.file;
+      m_details.width = shared.width;
+      m_details.height = shared.height;
+      if (out_texture) // caller wants the texture
+        *out_texture = LoadImage(CTextureCache::GetCachedPath(m_details.file), width, height,
+                                 "" /* already flipped */);
+      return true;
+    }
+
+    texture = CTexture::LoadFromFileInMemory(encoded.data(), encoded.size(), mimeType, width,
+                                             height);
+    if (texture && IsControl(additional_info))
+      texture->SetOrientation(texture->GetOrientation() ^ 1);
+  }
+  else
+    texture = LoadImage(image, width, height, additional_info, true);
+
   if (texture)
   {
+    // name the cached file after its content: cached files are shared and must never be
+    // overwritten with a different image when an URL is recached
+    const std::string cachePath =
+        m_details.contentHash.empty()
+            ? m_cachePath
+            : StringUtils::Format("{}/{}", m_details.contentHash[0], m_details.contentHash);
     if (texture->HasAlpha())
-      m_details.file = m_cachePath + ".png";
+      m_details.file = cachePath + ".png";
     else
-      m_details.file = m_cachePath + ".jpg";
+      m_details.file = cachePath + ".jpg";
 
     CLog::Log(LOGDEBUG, "{} image '{}' to '{}':", m_oldHash.empty() ? "Caching" : "Recaching",
               CURL::GetRedacted(image), m_details.file);
@@ -314,6 +354,82 @@ std::string CTextureCacheJob::GetImageHash(const std::string &url)
   return "";
 }
 
+bool CTextureCacheJob::LoadEncodedImage(const std::string& image,
+                                        const std::string& additional_info,
+                                        std::vector<uint8_t>& data,
+                                        std::string& mimeType)
+{
+  if (!additional_info.empty() && !IsControl(additional_info) &&
+      !IsPVROwnedImage(additional_info))
+  {
+    // only images stored as they are, e.g. embedded in a media file, have encoded data
+    IMAGE_FILES::CSpecialImageLoaderFactory specialImageLoader{};
+    return specialImageLoader.LoadEncoded(additional_info, image, data, mimeType);
+  }
+
+  // textures and images of our own vfs types are not decoded from a file
+  if (URIUtils::HasExtension(image, ".dds") || URIUtils::IsProtocol(image, "xbt") ||
+      URIUtils::IsProtocol(image, "resource") || URIUtils::IsProtocol(image, "androidapp"))
+    return false;
+
+  CFileItem file(image, false);
+  file.FillInMimeType();
+  if (!(file.IsPicture() && !(file.IsZIP() || file.IsRAR() || file.IsCBR() || file.IsCBZ())) &&
+      !StringUtils::StartsWithNoCase(file.GetMimeType(), "image/") &&
+      !StringUtils::EqualsNoCase(file.GetMimeType(), "application/octet-stream"))
+    return false;
+
+  mimeType = file.GetMimeType();
+  if (mimeType.empty())
+    return false;
+
+  XFILE::CFile imageFile;
+  return imageFile.LoadFile(image, data) > 0;
+}
+
+std::string CTextureCacheJob::GetContentHash(const std::vector<uint8_t>& data,
+                                             unsigned int width,
+                                             unsigned int height,
+                                             CPictureScalingAlgorithm::Algorithm scalingAlgorithm,
+                                             bool flipped)
+{
+  KODI::UTILITY::CDigest digest{KODI::UTILITY::CDigest::Type::MD5};
+  digest.Update(StringUtils::Format("w{}h{}a{}f{}|", width, height,
+                                    CPictureScalingAlgorithm::ToString(scalingAlgorithm), flipped));
+  digest.Update(data.data(), data.size());
+  return digest.Finalize();
+}
+
+CTextureDDSJob::CTextureDDSJob(const std::string &original) : m_original(original)
+{
+}
+
+bool CTextureDDSJob::operator==(const CJob* job) const
+{
+  if (strcmp(job->GetType(),GetType()) == 0)
+  {
+    const CTextureDDSJob* ddsJob = dynamic_cast<const CTextureDDSJob*>(job);
+    if (ddsJob && ddsJob->m_original == m_original)
+      return true;
+  }
+  return false;
+}
+
+bool CTextureDDSJob::DoWork()
+{
+  if (URIUtils::HasExtension(m_original, ".dds"))
+    return false;
+
+  std::unique_ptr<CTexture> texture = CTexture::LoadFromFile(m_original, 0, 0, true);
+  if (!texture || !texture->GetPixels())
+    return false;
+
+  CDDSImage dds;
+  return dds.Create(URIUtils::ReplaceExtension(m_original, ".dds"), texture->GetWidth(),
+                    texture->GetHeight(), texture->GetPitch(), texture->GetPixels(),
+                    texture->HasAlpha());
+}
+
 CTextureUseCountJob::CTextureUseCountJob(const std::vector<CTextureDetails> &textures) : m_textures(textures)
 {
 }
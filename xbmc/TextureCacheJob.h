@@ -36,8 +36,10 @@ public:
   int id{-1};
   std::string file;
   std::string hash;
+  std::string contentHash;
   unsigned int width{0};
   unsigned int height{0};
+  unsigned int useCount{0};
   bool updateable{false};
   bool hashRevalidated{false};
 };
@@ -78,6 +80,34 @@ private:
    */
   static std::string GetImageHash(const std::string &url);
 
+  /*! \brief Read the encoded data of an image which is stored as it is
+   \param image the image, a file or an image embedded in a media file
+   \param additional_info extra info for special images
+   \param data [out] the encoded image
+   \param mimeType [out] the mime type of the encoded image
+   \return true if the encoded data was read, false for generated images and textures
+   */
+  static bool LoadEncodedImage(const std::string& image,
+                               const std::string& additional_info,
+                               std::vector<uint8_t>& data,
+                               std::string& mimeType);
+
+  /*! \brief retrieve a hash for the content of the given image
+   Combines the encoded image with the options used for caching it, so that identical images
+   referenced via different URLs resolve to the same hash without decoding them.
+   \param data the encoded image
+   \param width the desired maximum width
+   \param height the desired maximum height
+   \param scalingAlgorithm the scaling algorithm used for resizing
+   \param flipped whether the image is mirrored
+   \return a hash string for the content of this image
+   */
+  static std::string GetContentHash(const std::vector<uint8_t>& data,
+                                    unsigned int width,
+                                    unsigned int height,
+                                    CPictureScalingAlgorithm::Algorithm scalingAlgorithm,
+                                    bool flipped);
+
   /*! \brief Decode an image URL to the underlying image, width, height and orientation
    \param url wrapped URL of the image
    \param width width derived from URL
@@ -108,6 +138,22 @@ private:
   std::string    m_cachePath;
 };
 
+/* \brief Job class for storing a cached image pre-decoded
+ Writes the pixels of a cached image to a .dds file next to it, which is uploaded to the GPU as is
+ when loading the image, skipping the decoding of the image.
+ */
+class CTextureDDSJob : public CJob
+{
+public:
+  explicit CTextureDDSJob(const std::string &original);
+
+  const char* GetType() const override { return "ddscompress"; }
+  bool operator==(const CJob *job) const override;
+  bool DoWork() override;
+
+  std::string m_original;
+};
+
 /* \brief Job class for storing the use count of textures
  */
 class CTextureUseCountJob : public CJob
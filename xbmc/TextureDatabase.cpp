@@ -151,7 +151,7 @@ bool CTextureDatabase::Open()
 void CTextureDatabase::CreateTables()
 {
   CLog::Log(LOGINFO, "create texture table");
-  m_pDS->exec("CREATE TABLE texture (id integer primary key, url text, cachedurl text, imagehash text, lasthashcheck text)");
+  m_pDS->exec("CREATE TABLE texture (id integer primary key, url text, cachedurl text, imagehash text, lasthashcheck text, contenthash text)");
 
   CLog::Log(LOGINFO, "create sizes table, index,  and trigger");
   m_pDS->exec("CREATE TABLE sizes (idtexture integer, size integer, width integer, height integer, usecount integer, lastusetime text)");
@@ -164,6 +164,8 @@ void CTextureDatabase::CreateAnalytics()
 {
   CLog::Log(LOGINFO, "{} creating indices", __FUNCTION__);
   m_pDS->exec("CREATE INDEX idxTexture ON texture(url)");
+  m_pDS->exec("CREATE INDEX idxTextureCachedUrl ON texture(cachedurl)");
+  m_pDS->exec("CREATE INDEX idxTextureContent ON texture(contenthash)");
   m_pDS->exec("CREATE INDEX idxSize ON sizes(idtexture, size)");
   m_pDS->exec("CREATE INDEX idxSize2 ON sizes(idtexture, width, height)");
   //! @todo Should the path index be a covering index? (we need only retrieve texture)
@@ -226,6 +228,10 @@ void CTextureDatabase::UpdateTables(int version)
     m_pDS->exec("CREATE TABLE texture (id integer primary key, url text, cachedurl text, imagehash text, lasthashcheck text)");
     m_pDS->exec("CREATE TABLE sizes (idtexture integer, size integer, width integer, height integer, usecount integer, lastusetime text)");
   }
+  if (version < 14)
+  { // add the content hash used to share cached files between textures
+    m_pDS->exec("ALTER TABLE texture ADD contenthash text");
+  }
 }
 
 bool CTextureDatabase::IncrementUseCount(const CTextureDetails &details)
@@ -243,7 +249,7 @@ bool CTextureDatabase::GetCachedTexture(const std::string &url, CTextureDetails
     if (!m_pDS)
       return false;
 
-    std::string sql = PrepareSQL("SELECT id, cachedurl, lasthashcheck, imagehash, width, height FROM texture JOIN sizes ON (texture.id=sizes.idtexture AND sizes.size=1) WHERE url='%s'", url.c_str());
+    std::string sql = PrepareSQL("SELECT id, cachedurl, lasthashcheck, imagehash, width, height, usecount FROM texture JOIN sizes ON (texture.id=sizes.idtexture AND sizes.size=1) WHERE url='%s'", url.c_str());
     m_pDS->query(sql);
     if (!m_pDS->eof())
     { // have some information
@@ -255,6 +261,7 @@ bool CTextureDatabase::GetCachedTexture(const std::string &url, CTextureDetails
         details.hash = m_pDS->fv(3).get_asString();
       details.width = m_pDS->fv(4).get_asInt();
       details.height = m_pDS->fv(5).get_asInt();
+      details.useCount = m_pDS->fv(6).get_asInt();
       m_pDS->close();
       return true;
     }
@@ -267,6 +274,45 @@ bool CTextureDatabase::GetCachedTexture(const std::string &url, CTextureDetails
   return false;
 }
 
+bool CTextureDatabase::GetCachedTextureByContent(const std::string& contentHash,
+                                                 CTextureDetails& details)
+{
+  try
+  {
+    if (!m_pDB)
+      return false;
+    if (!m_pDS)
+      return false;
+
+    if (contentHash.empty())
+      return false;
+
+    std::string sql = PrepareSQL("SELECT id, cachedurl, width, height FROM texture JOIN sizes ON (texture.id=sizes.idtexture AND sizes.size=1) WHERE contenthash='%s' LIMIT 1", contentHash.c_str());
+    m_pDS->query(sql);
+    if (!m_pDS->eof())
+    {
+      details.id = m_pDS->fv(0).get_asInt();
+      details.file = m_pDS->fv(1).get_asString();
+      details.width = m_pDS->fv(2).get_asInt();
+      details.height = m_pDS->fv(3).get_asInt();
+      details.contentHash = contentHash;
+      m_pDS->close();
+      return true;
+    }
+    m_pDS->close();
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "{}, failed on content hash '{}'", __FUNCTION__, contentHash);
+  }
+  return false;
+}
+
+bool CTextureDatabase::IsCachedFileReferenced(const std::string& cacheFile)
+{
+  return !GetSingleValue(PrepareSQL("SELECT id FROM texture WHERE cachedurl='%s' LIMIT 1", cacheFile.c_str())).empty();
+}
+
 bool CTextureDatabase::GetTextures(CVariant &items, const Filter &filter)
 {
   try
@@ -281,7 +327,10 @@ bool CTextureDatabase::GetTextures(CVariant &items, const Filter &filter)
     if (!CDatabase::BuildSQL("", filter, sqlFilter))
       return false;
 
-    sql = PrepareSQL(sql, !filter.fields.empty() ? filter.fields.c_str() : "*") + sqlFilter;
+    // list the columns explicitly, the texture table gained columns over time
+    const std::string columns = "texture.id, url, cachedurl, imagehash, lasthashcheck, "
+                                "sizes.idtexture, size, width, height, usecount, lastusetime";
+    sql = PrepareSQL(sql, !filter.fields.empty() ? filter.fields.c_str() : columns.c_str()) + sqlFilter;
     if (!m_pDS->query(sql))
       return false;
 
@@ -335,7 +384,7 @@ bool CTextureDatabase::AddCachedTexture(const std::string &url, const CTextureDe
     m_pDS->exec(sql);
 
     std::string date = details.updateable ? CDateTime::GetCurrentDateTime().GetAsDBDateTime() : "";
-    sql = PrepareSQL("INSERT INTO texture (id, url, cachedurl, imagehash, lasthashcheck) VALUES(NULL, '%s', '%s', '%s', '%s')", url.c_str(), details.file.c_str(), details.hash.c_str(), date.c_str());
+    sql = PrepareSQL("INSERT INTO texture (id, url, cachedurl, imagehash, lasthashcheck, contenthash) VALUES(NULL, '%s', '%s', '%s', '%s', '%s')", url.c_str(), details.file.c_str(), details.hash.c_str(), date.c_str(), details.contentHash.c_str());
     m_pDS->exec(sql);
     int textureID = (int)m_pDS->lastinsertid();
 
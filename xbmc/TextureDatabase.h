@@ -69,6 +69,20 @@ public:
   bool ClearCachedTexture(int textureID, std::string &cacheFile);
   bool IncrementUseCount(const CTextureDetails &details);
 
+  /*! \brief Get a cached texture with the given content
+   Cached textures are shared between all original URLs resolving to the same image.
+   \param contentHash hash of the encoded image bytes and the options used for caching it.
+   \param details [out] details of the cached texture.
+   \return true if a cached texture with the given content exists, false otherwise.
+   */
+  bool GetCachedTextureByContent(const std::string& contentHash, CTextureDetails& details);
+
+  /*! \brief Check whether a cached file is still referenced by any texture
+   \param cacheFile the cached file, relative to the thumbnails folder.
+   \return true if the cached file is in use, false otherwise.
+   */
+  bool IsCachedFileReferenced(const std::string& cacheFile);
+
   /*! \brief Invalidate a previously cached texture
    Invalidates the texture hash, and sets the texture update time to the current time so that
    next texture load it will be re-cached.
@@ -120,6 +134,6 @@ protected:
   void CreateTables() override;
   void CreateAnalytics() override;
   void UpdateTables(int version) override;
-  int GetSchemaVersion() const override { return 13; }
+  int GetSchemaVersion() const override { return 14; }
   const char* GetBaseDBName() const override { return "Textures"; }
 };
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TexturePrecacheJob.h"
+
+#include "ServiceBroker.h"
+#include "TextureCache.h"
+#include "guilib/LocalizeStrings.h"
+#include "utils/CPUInfo.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <utility>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr unsigned int MAX_THREADS = 8;
+constexpr auto PROGRESS_INTERVAL = 500ms;
+} // namespace
+
+CTexturePrecacheJob::CTexturePrecacheJob(std::vector<std::string> urls,
+                                         unsigned int threads /* = 0 */)
+  : m_urls(std::move(urls)), m_threads(threads)
+{
+}
+
+bool CTexturePrecacheJob::DoWork()
+{
+  std::sort(m_urls.begin(), m_urls.end());
+  m_urls.erase(std::unique(m_urls.begin(), m_urls.end()), m_urls.end());
+  m_urls.erase(std::remove(m_urls.begin(), m_urls.end(), ""), m_urls.end());
+
+  const size_t total = m_urls.size();
+  unsigned int threads = m_threads;
+  if (threads == 0)
+    threads = std::min(static_cast<unsigned int>(CServiceBroker::GetCPUInfo()->GetCPUCount()),
+                       MAX_THREADS);
+  threads = std::max(std::min(threads, static_cast<unsigned int>(total)), 1u);
+
+  SetTitle(g_localizeStrings.Get(39203)); // Caching artwork
+
+  const std::shared_ptr<CTextureCache> textureCache = CServiceBroker::GetTextureCache();
+  std::atomic<size_t> next{0};
+  std::atomic<size_t> done{0};
+  std::atomic<size_t> cached{0};
+  std::atomic<size_t> failed{0};
+  std::atomic<bool> stop{false};
+
+  auto worker = [this, &textureCache, &next, &done, &cached, &failed, &stop]()
+  {
+    for (size_t i = next++; i < m_urls.size() && !stop; i = next++)
+    {
+      const std::string& url = m_urls[i];
+      if (!textureCache->HasCachedImage(url))
+      {
+        if (textureCache->CacheImage(url).empty())
+          failed++;
+        else
+          cached++;
+      }
+      done++;
+    }
+  };
+
+  CLog::Log(LOGINFO, "CTexturePrecacheJob: caching {} image(s) using {} thread(s)", total, threads);
+
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::future<void>> workers;
+  for (unsigned int i = 0; i < threads; ++i)
+    workers.emplace_back(std::async(std::launch::async, worker));
+
+  // report the progress until all workers are finished
+  for (auto& future : workers)
+  {
+    while (future.wait_for(PROGRESS_INTERVAL) != std::future_status::ready)
+    {
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      SetText(StringUtils::Format("{} / {} ({:.1f} images/s)", done.load(), total,
+                                  cached / elapsed.count()));
+      SetProgress(static_cast<int>(done), static_cast<int>(total));
+      if (!stop && ShouldCancel(static_cast<unsigned int>(done), static_cast<unsigned int>(total)))
+        stop = true;
+    }
+  }
+
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  CLog::Log(LOGINFO,
+            "CTexturePrecacheJob: cached {} of {} image(s) in {:.1f} s ({:.1f} images/s), {} "
+            "failed{}",
+            cached.load(), total, elapsed.count(), cached / std::max(elapsed.count(), 0.001),
+            failed.load(), stop ? ", cancelled" : "");
+
+  MarkFinished();
+  return !stop;
+}
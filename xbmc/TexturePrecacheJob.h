@@ -0,0 +1,40 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "utils/ProgressJob.h"
+
+#include <string>
+#include <vector>
+
+/*!
+ \ingroup textures
+ \brief Job class for caching a batch of images ahead of their first use
+
+ Warms the texture cache, e.g. for all the artwork of the library, by caching the images on a pool
+ of worker threads. Each worker loads, scales and encodes the images on its own, so the throughput
+ scales with the number of cores. Images which are already cached are skipped.
+ */
+class CTexturePrecacheJob : public CProgressJob
+{
+public:
+  /*! \brief Create a job caching the given images
+   \param urls urls of the images to cache.
+   \param threads number of images cached at once, 0 to use one thread per core.
+   */
+  explicit CTexturePrecacheJob(std::vector<std::string> urls, unsigned int threads = 0);
+
+  // implementation of CJob
+  const char* GetType() const override { return "texturePrecache"; }
+  bool DoWork() override;
+
+private:
+  std::vector<std::string> m_urls;
+  unsigned int m_threads;
+};
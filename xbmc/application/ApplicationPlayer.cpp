@@ -285,6 +285,13 @@ void CApplicationPlayer::Pause()
   }
 }
 
+void CApplicationPlayer::PrepareFiles(const std::vector<std::shared_ptr<CFileItem>>& files)
+{
+  std::shared_ptr<IPlayer> player = GetInternal();
+  if (player)
+    player->PrepareFiles(files);
+}
+
 void CApplicationPlayer::SetMute(bool bOnOff)
 {
   std::shared_ptr<IPlayer> player = GetInternal();
@@ -139,6 +139,7 @@ public:
   bool OnAction(const CAction &action);
   void OnNothingToQueueNotify();
   void Pause();
+  void PrepareFiles(const std::vector<std::shared_ptr<CFileItem>>& files);
   bool QueueNextFile(const CFileItem &file);
   void Seek(bool bPlus = true, bool bLargeStep = false, bool bChapterOverride = false);
   int SeekChapter(int iChapter);
@@ -339,6 +339,18 @@ int64_t CDataCacheCore::GetSeekOffSet() const
   return m_stateInfo.m_lastSeekOffset;
 }
 
+void CDataCacheCore::SetTimeToFirstFrame(std::chrono::milliseconds timeToFirstFrame)
+{
+  std::unique_lock<CCriticalSection> lock(m_stateSection);
+  m_stateInfo.m_timeToFirstFrame = timeToFirstFrame;
+}
+
+std::chrono::milliseconds CDataCacheCore::GetTimeToFirstFrame() const
+{
+  std::unique_lock<CCriticalSection> lock(m_stateSection);
+  return m_stateInfo.m_timeToFirstFrame;
+}
+
 bool CDataCacheCore::HasPerformedSeek(int64_t lastSecondInterval) const
 {
   std::unique_lock<CCriticalSection> lock(m_stateSection);
@@ -141,6 +141,19 @@ public:
   */
   int64_t GetSeekOffSet() const;
 
+  /*!
+   * @brief Notifies the cache core that playback of the current item has started
+   * @param timeToFirstFrame - the time from the request to play the item until its first frames
+   * were presented
+  */
+  void SetTimeToFirstFrame(std::chrono::milliseconds timeToFirstFrame);
+
+  /*!
+   * @brief Gets the time needed to start playback of the current item
+   * @return the time to the first frame, zero while playback has not started yet
+  */
+  std::chrono::milliseconds GetTimeToFirstFrame() const;
+
   void SetSpeed(float tempo, float speed);
   float GetSpeed();
   float GetTempo();
@@ -323,6 +336,8 @@ protected:
         std::chrono::time_point<std::chrono::system_clock>{}};
     /*! Last seek offset */
     int64_t m_lastSeekOffset{0};
+    /*! Time needed to start playback of the current item */
+    std::chrono::milliseconds m_timeToFirstFrame{0};
   } m_stateInfo;
 
   struct STimeInfo
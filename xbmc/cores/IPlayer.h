@@ -94,6 +94,8 @@ public:
   virtual bool OpenFile(const CFileItem& file, const CPlayerOptions& options){ return false;}
   virtual bool QueueNextFile(const CFileItem &file) { return false; }
   virtual void OnNothingToQueueNotify() {}
+  // open files likely to be played next in the background, releasing files prepared before
+  virtual void PrepareFiles(const std::vector<std::shared_ptr<CFileItem>>& files) {}
   virtual bool CloseFile(bool reopen = false) = 0;
   virtual bool IsPlaying() const { return false;}
   virtual bool CanPause() const { return true; }
@@ -24,6 +24,7 @@
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <memory>
 #include <mutex>
 
@@ -62,6 +63,68 @@ enum EFilterFlags {
   FILTER_ROTATE              = 0x40,  //< rotate image according to the codec hints
 };
 
+namespace
+{
+using ThreadingProfile = CDVDVideoCodecFFmpeg::ThreadingProfile;
+
+// Threading of software decoding, chosen by codec and picture size. ffmpeg uses frame threads if
+// the decoder supports them and the thread type allows it, slice threads otherwise. Every frame
+// thread delays the output by a frame, which is noticed after seeks and channel switches, and
+// threads beyond the number of cores mostly cost memory bandwidth. So streams start with the
+// threads they usually need and get the full set when the decoder falls behind.
+constexpr ThreadingProfile FULL_THREADING = {AV_CODEC_ID_NONE, 0, FF_THREAD_FRAME | FF_THREAD_SLICE,
+                                             150, 16};
+
+// the first matching entry is used
+constexpr ThreadingProfile THREADING_PROFILES[] = {
+    // h264 is mostly sent with a single slice per picture, so slice threads would not run in
+    // parallel. two frame threads delay the output by a single frame only.
+    {AV_CODEC_ID_H264, 1024 * 576, FF_THREAD_FRAME | FF_THREAD_SLICE, 100, 2},
+    // sd decodes in real time on a single core, slices keep the latency down
+    {AV_CODEC_ID_NONE, 1024 * 576, FF_THREAD_SLICE, 100, 4},
+    // a frame thread per core
+    {AV_CODEC_ID_HEVC, 0, FF_THREAD_FRAME | FF_THREAD_SLICE, 100, 16},
+    {AV_CODEC_ID_VP9, 0, FF_THREAD_FRAME | FF_THREAD_SLICE, 100, 16},
+    {AV_CODEC_ID_AV1, 0, FF_THREAD_FRAME | FF_THREAD_SLICE, 100, 16},
+    {AV_CODEC_ID_NONE, 1280 * 720, FF_THREAD_FRAME | FF_THREAD_SLICE, 100, 4},
+    FULL_THREADING,
+};
+
+// the threads are raised if the player asked to drop frames for this many of the last packets
+constexpr int BEHIND_PACKETS = 25;
+constexpr int BEHIND_WINDOW = 250;
+
+// packets tracked in the decoder, for streams that never output a frame
+constexpr size_t MAX_DECODER_QUEUE = 300;
+} // unnamed namespace
+
+const CDVDVideoCodecFFmpeg::ThreadingProfile& CDVDVideoCodecFFmpeg::GetThreadingProfile(
+    AVCodecID codec, int width, int height)
+{
+  const int pixels = width * height;
+  if (pixels <= 0)
+    return FULL_THREADING;
+
+  for (const auto& profile : THREADING_PROFILES)
+  {
+    if ((profile.codec == AV_CODEC_ID_NONE || profile.codec == codec) &&
+        (profile.maxPixels == 0 || pixels <= profile.maxPixels))
+      return profile;
+  }
+  return FULL_THREADING;
+}
+
+const CDVDVideoCodecFFmpeg::ThreadingProfile& CDVDVideoCodecFFmpeg::GetFullThreadingProfile()
+{
+  return FULL_THREADING;
+}
+
+int CDVDVideoCodecFFmpeg::GetThreadCount(const ThreadingProfile& profile, int cpuCount)
+{
+  const int threads = cpuCount * profile.threadsPerCpu / 100;
+  return std::max(1, std::min(threads, profile.maxThreads));
+}
+
 //------------------------------------------------------------------------------
 // Video Buffers
 //------------------------------------------------------------------------------
@@ -392,12 +455,21 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
     }
     else
     {
-      int num_threads = CServiceBroker::GetCPUInfo()->GetCPUCount() * 3 / 2;
-      num_threads = std::max(1, std::min(num_threads, 16));
+      const bool adaptive =
+          CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoAdaptiveThreads;
+      const ThreadingProfile& profile = adaptive && !m_threadsRaised
+                                            ? GetThreadingProfile(pCodec->id, hints.width,
+                                                                  hints.height)
+                                            : FULL_THREADING;
+      const int cpuCount = CServiceBroker::GetCPUInfo()->GetCPUCount();
+      const int num_threads = GetThreadCount(profile, cpuCount);
+      m_pCodecContext->thread_type = profile.threadType;
       m_pCodecContext->thread_count = num_threads;
+      m_canRaiseThreads = profile.threadType != FULL_THREADING.threadType ||
+                          num_threads < GetThreadCount(FULL_THREADING, cpuCount);
       m_decoderState = STATE_SW_MULTI;
-      CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg - open frame threaded with {} threads",
-                num_threads);
+      CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg - open {} threaded with {} threads",
+                profile.threadType & FF_THREAD_FRAME ? "frame" : "slice", num_threads);
     }
   }
   else
@@ -466,12 +538,31 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
   }
 
   UpdateName();
+  if (m_pCodecContext->active_thread_type & FF_THREAD_FRAME)
+    m_processInfo.SetVideoDecoderThreading(
+        StringUtils::Format("frame x{}", m_pCodecContext->thread_count));
+  else if (m_pCodecContext->active_thread_type & FF_THREAD_SLICE)
+    m_processInfo.SetVideoDecoderThreading(
+        StringUtils::Format("slice x{}", m_pCodecContext->thread_count));
+  else if (m_pCodecContext->thread_count > 1 &&
+           (pCodec->capabilities & AV_CODEC_CAP_OTHER_THREADS))
+    // decoders of external libraries run threads of their own
+    m_processInfo.SetVideoDecoderThreading(
+        StringUtils::Format("x{}", m_pCodecContext->thread_count));
+  else
+    m_processInfo.SetVideoDecoderThreading("single");
+
   const char* pixFmtName = av_get_pix_fmt_name(m_pCodecContext->pix_fmt);
   m_processInfo.SetVideoDimensions(m_pCodecContext->coded_width, m_pCodecContext->coded_height);
   m_processInfo.SetVideoPixelFormat(pixFmtName ? pixFmtName : "");
 
   m_dropCtrl.Reset(true);
   m_eof = false;
+  m_raiseThreads = false;
+  m_behindPackets = 0;
+  m_checkedPackets = 0;
+  m_decoderQueue.clear();
+  m_processInfo.SetVideoDecoderQueue(0, 0);
   return true;
 }
 
@@ -620,6 +711,13 @@ bool CDVDVideoCodecFFmpeg::AddData(const DemuxPacket &packet)
 
   int ret = avcodec_send_packet(m_pCodecContext, avpkt);
 
+  if (ret == 0 && avpkt->pts != AV_NOPTS_VALUE)
+  {
+    m_decoderQueue.push_back(avpkt->pts);
+    if (m_decoderQueue.size() > MAX_DECODER_QUEUE)
+      m_decoderQueue.pop_front();
+  }
+
   //! @todo: properly handle avpkt side_data. this works around our improper use of the side_data
   // as we pass pointers to ffmpeg allocated memory for the side_data. we should really be allocating
   // and storing our own AVPacket. This will require some extensive changes.
@@ -700,6 +798,15 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::GetPicture(VideoPicture* pVideoPi
       return ret;
   }
 
+  // the decoder fell behind, reopen it with more threads
+  if (m_raiseThreads && !(m_codecControlFlags & DVD_CODEC_CTRL_DRAIN))
+  {
+    CLog::Log(LOGINFO, "CDVDVideoCodecFFmpeg::GetPicture - decoder falls behind, raising threads");
+    m_raiseThreads = false;
+    m_threadsRaised = true;
+    return VC_REOPEN;
+  }
+
   // process ffmpeg
   if (m_codecControlFlags & DVD_CODEC_CTRL_DRAIN)
   {
@@ -800,6 +907,7 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::GetPicture(VideoPicture* pVideoPi
     }
   }
   m_dropCtrl.Process(framePTS, m_pCodecContext->skip_frame > AVDISCARD_DEFAULT);
+  UpdateDecoderQueue(framePTS);
 
   if (m_pDecodedFrame->key_frame)
   {
@@ -943,6 +1051,9 @@ void CDVDVideoCodecFFmpeg::Reset()
   m_skippedDeint = 0;
   m_droppedFrames = 0;
   m_eof = false;
+  m_behindPackets = 0;
+  m_checkedPackets = 0;
+  m_decoderQueue.clear();
   m_iLastKeyframe = m_pCodecContext->has_b_frames;
   avcodec_flush_buffers(m_pCodecContext);
   av_frame_unref(m_pFrame);
@@ -1396,10 +1507,49 @@ bool CDVDVideoCodecFFmpeg::GetCodecStats(double &pts, int &droppedFrames, int &s
   return true;
 }
 
+void CDVDVideoCodecFFmpeg::UpdateDecoderQueue(int64_t pts)
+{
+  if (pts == AV_NOPTS_VALUE)
+    return;
+
+  // packets up to the picture were output or dropped, the later ones are still decoded or
+  // reordered
+  m_decoderQueue.erase(std::remove_if(m_decoderQueue.begin(), m_decoderQueue.end(),
+                                      [pts](int64_t queued) { return queued <= pts; }),
+                       m_decoderQueue.end());
+
+  int lag = 0;
+  if (!m_decoderQueue.empty())
+  {
+    const int64_t last = *std::max_element(m_decoderQueue.begin(), m_decoderQueue.end());
+    lag = static_cast<int>((last - pts) * 1000 / AV_TIME_BASE);
+  }
+  m_processInfo.SetVideoDecoderQueue(static_cast<int>(m_decoderQueue.size()), lag);
+}
+
 void CDVDVideoCodecFFmpeg::SetCodecControl(int flags)
 {
   m_codecControlFlags = flags;
 
+  // packets sent while seeking, draining or fast forwarding are not counted
+  if (m_decoderState == STATE_SW_MULTI && m_canRaiseThreads && m_started &&
+      !(flags & (DVD_CODEC_CTRL_DROP | DVD_CODEC_CTRL_DRAIN | DVD_CODEC_CTRL_NO_POSTPROC)))
+  {
+    if (flags & DVD_CODEC_CTRL_DROP_ANY)
+      m_behindPackets++;
+
+    if (++m_checkedPackets >= BEHIND_WINDOW)
+    {
+      if (m_behindPackets >= BEHIND_PACKETS)
+      {
+        m_raiseThreads = true;
+        m_canRaiseThreads = false;
+      }
+      m_behindPackets = 0;
+      m_checkedPackets = 0;
+    }
+  }
+
   if (m_pCodecContext)
   {
     bool bDrop = (flags & DVD_CODEC_CTRL_DROP_ANY) != 0;
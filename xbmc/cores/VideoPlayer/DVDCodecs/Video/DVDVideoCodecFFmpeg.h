@@ -12,6 +12,7 @@
 #include "cores/VideoPlayer/DVDStreamInfo.h"
 #include "DVDVideoCodec.h"
 #include "DVDVideoPPFFmpeg.h"
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -45,6 +46,34 @@ public:
   IHardwareDecoder* GetHWAccel() override;
   bool GetPictureCommon(VideoPicture* pVideoPicture) override;
 
+  /*!
+   * \brief Threading of software decoding.
+   */
+  struct ThreadingProfile
+  {
+    AVCodecID codec; // AV_CODEC_ID_NONE for any codec
+    int maxPixels; // 0 for any size
+    int threadType;
+    int threadsPerCpu; // in percent
+    int maxThreads;
+  };
+
+  /*!
+   * \brief Get the threading a software decoder is opened with, by codec and picture size.
+   * Streams of unknown size get the full threading.
+   */
+  static const ThreadingProfile& GetThreadingProfile(AVCodecID codec, int width, int height);
+
+  /*!
+   * \brief Get the threading a software decoder is reopened with if it falls behind.
+   */
+  static const ThreadingProfile& GetFullThreadingProfile();
+
+  /*!
+   * \brief Get the number of threads of a threading profile for the number of CPU cores.
+   */
+  static int GetThreadCount(const ThreadingProfile& profile, int cpuCount);
+
 protected:
   void Dispose();
   static enum AVPixelFormat GetFormat(struct AVCodecContext * avctx, const AVPixelFormat * fmt);
@@ -54,6 +83,7 @@ protected:
   CDVDVideoCodec::VCReturn FilterProcess(AVFrame* frame);
   void SetFilters();
   void UpdateName();
+  void UpdateDecoderQueue(int64_t pts);
   bool SetPictureParams(VideoPicture* pVideoPicture);
 
   bool HasHardware() { return m_pHardware != nullptr; }
@@ -99,6 +129,14 @@ protected:
   CDVDStreamInfo m_hints;
   CDVDCodecOptions m_options;
 
+  // adaptive threading of software decoding
+  bool m_canRaiseThreads = false;
+  bool m_raiseThreads = false;
+  bool m_threadsRaised = false;
+  int m_behindPackets = 0;
+  int m_checkedPackets = 0;
+  std::deque<int64_t> m_decoderQueue; // pts of the packets in the decoder
+
   struct CDropControl
   {
     CDropControl();
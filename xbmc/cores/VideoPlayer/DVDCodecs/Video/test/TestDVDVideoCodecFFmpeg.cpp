@@ -0,0 +1,75 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDCodecs/Video/DVDVideoCodecFFmpeg.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct ThreadingCase
+{
+  AVCodecID codec;
+  int width;
+  int height;
+  int threadType;
+  int threadsFor4Cpus;
+};
+
+using Profile = CDVDVideoCodecFFmpeg::ThreadingProfile;
+
+constexpr int FRAME_AND_SLICE = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
+// clang-format off
+const ThreadingCase THREADING_CASES[] = {
+    // h264 sd has a single slice per picture, slice threads would not run in parallel
+    {AV_CODEC_ID_H264,       720,  576, FRAME_AND_SLICE, 2},
+    {AV_CODEC_ID_H264,       720,  480, FRAME_AND_SLICE, 2},
+    {AV_CODEC_ID_MPEG2VIDEO, 720,  576, FF_THREAD_SLICE, 4},
+    {AV_CODEC_ID_HEVC,       720,  576, FF_THREAD_SLICE, 4},
+    {AV_CODEC_ID_H264,      1280,  720, FRAME_AND_SLICE, 4},
+    {AV_CODEC_ID_MPEG2VIDEO,1280,  720, FRAME_AND_SLICE, 4},
+    {AV_CODEC_ID_HEVC,      3840, 2160, FRAME_AND_SLICE, 4},
+    {AV_CODEC_ID_H264,      1920, 1080, FRAME_AND_SLICE, 6},
+    // unknown size
+    {AV_CODEC_ID_H264,         0,    0, FRAME_AND_SLICE, 6},
+};
+// clang-format on
+} // namespace
+
+TEST(TestDVDVideoCodecFFmpeg, ThreadingProfiles)
+{
+  for (const ThreadingCase& test : THREADING_CASES)
+  {
+    SCOPED_TRACE(testing::Message() << avcodec_get_name(test.codec) << " " << test.width << "x"
+                                    << test.height);
+
+    const Profile& profile =
+        CDVDVideoCodecFFmpeg::GetThreadingProfile(test.codec, test.width, test.height);
+    EXPECT_EQ(test.threadType, profile.threadType);
+    EXPECT_EQ(test.threadsFor4Cpus, CDVDVideoCodecFFmpeg::GetThreadCount(profile, 4));
+  }
+}
+
+TEST(TestDVDVideoCodecFFmpeg, ThreadCount)
+{
+  const Profile& full = CDVDVideoCodecFFmpeg::GetFullThreadingProfile();
+  EXPECT_EQ(1, CDVDVideoCodecFFmpeg::GetThreadCount(full, 1));
+  EXPECT_EQ(3, CDVDVideoCodecFFmpeg::GetThreadCount(full, 2));
+  EXPECT_EQ(16, CDVDVideoCodecFFmpeg::GetThreadCount(full, 64));
+
+  // the full profile raises the threads of every other profile
+  for (const ThreadingCase& test : THREADING_CASES)
+  {
+    const Profile& profile =
+        CDVDVideoCodecFFmpeg::GetThreadingProfile(test.codec, test.width, test.height);
+    for (int cpus : {1, 2, 4, 8, 32})
+      EXPECT_LE(CDVDVideoCodecFFmpeg::GetThreadCount(profile, cpus),
+                CDVDVideoCodecFFmpeg::GetThreadCount(full, cpus));
+  }
+}
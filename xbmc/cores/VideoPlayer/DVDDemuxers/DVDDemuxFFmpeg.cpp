@@ -8,12 +8,15 @@
 
 #include "DVDDemuxFFmpeg.h"
 
+#include "DVDDemuxProbeCache.h"
+#include "DVDDemuxSeekIndex.h"
 #include "DVDDemuxUtils.h"
 #include "DVDInputStreams/DVDInputStream.h"
 #ifdef HAVE_LIBBLURAY
 #include "DVDInputStreams/DVDInputStreamBluray.h"
 #endif
 #include "DVDInputStreams/DVDInputStreamFFmpeg.h"
+#include "FileItem.h"
 #include "ServiceBroker.h"
 #include "URL.h"
 #include "Util.h"
@@ -26,10 +29,12 @@
 #include "filesystem/CurlFile.h"
 #include "filesystem/Directory.h"
 #include "filesystem/File.h"
+#include "profiles/ProfileManager.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SystemClock.h"
+#include "utils/Crc32.h"
 #include "utils/FontUtils.h"
 #include "utils/LangCodeExpander.h"
 #include "utils/StringUtils.h"
@@ -37,6 +42,7 @@
 #include "utils/XTimeUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -109,6 +115,69 @@ bool AttachmentIsFont(const AVDictionaryEntry* dict)
   }
   return false;
 }
+
+CDVDDemuxProbeCache& GetProbeCache()
+{
+  static CDVDDemuxProbeCache probeCache(static_cast<size_t>(
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoProbeCacheSize));
+  return probeCache;
+}
+
+// containers without index, seeking in which benefits from a stored one. The index must point at
+// packets, so Matroska files are not included as its index points at clusters.
+const std::vector<std::string> seek_index_formats = {"avi", "mpeg", "mpegts"};
+
+// seeks don't need more than one entry per second
+constexpr int64_t SEEK_INDEX_DISTANCE = 1;
+
+// containers with this many entries in the index of a stream have an index of their own
+constexpr int SEEK_INDEX_MIN_CONTAINER_ENTRIES = 10;
+
+int GetIndexEntriesCount(AVStream* st)
+{
+#if LIBAVFORMAT_BUILD >= AV_VERSION_INT(58, 78, 100)
+  return avformat_index_get_entries_count(st);
+#else
+  return st->nb_index_entries;
+#endif
+}
+
+std::string GetSeekIndexFolder()
+{
+  return URIUtils::AddFileToFolder(
+      CServiceBroker::GetSettingsComponent()->GetProfileManager()->GetThumbnailsFolder(),
+      "seekindex");
+}
+
+std::string GetSeekIndexFile(const std::string& path)
+{
+  return URIUtils::AddFileToFolder(
+      GetSeekIndexFolder(), StringUtils::Format("{:08x}.idx", Crc32::ComputeFromLowerCase(path)));
+}
+
+// number of stored indexes kept, the least recently written ones are deleted
+constexpr int SEEK_INDEX_MAX_FILES = 500;
+
+void PruneSeekIndexFolder(const std::string& folder)
+{
+  CFileItemList items;
+  if (!XFILE::CDirectory::GetDirectory(folder, items, ".idx", XFILE::DIR_FLAG_NO_FILE_DIRS) ||
+      items.Size() <= SEEK_INDEX_MAX_FILES)
+    return;
+
+  std::vector<std::shared_ptr<CFileItem>> files;
+  for (int i = 0; i < items.Size(); ++i)
+  {
+    if (!items[i]->m_bIsFolder)
+      files.emplace_back(items[i]);
+  }
+
+  std::sort(files.begin(), files.end(),
+            [](const auto& a, const auto& b) { return a->m_dateTime < b->m_dateTime; });
+
+  for (size_t i = 0; i + SEEK_INDEX_MAX_FILES < files.size(); ++i)
+    XFILE::CFile::Delete(files[i]->GetPath());
+}
 } // namespace
 
 std::string CDemuxStreamAudioFFmpeg::GetStreamName()
@@ -560,15 +629,45 @@ bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput, bool
   m_bAVI = strcmp(m_pFormatContext->iformat->name, "avi") == 0;
   m_bSup = strcmp(m_pFormatContext->iformat->name, "sup") == 0;
 
+  // files probed before only need to be probed again if they changed
+  struct __stat64 fileStat = {};
+  const bool hasFileStat = m_pInput->IsStreamType(DVDSTREAM_TYPE_FILE) &&
+                           !m_pInput->IsRealtime() && XFILE::CFile::Stat(strFile, &fileStat) == 0;
+  const bool useProbeCache =
+      hasFileStat && m_streaminfo && !m_checkTransportStream &&
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoProbeCacheSize > 0;
+  bool probeCacheApplied = false;
+
   if (m_streaminfo)
   {
     /* to speed up dvd switches, only analyse very short */
     if (m_pInput->IsStreamType(DVDSTREAM_TYPE_DVD))
       av_opt_set_int(m_pFormatContext, "analyzeduration", 500000, 0);
 
+    if (useProbeCache && GetProbeCache().Apply(strFile, fileStat.st_size, fileStat.st_mtime,
+                                               m_pFormatContext))
+    {
+      // all parameters are known, probing only needs the first packets of the streams
+      CLog::Log(LOGDEBUG, "{} - using cached stream parameters", __FUNCTION__);
+      av_opt_set_int(m_pFormatContext, "analyzeduration", 500000, 0);
+      probeCacheApplied = true;
+    }
+
     CLog::Log(LOGDEBUG, "{} - avformat_find_stream_info starting", __FUNCTION__);
     int iErr = avformat_find_stream_info(m_pFormatContext, NULL);
-    if (iErr < 0)
+    if (iErr < 0 && probeCacheApplied)
+    {
+      // the cached parameters did not work out, probe the file from scratch
+      CLog::Log(LOGWARNING, "{} - probing with cached stream parameters failed for {}",
+                __FUNCTION__, CURL::GetRedacted(strFile));
+      GetProbeCache().Remove(strFile);
+      std::shared_ptr<CDVDInputStream> pInputStream = m_pInput;
+      Dispose();
+      if (pInputStream->Seek(0, SEEK_SET) != 0)
+        return false;
+      return Open(pInputStream, fileinfo);
+    }
+    else if (iErr < 0)
     {
       CLog::Log(LOGWARNING, "could not find codec parameters for {}", CURL::GetRedacted(strFile));
       if (m_pInput->IsStreamType(DVDSTREAM_TYPE_DVD) ||
@@ -587,6 +686,9 @@ bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput, bool
     }
     CLog::Log(LOGDEBUG, "{} - av_find_stream_info finished", __FUNCTION__);
 
+    if (iErr >= 0 && useProbeCache && !probeCacheApplied)
+      GetProbeCache().Store(strFile, fileStat.st_size, fileStat.st_mtime, m_pFormatContext);
+
     // print some extra information
     av_dump_format(m_pFormatContext, 0, CURL::GetRedacted(strFile).c_str(), 0);
 
@@ -694,6 +796,20 @@ bool CDVDDemuxFFmpeg::Open(const std::shared_ptr<CDVDInputStream>& pInput, bool
     CreateStreams(nProgram);
   }
 
+  if (hasFileStat &&
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoSeekIndex)
+  {
+    // the seek stream of a transport stream is known once its first packets have been read
+    if (m_checkTransportStream)
+    {
+      m_pendingSeekIndexPath = strFile;
+      m_pendingSeekIndexFileSize = fileStat.st_size;
+      m_pendingSeekIndexFileTime = fileStat.st_mtime;
+    }
+    else
+      OpenSeekIndex(strFile, fileStat.st_size, fileStat.st_mtime);
+  }
+
   m_newProgram = m_program;
 
   // allow IsProgramChange to return true
@@ -724,6 +840,9 @@ void CDVDDemuxFFmpeg::Dispose()
   m_pkt.result = -1;
   av_packet_unref(&m_pkt.pkt);
 
+  CloseSeekIndex();
+  m_pendingSeekIndexPath.clear();
+
   delete m_pSSIF;
   m_pSSIF = nullptr;
 
@@ -752,6 +871,68 @@ void CDVDDemuxFFmpeg::Dispose()
   m_pInput = NULL;
 }
 
+void CDVDDemuxFFmpeg::OpenSeekIndex(const std::string& path, int64_t fileSize, int64_t fileTime)
+{
+  if (std::find(seek_index_formats.begin(), seek_index_formats.end(),
+                m_pFormatContext->iformat->name) == seek_index_formats.end())
+    return;
+
+  // av_seek_frame seeks in the seek stream of a transport stream, else in the default stream
+  const int streamIdx =
+      m_checkTransportStream ? m_seekStream : av_find_default_stream_index(m_pFormatContext);
+  if (streamIdx < 0)
+    return;
+
+  AVStream* st = m_pFormatContext->streams[streamIdx];
+  if (GetIndexEntriesCount(st) >= SEEK_INDEX_MIN_CONTAINER_ENTRIES || st->time_base.num <= 0 ||
+      st->time_base.den <= 0)
+    return;
+
+  CDVDDemuxSeekIndex::Source source;
+  source.path = path;
+  source.fileSize = fileSize;
+  source.fileTime = fileTime;
+  source.stream = streamIdx;
+  source.timeBaseNum = st->time_base.num;
+  source.timeBaseDen = st->time_base.den;
+
+  m_seekIndex = std::make_unique<CDVDDemuxSeekIndex>(
+      source, av_rescale(SEEK_INDEX_DISTANCE, st->time_base.den, st->time_base.num));
+
+  const std::string file = GetSeekIndexFile(path);
+  if (XFILE::CFile::Exists(file) && m_seekIndex->Load(file))
+  {
+    // the binary search of the demuxer starts with the closest entries of the index
+    for (const auto& entry : m_seekIndex->GetEntries())
+      av_add_index_entry(st, entry.pos, entry.timestamp, 0, 0, AVINDEX_KEYFRAME);
+
+    CLog::Log(LOGDEBUG, "{} - loaded seek index with {} entries for {}", __FUNCTION__,
+              m_seekIndex->GetEntries().size(), CURL::GetRedacted(path));
+  }
+}
+
+void CDVDDemuxFFmpeg::OpenPendingSeekIndex()
+{
+  if (m_pendingSeekIndexPath.empty() || !IsTransportStreamReady())
+    return;
+
+  const std::string path = std::move(m_pendingSeekIndexPath);
+  m_pendingSeekIndexPath.clear();
+  OpenSeekIndex(path, m_pendingSeekIndexFileSize, m_pendingSeekIndexFileTime);
+}
+
+void CDVDDemuxFFmpeg::CloseSeekIndex()
+{
+  if (m_seekIndex && m_seekIndex->IsModified())
+  {
+    const std::string folder = GetSeekIndexFolder();
+    if ((XFILE::CDirectory::Exists(folder) || XFILE::CDirectory::Create(folder)) &&
+        m_seekIndex->Save(GetSeekIndexFile(m_seekIndex->GetSource().path)))
+      PruneSeekIndexFolder(folder);
+  }
+  m_seekIndex.reset();
+}
+
 bool CDVDDemuxFFmpeg::Reset()
 {
   std::shared_ptr<CDVDInputStream> pInputStream = m_pInput;
@@ -1168,6 +1349,17 @@ DemuxPacket* CDVDDemuxFFmpeg::ReadInternal(bool keep)
 
         AVStream* stream = m_pFormatContext->streams[m_pkt.pkt.stream_index];
 
+        OpenPendingSeekIndex();
+
+        if (m_seekIndex && m_pkt.pkt.stream_index == m_seekIndex->GetSource().stream &&
+            (m_pkt.pkt.flags & AV_PKT_FLAG_KEY))
+        {
+          const int64_t timestamp =
+              m_pkt.pkt.dts != AV_NOPTS_VALUE ? m_pkt.pkt.dts : m_pkt.pkt.pts;
+          if (timestamp != AV_NOPTS_VALUE)
+            m_seekIndex->Add(timestamp, m_pkt.pkt.pos);
+        }
+
         if (IsTransportStreamReady())
         {
           // libavformat is confused by the interleaved SSIF.
@@ -1394,6 +1586,9 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
       }
     }
 
+    // the stored index narrows the search of av_seek_frame
+    OpenPendingSeekIndex();
+
     AVStream* st = m_pFormatContext->streams[m_seekStream];
     seek_pts = av_rescale(static_cast<int64_t>(m_startTime + time / 1000), st->time_base.den,
                           st->time_base.num);
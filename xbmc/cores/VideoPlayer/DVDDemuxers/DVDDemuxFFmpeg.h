@@ -21,6 +21,7 @@ extern "C" {
 }
 
 class CDVDDemuxFFmpeg;
+class CDVDDemuxSeekIndex;
 class CURL;
 
 enum class TRANSPORT_STREAM_STATE
@@ -147,6 +148,10 @@ protected:
 
   StreamHdrType DetermineHdrType(AVStream* pStream);
 
+  void OpenSeekIndex(const std::string& path, int64_t fileSize, int64_t fileTime);
+  void OpenPendingSeekIndex();
+  void CloseSeekIndex();
+
   CCriticalSection m_critSection;
   std::map<int, CDemuxStream*> m_streams;
   std::map<int, std::unique_ptr<CDemuxParserFFmpeg>> m_parsers;
@@ -183,5 +188,11 @@ protected:
   double m_dtsAtDisplayTime;
   bool m_seekToKeyFrame = false;
   double m_startTime = 0;
+  std::unique_ptr<CDVDDemuxSeekIndex> m_seekIndex;
+
+  // file of a transport stream whose seek index is opened once the stream is ready
+  std::string m_pendingSeekIndexPath;
+  int64_t m_pendingSeekIndexFileSize = 0;
+  int64_t m_pendingSeekIndexFileTime = 0;
 };
 
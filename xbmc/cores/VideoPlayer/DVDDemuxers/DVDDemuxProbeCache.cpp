@@ -0,0 +1,169 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DVDDemuxProbeCache.h"
+
+#include "URL.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string.h>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+}
+
+void CDVDDemuxProbeCache::CodecParametersDeleter::operator()(AVCodecParameters* codecpar) const
+{
+  avcodec_parameters_free(&codecpar);
+}
+
+CDVDDemuxProbeCache::CDVDDemuxProbeCache(size_t maxEntries) : m_maxEntries(maxEntries)
+{
+}
+
+CDVDDemuxProbeCache::~CDVDDemuxProbeCache() = default;
+
+bool CDVDDemuxProbeCache::Matches(const Entry& entry, const AVFormatContext* context)
+{
+  if (!context->iformat || !context->iformat->name || entry.format != context->iformat->name)
+    return false;
+
+  if (entry.streams.size() != context->nb_streams)
+    return false;
+
+  for (unsigned int i = 0; i < context->nb_streams; ++i)
+  {
+    const AVCodecParameters* header = context->streams[i]->codecpar;
+    const AVCodecParameters* probed = entry.streams[i].codecpar.get();
+
+    // the header might not tell everything, but what it tells must not differ
+    if (header->codec_type != AVMEDIA_TYPE_UNKNOWN && header->codec_type != probed->codec_type)
+      return false;
+
+    if (header->codec_id != AV_CODEC_ID_NONE && header->codec_id != probed->codec_id)
+      return false;
+
+    if (header->extradata_size > 0 &&
+        (header->extradata_size != probed->extradata_size ||
+         memcmp(header->extradata, probed->extradata, header->extradata_size) != 0))
+      return false;
+  }
+
+  return true;
+}
+
+bool CDVDDemuxProbeCache::Apply(const std::string& path,
+                                int64_t size,
+                                int64_t mtime,
+                                AVFormatContext* context)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  const auto it = std::find_if(m_entries.begin(), m_entries.end(),
+                               [&path](const Entry& entry) { return entry.path == path; });
+  if (it == m_entries.end())
+    return false;
+
+  if (it->size != size || it->mtime != mtime)
+  {
+    CLog::Log(LOGDEBUG, "CDVDDemuxProbeCache - [{}] changed since it was probed",
+              CURL::GetRedacted(path));
+    m_entries.erase(it);
+    return false;
+  }
+
+  if (!Matches(*it, context))
+  {
+    CLog::Log(LOGDEBUG, "CDVDDemuxProbeCache - streams of [{}] do not match the probed ones",
+              CURL::GetRedacted(path));
+    m_entries.erase(it);
+    return false;
+  }
+
+  for (unsigned int i = 0; i < context->nb_streams; ++i)
+  {
+    AVStream* st = context->streams[i];
+    const Stream& stream = it->streams[i];
+
+    if (avcodec_parameters_copy(st->codecpar, stream.codecpar.get()) < 0)
+      return false;
+
+    if (stream.rFrameRate.num && stream.rFrameRate.den)
+      st->r_frame_rate = stream.rFrameRate;
+    if (stream.avgFrameRate.num && stream.avgFrameRate.den)
+      st->avg_frame_rate = stream.avgFrameRate;
+    if (st->duration == AV_NOPTS_VALUE)
+      st->duration = stream.duration;
+    if (st->start_time == AV_NOPTS_VALUE)
+      st->start_time = stream.startTime;
+  }
+
+  if (context->duration == AV_NOPTS_VALUE)
+    context->duration = it->duration;
+  if (context->start_time == AV_NOPTS_VALUE)
+    context->start_time = it->startTime;
+
+  m_entries.splice(m_entries.begin(), m_entries, it);
+  return true;
+}
+
+void CDVDDemuxProbeCache::Store(const std::string& path,
+                                int64_t size,
+                                int64_t mtime,
+                                const AVFormatContext* context)
+{
+  if (m_maxEntries == 0 || !context->iformat || !context->iformat->name)
+    return;
+
+  Entry entry;
+  entry.path = path;
+  entry.size = size;
+  entry.mtime = mtime;
+  entry.format = context->iformat->name;
+  entry.duration = context->duration;
+  entry.startTime = context->start_time;
+  entry.streams.reserve(context->nb_streams);
+
+  for (unsigned int i = 0; i < context->nb_streams; ++i)
+  {
+    const AVStream* st = context->streams[i];
+
+    Stream stream;
+    stream.codecpar.reset(avcodec_parameters_alloc());
+    if (!stream.codecpar || avcodec_parameters_copy(stream.codecpar.get(), st->codecpar) < 0)
+      return;
+
+    stream.rFrameRate = st->r_frame_rate;
+    stream.avgFrameRate = st->avg_frame_rate;
+    stream.duration = st->duration;
+    stream.startTime = st->start_time;
+    entry.streams.emplace_back(std::move(stream));
+  }
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  m_entries.remove_if([&path](const Entry& entry) { return entry.path == path; });
+  m_entries.emplace_front(std::move(entry));
+  if (m_entries.size() > m_maxEntries)
+    m_entries.pop_back();
+}
+
+void CDVDDemuxProbeCache::Remove(const std::string& path)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_entries.remove_if([&path](const Entry& entry) { return entry.path == path; });
+}
+
+size_t CDVDDemuxProbeCache::Size() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return m_entries.size();
+}
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <list>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <libavutil/rational.h>
+}
+
+struct AVCodecParameters;
+struct AVFormatContext;
+
+/*!
+ \brief Remembers the stream parameters found by avformat_find_stream_info for recently played
+ files.
+
+ Probing reads and decodes the start of a file until the parameters of all streams are known,
+ which for large files on network shares takes seconds. When the same, unchanged file is opened
+ again, the remembered parameters are applied to the streams found in its header, so probing
+ finds all parameters set and only reads a few packets.
+
+ Files are identified by path, size and modification time. The remembered parameters are only
+ applied if the streams found in the header still match them.
+ */
+class CDVDDemuxProbeCache
+{
+public:
+  /*!
+   \param maxEntries The number of files remembered, the least recently used ones are dropped.
+   */
+  explicit CDVDDemuxProbeCache(size_t maxEntries);
+  ~CDVDDemuxProbeCache();
+
+  /*!
+   \brief Apply the parameters remembered for a file to its freshly opened format context.
+   \param path The path of the file.
+   \param size The size of the file.
+   \param mtime The modification time of the file.
+   \param context The format context, opened but not probed yet.
+   \return true if the parameters were applied, false if there are none or they do not match the
+   streams of the context.
+   */
+  bool Apply(const std::string& path, int64_t size, int64_t mtime, AVFormatContext* context);
+
+  /*!
+   \brief Remember the parameters of a probed format context.
+   */
+  void Store(const std::string& path, int64_t size, int64_t mtime, const AVFormatContext* context);
+
+  /*!
+   \brief Forget the parameters remembered for a file, e.g. because probing failed with them.
+   */
+  void Remove(const std::string& path);
+
+  size_t Size() const;
+
+private:
+  struct CodecParametersDeleter
+  {
+    void operator()(AVCodecParameters* codecpar) const;
+  };
+
+  struct Stream
+  {
+    std::unique_ptr<AVCodecParameters, CodecParametersDeleter> codecpar;
+    AVRational rFrameRate{0, 1};
+    AVRational avgFrameRate{0, 1};
+    int64_t duration{0};
+    int64_t startTime{0};
+  };
+
+  struct Entry
+  {
+    std::string path;
+    int64_t size{0};
+    int64_t mtime{0};
+    std::string format;
+    int64_t duration{0};
+    int64_t startTime{0};
+    std::vector<Stream> streams;
+  };
+
+  static bool Matches(const Entry& entry, const AVFormatContext* context);
+
+  const size_t m_maxEntries;
+  mutable CCriticalSection m_critSection;
+  std::list<Entry> m_entries; // most recently used first
+};
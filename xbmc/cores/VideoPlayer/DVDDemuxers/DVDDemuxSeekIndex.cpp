@@ -0,0 +1,148 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DVDDemuxSeekIndex.h"
+
+#include "filesystem/File.h"
+#include "utils/Archive.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace
+{
+constexpr int SEEK_INDEX_VERSION = 1;
+// a keyframe per second of a day long recording
+constexpr unsigned int SEEK_INDEX_MAX_ENTRIES = 24 * 60 * 60;
+} // unnamed namespace
+
+bool CDVDDemuxSeekIndex::Source::operator==(const Source& other) const
+{
+  return path == other.path && fileSize == other.fileSize && fileTime == other.fileTime &&
+         stream == other.stream && timeBaseNum == other.timeBaseNum &&
+         timeBaseDen == other.timeBaseDen;
+}
+
+CDVDDemuxSeekIndex::CDVDDemuxSeekIndex(const Source& source, int64_t minDistance)
+  : m_source(source), m_minDistance(minDistance)
+{
+}
+
+bool CDVDDemuxSeekIndex::Add(int64_t timestamp, int64_t pos)
+{
+  if (pos < 0)
+    return false;
+
+  const auto it = std::lower_bound(
+      m_entries.begin(), m_entries.end(), timestamp,
+      [](const Entry& entry, int64_t timestamp) { return entry.timestamp < timestamp; });
+
+  if (it != m_entries.end() && it->timestamp - timestamp < m_minDistance)
+    return false;
+  if (it != m_entries.begin() && timestamp - std::prev(it)->timestamp < m_minDistance)
+    return false;
+  if (it != m_entries.end() && it->timestamp == timestamp)
+    return false;
+
+  if (m_entries.size() >= SEEK_INDEX_MAX_ENTRIES)
+    return false;
+
+  m_entries.insert(it, {timestamp, pos});
+  m_modified = true;
+  return true;
+}
+
+bool CDVDDemuxSeekIndex::Load(const std::string& file)
+{
+  XFILE::CFile index;
+  if (!index.Open(file))
+    return false;
+
+  std::vector<Entry> entries;
+  try
+  {
+    CArchive ar(&index, CArchive::load);
+
+    int version = 0;
+    Source source;
+    ar >> version;
+    if (version != SEEK_INDEX_VERSION)
+      return false;
+
+    ar >> source.path;
+    ar >> source.fileSize;
+    ar >> source.fileTime;
+    ar >> source.stream;
+    ar >> source.timeBaseNum;
+    ar >> source.timeBaseDen;
+    if (source != m_source)
+      return false;
+
+    unsigned int count = 0;
+    ar >> count;
+    if (count > SEEK_INDEX_MAX_ENTRIES)
+      return false;
+
+    entries.reserve(count);
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      Entry entry;
+      ar >> entry.timestamp;
+      ar >> entry.pos;
+      if (entry.pos < 0 || (!entries.empty() && entry.timestamp <= entries.back().timestamp))
+      {
+        CLog::Log(LOGWARNING, "CDVDDemuxSeekIndex::{} - ignoring damaged index {}", __FUNCTION__,
+                  file);
+        return false;
+      }
+      entries.emplace_back(entry);
+    }
+    ar.Close();
+  }
+  catch (const std::out_of_range&)
+  {
+    CLog::Log(LOGWARNING, "CDVDDemuxSeekIndex::{} - ignoring damaged index {}", __FUNCTION__,
+              file);
+    return false;
+  }
+
+  m_entries = std::move(entries);
+  m_modified = false;
+  return true;
+}
+
+bool CDVDDemuxSeekIndex::Save(const std::string& file)
+{
+  XFILE::CFile index;
+  if (!index.OpenForWrite(file, true))
+  {
+    CLog::Log(LOGERROR, "CDVDDemuxSeekIndex::{} - unable to write {}", __FUNCTION__, file);
+    return false;
+  }
+
+  CArchive ar(&index, CArchive::store);
+  ar << SEEK_INDEX_VERSION;
+  ar << m_source.path;
+  ar << m_source.fileSize;
+  ar << m_source.fileTime;
+  ar << m_source.stream;
+  ar << m_source.timeBaseNum;
+  ar << m_source.timeBaseDen;
+  ar << static_cast<unsigned int>(m_entries.size());
+  for (const auto& entry : m_entries)
+  {
+    ar << entry.timestamp;
+    ar << entry.pos;
+  }
+  ar.Close();
+
+  m_modified = false;
+  return true;
+}
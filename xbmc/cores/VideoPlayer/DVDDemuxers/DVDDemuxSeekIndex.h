@@ -0,0 +1,81 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*!
+ \brief Index of the keyframes of a file, for containers which do not carry an index themselves.
+
+ Seeking in MPEG-TS, MPEG-PS or AVI files without index has to search the file for the requested
+ time, which reads from many places of the file. The index is built while the file is played and
+ stored in the thumbnails folder, so seeks in later playbacks start reading at a known keyframe
+ close to the requested time. Matroska files without cues are not indexed, as the index entries of
+ the Matroska demuxer have to point at clusters.
+
+ Timestamps are in the time base of the indexed stream. The index belongs to a particular version
+ of a file, identified by the source information stored with it.
+ */
+class CDVDDemuxSeekIndex
+{
+public:
+  struct Source
+  {
+    std::string path;
+    int64_t fileSize = 0;
+    int64_t fileTime = 0;
+    int stream = -1;
+    int timeBaseNum = 0;
+    int timeBaseDen = 0;
+
+    bool operator==(const Source& other) const;
+    bool operator!=(const Source& other) const { return !(*this == other); }
+  };
+
+  struct Entry
+  {
+    int64_t timestamp;
+    int64_t pos;
+  };
+
+  /*!
+   \param source The file and stream indexed.
+   \param minDistance Keyframes closer than this to an entry of the index are not added.
+   */
+  CDVDDemuxSeekIndex(const Source& source, int64_t minDistance);
+
+  /*!
+   \brief Add a keyframe read from the file.
+   \return true if it was added, false if the index has an entry close to it already.
+   */
+  bool Add(int64_t timestamp, int64_t pos);
+
+  const std::vector<Entry>& GetEntries() const { return m_entries; }
+  const Source& GetSource() const { return m_source; }
+  bool IsModified() const { return m_modified; }
+
+  /*!
+   \brief Load the index stored in a file. The entries are only taken if the file was stored for
+   the same source.
+   */
+  bool Load(const std::string& file);
+
+  /*!
+   \brief Store the index in a file.
+   */
+  bool Save(const std::string& file);
+
+private:
+  const Source m_source;
+  const int64_t m_minDistance;
+  std::vector<Entry> m_entries; // sorted by timestamp
+  bool m_modified = false;
+};
@@ -0,0 +1,145 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxProbeCache.h"
+
+#include <cstring>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/mem.h>
+}
+
+namespace
+{
+struct FormatContextDeleter
+{
+  void operator()(AVFormatContext* context) const { avformat_free_context(context); }
+};
+using FormatContextPtr = std::unique_ptr<AVFormatContext, FormatContextDeleter>;
+
+void SetExtradata(AVCodecParameters* codecpar, const char* data)
+{
+  codecpar->extradata_size = static_cast<int>(strlen(data));
+  codecpar->extradata = static_cast<uint8_t*>(
+      av_mallocz(codecpar->extradata_size + AV_INPUT_BUFFER_PADDING_SIZE));
+  memcpy(codecpar->extradata, data, codecpar->extradata_size);
+}
+
+// a context as found in the header of a file, before probing
+FormatContextPtr CreateContext(AVCodecID videoCodec = AV_CODEC_ID_H264)
+{
+  FormatContextPtr context(avformat_alloc_context());
+  context->iformat = av_find_input_format("matroska");
+
+  AVStream* video = avformat_new_stream(context.get(), nullptr);
+  video->codecpar->codec_type = AVMEDIA_TYPE_VIDEO;
+  video->codecpar->codec_id = videoCodec;
+  SetExtradata(video->codecpar, "avcC");
+
+  AVStream* audio = avformat_new_stream(context.get(), nullptr);
+  audio->codecpar->codec_type = AVMEDIA_TYPE_AUDIO;
+  audio->codecpar->codec_id = AV_CODEC_ID_AC3;
+
+  return context;
+}
+
+// the same context after probing
+FormatContextPtr CreateProbedContext()
+{
+  FormatContextPtr context = CreateContext();
+  context->duration = 5400 * int64_t{AV_TIME_BASE};
+  context->start_time = 0;
+
+  AVStream* video = context->streams[0];
+  video->codecpar->width = 1920;
+  video->codecpar->height = 1080;
+  video->r_frame_rate = {24000, 1001};
+  video->avg_frame_rate = {24000, 1001};
+
+  context->streams[1]->codecpar->sample_rate = 48000;
+  return context;
+}
+} // unnamed namespace
+
+TEST(TestDVDDemuxProbeCache, ApplyStored)
+{
+  CDVDDemuxProbeCache cache(10);
+  cache.Store("smb://server/movie.mkv", 1000, 42, CreateProbedContext().get());
+
+  const FormatContextPtr context = CreateContext();
+  EXPECT_FALSE(cache.Apply("smb://server/other.mkv", 1000, 42, context.get()));
+  ASSERT_TRUE(cache.Apply("smb://server/movie.mkv", 1000, 42, context.get()));
+
+  const AVStream* video = context->streams[0];
+  EXPECT_EQ(1920, video->codecpar->width);
+  EXPECT_EQ(1080, video->codecpar->height);
+  EXPECT_EQ(24000, video->r_frame_rate.num);
+  EXPECT_EQ(1001, video->avg_frame_rate.den);
+  ASSERT_EQ(4, video->codecpar->extradata_size);
+  EXPECT_EQ(0, memcmp(video->codecpar->extradata, "avcC", 4));
+  EXPECT_EQ(48000, context->streams[1]->codecpar->sample_rate);
+  EXPECT_EQ(5400 * int64_t{AV_TIME_BASE}, context->duration);
+}
+
+TEST(TestDVDDemuxProbeCache, ChangedFile)
+{
+  CDVDDemuxProbeCache cache(10);
+  cache.Store("/movies/movie.mkv", 1000, 42, CreateProbedContext().get());
+
+  // a modified file must be probed again, its stale entry is dropped
+  const FormatContextPtr context = CreateContext();
+  EXPECT_FALSE(cache.Apply("/movies/movie.mkv", 1000, 43, context.get()));
+  EXPECT_EQ(0, context->streams[0]->codecpar->width);
+  EXPECT_EQ(0u, cache.Size());
+}
+
+TEST(TestDVDDemuxProbeCache, StreamMismatch)
+{
+  CDVDDemuxProbeCache cache(10);
+
+  cache.Store("/movies/movie.mkv", 1000, 42, CreateProbedContext().get());
+  EXPECT_FALSE(cache.Apply("/movies/movie.mkv", 1000, 42, CreateContext(AV_CODEC_ID_HEVC).get()));
+
+  cache.Store("/movies/movie.mkv", 1000, 42, CreateProbedContext().get());
+  const FormatContextPtr context = CreateContext();
+  av_freep(&context->streams[0]->codecpar->extradata);
+  SetExtradata(context->streams[0]->codecpar, "hvcC");
+  EXPECT_FALSE(cache.Apply("/movies/movie.mkv", 1000, 42, context.get()));
+
+  cache.Store("/movies/movie.mkv", 1000, 42, CreateProbedContext().get());
+  const FormatContextPtr moreStreams = CreateContext();
+  avformat_new_stream(moreStreams.get(), nullptr);
+  EXPECT_FALSE(cache.Apply("/movies/movie.mkv", 1000, 42, moreStreams.get()));
+}
+
+TEST(TestDVDDemuxProbeCache, LeastRecentlyUsed)
+{
+  CDVDDemuxProbeCache cache(2);
+  cache.Store("/movies/1.mkv", 1000, 42, CreateProbedContext().get());
+  cache.Store("/movies/2.mkv", 1000, 42, CreateProbedContext().get());
+
+  EXPECT_TRUE(cache.Apply("/movies/1.mkv", 1000, 42, CreateContext().get()));
+  cache.Store("/movies/3.mkv", 1000, 42, CreateProbedContext().get());
+  EXPECT_EQ(2u, cache.Size());
+
+  EXPECT_FALSE(cache.Apply("/movies/2.mkv", 1000, 42, CreateContext().get()));
+  EXPECT_TRUE(cache.Apply("/movies/1.mkv", 1000, 42, CreateContext().get()));
+  EXPECT_TRUE(cache.Apply("/movies/3.mkv", 1000, 42, CreateContext().get()));
+}
+
+TEST(TestDVDDemuxProbeCache, Disabled)
+{
+  CDVDDemuxProbeCache cache(0);
+  cache.Store("/movies/movie.mkv", 1000, 42, CreateProbedContext().get());
+  EXPECT_EQ(0u, cache.Size());
+}
@@ -0,0 +1,389 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "ServiceBroker.h"
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxFFmpeg.h"
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxSeekIndex.h"
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxUtils.h"
+#include "cores/VideoPlayer/DVDInputStreams/DVDInputStreamFile.h"
+#include "cores/VideoPlayer/Interface/DemuxPacket.h"
+#include "cores/VideoPlayer/Interface/TimingConstants.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "profiles/ProfileManager.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "test/TestUtils.h"
+#include "utils/Crc32.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+extern "C"
+{
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+}
+
+namespace
+{
+constexpr int64_t TIME_BASE = 90000;
+constexpr int64_t FRAME_DURATION = TIME_BASE / 25;
+
+struct Frame
+{
+  int64_t timestamp;
+  int64_t pos;
+  bool keyframe;
+};
+
+// two minutes of 25 fps video with a keyframe every 12 frames and varying frame sizes
+std::vector<Frame> CreateFrames()
+{
+  std::vector<Frame> frames;
+  int64_t pos = 0;
+  for (int i = 0; i < 25 * 120; ++i)
+  {
+    const bool keyframe = i % 12 == 0;
+    frames.push_back({i * FRAME_DURATION, pos, keyframe});
+    pos += keyframe ? 60000 + (i % 7) * 1000 : 8000 + (i % 5) * 500;
+  }
+  return frames;
+}
+
+// where a seek without index ends up: the last keyframe at or before the time, found by
+// searching the file
+const Frame* SearchKeyframe(const std::vector<Frame>& frames, int64_t timestamp)
+{
+  const Frame* found = nullptr;
+  for (const auto& frame : frames)
+  {
+    if (frame.timestamp > timestamp)
+      break;
+    if (frame.keyframe)
+      found = &frame;
+  }
+  return found;
+}
+
+void Play(CDVDDemuxSeekIndex& index, const std::vector<Frame>& frames, size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end && i < frames.size(); ++i)
+  {
+    if (frames[i].keyframe)
+      index.Add(frames[i].timestamp, frames[i].pos);
+  }
+}
+
+// the entry a seek with the index starts at: the last one at or before the time
+const CDVDDemuxSeekIndex::Entry* FindEntry(const CDVDDemuxSeekIndex& index, int64_t timestamp)
+{
+  const auto& entries = index.GetEntries();
+  const auto it = std::upper_bound(entries.begin(), entries.end(), timestamp,
+                                   [](int64_t timestamp, const CDVDDemuxSeekIndex::Entry& entry)
+                                   { return timestamp < entry.timestamp; });
+  return it == entries.begin() ? nullptr : &*std::prev(it);
+}
+
+CDVDDemuxSeekIndex::Source CreateSource()
+{
+  CDVDDemuxSeekIndex::Source source;
+  source.path = "smb://server/recording.ts";
+  source.fileSize = 123456789;
+  source.fileTime = 1700000000;
+  source.stream = 0;
+  source.timeBaseNum = 1;
+  source.timeBaseDen = static_cast<int>(TIME_BASE);
+  return source;
+}
+
+// write an MPEG-TS file with MPEG-2 video of 25 fps and a keyframe every 12 frames
+bool CreateTransportStream(const std::string& path, int seconds)
+{
+  const AVCodec* codec = avcodec_find_encoder(AV_CODEC_ID_MPEG2VIDEO);
+  AVFormatContext* format = nullptr;
+  if (!codec || avformat_alloc_output_context2(&format, nullptr, "mpegts", path.c_str()) < 0)
+    return false;
+
+  AVStream* stream = avformat_new_stream(format, nullptr);
+  AVCodecContext* context = avcodec_alloc_context3(codec);
+  AVFrame* frame = av_frame_alloc();
+  AVPacket* packet = av_packet_alloc();
+
+  context->width = 64;
+  context->height = 64;
+  context->pix_fmt = AV_PIX_FMT_YUV420P;
+  context->time_base = {1, 25};
+  context->framerate = {25, 1};
+  context->gop_size = 12;
+  context->max_b_frames = 0;
+  context->bit_rate = 400000;
+
+  frame->format = context->pix_fmt;
+  frame->width = context->width;
+  frame->height = context->height;
+
+  bool ok = stream && avcodec_open2(context, codec, nullptr) >= 0 &&
+            avcodec_parameters_from_context(stream->codecpar, context) >= 0 &&
+            av_frame_get_buffer(frame, 0) >= 0 &&
+            avio_open(&format->pb, path.c_str(), AVIO_FLAG_WRITE) >= 0;
+  if (ok)
+  {
+    stream->time_base = context->time_base;
+    ok = avformat_write_header(format, nullptr) >= 0;
+  }
+
+  const auto writePackets = [&]() {
+    while (ok && avcodec_receive_packet(context, packet) == 0)
+    {
+      av_packet_rescale_ts(packet, context->time_base, stream->time_base);
+      packet->stream_index = stream->index;
+      ok = av_interleaved_write_frame(format, packet) >= 0;
+    }
+  };
+
+  for (int i = 0; ok && i < seconds * 25; ++i)
+  {
+    ok = av_frame_make_writable(frame) >= 0;
+    for (int y = 0; ok && y < frame->height; ++y)
+    {
+      for (int x = 0; x < frame->width; ++x)
+        frame->data[0][y * frame->linesize[0] + x] = static_cast<uint8_t>(x + y + i * 3);
+    }
+    for (int plane = 1; ok && plane < 3; ++plane)
+    {
+      for (int y = 0; y < frame->height / 2; ++y)
+        std::fill_n(frame->data[plane] + y * frame->linesize[plane], frame->width / 2,
+                    static_cast<uint8_t>(128 + i));
+    }
+    frame->pts = i;
+    ok = ok && avcodec_send_frame(context, frame) >= 0;
+    writePackets();
+  }
+
+  if (ok)
+  {
+    avcodec_send_frame(context, nullptr);
+    writePackets();
+    ok = ok && av_write_trailer(format) >= 0;
+  }
+
+  if (format->pb)
+    avio_closep(&format->pb);
+  av_packet_free(&packet);
+  av_frame_free(&frame);
+  avcodec_free_context(&context);
+  avformat_free_context(format);
+  return ok;
+}
+
+std::unique_ptr<CDVDDemuxFFmpeg> OpenDemuxer(const std::string& path)
+{
+  auto input = std::make_shared<CDVDInputStreamFile>(CFileItem(path, false), 0);
+  auto demuxer = std::make_unique<CDVDDemuxFFmpeg>();
+  if (!input->Open() || !demuxer->Open(input, false))
+    return {};
+
+  return demuxer;
+}
+
+// the timestamp of the first video packet read after seeking to a time in ms
+double SeekVideo(CDVDDemuxFFmpeg& demuxer, double time)
+{
+  if (!demuxer.SeekTime(time, true))
+    return DVD_NOPTS_VALUE;
+
+  DemuxPacket* packet;
+  while ((packet = demuxer.Read()))
+  {
+    const CDemuxStream* stream = demuxer.GetStream(packet->iStreamId);
+    const double dts = packet->dts;
+    CDVDDemuxUtils::FreeDemuxPacket(packet);
+
+    if (stream && stream->type == STREAM_VIDEO && dts != DVD_NOPTS_VALUE)
+      return dts;
+  }
+  return DVD_NOPTS_VALUE;
+}
+} // unnamed namespace
+
+TEST(TestDVDDemuxSeekIndex, SeekPositions)
+{
+  const std::vector<Frame> frames = CreateFrames();
+
+  // an index of all keyframes seeks to the same positions as searching the file
+  CDVDDemuxSeekIndex index(CreateSource(), 0);
+  Play(index, frames, 0, frames.size());
+
+  for (int64_t timestamp = 0; timestamp < 120 * TIME_BASE; timestamp += TIME_BASE / 3)
+  {
+    const Frame* expected = SearchKeyframe(frames, timestamp);
+    const CDVDDemuxSeekIndex::Entry* entry = FindEntry(index, timestamp);
+    ASSERT_NE(nullptr, expected);
+    ASSERT_NE(nullptr, entry);
+    EXPECT_EQ(expected->pos, entry->pos) << "timestamp " << timestamp;
+    EXPECT_EQ(expected->timestamp, entry->timestamp);
+  }
+
+  EXPECT_EQ(nullptr, FindEntry(index, -1));
+}
+
+TEST(TestDVDDemuxSeekIndex, SeekPositionsSparseIndex)
+{
+  const std::vector<Frame> frames = CreateFrames();
+
+  // an index with an entry per second starts reading at a keyframe shortly before the one found by
+  // searching the file
+  CDVDDemuxSeekIndex index(CreateSource(), TIME_BASE);
+  Play(index, frames, 0, frames.size());
+  EXPECT_LE(index.GetEntries().size(), 121u);
+
+  for (int64_t timestamp = 0; timestamp < 120 * TIME_BASE; timestamp += TIME_BASE / 3)
+  {
+    const Frame* expected = SearchKeyframe(frames, timestamp);
+    const CDVDDemuxSeekIndex::Entry* entry = FindEntry(index, timestamp);
+    ASSERT_NE(nullptr, entry);
+    EXPECT_LE(entry->pos, expected->pos);
+    EXPECT_LE(entry->timestamp, expected->timestamp);
+    EXPECT_LT(expected->timestamp - entry->timestamp, TIME_BASE);
+
+    const Frame* keyframe = SearchKeyframe(frames, entry->timestamp);
+    EXPECT_EQ(keyframe->pos, entry->pos);
+  }
+}
+
+TEST(TestDVDDemuxSeekIndex, PlaybackWithSeeks)
+{
+  const std::vector<Frame> frames = CreateFrames();
+
+  // play the middle, seek back to the start, then play the end
+  CDVDDemuxSeekIndex index(CreateSource(), 0);
+  Play(index, frames, 1000, 1500);
+  Play(index, frames, 0, 600);
+  Play(index, frames, 1400, frames.size());
+
+  const auto& entries = index.GetEntries();
+  for (size_t i = 1; i < entries.size(); ++i)
+    EXPECT_LT(entries[i - 1].timestamp, entries[i].timestamp);
+
+  // within the ranges played the index is exact
+  for (const size_t frame : {0, 300, 1100, 2000})
+  {
+    const int64_t timestamp = frames[frame].timestamp;
+    EXPECT_EQ(SearchKeyframe(frames, timestamp)->pos, FindEntry(index, timestamp)->pos);
+  }
+
+  // between them it starts at the last keyframe played before
+  EXPECT_EQ(SearchKeyframe(frames, frames[599].timestamp)->pos,
+            FindEntry(index, frames[800].timestamp)->pos);
+}
+
+TEST(TestDVDDemuxSeekIndex, SaveLoad)
+{
+  const std::vector<Frame> frames = CreateFrames();
+  CDVDDemuxSeekIndex index(CreateSource(), 0);
+  Play(index, frames, 0, frames.size());
+  EXPECT_TRUE(index.IsModified());
+
+  XFILE::CFile* file;
+  ASSERT_NE(nullptr, (file = XBMC_CREATETEMPFILE(".idx")));
+  file->Close();
+  ASSERT_TRUE(index.Save(XBMC_TEMPFILEPATH(file)));
+  EXPECT_FALSE(index.IsModified());
+
+  CDVDDemuxSeekIndex loaded(CreateSource(), 0);
+  ASSERT_TRUE(loaded.Load(XBMC_TEMPFILEPATH(file)));
+  EXPECT_FALSE(loaded.IsModified());
+  ASSERT_EQ(index.GetEntries().size(), loaded.GetEntries().size());
+  for (size_t i = 0; i < index.GetEntries().size(); ++i)
+  {
+    EXPECT_EQ(index.GetEntries()[i].timestamp, loaded.GetEntries()[i].timestamp);
+    EXPECT_EQ(index.GetEntries()[i].pos, loaded.GetEntries()[i].pos);
+  }
+
+  // the index of a file which was changed since is not used
+  CDVDDemuxSeekIndex::Source changed = CreateSource();
+  changed.fileTime++;
+  CDVDDemuxSeekIndex changedIndex(changed, 0);
+  EXPECT_FALSE(changedIndex.Load(XBMC_TEMPFILEPATH(file)));
+  EXPECT_TRUE(changedIndex.GetEntries().empty());
+
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
+
+TEST(TestDVDDemuxSeekIndex, DemuxerSeeksWithStoredIndex)
+{
+  XFILE::CFile* file;
+  ASSERT_NE(nullptr, (file = XBMC_CREATETEMPFILE(".ts")));
+  file->Close();
+  const std::string path = CSpecialProtocol::TranslatePath(XBMC_TEMPFILEPATH(file));
+  const std::string indexFile = URIUtils::AddFileToFolder(
+      CServiceBroker::GetSettingsComponent()->GetProfileManager()->GetThumbnailsFolder(),
+      "seekindex", StringUtils::Format("{:08x}.idx", Crc32::ComputeFromLowerCase(path)));
+
+  if (!CreateTransportStream(path, 20))
+  {
+    XBMC_DELETETEMPFILE(file);
+    GTEST_SKIP() << "MPEG-2 video or MPEG-TS is not supported by ffmpeg";
+  }
+
+  struct SeekIndexSetting
+  {
+    ~SeekIndexSetting() { settings->m_videoSeekIndex = value; }
+    const std::shared_ptr<CAdvancedSettings> settings =
+        CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+    const bool value = settings->m_videoSeekIndex;
+  } setting;
+
+  const std::vector<double> times = {3100, 7700, 12345, 17000, 500};
+
+  // seeks searching the file
+  setting.settings->m_videoSeekIndex = false;
+  std::vector<double> expected;
+  {
+    const std::unique_ptr<CDVDDemuxFFmpeg> demuxer = OpenDemuxer(path);
+    ASSERT_NE(nullptr, demuxer);
+    for (const double time : times)
+    {
+      expected.emplace_back(SeekVideo(*demuxer, time));
+      EXPECT_NE(DVD_NOPTS_VALUE, expected.back()) << "time " << time;
+    }
+  }
+  EXPECT_FALSE(XFILE::CFile::Exists(indexFile));
+
+  // a playback builds the index, which is stored when the demuxer is closed
+  setting.settings->m_videoSeekIndex = true;
+  {
+    const std::unique_ptr<CDVDDemuxFFmpeg> demuxer = OpenDemuxer(path);
+    ASSERT_NE(nullptr, demuxer);
+    DemuxPacket* packet;
+    while ((packet = demuxer->Read()))
+      CDVDDemuxUtils::FreeDemuxPacket(packet);
+  }
+  ASSERT_TRUE(XFILE::CFile::Exists(indexFile));
+
+  // seeks starting at the entries of the loaded index end up at the same frames
+  {
+    const std::unique_ptr<CDVDDemuxFFmpeg> demuxer = OpenDemuxer(path);
+    ASSERT_NE(nullptr, demuxer);
+    for (size_t i = 0; i < times.size(); ++i)
+      EXPECT_EQ(expected[i], SeekVideo(*demuxer, times[i])) << "time " << times[i];
+  }
+
+  XFILE::CFile::Delete(indexFile);
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
@@ -8,14 +8,23 @@
 
 #include "InputStreamPVRChannel.h"
 
+#include "PVRTimeshiftBuffer.h"
 #include "ServiceBroker.h"
+#include "cores/VideoPlayer/Interface/TimingConstants.h"
 #include "pvr/PVRManager.h"
 #include "pvr/addons/PVRClient.h"
 #include "pvr/channels/PVRChannelGroupsContainer.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "utils/log.h"
 
 using namespace PVR;
 
+namespace
+{
+constexpr size_t TIMESHIFT_SEGMENT_SIZE = 16 * 1024 * 1024;
+} // unnamed namespace
+
 CInputStreamPVRChannel::CInputStreamPVRChannel(IVideoPlayer* pPlayer, const CFileItem& fileitem)
   : CInputStreamPVRBase(pPlayer, fileitem)
 {
@@ -34,6 +43,14 @@ CDVDInputStream::IDemux* CInputStreamPVRChannel::GetIDemux()
   return CInputStreamPVRBase::GetIDemux();
 }
 
+CDVDInputStream::IPosTime* CInputStreamPVRChannel::GetIPosTime()
+{
+  if (m_timeshiftBuffer)
+    return this;
+
+  return CInputStreamPVRBase::GetIPosTime();
+}
+
 bool CInputStreamPVRChannel::OpenPVRStream()
 {
   std::shared_ptr<CPVRChannel> channel = m_item.GetPVRChannelInfoTag();
@@ -50,13 +67,55 @@ bool CInputStreamPVRChannel::OpenPVRStream()
     m_bDemuxActive = m_client->GetClientCapabilities().HandlesDemuxing();
     CLog::Log(LOGDEBUG, "CInputStreamPVRChannel - {} - opened channel stream {}", __FUNCTION__,
               m_item.GetPath());
+
+    if (!m_bDemuxActive)
+      StartTimeshift();
+
     return true;
   }
   return false;
 }
 
+void CInputStreamPVRChannel::StartTimeshift()
+{
+  const std::shared_ptr<CAdvancedSettings> advancedSettings =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  if (!advancedSettings->m_bPVRTimeshiftBufferEnabled)
+    return;
+
+  // clients supporting timeshift keep handling pause and seek themselves
+  bool bCanPause = false;
+  bool bCanSeek = false;
+  m_client->CanPauseStream(bCanPause);
+  m_client->CanSeekStream(bCanSeek);
+  if (bCanPause || bCanSeek)
+    return;
+
+  const size_t bufferSize =
+      static_cast<size_t>(advancedSettings->m_iPVRTimeshiftBufferSize) * 1024 * 1024;
+  auto timeshiftBuffer = std::make_unique<CPVRTimeshiftBuffer>(
+      advancedSettings->m_strPVRTimeshiftBufferPath, TIMESHIFT_SEGMENT_SIZE,
+      bufferSize / TIMESHIFT_SEGMENT_SIZE);
+  if (!timeshiftBuffer->Open())
+    return;
+
+  const std::shared_ptr<CPVRClient> client = m_client;
+  timeshiftBuffer->Start([client](uint8_t* buf, int size) {
+    int read = -1;
+    client->ReadLiveStream(buf, size, read);
+    return read;
+  });
+  m_timeshiftBuffer = std::move(timeshiftBuffer);
+
+  CLog::Log(LOGDEBUG, "CInputStreamPVRChannel - {} - buffering channel stream {} in {}",
+            __FUNCTION__, m_item.GetPath(), advancedSettings->m_strPVRTimeshiftBufferPath);
+}
+
 void CInputStreamPVRChannel::ClosePVRStream()
 {
+  // stop reading from the client before closing the stream
+  m_timeshiftBuffer.reset();
+
   if (m_client && (m_client->CloseLiveStream() == PVR_ERROR_NO_ERROR))
   {
     m_bDemuxActive = false;
@@ -67,6 +126,9 @@ void CInputStreamPVRChannel::ClosePVRStream()
 
 int CInputStreamPVRChannel::ReadPVRStream(uint8_t* buf, int buf_size)
 {
+  if (m_timeshiftBuffer)
+    return m_timeshiftBuffer->Read(buf, buf_size);
+
   int ret = -1;
 
   if (m_client)
@@ -77,6 +139,9 @@ int CInputStreamPVRChannel::ReadPVRStream(uint8_t* buf, int buf_size)
 
 int64_t CInputStreamPVRChannel::SeekPVRStream(int64_t offset, int whence)
 {
+  if (m_timeshiftBuffer)
+    return m_timeshiftBuffer->Seek(offset, whence);
+
   int64_t ret = -1;
 
   if (m_client)
@@ -87,6 +152,9 @@ int64_t CInputStreamPVRChannel::SeekPVRStream(int64_t offset, int whence)
 
 int64_t CInputStreamPVRChannel::GetPVRStreamLength()
 {
+  if (m_timeshiftBuffer)
+    return m_timeshiftBuffer->GetLength();
+
   int64_t ret = -1;
 
   if (m_client)
@@ -105,6 +173,9 @@ CDVDInputStream::ENextStream CInputStreamPVRChannel::NextPVRStream()
 
 bool CInputStreamPVRChannel::CanPausePVRStream()
 {
+  if (m_timeshiftBuffer)
+    return true;
+
   bool ret = false;
 
   if (m_client)
@@ -115,6 +186,9 @@ bool CInputStreamPVRChannel::CanPausePVRStream()
 
 bool CInputStreamPVRChannel::CanSeekPVRStream()
 {
+  if (m_timeshiftBuffer)
+    return true;
+
   bool ret = false;
 
   if (m_client)
@@ -122,3 +196,48 @@ bool CInputStreamPVRChannel::CanSeekPVRStream()
 
   return ret;
 }
+
+bool CInputStreamPVRChannel::GetTimes(Times& times)
+{
+  if (!m_timeshiftBuffer)
+    return CInputStreamPVRBase::GetTimes(times);
+
+  const CPVRTimeshiftBuffer::Status status = m_timeshiftBuffer->GetStatus();
+  if (status.startTime == 0)
+    return false;
+
+  // the player's clock starts at the first timestamp of the stream, like the buffer's times
+  times.startTime = status.startTime;
+  times.ptsStart = 0;
+  times.ptsBegin = status.ptsBegin;
+  times.ptsEnd = status.ptsEnd;
+  return true;
+}
+
+bool CInputStreamPVRChannel::IsRealtime()
+{
+  if (!m_timeshiftBuffer)
+    return CInputStreamPVRBase::IsRealtime();
+
+  // playing from the buffer is realtime only close to the live position
+  const CPVRTimeshiftBuffer::Status status = m_timeshiftBuffer->GetStatus();
+  const int threshold =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iPVRTimeshiftThreshold;
+  return status.ptsEnd - status.ptsRead < DVD_SEC_TO_TIME(threshold);
+}
+
+void CInputStreamPVRChannel::Pause(bool bPaused)
+{
+  // keep receiving the live stream into the buffer while paused
+  if (!m_timeshiftBuffer)
+    CInputStreamPVRBase::Pause(bPaused);
+}
+
+bool CInputStreamPVRChannel::PosTime(int ms)
+{
+  if (!m_timeshiftBuffer || !m_timeshiftBuffer->SeekTime(DVD_MSEC_TO_TIME(ms)))
+    return false;
+
+  m_eof = false;
+  return true;
+}
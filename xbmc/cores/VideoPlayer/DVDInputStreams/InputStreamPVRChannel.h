@@ -10,13 +10,25 @@
 
 #include "InputStreamPVRBase.h"
 
-class CInputStreamPVRChannel : public CInputStreamPVRBase
+#include <memory>
+
+class CPVRTimeshiftBuffer;
+
+class CInputStreamPVRChannel : public CInputStreamPVRBase, public CDVDInputStream::IPosTime
 {
 public:
   CInputStreamPVRChannel(IVideoPlayer* pPlayer, const CFileItem& fileitem);
   ~CInputStreamPVRChannel() override;
 
   CDVDInputStream::IDemux* GetIDemux() override;
+  CDVDInputStream::IPosTime* GetIPosTime() override;
+
+  bool GetTimes(Times& times) override;
+  bool IsRealtime() override;
+  void Pause(bool bPaused) override;
+
+  // IPosTime implementation, only available while the built-in timeshift buffer is used
+  bool PosTime(int ms) override;
 
 protected:
   bool OpenPVRStream() override;
@@ -29,5 +41,8 @@ protected:
   bool CanSeekPVRStream() override;
 
 private:
+  void StartTimeshift();
+
   bool m_bDemuxActive = false;
+  std::unique_ptr<CPVRTimeshiftBuffer> m_timeshiftBuffer;
 };
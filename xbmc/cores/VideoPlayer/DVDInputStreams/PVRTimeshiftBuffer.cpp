@@ -0,0 +1,516 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PVRTimeshiftBuffer.h"
+
+#include "FileItem.h"
+#include "Util.h"
+#include "cores/VideoPlayer/Interface/TimingConstants.h"
+#include "filesystem/Directory.h"
+#include "threads/SystemClock.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr uint8_t TS_SYNC_BYTE = 0x47;
+constexpr int64_t PTS_WRAP = int64_t(1) << 33;
+constexpr int PTS_CLOCK = 90000;
+// amount of data read from the live stream at once
+constexpr size_t READ_CHUNK_SIZE = 64 * CPVRTimeshiftBuffer::TS_PACKET_SIZE;
+// time a reader waits for new data of the live stream before giving up
+constexpr auto READ_TIMEOUT = 10s;
+// the folder of the segment files, below the configured timeshift directory
+constexpr const char* SEGMENT_FOLDER = "kodi-timeshift/";
+constexpr const char* SEGMENT_PREFIX = "segment-";
+} // unnamed namespace
+
+CPVRTimeshiftBuffer::CPVRTimeshiftBuffer(const std::string& directory,
+                                         size_t segmentSize,
+                                         size_t maxSegments)
+  : CThread("PVRTimeshift"),
+    m_directory(URIUtils::AddFileToFolder(directory, SEGMENT_FOLDER)),
+    m_segmentSize(std::max(segmentSize - segmentSize % TS_PACKET_SIZE, TS_PACKET_SIZE)),
+    m_maxSegments(std::max(maxSegments, size_t(2)))
+{
+}
+
+CPVRTimeshiftBuffer::~CPVRTimeshiftBuffer()
+{
+  Close();
+}
+
+bool CPVRTimeshiftBuffer::Open()
+{
+  if (XFILE::CDirectory::Exists(m_directory, false))
+  {
+    // delete the segments left over by a session that was not closed, nothing else
+    CFileItemList items;
+    XFILE::CDirectory::GetDirectory(m_directory, items, ".ts", XFILE::DIR_FLAG_NO_FILE_DIRS);
+    for (const auto& item : items)
+    {
+      if (!item->m_bIsFolder &&
+          StringUtils::StartsWith(URIUtils::GetFileName(item->GetPath()), SEGMENT_PREFIX))
+        XFILE::CFile::Delete(item->GetPath());
+    }
+  }
+  else if (!CUtil::CreateDirectoryEx(m_directory))
+  {
+    CLog::LogF(LOGERROR, "Unable to create timeshift directory '{}'", m_directory);
+    return false;
+  }
+  return true;
+}
+
+void CPVRTimeshiftBuffer::Close()
+{
+  Stop();
+
+  // wake up a reader waiting for data, before waiting for it
+  SetEndOfStream();
+
+  std::unique_lock<CCriticalSection> readLock(m_readSection);
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  m_writeFile.Close();
+  m_readFile.Close();
+  m_readSegment = -1;
+
+  // delete the segments written by this buffer
+  if (m_writeSegment >= 0)
+  {
+    for (int64_t segment = m_firstSegment; segment <= m_writeSegment; ++segment)
+      XFILE::CFile::Delete(GetSegmentPath(segment));
+
+    m_firstSegment = m_writeSegment + 1;
+    m_writeSegment = -1;
+  }
+
+  // only succeeds if no other files were put there
+  if (XFILE::CDirectory::Exists(m_directory, false))
+    XFILE::CDirectory::Remove(m_directory);
+}
+
+void CPVRTimeshiftBuffer::Start(const Source& source)
+{
+  m_source = source;
+  Create();
+}
+
+void CPVRTimeshiftBuffer::Stop()
+{
+  StopThread(true);
+}
+
+void CPVRTimeshiftBuffer::Process()
+{
+  std::vector<uint8_t> buffer(READ_CHUNK_SIZE);
+  while (!m_bStop)
+  {
+    const int read = m_source(buffer.data(), static_cast<int>(buffer.size()));
+    if (read <= 0)
+    {
+      if (read < 0)
+        CLog::LogF(LOGERROR, "Reading the live stream failed");
+      break;
+    }
+
+    if (!Write(buffer.data(), static_cast<size_t>(read)))
+      break;
+  }
+
+  SetEndOfStream();
+}
+
+std::string CPVRTimeshiftBuffer::GetSegmentPath(int64_t segment) const
+{
+  return URIUtils::AddFileToFolder(m_directory,
+                                   StringUtils::Format("{}{}.ts", SEGMENT_PREFIX, segment));
+}
+
+bool CPVRTimeshiftBuffer::OpenWriteSegment(int64_t segment)
+{
+  m_writeFile.Close();
+  if (!m_writeFile.OpenForWrite(GetSegmentPath(segment), true))
+  {
+    CLog::LogF(LOGERROR, "Unable to create timeshift segment '{}'", GetSegmentPath(segment));
+    return false;
+  }
+  m_writeSegment = segment;
+
+  const int64_t evict = segment - static_cast<int64_t>(m_maxSegments);
+  if (evict >= 0)
+  {
+    std::vector<std::string> evictedSegments;
+    {
+      // a reader keeps its segment open between reads, e.g. while playback is paused. If it isn't
+      // reading right now its file is closed here, so that the segment can be deleted.
+      std::unique_lock<CCriticalSection> readLock(m_readSection, std::try_to_lock);
+      std::unique_lock<CCriticalSection> lock(m_critSection);
+      EvictSegment(evict);
+      if (readLock.owns_lock() && m_readSegment >= 0 && m_readSegment <= evict)
+      {
+        m_readFile.Close();
+        m_readSegment = -1;
+      }
+      evictedSegments = TakeEvictedSegments();
+    }
+
+    for (const auto& path : evictedSegments)
+      XFILE::CFile::Delete(path);
+  }
+  return true;
+}
+
+void CPVRTimeshiftBuffer::EvictSegment(int64_t segment)
+{
+  m_startOffset = (segment + 1) * static_cast<int64_t>(m_segmentSize);
+  while (!m_index.empty() && m_index.front().offset < m_startOffset)
+    m_index.pop_front();
+}
+
+std::vector<std::string> CPVRTimeshiftBuffer::TakeEvictedSegments()
+{
+  // the segment open for reading is deleted once the reader closed it, as an open file can't be
+  // deleted on all platforms
+  std::vector<std::string> paths;
+  const int64_t startSegment = m_startOffset / static_cast<int64_t>(m_segmentSize);
+  while (m_firstSegment < startSegment && m_firstSegment != m_readSegment)
+    paths.emplace_back(GetSegmentPath(m_firstSegment++));
+
+  return paths;
+}
+
+bool CPVRTimeshiftBuffer::Write(const uint8_t* data, size_t size)
+{
+  // only the writer changes the end offset, no need to lock for reading it here
+  int64_t offset = m_endOffset;
+
+  while (size > 0)
+  {
+    const int64_t segment = offset / static_cast<int64_t>(m_segmentSize);
+    if (segment != m_writeSegment && !OpenWriteSegment(segment))
+      return false;
+
+    const size_t segmentEnd = static_cast<size_t>((segment + 1) * m_segmentSize - offset);
+    const size_t chunk = std::min(size, segmentEnd);
+    if (m_writeFile.Write(data, chunk) != static_cast<ssize_t>(chunk))
+    {
+      CLog::LogF(LOGERROR, "Writing timeshift segment '{}' failed", GetSegmentPath(segment));
+      return false;
+    }
+
+    {
+      std::unique_lock<CCriticalSection> lock(m_critSection);
+      IndexPackets(data, chunk, offset);
+      m_endOffset = offset + chunk;
+    }
+    m_dataAvailable.Set();
+
+    data += chunk;
+    offset += chunk;
+    size -= chunk;
+  }
+  return true;
+}
+
+void CPVRTimeshiftBuffer::SetEndOfStream()
+{
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    m_endOfStream = true;
+  }
+  m_dataAvailable.Set();
+}
+
+void CPVRTimeshiftBuffer::IndexPackets(const uint8_t* data, size_t size, int64_t offset)
+{
+  size_t pos = 0;
+
+  // complete a packet split between two writes
+  if (!m_partialPacket.empty())
+  {
+    pos = std::min(TS_PACKET_SIZE - m_partialPacket.size(), size);
+    m_partialPacket.insert(m_partialPacket.end(), data, data + pos);
+    if (m_partialPacket.size() < TS_PACKET_SIZE)
+      return;
+
+    IndexPacket(m_partialPacket.data(), m_partialPacketOffset);
+    m_partialPacket.clear();
+  }
+
+  while (pos < size)
+  {
+    // resync after garbage or a lost packet boundary
+    if (data[pos] != TS_SYNC_BYTE)
+    {
+      ++pos;
+      continue;
+    }
+
+    if (size - pos < TS_PACKET_SIZE)
+    {
+      m_partialPacket.assign(data + pos, data + size);
+      m_partialPacketOffset = offset + pos;
+      return;
+    }
+
+    IndexPacket(data + pos, offset + pos);
+    pos += TS_PACKET_SIZE;
+  }
+}
+
+void CPVRTimeshiftBuffer::IndexPacket(const uint8_t* packet, int64_t offset)
+{
+  const bool unitStart = (packet[1] & 0x40) != 0;
+  const int adaptationControl = (packet[3] >> 4) & 0x03;
+  if (!unitStart || !(adaptationControl & 0x01))
+    return;
+
+  size_t payload = 4;
+  bool randomAccess = false;
+  if (adaptationControl & 0x02)
+  {
+    const size_t length = packet[4];
+    if (length > 0)
+      randomAccess = (packet[5] & 0x40) != 0;
+    payload = 5 + length;
+  }
+
+  // a PES header with a PTS takes 14 bytes
+  if (payload + 14 > TS_PACKET_SIZE)
+    return;
+
+  const uint8_t* pes = packet + payload;
+  if (pes[0] != 0x00 || pes[1] != 0x00 || pes[2] != 0x01 || !(pes[7] & 0x80))
+    return;
+
+  const bool video = (pes[3] & 0xf0) == 0xe0;
+  const bool audio = (pes[3] & 0xe0) == 0xc0;
+  if (!video && !audio)
+    return;
+
+  // index the first video stream, or the first audio stream for radio
+  const int pid = ((packet[1] & 0x1f) << 8) | packet[2];
+  if (pid != m_indexPid)
+  {
+    if (m_indexPid >= 0 && (m_indexPidIsVideo || !video))
+      return;
+
+    m_indexPid = pid;
+    m_indexPidIsVideo = video;
+    m_hasRandomAccess = false;
+    m_lastPts = -1;
+    m_index.clear();
+  }
+
+  int64_t pts = (static_cast<int64_t>(pes[9] & 0x0e) << 29) | (pes[10] << 22) |
+                ((pes[11] & 0xfe) << 14) | (pes[12] << 7) | (pes[13] >> 1);
+
+  // continue the timeline across the wrap of the 33 bit timestamps
+  if (m_lastPts >= 0)
+  {
+    pts += m_lastPts - m_lastPts % PTS_WRAP;
+    if (pts < m_lastPts - PTS_WRAP / 2)
+      pts += PTS_WRAP;
+    else if (pts > m_lastPts + PTS_WRAP / 2)
+      pts -= PTS_WRAP;
+  }
+  m_lastPts = pts;
+
+  AddIndexEntry(offset, pts, randomAccess);
+}
+
+void CPVRTimeshiftBuffer::AddIndexEntry(int64_t offset, int64_t pts, bool randomAccess)
+{
+  if (m_firstPts < 0)
+  {
+    m_firstPts = pts;
+    m_startTime = time(nullptr);
+  }
+  m_maxPts = std::max(m_maxPts, pts);
+
+  // once the stream signals random access points, only those are used to seek to
+  if (randomAccess && !m_hasRandomAccess)
+  {
+    m_hasRandomAccess = true;
+    m_index.clear();
+  }
+  if (m_hasRandomAccess && !randomAccess)
+    return;
+
+  // frames with a timestamp below the last entry (reordered frames) are no useful seek targets
+  if (!m_index.empty() && pts <= m_index.back().pts)
+    return;
+
+  m_index.push_back({offset, pts});
+}
+
+int CPVRTimeshiftBuffer::Read(uint8_t* buf, int size)
+{
+  if (size <= 0)
+    return 0;
+
+  // the segment file is read holding the reader lock only, so the writer is not blocked by it
+  std::unique_lock<CCriticalSection> readLock(m_readSection);
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  XbmcThreads::EndTime<> timeout(READ_TIMEOUT);
+  while (m_readPosition >= m_endOffset)
+  {
+    if (m_endOfStream)
+      return 0;
+
+    if (timeout.IsTimePast())
+    {
+      CLog::LogF(LOGERROR, "Timeout waiting for data of the live stream");
+      return -1;
+    }
+
+    lock.unlock();
+    m_dataAvailable.Wait(timeout.GetTimeLeft());
+    lock.lock();
+  }
+
+  // the data at the read position might have been dropped meanwhile
+  m_readPosition = std::max(m_readPosition, m_startOffset);
+
+  const int64_t position = m_readPosition;
+  const int64_t segment = position / static_cast<int64_t>(m_segmentSize);
+  const int64_t segmentEnd = (segment + 1) * static_cast<int64_t>(m_segmentSize);
+  const int64_t available = std::min(segmentEnd, m_endOffset) - position;
+  const size_t chunk = static_cast<size_t>(std::min(available, static_cast<int64_t>(size)));
+
+  // the writer does not delete the segment while it is the read segment
+  const bool openSegment = (segment != m_readSegment);
+  std::vector<std::string> evictedSegments;
+  if (openSegment)
+  {
+    m_readFile.Close();
+    m_readSegment = segment;
+    evictedSegments = TakeEvictedSegments();
+  }
+  lock.unlock();
+
+  if (openSegment)
+  {
+    for (const auto& path : evictedSegments)
+      XFILE::CFile::Delete(path);
+
+    if (!m_readFile.Open(GetSegmentPath(segment), XFILE::READ_NO_CACHE | XFILE::READ_NO_BUFFER))
+    {
+      CLog::LogF(LOGERROR, "Unable to open timeshift segment '{}'", GetSegmentPath(segment));
+      lock.lock();
+      m_readSegment = -1;
+      return -1;
+    }
+  }
+
+  if (m_readFile.Seek(position % static_cast<int64_t>(m_segmentSize), SEEK_SET) < 0)
+    return -1;
+
+  const ssize_t read = m_readFile.Read(buf, chunk);
+  if (read <= 0)
+  {
+    CLog::LogF(LOGERROR, "Reading timeshift segment '{}' failed", GetSegmentPath(segment));
+    return -1;
+  }
+
+  // a seek meanwhile takes precedence
+  lock.lock();
+  if (m_readPosition == position)
+    m_readPosition += read;
+
+  return static_cast<int>(read);
+}
+
+int64_t CPVRTimeshiftBuffer::Seek(int64_t offset, int whence)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  int64_t position;
+  switch (whence)
+  {
+    case SEEK_SET:
+      position = offset;
+      break;
+    case SEEK_CUR:
+      position = m_readPosition + offset;
+      break;
+    case SEEK_END:
+      position = m_endOffset + offset;
+      break;
+    default:
+      return -1;
+  }
+
+  m_readPosition = std::clamp(position, m_startOffset, m_endOffset);
+  return m_readPosition;
+}
+
+bool CPVRTimeshiftBuffer::SeekTime(double time)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  if (m_index.empty())
+    return false;
+
+  const int64_t pts = m_firstPts + std::llround(time * PTS_CLOCK / DVD_TIME_BASE);
+  auto it = std::upper_bound(m_index.cbegin(), m_index.cend(), pts,
+                             [](int64_t pts, const IndexEntry& entry) { return pts < entry.pts; });
+  if (it != m_index.cbegin())
+    --it;
+
+  m_readPosition = it->offset;
+  return true;
+}
+
+int64_t CPVRTimeshiftBuffer::GetLength() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return m_endOffset;
+}
+
+CPVRTimeshiftBuffer::Status CPVRTimeshiftBuffer::GetStatus() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  Status status;
+  status.startTime = m_startTime;
+  status.startOffset = m_startOffset;
+  status.endOffset = m_endOffset;
+  if (!m_index.empty())
+  {
+    status.ptsBegin = ToTime(m_index.front().pts);
+    status.ptsEnd = ToTime(m_maxPts);
+    status.ptsRead = ToTime(GetPtsAt(m_readPosition));
+  }
+  return status;
+}
+
+double CPVRTimeshiftBuffer::ToTime(int64_t pts) const
+{
+  return static_cast<double>(pts - m_firstPts) * DVD_TIME_BASE / PTS_CLOCK;
+}
+
+int64_t CPVRTimeshiftBuffer::GetPtsAt(int64_t offset) const
+{
+  auto it = std::upper_bound(
+      m_index.cbegin(), m_index.cend(), offset,
+      [](int64_t offset, const IndexEntry& entry) { return offset < entry.offset; });
+  if (it != m_index.cbegin())
+    --it;
+
+  return it->pts;
+}
@@ -0,0 +1,174 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "filesystem/File.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+
+#include <deque>
+#include <functional>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <time.h>
+#include <vector>
+
+/*!
+ \brief On-disk timeshift ring buffer for live MPEG-TS streams.
+
+ The live stream is written to a sequence of segment files of a fixed size. Only the most recent
+ segments are kept, older segments are deleted while new ones are written. The buffer is addressed
+ by byte offsets counted from the start of the live stream, so readers see one growing stream of
+ which only the most recent window is available.
+
+ While writing, the TS packets are scanned for PES headers with a timestamp. The offsets of the
+ frame starts (random access points if the stream signals them) are kept in an index, which is used
+ to seek by time and to report the time window of the buffer.
+ */
+class CPVRTimeshiftBuffer : private CThread
+{
+public:
+  /*!
+   \brief Reads from the live stream.
+   \return The number of bytes read, 0 at the end of the stream, negative on error.
+   */
+  using Source = std::function<int(uint8_t* buf, int size)>;
+
+  struct Status
+  {
+    time_t startTime = 0; // wall clock time of the start of the live stream
+    int64_t startOffset = 0; // first byte still in the buffer
+    int64_t endOffset = 0; // end of the data written so far
+    double ptsBegin = 0.0; // begin of the buffer, DVD time relative to the start of the stream
+    double ptsEnd = 0.0; // end of the buffer, DVD time relative to the start of the stream
+    double ptsRead = 0.0; // time of the frame at the read position
+  };
+
+  /*!
+   \param directory The directory for the segment files. They are kept in its subfolder
+   'kodi-timeshift', other files in the directory are never touched.
+   \param segmentSize The size of a segment file in bytes, a multiple of the TS packet size.
+   \param maxSegments The number of segments kept.
+   */
+  CPVRTimeshiftBuffer(const std::string& directory, size_t segmentSize, size_t maxSegments);
+  ~CPVRTimeshiftBuffer() override;
+
+  /*!
+   \brief Create the segment folder, deleting segments left over from a previous session.
+   */
+  bool Open();
+
+  /*!
+   \brief Stop writing, delete the segment files and the segment folder if it is empty then.
+   */
+  void Close();
+
+  /*!
+   \brief Start writing the data of a live stream from a background thread.
+   */
+  void Start(const Source& source);
+
+  /*!
+   \brief Stop the background thread. The data written so far stays readable.
+   */
+  void Stop();
+
+  /*!
+   \brief Append data of the live stream.
+   \return false if the data could not be written.
+   */
+  bool Write(const uint8_t* data, size_t size);
+
+  /*!
+   \brief Mark the end of the live stream. Readers get the end of stream once all data was read.
+   */
+  void SetEndOfStream();
+
+  /*!
+   \brief Read from the current position, waiting for the live stream if all data was read.
+   \return The number of bytes read, 0 at the end of the stream, -1 on error or timeout.
+   */
+  int Read(uint8_t* buf, int size);
+
+  /*!
+   \brief Seek within the window of the buffer. Positions outside the window are clamped to it.
+   \return The new position, or -1 for an unsupported whence.
+   */
+  int64_t Seek(int64_t offset, int whence);
+
+  /*!
+   \brief Seek to the last indexed frame starting at or before a point in time.
+   \param time DVD time relative to the start of the stream.
+   \return false if nothing was indexed yet.
+   */
+  bool SeekTime(double time);
+
+  int64_t GetLength() const;
+  Status GetStatus() const;
+
+  static constexpr size_t TS_PACKET_SIZE = 188;
+
+protected:
+  // CThread implementation
+  void Process() override;
+
+private:
+  struct IndexEntry
+  {
+    int64_t offset; // offset of the TS packet starting the frame
+    int64_t pts; // 90 kHz, unwrapped
+  };
+
+  std::string GetSegmentPath(int64_t segment) const;
+  bool OpenWriteSegment(int64_t segment);
+  void IndexPackets(const uint8_t* data, size_t size, int64_t offset);
+  void IndexPacket(const uint8_t* packet, int64_t offset);
+  void AddIndexEntry(int64_t offset, int64_t pts, bool randomAccess);
+  void EvictSegment(int64_t segment);
+  std::vector<std::string> TakeEvictedSegments();
+  double ToTime(int64_t pts) const;
+  int64_t GetPtsAt(int64_t offset) const;
+
+  const std::string m_directory;
+  const size_t m_segmentSize;
+  const size_t m_maxSegments;
+
+  mutable CCriticalSection m_critSection;
+  CCriticalSection m_readSection; // held by readers during Read(), taken before m_critSection
+  CEvent m_dataAvailable;
+  Source m_source;
+
+  // writer state, only used by the writing thread
+  XFILE::CFile m_writeFile;
+  int64_t m_writeSegment = -1;
+  std::vector<uint8_t> m_partialPacket;
+  int64_t m_partialPacketOffset = 0;
+  int64_t m_lastPts = -1;
+
+  // reader state, the file is only used holding m_readSection. The writer closes it when its
+  // segment is evicted and no read is in progress.
+  XFILE::CFile m_readFile;
+  int64_t m_readPosition = 0;
+
+  // shared state
+  int64_t m_readSegment = -1; // segment of m_readFile, not deleted while it is open
+  int64_t m_firstSegment = 0; // oldest segment not deleted yet
+  int64_t m_startOffset = 0;
+  int64_t m_endOffset = 0;
+  bool m_endOfStream = false;
+  time_t m_startTime = 0;
+  int64_t m_firstPts = -1;
+  int64_t m_maxPts = -1;
+  int m_indexPid = -1;
+  bool m_indexPidIsVideo = false;
+  bool m_hasRandomAccess = false;
+  std::deque<IndexEntry> m_index;
+};
@@ -0,0 +1,288 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "cores/VideoPlayer/DVDInputStreams/PVRTimeshiftBuffer.h"
+#include "cores/VideoPlayer/Interface/TimingConstants.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "Util.h"
+#include "test/TestUtils.h"
+
+#include <algorithm>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr const char* BUFFER_PATH = "special://temp/pvrtimeshifttest/";
+constexpr size_t PACKET_SIZE = CPVRTimeshiftBuffer::TS_PACKET_SIZE;
+constexpr int VIDEO_PID = 0x100;
+constexpr int FRAME_DURATION = 3600; // 25 fps, 90 kHz
+constexpr int GOP_SIZE = 10;
+constexpr int PACKETS_PER_FRAME = 4;
+
+void WritePacket(std::vector<uint8_t>& stream, int frame, bool frameStart)
+{
+  uint8_t packet[PACKET_SIZE];
+  memset(packet, 0xff, sizeof(packet));
+
+  packet[0] = 0x47;
+  packet[1] = (frameStart ? 0x40 : 0x00) | ((VIDEO_PID >> 8) & 0x1f);
+  packet[2] = VIDEO_PID & 0xff;
+
+  size_t payload = 4;
+  if (frameStart)
+  {
+    // adaptation field signalling random access at the start of each group of pictures
+    packet[3] = 0x30;
+    packet[4] = 1;
+    packet[5] = frame % GOP_SIZE == 0 ? 0x40 : 0x00;
+    payload = 6;
+
+    const int64_t pts = 90000 + static_cast<int64_t>(frame) * FRAME_DURATION;
+    const uint8_t pes[] = {0x00,
+                           0x00,
+                           0x01,
+                           0xe0,
+                           0x00,
+                           0x00,
+                           0x80,
+                           0x80,
+                           0x05,
+                           static_cast<uint8_t>(0x21 | ((pts >> 29) & 0x0e)),
+                           static_cast<uint8_t>(pts >> 22),
+                           static_cast<uint8_t>(0x01 | ((pts >> 14) & 0xfe)),
+                           static_cast<uint8_t>(pts >> 7),
+                           static_cast<uint8_t>(0x01 | ((pts << 1) & 0xfe))};
+    memcpy(packet + payload, pes, sizeof(pes));
+  }
+  else
+  {
+    packet[3] = 0x10;
+  }
+
+  stream.insert(stream.end(), packet, packet + sizeof(packet));
+}
+
+std::vector<uint8_t> CreateStream(int frames)
+{
+  std::vector<uint8_t> stream;
+  for (int frame = 0; frame < frames; ++frame)
+  {
+    for (int packet = 0; packet < PACKETS_PER_FRAME; ++packet)
+      WritePacket(stream, frame, packet == 0);
+  }
+  return stream;
+}
+
+int64_t GetFrameOffset(int frame)
+{
+  return static_cast<int64_t>(frame) * PACKETS_PER_FRAME * PACKET_SIZE;
+}
+
+bool CreateFile(const std::string& path)
+{
+  XFILE::CFile file;
+  if (!file.OpenForWrite(path, true))
+    return false;
+
+  file.Write("x", 1);
+  file.Close();
+  return true;
+}
+
+std::vector<uint8_t> ReadAll(CPVRTimeshiftBuffer& buffer)
+{
+  std::vector<uint8_t> data;
+  uint8_t buf[1000];
+  int read;
+  while ((read = buffer.Read(buf, sizeof(buf))) > 0)
+    data.insert(data.end(), buf, buf + read);
+
+  EXPECT_EQ(0, read);
+  return data;
+}
+} // unnamed namespace
+
+TEST(TestPVRTimeshiftBuffer, ReadBack)
+{
+  const std::vector<uint8_t> stream = CreateStream(100);
+
+  CPVRTimeshiftBuffer buffer(BUFFER_PATH, 20 * PACKET_SIZE, 100);
+  ASSERT_TRUE(buffer.Open());
+
+  // unaligned writes, the indexer has to join split packets
+  for (size_t offset = 0; offset < stream.size(); offset += 1000)
+    ASSERT_TRUE(
+        buffer.Write(stream.data() + offset, std::min<size_t>(1000, stream.size() - offset)));
+  buffer.SetEndOfStream();
+
+  EXPECT_EQ(static_cast<int64_t>(stream.size()), buffer.GetLength());
+  EXPECT_EQ(stream, ReadAll(buffer));
+
+  const CPVRTimeshiftBuffer::Status status = buffer.GetStatus();
+  EXPECT_EQ(0, status.startOffset);
+  EXPECT_DOUBLE_EQ(0.0, status.ptsBegin);
+  EXPECT_DOUBLE_EQ(DVD_MSEC_TO_TIME(99 * 40), status.ptsEnd);
+
+  buffer.Close();
+}
+
+TEST(TestPVRTimeshiftBuffer, SeekTime)
+{
+  const std::vector<uint8_t> stream = CreateStream(100);
+
+  CPVRTimeshiftBuffer buffer(BUFFER_PATH, 20 * PACKET_SIZE, 100);
+  ASSERT_TRUE(buffer.Open());
+  ASSERT_TRUE(buffer.Write(stream.data(), stream.size()));
+  buffer.SetEndOfStream();
+
+  // seeks land on the last random access point before the requested time
+  ASSERT_TRUE(buffer.SeekTime(DVD_MSEC_TO_TIME(35 * 40 + 10)));
+  EXPECT_EQ(GetFrameOffset(30), buffer.Seek(0, SEEK_CUR));
+  EXPECT_DOUBLE_EQ(DVD_MSEC_TO_TIME(30 * 40), buffer.GetStatus().ptsRead);
+
+  ASSERT_TRUE(buffer.SeekTime(DVD_MSEC_TO_TIME(40 * 40)));
+  EXPECT_EQ(GetFrameOffset(40), buffer.Seek(0, SEEK_CUR));
+
+  const std::vector<uint8_t> data = ReadAll(buffer);
+  EXPECT_EQ(stream.size() - GetFrameOffset(40), data.size());
+  EXPECT_TRUE(std::equal(data.begin(), data.end(), stream.begin() + GetFrameOffset(40)));
+
+  // times before the buffer seek to its start
+  ASSERT_TRUE(buffer.SeekTime(-DVD_TIME_BASE));
+  EXPECT_EQ(0, buffer.Seek(0, SEEK_CUR));
+
+  buffer.Close();
+}
+
+TEST(TestPVRTimeshiftBuffer, Window)
+{
+  const std::vector<uint8_t> stream = CreateStream(100);
+
+  // segments of 2.5 groups of pictures, of which 3 are kept
+  const size_t segmentSize = GOP_SIZE * PACKETS_PER_FRAME * PACKET_SIZE * 5 / 2;
+  CPVRTimeshiftBuffer buffer(BUFFER_PATH, segmentSize, 3);
+  ASSERT_TRUE(buffer.Open());
+  ASSERT_TRUE(buffer.Write(stream.data(), stream.size()));
+  buffer.SetEndOfStream();
+
+  // 100 frames fill 4 segments, the first one was dropped
+  const CPVRTimeshiftBuffer::Status status = buffer.GetStatus();
+  EXPECT_EQ(static_cast<int64_t>(segmentSize), status.startOffset);
+  EXPECT_EQ(static_cast<int64_t>(stream.size()), status.endOffset);
+  EXPECT_DOUBLE_EQ(DVD_MSEC_TO_TIME(30 * 40), status.ptsBegin);
+  EXPECT_DOUBLE_EQ(DVD_MSEC_TO_TIME(99 * 40), status.ptsEnd);
+
+  // seeks are clamped to the window
+  EXPECT_EQ(status.startOffset, buffer.Seek(0, SEEK_SET));
+  EXPECT_EQ(status.endOffset, buffer.Seek(1000, SEEK_END));
+
+  ASSERT_TRUE(buffer.SeekTime(0.0));
+  EXPECT_EQ(GetFrameOffset(30), buffer.Seek(0, SEEK_CUR));
+
+  const std::vector<uint8_t> data = ReadAll(buffer);
+  EXPECT_TRUE(std::equal(data.begin(), data.end(), stream.begin() + GetFrameOffset(30)));
+
+  buffer.Close();
+}
+
+TEST(TestPVRTimeshiftBuffer, LiveSource)
+{
+  const std::vector<uint8_t> stream = CreateStream(200);
+  XFILE::CFile* file;
+  ASSERT_NE(nullptr, (file = XBMC_CREATETEMPFILE(".ts")));
+  ASSERT_EQ(static_cast<ssize_t>(stream.size()), file->Write(stream.data(), stream.size()));
+  file->Close();
+
+  XFILE::CFile input;
+  ASSERT_TRUE(input.Open(XBMC_TEMPFILEPATH(file)));
+
+  CPVRTimeshiftBuffer buffer(BUFFER_PATH, 64 * PACKET_SIZE, 100);
+  ASSERT_TRUE(buffer.Open());
+  buffer.Start(
+      [&input](uint8_t* buf, int size) { return static_cast<int>(input.Read(buf, size)); });
+
+  // reads wait for the data written by the background thread
+  EXPECT_EQ(stream, ReadAll(buffer));
+  EXPECT_DOUBLE_EQ(DVD_MSEC_TO_TIME(199 * 40), buffer.GetStatus().ptsEnd);
+
+  buffer.Close();
+  input.Close();
+  XBMC_DELETETEMPFILE(file);
+}
+
+TEST(TestPVRTimeshiftBuffer, KeepsOtherFiles)
+{
+  const std::string otherFile = std::string(BUFFER_PATH) + "recording.ts";
+  const std::string segmentFolder = std::string(BUFFER_PATH) + "kodi-timeshift/";
+  const std::string leftOverSegment = segmentFolder + "segment-7.ts";
+  const std::string otherSegmentFolderFile = segmentFolder + "notes.txt";
+
+  ASSERT_TRUE(CUtil::CreateDirectoryEx(segmentFolder));
+  ASSERT_TRUE(CreateFile(otherFile));
+  ASSERT_TRUE(CreateFile(leftOverSegment));
+  ASSERT_TRUE(CreateFile(otherSegmentFolderFile));
+
+  const std::vector<uint8_t> stream = CreateStream(100);
+  {
+    CPVRTimeshiftBuffer buffer(BUFFER_PATH, 20 * PACKET_SIZE, 3);
+    ASSERT_TRUE(buffer.Open());
+
+    // segments of a previous session are deleted
+    EXPECT_FALSE(XFILE::CFile::Exists(leftOverSegment));
+
+    ASSERT_TRUE(buffer.Write(stream.data(), stream.size()));
+    EXPECT_FALSE(XFILE::CFile::Exists(segmentFolder + "segment-0.ts"));
+    buffer.Close();
+  }
+
+  // only the files of the buffer are deleted
+  EXPECT_TRUE(XFILE::CFile::Exists(otherFile));
+  EXPECT_TRUE(XFILE::CFile::Exists(otherSegmentFolderFile));
+  EXPECT_FALSE(XFILE::CFile::Exists(segmentFolder + "segment-19.ts"));
+
+  XFILE::CFile::Delete(otherSegmentFolderFile);
+  XFILE::CFile::Delete(otherFile);
+  XFILE::CDirectory::Remove(segmentFolder);
+  XFILE::CDirectory::Remove(BUFFER_PATH);
+}
+
+TEST(TestPVRTimeshiftBuffer, PausedReaderKeepsNoSegments)
+{
+  const std::string segmentFolder = std::string(BUFFER_PATH) + "kodi-timeshift/";
+  const std::vector<uint8_t> stream = CreateStream(100);
+  const size_t segmentSize = 20 * PACKET_SIZE;
+
+  CPVRTimeshiftBuffer buffer(BUFFER_PATH, segmentSize, 3);
+  ASSERT_TRUE(buffer.Open());
+
+  // the reader opens the first segment, then playback is paused while the stream is written on
+  ASSERT_TRUE(buffer.Write(stream.data(), 2 * segmentSize));
+  uint8_t buf[1000];
+  ASSERT_LT(0, buffer.Read(buf, sizeof(buf)));
+  ASSERT_TRUE(buffer.Write(stream.data() + 2 * segmentSize, stream.size() - 2 * segmentSize));
+
+  CFileItemList items;
+  ASSERT_TRUE(XFILE::CDirectory::GetDirectory(segmentFolder, items, ".ts",
+                                              XFILE::DIR_FLAG_NO_FILE_DIRS));
+  EXPECT_EQ(3, items.Size());
+
+  // reading continues at the start of the window
+  const int64_t startOffset = buffer.GetStatus().startOffset;
+  ASSERT_LT(0, buffer.Read(buf, sizeof(buf)));
+  EXPECT_TRUE(std::equal(buf, buf + sizeof(buf), stream.begin() + startOffset));
+
+  buffer.Close();
+  XFILE::CDirectory::Remove(BUFFER_PATH);
+}
@@ -75,6 +75,9 @@ void CProcessInfo::ResetVideoCodecInfo()
   m_videoFPS = 0.0;
   m_videoDAR = 0.0;
   m_videoIsInterlaced = false;
+  m_videoDecoderThreading.clear();
+  m_videoDecoderQueue = 0;
+  m_videoDecoderLag = 0;
   m_deintMethods.clear();
   m_deintMethods.push_back(EINTERLACEMETHOD::VS_INTERLACEMETHOD_NONE);
   m_deintMethodDefault = EINTERLACEMETHOD::VS_INTERLACEMETHOD_NONE;
@@ -239,6 +242,36 @@ bool CProcessInfo::GetVideoInterlaced()
   return m_videoIsInterlaced;
 }
 
+void CProcessInfo::SetVideoDecoderThreading(const std::string& threading)
+{
+  std::unique_lock<CCriticalSection> lock(m_videoCodecSection);
+
+  m_videoDecoderThreading = threading;
+}
+
+std::string CProcessInfo::GetVideoDecoderThreading()
+{
+  std::unique_lock<CCriticalSection> lock(m_videoCodecSection);
+
+  return m_videoDecoderThreading;
+}
+
+void CProcessInfo::SetVideoDecoderQueue(int frames, int lagMs)
+{
+  std::unique_lock<CCriticalSection> lock(m_videoCodecSection);
+
+  m_videoDecoderQueue = frames;
+  m_videoDecoderLag = lagMs;
+}
+
+void CProcessInfo::GetVideoDecoderQueue(int& frames, int& lagMs)
+{
+  std::unique_lock<CCriticalSection> lock(m_videoCodecSection);
+
+  frames = m_videoDecoderQueue;
+  lagMs = m_videoDecoderLag;
+}
+
 EINTERLACEMETHOD CProcessInfo::GetFallbackDeintMethod()
 {
   return VS_INTERLACEMETHOD_DEINTERLACE;
@@ -476,6 +509,13 @@ void CProcessInfo::SeekFinished(int64_t offset)
     m_dataCache->SeekFinished(offset);
 }
 
+void CProcessInfo::SetTimeToFirstFrame(std::chrono::milliseconds timeToFirstFrame)
+{
+  std::unique_lock<CCriticalSection> lock(m_stateSection);
+  if (m_dataCache)
+    m_dataCache->SetTimeToFirstFrame(timeToFirstFrame);
+}
+
 void CProcessInfo::SetStateSeeking(bool active)
 {
   std::unique_lock<CCriticalSection> lock(m_renderSection);
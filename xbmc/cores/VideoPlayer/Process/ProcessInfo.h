@@ -14,6 +14,7 @@
 #include "threads/CriticalSection.h"
 
 #include <atomic>
+#include <chrono>
 #include <list>
 #include <map>
 #include <string>
@@ -50,6 +51,10 @@ public:
   float GetVideoDAR();
   void SetVideoInterlaced(bool interlaced);
   bool GetVideoInterlaced();
+  void SetVideoDecoderThreading(const std::string& threading);
+  std::string GetVideoDecoderThreading();
+  void SetVideoDecoderQueue(int frames, int lagMs);
+  void GetVideoDecoderQueue(int& frames, int& lagMs);
   virtual EINTERLACEMETHOD GetFallbackDeintMethod();
   virtual void SetSwDeinterlacingMethods();
   void UpdateDeinterlacingMethods(std::list<EINTERLACEMETHOD> &methods);
@@ -88,6 +93,13 @@ public:
   */
   void SeekFinished(int64_t offset);
 
+  /*!
+   * @brief Notifies that playback of the current item has started
+   * @param timeToFirstFrame - the time from the request to play the item until its first frames
+   * were presented
+  */
+  void SetTimeToFirstFrame(std::chrono::milliseconds timeToFirstFrame);
+
   void SetStateSeeking(bool active);
   bool IsSeeking();
   void SetStateRealtime(bool state);
@@ -135,6 +147,9 @@ protected:
   float m_videoFPS;
   float m_videoDAR;
   bool m_videoIsInterlaced;
+  std::string m_videoDecoderThreading;
+  int m_videoDecoderQueue = 0;
+  int m_videoDecoderLag = 0;
   std::list<EINTERLACEMETHOD> m_deintMethods;
   EINTERLACEMETHOD m_deintMethodDefault;
   mutable CCriticalSection m_videoCodecSection;
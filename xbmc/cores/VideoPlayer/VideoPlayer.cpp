@@ -35,6 +35,7 @@
 #endif
 #include "Util.h"
 #include "VideoPlayerAudio.h"
+#include "VideoPlayerPreOpen.h"
 #include "VideoPlayerRadioRDS.h"
 #include "VideoPlayerVideo.h"
 #include "application/Application.h"
@@ -682,6 +683,8 @@ CVideoPlayer::CVideoPlayer(IPlayerCallback& callback)
 
   CreatePlayers();
 
+  m_preOpen = std::make_unique<CVideoPlayerPreOpen>(this);
+
   m_displayLost = false;
   m_error = false;
   m_bCloseRequest = false;
@@ -693,6 +696,7 @@ CVideoPlayer::~CVideoPlayer()
   CServiceBroker::GetWinSystem()->Unregister(this);
 
   CloseFile();
+  m_preOpen.reset();
   DestroyPlayers();
 
   while (m_outboundEvents->IsProcessing())
@@ -721,6 +725,7 @@ bool CVideoPlayer::OpenFile(const CFileItem& file, const CPlayerOptions &options
 
   m_item = file;
   m_playerOptions = options;
+  m_openStartTime = std::chrono::steady_clock::now();
 
   m_processInfo->SetPlayTimes(0,0,0,0);
   m_bAbortRequest = false;
@@ -776,6 +781,11 @@ bool CVideoPlayer::CloseFile(bool reopen)
   return true;
 }
 
+void CVideoPlayer::PrepareFiles(const std::vector<std::shared_ptr<CFileItem>>& files)
+{
+  m_preOpen->Prepare(files);
+}
+
 bool CVideoPlayer::IsPlaying() const
 {
   return !m_bStop;
@@ -795,13 +805,24 @@ void CVideoPlayer::OnStartup()
 
 bool CVideoPlayer::OpenInputStream()
 {
+  m_pPreOpenedDemuxer.reset();
   if (m_pInputStream.use_count() > 1)
     throw std::runtime_error("m_pInputStream reference count is greater than 1");
   m_pInputStream.reset();
 
-  CLog::Log(LOGINFO, "Creating InputStream");
+  const bool preOpened = m_preOpen->Take(m_item, m_pInputStream, m_pPreOpenedDemuxer);
+  m_zapPreOpened = preOpened;
+
+  if (preOpened)
+  {
+    CLog::Log(LOGINFO, "Using pre-opened InputStream");
+  }
+  else
+  {
+    CLog::Log(LOGINFO, "Creating InputStream");
+    m_pInputStream = CDVDFactoryInputStream::CreateInputStream(this, m_item, true);
+  }
 
-  m_pInputStream = CDVDFactoryInputStream::CreateInputStream(this, m_item, true);
   if (m_pInputStream == nullptr)
   {
     CLog::Log(LOGERROR, "CVideoPlayer::OpenInputStream - unable to create input stream for [{}]",
@@ -809,7 +830,7 @@ bool CVideoPlayer::OpenInputStream()
     return false;
   }
 
-  if (!m_pInputStream->Open())
+  if (!preOpened && !m_pInputStream->Open())
   {
     CLog::Log(LOGERROR, "CVideoPlayer::OpenInputStream - error opening [{}]",
               CURL::GetRedacted(m_item.GetPath()));
@@ -860,9 +881,18 @@ bool CVideoPlayer::OpenDemuxStream()
 {
   CloseDemuxer();
 
-  CLog::Log(LOGINFO, "Creating Demuxer");
-
   int attempts = 10;
+  if (m_pPreOpenedDemuxer)
+  {
+    CLog::Log(LOGINFO, "Using pre-opened Demuxer");
+    m_pDemuxer = std::move(m_pPreOpenedDemuxer);
+    attempts = 0;
+  }
+  else
+  {
+    CLog::Log(LOGINFO, "Creating Demuxer");
+  }
+
   while (!m_bStop && attempts-- > 0)
   {
     m_pDemuxer.reset(CDVDFactoryDemuxer::CreateDemuxer(m_pInputStream));
@@ -899,6 +929,10 @@ bool CVideoPlayer::OpenDemuxStream()
 
   m_offset_pts = 0;
 
+  if (m_zapMeasuring)
+    m_zapOpenDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - m_openStartTime);
+
   return true;
 }
 
@@ -2215,6 +2249,21 @@ void CVideoPlayer::HandlePlaySpeed()
           cb->OnAVStarted(fileItem);
         });
         m_State.streamsReady = true;
+
+        const auto timeToFirstFrame = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - m_openStartTime);
+        m_processInfo->SetTimeToFirstFrame(timeToFirstFrame);
+        CLog::Log(LOGDEBUG, "{} - playback started {} ms after opening the file", __FUNCTION__,
+                  timeToFirstFrame.count());
+
+        if (m_zapMeasuring)
+        {
+          m_zapMeasuring = false;
+          CLog::LogFC(LOGDEBUG, LOGPVR,
+                      "Channel switch to [{}] took {} ms, opening the stream took {} ms ({})",
+                      CURL::GetRedacted(m_item.GetPath()), timeToFirstFrame.count(),
+                      m_zapOpenDuration.count(), m_zapPreOpened ? "pre-opened" : "not pre-opened");
+        }
       }
     }
     else
@@ -2681,6 +2730,8 @@ void CVideoPlayer::OnExit()
   // destroy objects
   m_renderManager.Flush(false, false);
   m_pDemuxer.reset();
+  m_pPreOpenedDemuxer.reset();
+  m_preOpen->Clear();
   m_pSubtitleDemuxer.reset();
   m_subtitleDemuxerMap.clear();
   m_pCCDemuxer.reset();
@@ -2751,6 +2802,10 @@ void CVideoPlayer::HandleMessages()
       m_item = msg.GetItem();
       m_playerOptions = msg.GetOptions();
 
+      m_zapMeasuring = m_item.IsPVRChannel();
+      m_openStartTime = std::chrono::steady_clock::now();
+      m_processInfo->SetTimeToFirstFrame(std::chrono::milliseconds(0));
+
       m_processInfo->SetPlayTimes(0,0,0,0);
 
       m_outboundEvents->Submit([this]() {
@@ -2760,6 +2815,7 @@ void CVideoPlayer::HandleMessages()
       FlushBuffers(DVD_NOPTS_VALUE, true, true);
       m_renderManager.Flush(false, false);
       m_pDemuxer.reset();
+      m_pPreOpenedDemuxer.reset();
       m_pSubtitleDemuxer.reset();
       m_subtitleDemuxerMap.clear();
       m_pCCDemuxer.reset();
@@ -3456,6 +3512,14 @@ void CVideoPlayer::GetGeneralInfo(std::string& strGeneralInfo)
                                     m_State.cache_offset * 100.0);
     }
 
+    if (m_State.cache_readahead_time > 0.0)
+    {
+      strBuf += StringUtils::Format(", read-ahead: {:.0f}s at {}/s, link: {}/s",
+                                    m_State.cache_readahead_time,
+                                    StringUtils::SizeToString(m_State.cache_consume_rate),
+                                    StringUtils::SizeToString(m_State.cache_link_rate));
+    }
+
     if (m_omxplayer_mode)
       strGeneralInfo = StringUtils::Format("C( a/v:{: 6.3f}, {} amp:{: 5.2f} )"
         , dDiff
@@ -5141,9 +5205,17 @@ void CVideoPlayer::UpdatePlayState(double timeout)
     state.cache_bytes = status.forward;
     if(state.timeMax)
       state.cache_bytes += m_pInputStream->GetLength() * (int64_t)(queueTime / state.timeMax);
+    state.cache_readahead_time = status.readaheadtime;
+    state.cache_consume_rate = status.consumerate;
+    state.cache_link_rate = status.linkrate;
   }
   else
+  {
     state.cache_bytes = 0;
+    state.cache_readahead_time = 0.0;
+    state.cache_consume_rate = 0;
+    state.cache_link_rate = 0;
+  }
 
   state.timestamp = m_clock.GetAbsoluteClock();
 
@@ -99,6 +99,9 @@ struct SPlayerState
     cache_bytes = 0;
     cache_level = 0.0;
     cache_offset = 0.0;
+    cache_readahead_time = 0.0;
+    cache_consume_rate = 0;
+    cache_link_rate = 0;
     lastSeek = 0;
     streamsReady = false;
   }
@@ -130,6 +133,9 @@ struct SPlayerState
   double cache_level; // current cache level
   double cache_offset; // percentage of file ahead of current position
   double cache_time; // estimated playback time of current cached bytes
+  double cache_readahead_time; // adaptive read-ahead target in seconds of media
+  uint32_t cache_consume_rate; // measured consumption rate in bytes/second
+  uint32_t cache_link_rate; // measured throughput of the source in bytes/second
 };
 
 class CDVDInputStream;
@@ -289,6 +295,7 @@ struct CacheInfo
 
 class CProcessInfo;
 class CJobQueue;
+class CVideoPlayerPreOpen;
 
 class CVideoPlayer : public IPlayer, public CThread, public IVideoPlayer,
                      public IDispResource, public IRenderLoop, public IRenderMsg
@@ -298,6 +305,7 @@ public:
   ~CVideoPlayer() override;
   bool OpenFile(const CFileItem& file, const CPlayerOptions &options) override;
   bool CloseFile(bool reopen = false) override;
+  void PrepareFiles(const std::vector<std::shared_ptr<CFileItem>>& files) override;
   bool IsPlaying() const override;
   void Pause() override;
   bool HasVideo() const override;
@@ -597,6 +605,16 @@ protected:
   std::unordered_map<int64_t, std::shared_ptr<CDVDDemux>> m_subtitleDemuxerMap;
   std::unique_ptr<CDVDDemuxCC> m_pCCDemuxer;
 
+  // input streams and demuxers opened in advance for files likely to be played next
+  std::unique_ptr<CVideoPlayerPreOpen> m_preOpen;
+  std::unique_ptr<CDVDDemux> m_pPreOpenedDemuxer;
+
+  // measurement of the time needed to start playback and to switch channels
+  std::chrono::steady_clock::time_point m_openStartTime;
+  std::chrono::milliseconds m_zapOpenDuration{0};
+  bool m_zapMeasuring = false;
+  bool m_zapPreOpened = false;
+
   CRenderManager m_renderManager;
 
   struct SDVDInfo
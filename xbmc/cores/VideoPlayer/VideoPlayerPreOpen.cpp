@@ -0,0 +1,255 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoPlayerPreOpen.h"
+
+#include "DVDDemuxers/DVDDemux.h"
+#include "DVDDemuxers/DVDFactoryDemuxer.h"
+#include "DVDInputStreams/DVDFactoryInputStream.h"
+#include "DVDInputStreams/DVDInputStream.h"
+#include "FileItem.h"
+#include "URL.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <mutex>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+// prepared live streams are not read and fall behind, release them after this time
+constexpr auto PREPARED_FILE_TIMEOUT = 15s;
+
+bool IsSameFile(const CFileItem& item1, const CFileItem& item2)
+{
+  return item1.GetPath() == item2.GetPath() && item1.GetDynPath() == item2.GetDynPath();
+}
+} // unnamed namespace
+
+CVideoPlayerPreOpen::CVideoPlayerPreOpen(IVideoPlayer* player)
+  : CThread("VideoPlayerPreOpen"), m_player(player)
+{
+}
+
+CVideoPlayerPreOpen::~CVideoPlayerPreOpen()
+{
+  Clear();
+  StopThread(false);
+  m_event.Set();
+  StopThread(true);
+}
+
+void CVideoPlayerPreOpen::Prepare(const std::vector<std::shared_ptr<CFileItem>>& items)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  const auto released =
+      std::stable_partition(m_files.begin(), m_files.end(), [&items](const PreparedFile& file) {
+        return std::any_of(items.cbegin(), items.cend(),
+                           [&file](const auto& item) { return IsSameFile(*item, *file.item); });
+      });
+  Release(released, m_files.end());
+
+  for (const auto& item : items)
+  {
+    if (std::none_of(m_files.cbegin(), m_files.cend(),
+                     [&item](const PreparedFile& file) { return IsSameFile(*item, *file.item); }))
+    {
+      PreparedFile file;
+      file.item = std::make_shared<CFileItem>(*item);
+      m_files.emplace_back(std::move(file));
+    }
+  }
+
+  if (!IsRunning())
+    Create();
+
+  m_event.Set();
+}
+
+bool CVideoPlayerPreOpen::Take(const CFileItem& item,
+                               std::shared_ptr<CDVDInputStream>& inputStream,
+                               std::unique_ptr<CDVDDemux>& demuxer)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  const auto isItem = [&item](const PreparedFile& file) { return IsSameFile(item, *file.item); };
+
+  // a file being opened right now will be ready sooner than when opening it again
+  auto it = std::find_if(m_files.begin(), m_files.end(), isItem);
+  while (it != m_files.end() && !it->done && it->item == m_openingItem)
+  {
+    lock.unlock();
+    m_preparedEvent.Wait(100ms);
+    lock.lock();
+    it = std::find_if(m_files.begin(), m_files.end(), isItem);
+  }
+
+  bool found = false;
+  if (it != m_files.end() && it->demuxer)
+  {
+    inputStream = std::move(it->inputStream);
+    demuxer = std::move(it->demuxer);
+    m_files.erase(it);
+    found = true;
+  }
+
+  Release(m_files.begin(), m_files.end());
+
+  // the player opens the file next, close the released files first so that the number of open
+  // streams does not exceed the limit of the source. This includes files the worker closes or
+  // opens right now, opening them has been aborted by Release().
+  std::vector<PreparedFile> releasedFiles;
+  releasedFiles.swap(m_releasedFiles);
+  while (m_openingItem || m_closingFiles)
+  {
+    lock.unlock();
+    m_preparedEvent.Wait(100ms);
+    lock.lock();
+  }
+  lock.unlock();
+
+  CloseFiles(releasedFiles);
+  return found;
+}
+
+void CVideoPlayerPreOpen::Clear()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  Release(m_files.begin(), m_files.end());
+}
+
+void CVideoPlayerPreOpen::Release(std::vector<PreparedFile>::iterator first,
+                                  std::vector<PreparedFile>::iterator last)
+{
+  if (first == last)
+    return;
+
+  if (m_openingStream && std::any_of(first, last, [this](const PreparedFile& file) {
+        return file.item == m_openingItem;
+      }))
+    m_openingStream->Abort();
+
+  // closing streams might block, leave that to the worker thread
+  m_releasedFiles.insert(m_releasedFiles.end(), std::make_move_iterator(first),
+                         std::make_move_iterator(last));
+  m_files.erase(first, last);
+  m_event.Set();
+}
+
+void CVideoPlayerPreOpen::CloseFiles(std::vector<PreparedFile>& files)
+{
+  // close the demuxers before their input streams
+  for (auto& file : files)
+    file.demuxer.reset();
+  files.clear();
+}
+
+void CVideoPlayerPreOpen::Process()
+{
+  while (!m_bStop)
+  {
+    std::vector<PreparedFile> releasedFiles;
+    std::shared_ptr<CFileItem> item;
+    {
+      std::unique_lock<CCriticalSection> lock(m_critSection);
+
+      const auto now = std::chrono::steady_clock::now();
+      const auto expired =
+          std::stable_partition(m_files.begin(), m_files.end(), [&now](const PreparedFile& file) {
+            return !file.done || now - file.preparedTime < PREPARED_FILE_TIMEOUT;
+          });
+      Release(expired, m_files.end());
+      releasedFiles.swap(m_releasedFiles);
+      m_closingFiles = !releasedFiles.empty();
+
+      const auto it = std::find_if(m_files.cbegin(), m_files.cend(),
+                                   [](const PreparedFile& file) { return !file.done; });
+      if (it != m_files.cend())
+        item = it->item;
+
+      m_openingItem = item;
+    }
+
+    if (m_closingFiles)
+    {
+      CloseFiles(releasedFiles);
+      {
+        std::unique_lock<CCriticalSection> lock(m_critSection);
+        m_closingFiles = false;
+      }
+      m_preparedEvent.Set();
+    }
+
+    if (!item)
+    {
+      m_event.Wait(1s);
+      continue;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::shared_ptr<CDVDInputStream> inputStream =
+        CDVDFactoryInputStream::CreateInputStream(m_player, *item, true);
+    {
+      std::unique_lock<CCriticalSection> lock(m_critSection);
+      if (std::none_of(m_files.cbegin(), m_files.cend(),
+                       [&item](const PreparedFile& file) { return file.item == item; }))
+        inputStream.reset();
+
+      m_openingStream = inputStream;
+    }
+
+    std::unique_ptr<CDVDDemux> demuxer;
+    if (inputStream && inputStream->Open())
+      demuxer.reset(CDVDFactoryDemuxer::CreateDemuxer(inputStream));
+
+    const auto duration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+                                                              start);
+    if (demuxer)
+      CLog::Log(LOGDEBUG, "CVideoPlayerPreOpen - opened [{}] in {} ms",
+                CURL::GetRedacted(item->GetPath()), duration.count());
+    else
+      CLog::Log(LOGDEBUG, "CVideoPlayerPreOpen - unable to open [{}]",
+                CURL::GetRedacted(item->GetPath()));
+
+    {
+      std::unique_lock<CCriticalSection> lock(m_critSection);
+      m_openingStream.reset();
+
+      // the file might have been released meanwhile
+      const auto it = std::find_if(m_files.begin(), m_files.end(),
+                                   [&item](const PreparedFile& file) { return file.item == item; });
+      if (it != m_files.end())
+      {
+        it->done = true;
+        it->preparedTime = std::chrono::steady_clock::now();
+        if (demuxer)
+        {
+          it->inputStream = std::move(inputStream);
+          it->demuxer = std::move(demuxer);
+        }
+      }
+    }
+
+    // a released file is closed before it stops counting as being opened, see Take()
+    demuxer.reset();
+    inputStream.reset();
+    {
+      std::unique_lock<CCriticalSection> lock(m_critSection);
+      m_openingItem.reset();
+    }
+    m_preparedEvent.Set();
+  }
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  Release(m_files.begin(), m_files.end());
+  CloseFiles(m_releasedFiles);
+}
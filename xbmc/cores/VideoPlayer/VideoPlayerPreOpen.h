@@ -0,0 +1,89 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+class CDVDDemux;
+class CDVDInputStream;
+class CFileItem;
+class IVideoPlayer;
+
+/*!
+ \brief Opens the input stream and the demuxer of files likely to be played next in the background.
+
+ Opening the input stream and probing the demuxer takes most of the time needed to start playing a
+ (live) stream. Files prepared by this class are handed over to the player fully opened, so the
+ player only has to start its stream players.
+
+ Prepared streams are not read until they are taken. As live streams fall behind while they are
+ not read, prepared files are released after a short time.
+ */
+class CVideoPlayerPreOpen : private CThread
+{
+public:
+  explicit CVideoPlayerPreOpen(IVideoPlayer* player);
+  ~CVideoPlayerPreOpen() override;
+
+  /*!
+   \brief Prepare the given files. Files prepared before which are not in the list are released.
+   */
+  void Prepare(const std::vector<std::shared_ptr<CFileItem>>& items);
+
+  /*!
+   \brief Take the input stream and demuxer prepared for a file. All other files are released and
+   closed before returning, so that the number of open streams does not grow when the player opens
+   the file.
+   \param item The file to play.
+   \param inputStream Set to the opened input stream of the file.
+   \param demuxer Set to the demuxer of the file.
+   \return true if the file was prepared, false otherwise.
+   */
+  bool Take(const CFileItem& item,
+            std::shared_ptr<CDVDInputStream>& inputStream,
+            std::unique_ptr<CDVDDemux>& demuxer);
+
+  /*!
+   \brief Release all prepared files.
+   */
+  void Clear();
+
+protected:
+  // CThread implementation
+  void Process() override;
+
+private:
+  struct PreparedFile
+  {
+    std::shared_ptr<CFileItem> item;
+    std::shared_ptr<CDVDInputStream> inputStream;
+    std::unique_ptr<CDVDDemux> demuxer;
+    std::chrono::steady_clock::time_point preparedTime;
+    bool done = false;
+  };
+
+  void Release(std::vector<PreparedFile>::iterator first, std::vector<PreparedFile>::iterator last);
+  static void CloseFiles(std::vector<PreparedFile>& files);
+
+  IVideoPlayer* m_player;
+  CCriticalSection m_critSection;
+  CEvent m_event;
+  CEvent m_preparedEvent;
+  std::vector<PreparedFile> m_files;
+  std::vector<PreparedFile> m_releasedFiles;
+  std::shared_ptr<CFileItem> m_openingItem;
+  std::shared_ptr<CDVDInputStream> m_openingStream;
+  bool m_closingFiles = false;
+};
@@ -957,6 +957,13 @@ std::string CVideoPlayerVideo::GetPlayerInfo()
   s << "vq:"   << std::setw(2) << std::min(99, m_processInfo.GetLevelVQ()) << "%";
   s << ", Mb/s:" << std::fixed << std::setprecision(2) << (double)GetVideoBitrate() / (1024.0*1024.0);
   s << ", dc:"   << m_processInfo.GetVideoDecoderName().c_str();
+  std::string threading = m_processInfo.GetVideoDecoderThreading();
+  if (!threading.empty())
+  {
+    int queued, lag;
+    m_processInfo.GetVideoDecoderQueue(queued, lag);
+    s << "(" << threading << "), dq:" << queued << "/" << lag << "ms";
+  }
   s << ", " << width << "x" << height << "[" << std::setprecision(2) << m_processInfo.GetVideoDAR() << "]@" << std::fixed << std::setprecision(3) << m_processInfo.GetVideoFps() << ", deint:" << m_processInfo.GetVideoDeintMethod();
   s << ", drop:" << m_iDroppedFrames;
   s << ", skip:" << m_renderManager.GetSkippedFrames();
@@ -445,3 +445,9 @@ CCacheStrategy *CDoubleCache::CreateNew()
   return new CDoubleCache(m_pCache->CreateNew());
 }
 
+void CDoubleCache::SetBackBufferSize(size_t size)
+{
+  m_pCache->SetBackBufferSize(size);
+  if (m_pCacheOld)
+    m_pCacheOld->SetBackBufferSize(size);
+}
@@ -55,6 +55,12 @@ public:
 
   virtual CCacheStrategy *CreateNew() = 0;
 
+  /*!
+   \brief Set the amount of already read data which is kept for seeking backwards
+   \param size size of the back buffer in bytes, limited by the size of the cache
+   */
+  virtual void SetBackBufferSize(size_t size) {}
+
   CEvent m_space;
 protected:
   bool  m_bEndOfInput = false;
@@ -124,6 +130,8 @@ public:
 
   CCacheStrategy *CreateNew() override;
 
+  void SetBackBufferSize(size_t size) override;
+
 protected:
   CCacheStrategy *m_pCache;
   CCacheStrategy *m_pCacheOld;
@@ -277,3 +277,11 @@ CCacheStrategy *CCircularCache::CreateNew()
   return new CCircularCache(m_size - m_size_back, m_size_back);
 }
 
+void CCircularCache::SetBackBufferSize(size_t size)
+{
+  std::unique_lock<CCriticalSection> lock(m_sync);
+  m_size_back = std::min(size, m_size);
+
+  // a smaller back buffer may leave more room to write
+  m_space.Set();
+}
@@ -488,6 +488,10 @@ void CCurlFile::SetCommonOptions(CReadState* state, bool failOnError /* = true *
   g_curlInterface.easy_setopt(h, CURLOPT_READDATA, state);
   g_curlInterface.easy_setopt(h, CURLOPT_READFUNCTION, read_callback);
 
+  // share resolved host names and TLS sessions with all other sessions
+  if (g_curlInterface.GetShare())
+    g_curlInterface.easy_setopt(h, CURLOPT_SHARE, g_curlInterface.GetShare());
+
   // use DNS cache
   g_curlInterface.easy_setopt(h, CURLOPT_RESOLVE, m_dnsCacheList);
 
@@ -11,9 +11,21 @@
 #include "threads/SystemClock.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <assert.h>
 #include <mutex>
 
+namespace
+{
+/* maximum number of sessions busy with the same host, further requests wait for one to be
+ * released so e.g. scanning a library doesn't open dozens of connections to a scraper site */
+constexpr size_t MAX_BUSY_SESSIONS_PER_HOST = 8;
+/* maximum time to wait for a session to the same host before exceeding the limit */
+constexpr std::chrono::seconds HOST_WAIT_TIMEOUT{5};
+/* minimum time between two logs of the connection reuse counters */
+constexpr std::chrono::minutes STATS_LOG_INTERVAL{5};
+} // namespace
+
 namespace XCURL
 {
 CURLcode DllLibCurl::global_init(long flags)
@@ -112,6 +124,16 @@ const char* DllLibCurl::easy_strerror(CURLcode code)
   return curl_easy_strerror(code);
 }
 
+CURLSH* DllLibCurl::share_init()
+{
+  return curl_share_init();
+}
+
+CURLSHcode DllLibCurl::share_cleanup(CURLSH* share)
+{
+  return curl_share_cleanup(share);
+}
+
 DllLibCurlGlobal::DllLibCurlGlobal()
 {
   /* we handle this ourself */
@@ -119,6 +141,17 @@ DllLibCurlGlobal::DllLibCurlGlobal()
   {
     CLog::Log(LOGERROR, "Error initializing libcurl");
   }
+
+  /* share resolved host names and TLS sessions between all sessions */
+  m_share = share_init();
+  if (m_share)
+  {
+    share_setopt(m_share, CURLSHOPT_LOCKFUNC, LockShare);
+    share_setopt(m_share, CURLSHOPT_UNLOCKFUNC, UnlockShare);
+    share_setopt(m_share, CURLSHOPT_USERDATA, this);
+    share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+  }
 }
 
 DllLibCurlGlobal::~DllLibCurlGlobal()
@@ -132,10 +165,40 @@ DllLibCurlGlobal::~DllLibCurlGlobal()
     if (session.m_multi)
       multi_cleanup(session.m_multi);
   }
+  if (m_share)
+    share_cleanup(m_share);
   // close libcurl
   curl_global_cleanup();
 }
 
+void DllLibCurlGlobal::LockShare(CURL_HANDLE* handle,
+                                 curl_lock_data data,
+                                 curl_lock_access access,
+                                 void* userptr)
+{
+  auto* curl = static_cast<DllLibCurlGlobal*>(userptr);
+  if (data >= 0 && data < CURL_LOCK_DATA_LAST)
+    curl->m_shareLocks[data].lock();
+}
+
+void DllLibCurlGlobal::UnlockShare(CURL_HANDLE* handle, curl_lock_data data, void* userptr)
+{
+  auto* curl = static_cast<DllLibCurlGlobal*>(userptr);
+  if (data >= 0 && data < CURL_LOCK_DATA_LAST)
+    curl->m_shareLocks[data].unlock();
+}
+
+DllLibCurlGlobal::SStats DllLibCurlGlobal::GetStats()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  SStats stats = m_stats;
+  stats.sessions = m_sessions.size();
+  stats.busySessions = std::count_if(m_sessions.begin(), m_sessions.end(),
+                                     [](const SSession& session) { return session.m_busy; });
+  return stats;
+}
+
 void DllLibCurlGlobal::CheckIdle()
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
@@ -166,6 +229,19 @@ void DllLibCurlGlobal::CheckIdle()
     }
     ++it;
   }
+
+  /* log the connection reuse counters from time to time if there were new requests */
+  const auto now = std::chrono::steady_clock::now();
+  if (m_stats.requests != m_loggedRequests && now - m_statsLogged >= STATS_LOG_INTERVAL)
+  {
+    CLog::Log(LOGDEBUG,
+              "{} - {} requests, {} reused a connection, {} over HTTP/2, {} waited for a session "
+              "to the same host, {} open sessions",
+              __FUNCTION__, m_stats.requests, m_stats.reusedConnections, m_stats.http2Requests,
+              m_stats.hostWaits, m_sessions.size());
+    m_loggedRequests = m_stats.requests;
+    m_statsLogged = now;
+  }
 }
 
 void DllLibCurlGlobal::easy_acquire(const char* protocol,
@@ -177,34 +253,56 @@ void DllLibCurlGlobal::easy_acquire(const char* protocol,
 
   std::unique_lock<CCriticalSection> lock(m_critSection);
 
+  const auto isSameHost = [protocol, hostname](const SSession& session)
+  { return session.m_protocol.compare(protocol) == 0 && session.m_hostname.compare(hostname) == 0; };
+
+  /* limit the number of concurrent requests to the same host */
+  const auto hasFreeSession = [this, &isSameHost]()
+  {
+    return static_cast<size_t>(std::count_if(m_sessions.begin(), m_sessions.end(),
+                                             [&isSameHost](const SSession& session) {
+                                               return session.m_busy && isSameHost(session);
+                                             })) < MAX_BUSY_SESSIONS_PER_HOST;
+  };
+  if (!hasFreeSession())
+  {
+    m_stats.hostWaits++;
+    if (!m_sessionReleased.wait(lock, HOST_WAIT_TIMEOUT, hasFreeSession))
+      CLog::Log(LOGDEBUG, "{} - Exceeding the limit of {} sessions to {}://{}", __FUNCTION__,
+                MAX_BUSY_SESSIONS_PER_HOST, protocol, hostname);
+  }
+
+  /* allow reuse of requester is trying to connect to same host */
+  /* curl will take care of any differences in username/password */
+  /* prefer the most recently released session whose connection is most likely still open */
+  SSession* idleSession = nullptr;
   for (auto& it : m_sessions)
   {
-    if (!it.m_busy)
-    {
-      /* allow reuse of requester is trying to connect to same host */
-      /* curl will take care of any differences in username/password */
-      if (it.m_protocol.compare(protocol) == 0 && it.m_hostname.compare(hostname) == 0)
-      {
-        it.m_busy = true;
-        if (easy_handle)
-        {
-          if (!it.m_easy)
-            it.m_easy = easy_init();
+    if (!it.m_busy && isSameHost(it) &&
+        (idleSession == nullptr || it.m_idletimestamp > idleSession->m_idletimestamp))
+      idleSession = &it;
+  }
 
-          *easy_handle = it.m_easy;
-        }
+  if (idleSession)
+  {
+    idleSession->m_busy = true;
+    if (easy_handle)
+    {
+      if (!idleSession->m_easy)
+        idleSession->m_easy = easy_init();
 
-        if (multi_handle)
-        {
-          if (!it.m_multi)
-            it.m_multi = multi_init();
+      *easy_handle = idleSession->m_easy;
+    }
 
-          *multi_handle = it.m_multi;
-        }
+    if (multi_handle)
+    {
+      if (!idleSession->m_multi)
+        idleSession->m_multi = multi_init();
 
-        return;
-      }
+      *multi_handle = idleSession->m_multi;
     }
+
+    return;
   }
 
   SSession session = {};
@@ -252,11 +350,29 @@ void DllLibCurlGlobal::easy_release(CURL_HANDLE** easy_handle, CURLM** multi_han
   {
     if (it.m_easy == easy && (multi == nullptr || it.m_multi == multi))
     {
+      /* count the connections reused by the last request of the session */
+      long responseCode = 0;
+      if (easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &responseCode) == CURLE_OK &&
+          responseCode > 0)
+      {
+        m_stats.requests++;
+
+        long connects = 0;
+        if (easy_getinfo(easy, CURLINFO_NUM_CONNECTS, &connects) == CURLE_OK && connects == 0)
+          m_stats.reusedConnections++;
+
+        long httpVersion = 0;
+        if (easy_getinfo(easy, CURLINFO_HTTP_VERSION, &httpVersion) == CURLE_OK &&
+            httpVersion >= CURL_HTTP_VERSION_2_0)
+          m_stats.http2Requests++;
+      }
+
       /* reset session so next caller doesn't reuse options, only connections */
       /* will reset verbose too so it won't print that it closed connections on cleanup*/
       easy_reset(easy);
       it.m_busy = false;
       it.m_idletimestamp = std::chrono::steady_clock::now();
+      m_sessionReleased.notifyAll();
       return;
     }
   }
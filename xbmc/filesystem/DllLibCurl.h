@@ -8,8 +8,12 @@
 
 #pragma once
 
+#include "threads/Condition.h"
 #include "threads/CriticalSection.h"
 
+#include <array>
+#include <chrono>
+#include <stdint.h>
 #include <stdio.h>
 #include <string>
 #include <sys/time.h>
@@ -62,6 +66,13 @@ public:
   curl_slist* slist_append(curl_slist* list, const char* to_append);
   void slist_free_all(curl_slist* list);
   const char* easy_strerror(CURLcode code);
+  CURLSH* share_init();
+  template<typename... Args>
+  CURLSHcode share_setopt(CURLSH* share, CURLSHoption option, Args... args)
+  {
+    return curl_share_setopt(share, option, std::forward<Args>(args)...);
+  }
+  CURLSHcode share_cleanup(CURLSH* share);
 };
 
 class DllLibCurlGlobal : public DllLibCurl
@@ -82,6 +93,28 @@ public:
   CURL_HANDLE* easy_duphandle(CURL_HANDLE* easy_handle) override;
   void CheckIdle();
 
+  /*! \brief Share object used by all sessions to share resolved host names and TLS sessions.
+   Connections can't be shared as libcurl doesn't support sharing them between threads, they are
+   reused by reacquiring an idle session to the same host instead.
+   */
+  CURLSH* GetShare() const { return m_share; }
+
+  /* structure holding the connection reuse counters */
+  struct SStats
+  {
+    uint64_t requests = 0; // number of requests performed by released sessions
+    uint64_t reusedConnections = 0; // number of requests which reused an open connection
+    uint64_t http2Requests = 0; // number of requests performed over HTTP/2
+    uint64_t hostWaits = 0; // number of acquires which had to wait for a session to the same host
+    size_t sessions = 0;
+    size_t busySessions = 0;
+  };
+
+  /*! \brief Get the connection reuse counters, they are also logged by CheckIdle() every few
+   minutes while there are requests
+   */
+  SStats GetStats();
+
   /* overloaded load and unload with reference counter */
 
   /* structure holding a session info */
@@ -100,6 +133,18 @@ public:
 
   VEC_CURLSESSIONS m_sessions;
   CCriticalSection m_critSection;
+
+private:
+  static void LockShare(CURL_HANDLE* handle, curl_lock_data data, curl_lock_access access, void* userptr);
+  static void UnlockShare(CURL_HANDLE* handle, curl_lock_data data, void* userptr);
+
+  CURLSH* m_share = nullptr;
+  std::array<CCriticalSection, CURL_LOCK_DATA_LAST> m_shareLocks;
+
+  XbmcThreads::ConditionVariable m_sessionReleased;
+  SStats m_stats;
+  std::chrono::time_point<std::chrono::steady_clock> m_statsLogged;
+  uint64_t m_loggedRequests = 0;
 };
 } // namespace XCURL
 
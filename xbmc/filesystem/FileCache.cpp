@@ -142,7 +142,7 @@ bool CFileCache::Open(const CURL& url)
       // Use cache on disk
       m_pCache = std::make_unique<CSimpleFileCache>();
       m_forwardCacheSize = 0;
-      m_maxForward = m_fileSize;
+      m_maxForward = m_fileSize.load();
     }
     else
     {
@@ -186,6 +186,9 @@ bool CFileCache::Open(const CURL& url)
       m_pCache = std::make_unique<CCircularCache>(front, back);
       m_forwardCacheSize = front;
       m_maxForward = m_forwardCacheSize;
+
+      // the split between read-ahead and back buffer adapts to the media and the source
+      m_readAhead = std::make_unique<CReadAheadController>(cacheSize, m_chunkSize * 2);
     }
 
     if (m_flags & READ_MULTI_STREAM)
@@ -208,6 +211,7 @@ bool CFileCache::Open(const CURL& url)
   m_writeRate = 1024 * 1024;
   m_writeRateActual = 0;
   m_writeRateLowSpeed = 0;
+  m_rateHint = 0;
   m_bFilling = true;
   m_seekEvent.Reset();
   m_seekEnded.Reset();
@@ -288,11 +292,25 @@ void CFileCache::Process()
           m_bFilling = true;
           m_writeRateLowSpeed = 0;
         }
+        UpdateReadAhead(true);
       }
 
       m_seekEnded.Set();
     }
 
+    UpdateReadAhead(false);
+
+    // stop filling once the read-ahead target has been reached
+    if (m_readAhead && m_writePos - m_readPos >= m_maxForward)
+    {
+      if (m_seekEvent.Wait(m_processWait))
+      {
+        if (!m_bStop)
+          m_seekEvent.Set();
+      }
+      continue;
+    }
+
     // variable read factor based on cache level
     if (useAdaptativeReadFactor)
     {
@@ -338,7 +356,14 @@ void CFileCache::Process()
 
     ssize_t iRead = 0;
     if (maxSourceRead > 0)
+    {
+      const auto start = std::chrono::steady_clock::now();
       iRead = m_source.Read(buffer.get(), maxSourceRead);
+      const auto end = std::chrono::steady_clock::now();
+      if (m_readAhead && iRead > 0)
+        m_readAhead->OnSourceRead(
+            iRead, std::chrono::duration_cast<std::chrono::microseconds>(end - start), end);
+    }
     if (iRead <= 0)
     {
       // Check for actual EOF and retry as long as we still have data in our cache
@@ -433,7 +458,7 @@ void CFileCache::Process()
     if (m_bFilling && m_forwardCacheSize != 0)
     {
       const int64_t forward = m_pCache->WaitForData(0, 0ms);
-      if (forward + m_chunkSize >= m_forwardCacheSize)
+      if (forward + m_chunkSize >= (m_readAhead ? m_maxForward.load() : m_forwardCacheSize))
       {
         if (m_writeRateActual < m_writeRate)
           m_writeRateLowSpeed = m_writeRateActual;
@@ -444,6 +469,28 @@ void CFileCache::Process()
   }
 }
 
+void CFileCache::UpdateReadAhead(bool reset)
+{
+  if (!m_readAhead)
+    return;
+
+  const auto now = std::chrono::steady_clock::now();
+  if (reset)
+    m_readAhead->Reset(m_readPos, now);
+  else
+    m_readAhead->OnConsumed(m_readPos, now);
+
+  m_readAhead->SetRateHint(m_rateHint);
+  const CReadAheadController::State& state = m_readAhead->Update();
+
+  if (state.backBuffer != m_readAheadState.backBuffer)
+    m_pCache->SetBackBufferSize(state.backBuffer);
+  m_maxForward = state.readAhead;
+
+  std::unique_lock<CCriticalSection> lock(m_readAheadSync);
+  m_readAheadState = state;
+}
+
 void CFileCache::OnExit()
 {
   m_bStop = true;
@@ -623,12 +670,19 @@ int CFileCache::IoControl(EIoControl request, void* param)
     status->currate = m_writeRateActual;
     status->lowrate = m_writeRateLowSpeed;
     m_writeRateLowSpeed = 0; // Reset low speed condition
+
+    std::unique_lock<CCriticalSection> lock(m_readAheadSync);
+    status->readaheadtime = m_readAheadState.readAheadTime;
+    status->consumerate = m_readAheadState.consumptionRate;
+    status->linkrate = m_readAheadState.linkRate;
+    status->maxback = m_readAheadState.backBuffer;
     return 0;
   }
 
   if (request == IOCTRL_CACHE_SETRATE)
   {
     m_writeRate = *static_cast<uint32_t*>(param);
+    m_rateHint = m_writeRate;
 
     const double mBits = m_writeRate / 1024.0 / 1024.0 * 8.0; // Mbit/s
 
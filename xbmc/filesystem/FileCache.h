@@ -11,6 +11,7 @@
 #include "CacheStrategy.h"
 #include "File.h"
 #include "IFile.h"
+#include "ReadAheadController.h"
 #include "threads/CriticalSection.h"
 #include "threads/Thread.h"
 
@@ -58,6 +59,8 @@ namespace XFILE
     }
 
   private:
+    void UpdateReadAhead(bool reset);
+
     std::unique_ptr<CCacheStrategy> m_pCache;
     int m_seekPossible = 0;
     CFile m_source;
@@ -73,12 +76,16 @@ namespace XFILE
     uint32_t m_writeRateActual = 0;
     uint32_t m_writeRateLowSpeed = 0;
     int64_t m_forwardCacheSize = 0;
-    int64_t m_maxForward = 0;
+    std::atomic<int64_t> m_maxForward{0};
     bool m_bFilling = false;
     std::atomic<int64_t> m_fileSize;
     unsigned int m_flags;
     CCriticalSection m_sync;
     std::chrono::milliseconds m_processWait{100ms};
+    std::unique_ptr<CReadAheadController> m_readAhead;
+    std::atomic<uint32_t> m_rateHint{0};
+    mutable CCriticalSection m_readAheadSync;
+    CReadAheadController::State m_readAheadState;
   };
 
 }
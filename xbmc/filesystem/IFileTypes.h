@@ -56,6 +56,10 @@ struct SCacheStatus
   uint32_t maxrate; /**< maximum allowed read(fill) rate (bytes/second) */
   uint32_t currate; /**< average read rate (bytes/second) since last position change */
   uint32_t lowrate; /**< low speed read rate (bytes/second) (if any, else 0) */
+  double readaheadtime = 0.0; /**< adaptive read-ahead target in seconds of media (if any, else 0) */
+  uint32_t consumerate = 0; /**< measured consumption rate (bytes/second) */
+  uint32_t linkrate = 0; /**< measured throughput of the source (bytes/second) */
+  uint64_t maxback = 0; /**< back buffer size in bytes */
 };
 
 enum CACHE_BUFFER_MODES
@@ -0,0 +1,143 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ReadAheadController.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace XFILE;
+using namespace std::chrono_literals;
+
+namespace
+{
+// weight of a new sample in the moving averages
+constexpr double SMOOTHING = 0.25;
+// minimum time between two samples of the consumption rate
+constexpr auto CONSUMPTION_INTERVAL = 1s;
+// minimum reading time and maximum wall time of a sample of the throughput of the source
+constexpr auto LINK_SAMPLE_DURATION = 250ms;
+constexpr auto LINK_SAMPLE_WINDOW = 2s;
+// throughput of the source relative to the consumption rate below which buffering further ahead
+// starts to pay off
+constexpr double SAFE_HEADROOM = 2.0;
+
+double Average(double average, double sample)
+{
+  return average == 0.0 ? sample : average + SMOOTHING * (sample - average);
+}
+} // namespace
+
+CReadAheadController::CReadAheadController(uint64_t capacity, uint64_t minReadAhead)
+  : m_capacity(capacity), m_minReadAhead(std::min(minReadAhead, capacity))
+{
+  Update();
+}
+
+void CReadAheadController::Reset(int64_t position, Clock::time_point now)
+{
+  m_consumptionStarted = true;
+  m_consumedPosition = position;
+  m_consumedTime = now;
+}
+
+void CReadAheadController::OnConsumed(int64_t position, Clock::time_point now)
+{
+  if (!m_consumptionStarted)
+  {
+    Reset(position, now);
+    return;
+  }
+
+  const auto elapsed = now - m_consumedTime;
+  if (elapsed < CONSUMPTION_INTERVAL)
+    return;
+
+  const int64_t consumed = position - m_consumedPosition;
+  Reset(position, now);
+
+  // nothing consumed means paused or stalled, which doesn't change the rate of the media
+  if (consumed <= 0)
+    return;
+
+  const double seconds = std::chrono::duration<double>(elapsed).count();
+  m_consumptionRate = Average(m_consumptionRate, consumed / seconds);
+}
+
+void CReadAheadController::OnSourceRead(uint64_t bytes,
+                                        std::chrono::microseconds duration,
+                                        Clock::time_point now)
+{
+  if (m_windowBytes == 0 && m_windowDuration == 0us)
+    m_windowStart = now;
+
+  m_windowBytes += bytes;
+  m_windowDuration += duration;
+
+  // reads served from buffers of the source are too short to be measured on their own
+  if (m_windowDuration < LINK_SAMPLE_DURATION && now - m_windowStart < LINK_SAMPLE_WINDOW)
+    return;
+
+  if (m_windowDuration > 0us)
+  {
+    const double rate =
+        m_windowBytes / std::chrono::duration<double>(m_windowDuration).count();
+    m_linkDeviation =
+        m_linkRate == 0.0 ? 0.0 : Average(m_linkDeviation, std::abs(rate - m_linkRate));
+    m_linkRate = Average(m_linkRate, rate);
+  }
+
+  m_windowBytes = 0;
+  m_windowDuration = 0us;
+}
+
+const CReadAheadController::State& CReadAheadController::Update()
+{
+  const double consumptionRate = m_consumptionRate > 0.0 ? m_consumptionRate : m_rateHint;
+
+  m_state.consumptionRate = static_cast<uint32_t>(consumptionRate);
+  m_state.linkRate = static_cast<uint32_t>(m_linkRate);
+  m_state.linkVariation = m_linkRate > 0.0 ? m_linkDeviation / m_linkRate : 0.0;
+
+  // always keep some room for the back buffer
+  const uint64_t maxReadAhead = std::max(m_minReadAhead, m_capacity - m_capacity / 8);
+
+  if (consumptionRate <= 0.0)
+  {
+    // nothing known about the media, split the memory like a fixed size cache
+    m_state.readAheadTime = 0.0;
+    m_state.readAhead = std::max(m_minReadAhead, m_capacity - m_capacity / 4);
+    m_state.backBuffer = m_capacity - m_state.readAhead;
+    return m_state;
+  }
+
+  // the less headroom the source has and the more its throughput varies, the further ahead to read
+  double risk = 1.0;
+  if (m_linkRate > 0.0)
+  {
+    const double headroom = m_linkRate / consumptionRate;
+    const double shortfall =
+        std::clamp((SAFE_HEADROOM - headroom) / (SAFE_HEADROOM - 1.0), 0.0, 1.0);
+    risk = std::clamp(shortfall + m_state.linkVariation, 0.0, 1.0);
+  }
+
+  const double minTime = std::chrono::duration<double>(MIN_READ_AHEAD_TIME).count();
+  const double maxTime = std::chrono::duration<double>(MAX_READ_AHEAD_TIME).count();
+  m_state.readAheadTime = minTime + (maxTime - minTime) * risk;
+
+  m_state.readAhead = std::clamp(static_cast<uint64_t>(m_state.readAheadTime * consumptionRate),
+                                 m_minReadAhead, maxReadAhead);
+  m_state.readAheadTime = m_state.readAhead / consumptionRate;
+
+  const double backTime = std::chrono::duration<double>(BACK_BUFFER_TIME).count();
+  const uint64_t maxBackBuffer = m_capacity - m_state.readAhead;
+  m_state.backBuffer = std::clamp(static_cast<uint64_t>(backTime * consumptionRate),
+                                  std::min(m_capacity / 8, maxBackBuffer), maxBackBuffer);
+
+  return m_state;
+}
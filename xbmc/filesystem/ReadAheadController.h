@@ -0,0 +1,107 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <stdint.h>
+
+namespace XFILE
+{
+
+/*!
+ \brief Sizes the read-ahead and the back buffer of CFileCache.
+
+ The read-ahead is expressed as a number of seconds of media which is converted to bytes using the
+ measured consumption rate of the reader (or the rate hinted by the player before anything has been
+ consumed). The number of seconds grows from the minimum to the maximum target the closer the
+ throughput of the source gets to the consumption rate and the more it varies, so high bitrate
+ streams over flaky links are buffered further ahead while low bitrate streams over a fast link
+ don't read ahead minutes of data needlessly.
+
+ The back buffer keeps a number of seconds of already consumed media for small seeks backwards,
+ limited by the memory not needed for the read-ahead.
+
+ The controller isn't thread safe, all methods are expected to be called by the cache thread.
+ */
+class CReadAheadController
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct State
+  {
+    uint32_t consumptionRate = 0; ///< measured (or hinted) consumption rate in bytes/second
+    uint32_t linkRate = 0; ///< measured throughput of the source in bytes/second
+    double linkVariation = 0.0; ///< relative variation of the throughput of the source
+    double readAheadTime = 0.0; ///< read-ahead target in seconds of media, 0 if unknown
+    uint64_t readAhead = 0; ///< read-ahead target in bytes
+    uint64_t backBuffer = 0; ///< back buffer target in bytes
+  };
+
+  /*!
+   \param capacity Total size of the cache memory shared by read-ahead and back buffer
+   \param minReadAhead Minimum read-ahead in bytes (e.g. two read chunks)
+   */
+  CReadAheadController(uint64_t capacity, uint64_t minReadAhead);
+
+  /*!
+   \brief Sets the rate hinted by the player, used until a consumption rate has been measured
+   */
+  void SetRateHint(uint32_t rate) { m_rateHint = rate; }
+
+  /*!
+   \brief Restarts measuring the consumption rate after a seek
+   */
+  void Reset(int64_t position, Clock::time_point now);
+
+  /*!
+   \brief Reports the current read position of the reader
+   */
+  void OnConsumed(int64_t position, Clock::time_point now);
+
+  /*!
+   \brief Reports a read from the source
+   \param bytes Number of bytes read
+   \param duration Time spent reading
+   */
+  void OnSourceRead(uint64_t bytes, std::chrono::microseconds duration, Clock::time_point now);
+
+  /*!
+   \brief Recalculates the targets from the current measurements
+   */
+  const State& Update();
+
+  const State& GetState() const { return m_state; }
+
+  static constexpr std::chrono::seconds MIN_READ_AHEAD_TIME{10};
+  static constexpr std::chrono::seconds MAX_READ_AHEAD_TIME{120};
+  static constexpr std::chrono::seconds BACK_BUFFER_TIME{20};
+
+private:
+  const uint64_t m_capacity;
+  const uint64_t m_minReadAhead;
+  uint32_t m_rateHint = 0;
+
+  // consumption rate
+  bool m_consumptionStarted = false;
+  int64_t m_consumedPosition = 0;
+  Clock::time_point m_consumedTime;
+  double m_consumptionRate = 0.0;
+
+  // throughput of the source, sampled over windows of reading time
+  uint64_t m_windowBytes = 0;
+  std::chrono::microseconds m_windowDuration{0};
+  Clock::time_point m_windowStart;
+  double m_linkRate = 0.0;
+  double m_linkDeviation = 0.0;
+
+  State m_state;
+};
+
+} // namespace XFILE
@@ -0,0 +1,135 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/ReadAheadController.h"
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr uint64_t MB = 1024 * 1024;
+
+class TestReadAheadController : public testing::Test
+{
+protected:
+  // consumes the given rate for the given number of seconds
+  void Consume(CReadAheadController& controller, uint64_t rate, int seconds)
+  {
+    for (int i = 0; i < seconds; i++)
+    {
+      m_position += rate;
+      m_now += 1s;
+      controller.OnConsumed(m_position, m_now);
+    }
+  }
+
+  // reads from a source with the given throughput
+  void ReadSource(CReadAheadController& controller, uint64_t rate, int samples)
+  {
+    for (int i = 0; i < samples; i++)
+    {
+      m_now += 300ms;
+      controller.OnSourceRead(rate * 3 / 10, 300ms, m_now);
+    }
+  }
+
+  int64_t m_position = 0;
+  CReadAheadController::Clock::time_point m_now = CReadAheadController::Clock::now();
+};
+} // namespace
+
+TEST_F(TestReadAheadController, SplitsMemoryWithoutMeasurements)
+{
+  CReadAheadController controller(100 * MB, 2 * MB);
+  const auto& state = controller.Update();
+  EXPECT_EQ(0.0, state.readAheadTime);
+  EXPECT_EQ(75 * MB, state.readAhead);
+  EXPECT_EQ(25 * MB, state.backBuffer);
+}
+
+TEST_F(TestReadAheadController, UsesRateHintBeforeConsumption)
+{
+  CReadAheadController controller(160 * MB, 2 * MB);
+  controller.SetRateHint(MB);
+
+  // nothing is known about the source yet, read ahead as far as possible
+  const auto& state = controller.Update();
+  EXPECT_EQ(MB, state.consumptionRate);
+  EXPECT_DOUBLE_EQ(120.0, state.readAheadTime);
+  EXPECT_EQ(120 * MB, state.readAhead);
+  EXPECT_EQ(20 * MB, state.backBuffer);
+}
+
+TEST_F(TestReadAheadController, ReadsLessAheadOverFastLinks)
+{
+  CReadAheadController controller(100 * MB, 2 * MB);
+  controller.SetRateHint(4 * MB);
+  Consume(controller, MB, 5);
+  ReadSource(controller, 10 * MB, 10);
+
+  const auto& state = controller.Update();
+  EXPECT_EQ(MB, state.consumptionRate);
+  EXPECT_EQ(10 * MB, state.linkRate);
+  EXPECT_DOUBLE_EQ(10.0, state.readAheadTime);
+  EXPECT_EQ(10 * MB, state.readAhead);
+  EXPECT_EQ(20 * MB, state.backBuffer);
+}
+
+TEST_F(TestReadAheadController, ReadsFurtherAheadOverSlowOrUnstableLinks)
+{
+  CReadAheadController controller(1000 * MB, 2 * MB);
+  Consume(controller, MB, 5);
+
+  // the source is barely faster than the media
+  ReadSource(controller, MB * 12 / 10, 10);
+  const double slow = controller.Update().readAheadTime;
+  EXPECT_GT(slow, 90.0);
+  EXPECT_LE(slow, 120.0);
+
+  // the source is fast on average but varies a lot
+  CReadAheadController unstable(1000 * MB, 2 * MB);
+  Consume(unstable, MB, 5);
+  for (int i = 0; i < 10; i++)
+  {
+    ReadSource(unstable, 2 * MB, 1);
+    ReadSource(unstable, 10 * MB, 1);
+  }
+  const auto& state = unstable.Update();
+  EXPECT_GT(state.linkVariation, 0.3);
+  EXPECT_GT(state.readAheadTime, 40.0);
+}
+
+TEST_F(TestReadAheadController, PauseKeepsConsumptionRate)
+{
+  CReadAheadController controller(1000 * MB, 2 * MB);
+  Consume(controller, 2 * MB, 5);
+  EXPECT_EQ(2 * MB, controller.Update().consumptionRate);
+
+  Consume(controller, 0, 30);
+  EXPECT_EQ(2 * MB, controller.Update().consumptionRate);
+
+  // seeking doesn't count as consumption
+  m_position += 500 * MB;
+  controller.Reset(m_position, m_now);
+  Consume(controller, 2 * MB, 1);
+  EXPECT_EQ(2 * MB, controller.Update().consumptionRate);
+}
+
+TEST_F(TestReadAheadController, LimitedByMemory)
+{
+  CReadAheadController controller(16 * MB, 2 * MB);
+  controller.SetRateHint(10 * MB);
+
+  const auto& state = controller.Update();
+  EXPECT_EQ(14 * MB, state.readAhead);
+  EXPECT_EQ(2 * MB, state.backBuffer);
+  EXPECT_DOUBLE_EQ(1.4, state.readAheadTime);
+}
@@ -71,6 +71,11 @@ unsigned char *CDDSImage::GetData() const
   return m_data;
 }
 
+bool CDDSImage::HasAlpha() const
+{
+  return (m_desc.pixelFormat.flags & ddpf_alphapixels) != 0;
+}
+
 bool CDDSImage::ReadFile(const std::string &inputFile)
 {
   // open the file
@@ -100,6 +105,48 @@ bool CDDSImage::ReadFile(const std::string &inputFile)
   return true;
 }
 
+bool CDDSImage::Create(const std::string &outputFile,
+                       unsigned int width,
+                       unsigned int height,
+                       unsigned int pitch,
+                       const unsigned char *argb,
+                       bool hasAlpha)
+{
+  if (!argb || !width || !height || pitch < width * 4)
+    return false;
+
+  Allocate(width, height, XB_FMT_A8R8G8B8);
+  if (hasAlpha)
+    m_desc.pixelFormat.flags |= ddpf_alphapixels;
+
+  for (unsigned int y = 0; y < height; y++)
+    memcpy(m_data + y * width * 4, argb + y * pitch, width * 4);
+
+  return WriteFile(outputFile);
+}
+
+bool CDDSImage::WriteFile(const std::string &outputFile) const
+{
+  // open the file
+  CFile file;
+  if (!file.OpenForWrite(outputFile, true))
+    return false;
+
+  // write the header
+  if (file.Write("DDS ", 4) != 4 ||
+      file.Write(&m_desc, sizeof(m_desc)) != sizeof(m_desc) ||
+      file.Write(m_data, m_desc.linearSize) != static_cast<ssize_t>(m_desc.linearSize))
+  {
+    CLog::Log(LOGERROR, "{} - failed writing {}", __FUNCTION__, outputFile);
+    file.Close();
+    CFile::Delete(outputFile);
+    return false;
+  }
+
+  file.Close();
+  return true;
+}
+
 unsigned int CDDSImage::GetStorageRequirements(unsigned int width,
                                                unsigned int height,
                                                XB_FMT format)
@@ -25,9 +25,27 @@ public:
   XB_FMT GetFormat() const;
   unsigned int GetSize() const;
   unsigned char *GetData() const;
+  bool HasAlpha() const;
 
   bool ReadFile(const std::string &file);
 
+  /*! \brief Create a DDS image holding uncompressed ARGB pixels and write it to a file
+   \param outputFile the file to write.
+   \param width the width of the image.
+   \param height the height of the image.
+   \param pitch the number of bytes per row of the pixels.
+   \param argb the pixels of the image.
+   \param hasAlpha whether the image uses the alpha channel.
+   \return true on success, false otherwise.
+   */
+  bool Create(const std::string &outputFile,
+              unsigned int width,
+              unsigned int height,
+              unsigned int pitch,
+              const unsigned char *argb,
+              bool hasAlpha);
+  bool WriteFile(const std::string &file) const;
+
 private:
   void Allocate(unsigned int width, unsigned int height, XB_FMT format);
   static const char* GetFourCC(XB_FMT format);
@@ -114,6 +114,47 @@ static int64_t mem_file_seek(void *h, int64_t pos, int whence)
   return mbuf->pos;
 }
 
+// read the dimensions from the start of frame segment of a jpeg image
+static bool GetJpegDimensions(const uint8_t* buffer, size_t size, unsigned int& width, unsigned int& height)
+{
+  size_t pos = 2;
+  while (pos + 4 <= size)
+  {
+    if (buffer[pos] != 0xFF)
+      return false;
+
+    const uint8_t marker = buffer[pos + 1];
+    if (marker == 0xFF)
+    {
+      // fill byte
+      pos++;
+      continue;
+    }
+    if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8))
+    {
+      // markers without payload
+      pos += 2;
+      continue;
+    }
+    // start of scan, no frame header found
+    if (marker == 0xDA)
+      return false;
+
+    // SOF0 - SOF15, except DHT (C4), JPG (C8) and DAC (CC)
+    if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+    {
+      if (pos + 9 > size)
+        return false;
+      height = (buffer[pos + 5] << 8) | buffer[pos + 6];
+      width = (buffer[pos + 7] << 8) | buffer[pos + 8];
+      return width > 0 && height > 0;
+    }
+
+    pos += 2 + ((buffer[pos + 2] << 8) | buffer[pos + 3]);
+  }
+  return false;
+}
+
 CFFmpegImage::CFFmpegImage(const std::string& strMimeType) : m_strMimeType(strMimeType)
 {
   m_hasAlpha = false;
@@ -143,7 +184,7 @@ bool CFFmpegImage::LoadImageFromMemory(unsigned char* buffer, unsigned int bufSi
                                       unsigned int width, unsigned int height)
 {
 
-  if (!Initialize(buffer, bufSize))
+  if (!Initialize(buffer, bufSize, width, height))
   {
     //log
     return false;
@@ -155,7 +196,10 @@ bool CFFmpegImage::LoadImageFromMemory(unsigned char* buffer, unsigned int bufSi
   return !(m_pFrame == nullptr);
 }
 
-bool CFFmpegImage::Initialize(unsigned char* buffer, size_t bufSize)
+bool CFFmpegImage::Initialize(unsigned char* buffer,
+                              size_t bufSize,
+                              unsigned int maxWidth /* = 0 */,
+                              unsigned int maxHeight /* = 0 */)
 {
   int bufferSize = 4096;
   uint8_t* fbuffer = (uint8_t*)av_malloc(bufferSize + AV_INPUT_BUFFER_PADDING_SIZE);
@@ -262,6 +306,32 @@ bool CFFmpegImage::Initialize(unsigned char* buffer, size_t bufSize)
     return false;
   }
 
+  // let the decoder downscale by a power of two while decoding if the image is much larger than
+  // requested. This is considerably cheaper than decoding at full size and scaling afterwards.
+  unsigned int sourceWidth = codec_params->width;
+  unsigned int sourceHeight = codec_params->height;
+  if (maxWidth > 0 && maxHeight > 0 && codec && codec->max_lowres > 0 &&
+      ((sourceWidth > 0 && sourceHeight > 0) ||
+       (is_jpeg && GetJpegDimensions(buffer, bufSize, sourceWidth, sourceHeight))))
+  {
+    const float scale = std::min({maxWidth / static_cast<float>(sourceWidth),
+                                  maxHeight / static_cast<float>(sourceHeight), 1.0f});
+    const float fitWidth = sourceWidth * scale;
+    const float fitHeight = sourceHeight * scale;
+
+    int lowres = 0;
+    while (lowres < codec->max_lowres &&
+           (sourceWidth >> (lowres + 1)) >= fitWidth && (sourceHeight >> (lowres + 1)) >= fitHeight)
+      lowres++;
+
+    if (lowres > 0)
+    {
+      m_codec_ctx->lowres = lowres;
+      m_originalWidth = sourceWidth;
+      m_originalHeight = sourceHeight;
+    }
+  }
+
   if (avcodec_open2(m_codec_ctx, codec, NULL) < 0)
   {
     avformat_close_input(&m_fctx);
@@ -314,8 +384,12 @@ AVFrame* CFFmpegImage::ExtractFrame()
 
   m_height = frame->height;
   m_width = frame->width;
-  m_originalWidth = m_width;
-  m_originalHeight = m_height;
+  // when downscaled while decoding the original size is already known
+  if (m_codec_ctx->lowres == 0)
+  {
+    m_originalWidth = m_width;
+    m_originalHeight = m_height;
+  }
 
   const AVPixFmtDescriptor* pixDescriptor = av_pix_fmt_desc_get(static_cast<AVPixelFormat>(frame->format));
   if (pixDescriptor && ((pixDescriptor->flags & (AV_PIX_FMT_FLAG_ALPHA | AV_PIX_FMT_FLAG_PAL)) != 0))
@@ -489,8 +563,8 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
 
   // assumption quadratic maximums e.g. 2048x2048
   float ratio = m_width / (float)m_height;
-  unsigned int nHeight = m_originalHeight;
-  unsigned int nWidth = m_originalWidth;
+  unsigned int nHeight = frame->height;
+  unsigned int nWidth = frame->width;
   if (nHeight > height)
   {
     nHeight = height;
@@ -502,7 +576,7 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
     nHeight = (unsigned int)(nWidth / ratio + 0.5f);
   }
 
-  struct SwsContext* context = sws_getContext(m_originalWidth, m_originalHeight, pixFormat,
+  struct SwsContext* context = sws_getContext(frame->width, frame->height, pixFormat,
     nWidth, nHeight, AV_PIX_FMT_RGB32, SWS_BICUBIC, NULL, NULL, NULL);
 
   if (range == AVCOL_RANGE_JPEG)
@@ -515,7 +589,7 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
     sws_setColorspaceDetails(context, inv_table, srcRange, table, dstRange, brightness, contrast, saturation);
   }
 
-  sws_scale(context, frame->data, frame->linesize, 0, m_originalHeight,
+  sws_scale(context, frame->data, frame->linesize, 0, frame->height,
     pictureRGB->data, pictureRGB->linesize);
   sws_freeContext(context);
 
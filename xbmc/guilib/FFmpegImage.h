@@ -69,7 +69,18 @@ public:
                                   unsigned int &bufferoutSize) override;
   void ReleaseThumbnailBuffer() override;
 
-  bool Initialize(unsigned char* buffer, size_t bufSize);
+  /*!
+   \brief Open the image contained in the given buffer for decoding.
+   \param buffer the encoded image.
+   \param bufSize size of the encoded image in bytes.
+   \param maxWidth the maximum width the image is going to be displayed at, 0 if unknown.
+   \param maxHeight the maximum height the image is going to be displayed at, 0 if unknown.
+   Codecs supporting it downscale large images while decoding if a maximum size is given.
+   */
+  bool Initialize(unsigned char* buffer,
+                  size_t bufSize,
+                  unsigned int maxWidth = 0,
+                  unsigned int maxHeight = 0);
 
   std::shared_ptr<Frame> ReadFrame();
 
@@ -17,6 +17,7 @@
 #include "filesystem/XbtFile.h"
 #include "guilib/iimage.h"
 #include "guilib/imagefactory.h"
+#include "pictures/Picture.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 #if defined(TARGET_DARWIN_EMBEDDED)
@@ -33,6 +34,7 @@
 #include <cstring>
 #include <exception>
 #include <utility>
+#include <vector>
 
 /************************************************************************/
 /*                                                                      */
@@ -246,7 +248,32 @@ bool CTexture::LoadFromFileInternal(const std::string& texturePath,
     CDDSImage image;
     if (image.ReadFile(texturePath))
     {
-      Update(image.GetWidth(), image.GetHeight(), 0, image.GetFormat(), image.GetData(), false);
+      const unsigned int maxTextureSize = CServiceBroker::GetRenderSystem()->GetMaxTextureSize();
+      const unsigned int width = maxWidth ? std::min(maxWidth, maxTextureSize) : maxTextureSize;
+      const unsigned int height = maxHeight ? std::min(maxHeight, maxTextureSize) : maxTextureSize;
+
+      // pre-decoded images are scaled down like the ones decoded here, compressed textures are not
+      if (image.GetFormat() == XB_FMT_A8R8G8B8 &&
+          (image.GetWidth() > width || image.GetHeight() > height))
+      {
+        const float scale = std::min(static_cast<float>(width) / image.GetWidth(),
+                                     static_cast<float>(height) / image.GetHeight());
+        const unsigned int scaledWidth =
+            std::max(1u, static_cast<unsigned int>(image.GetWidth() * scale));
+        const unsigned int scaledHeight =
+            std::max(1u, static_cast<unsigned int>(image.GetHeight() * scale));
+        std::vector<uint8_t> pixels(scaledWidth * scaledHeight * 4);
+        if (!CPicture::ScaleImage(image.GetData(), image.GetWidth(), image.GetHeight(),
+                                  image.GetWidth() * 4, AV_PIX_FMT_BGRA, pixels.data(),
+                                  scaledWidth, scaledHeight, scaledWidth * 4, AV_PIX_FMT_BGRA))
+          return false;
+        Update(scaledWidth, scaledHeight, 0, XB_FMT_A8R8G8B8, pixels.data(), false);
+      }
+      else
+        Update(image.GetWidth(), image.GetHeight(), 0, image.GetFormat(), image.GetData(), false);
+
+      if (image.GetFormat() == XB_FMT_A8R8G8B8)
+        m_hasAlpha = image.HasAlpha();
       return true;
     }
     return false;
@@ -9,7 +9,9 @@
 #pragma once
 
 #include <memory>
+#include <stdint.h>
 #include <string>
+#include <vector>
 
 class CTexture;
 
@@ -31,6 +33,18 @@ public:
                                          const std::string& filePath,
                                          unsigned int preferredWidth,
                                          unsigned int preferredHeight) const = 0;
+  /*!
+   * @brief Get the encoded data of an image which is stored as it is, such as an embedded image.
+   * Generated images have no encoded data.
+   * @return true if the data was found, false otherwise.
+  */
+  virtual bool LoadEncoded(const std::string& specialType,
+                           const std::string& filePath,
+                           std::vector<uint8_t>& data,
+                           std::string& mimeType) const
+  {
+    return false;
+  }
   virtual ~ISpecialImageFileLoader() = default;
 };
 
@@ -46,3 +46,18 @@ std::unique_ptr<CTexture> CSpecialImageLoaderFactory::Load(const std::string& sp
   }
   return {};
 }
+
+bool CSpecialImageLoaderFactory::LoadEncoded(const std::string& specialType,
+                                             const std::string& filePath,
+                                             std::vector<uint8_t>& data,
+                                             std::string& mimeType) const
+{
+  if (specialType.empty())
+    return false;
+  for (auto& loader : m_specialImageLoaders)
+  {
+    if (loader->CanLoad(specialType) && loader->LoadEncoded(specialType, filePath, data, mimeType))
+      return true;
+  }
+  return false;
+}
@@ -28,6 +28,11 @@ public:
                                  unsigned int preferredWidth,
                                  unsigned int preferredHeight) const;
 
+  bool LoadEncoded(const std::string& specialType,
+                   const std::string& filePath,
+                   std::vector<uint8_t>& data,
+                   std::string& mimeType) const;
+
 private:
   std::array<std::unique_ptr<ISpecialImageFileLoader>, 6> m_specialImageLoaders{};
 };
@@ -14,11 +14,14 @@
 #include "playlists/PlayListTypes.h"
 #include "pvr/channels/PVRChannel.h"
 #include "threads/SingleLock.h"
+#include "utils/JSONVariantWriter.h"
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
 #include "video/VideoDatabase.h"
 
+#include <algorithm>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <stdio.h>
@@ -27,9 +30,145 @@
 
 using namespace ANNOUNCEMENT;
 
+namespace
+{
+// maximum number of announcements waiting to be delivered to an external transport
+constexpr size_t MAX_QUEUED_ANNOUNCEMENTS = 1000;
+
+// number of external transports which are delivered to at the same time
+constexpr unsigned int MAX_CONCURRENT_DELIVERIES = 2;
+
+// time library announcements are held back to coalesce identical ones
+constexpr std::chrono::milliseconds LIBRARY_BATCH_WINDOW{100};
+
+std::chrono::milliseconds GetBatchWindow(AnnouncementFlag flag)
+{
+  if (flag == VideoLibrary || flag == AudioLibrary)
+    return LIBRARY_BATCH_WINDOW;
+
+  return std::chrono::milliseconds::zero();
+}
+
+// Whether two announcements refer to the same library item. Items which are
+// not in the library are described by their tags so they are never the same.
+bool IsSameLibraryItem(const CFileItem& item, const CFileItem& other)
+{
+  if (item.GetPath() != other.GetPath())
+    return false;
+
+  if (item.HasVideoInfoTag() && other.HasVideoInfoTag())
+  {
+    const CVideoInfoTag& tag = *item.GetVideoInfoTag();
+    const CVideoInfoTag& otherTag = *other.GetVideoInfoTag();
+    return tag.m_iDbId > 0 && tag.m_iDbId == otherTag.m_iDbId && tag.m_type == otherTag.m_type &&
+           item.GetVideoContentType() == other.GetVideoContentType();
+  }
+
+  if (item.HasMusicInfoTag() && other.HasMusicInfoTag())
+  {
+    const MUSIC_INFO::CMusicInfoTag& tag = *item.GetMusicInfoTag();
+    const MUSIC_INFO::CMusicInfoTag& otherTag = *other.GetMusicInfoTag();
+    return tag.GetDatabaseId() > 0 && tag.GetDatabaseId() == otherTag.GetDatabaseId() &&
+           tag.GetType() == otherTag.GetType();
+  }
+
+  return false;
+}
+
+// An announcement ready to be delivered, shared by the queues of all announcers
+struct CAnnouncement
+{
+  AnnouncementFlag flag;
+  std::string sender;
+  std::string message;
+  CVariant data;
+
+  // the data serialized as JSON (pretty and compact), created on first use
+  mutable CCriticalSection critSection;
+  mutable std::string json[2];
+  mutable bool serialized[2] = {false, false};
+};
+
+// the announcement the current thread is delivering
+thread_local const CAnnouncement* currentAnnouncement = nullptr;
+} // namespace
+
+struct CAnnouncementManager::CListener
+{
+  CListener(IAnnouncer* listener, bool externalTransport)
+    : announcer(listener), external(externalTransport)
+  {
+  }
+
+  IAnnouncer* announcer;
+  const bool external;
+  std::atomic<bool> removed{false};
+
+  // held while a delivery job calls the announcer
+  CCriticalSection deliverySection;
+
+  CCriticalSection critSection;
+  std::deque<std::shared_ptr<const CAnnouncement>> queue;
+  const CJob* scheduledJob = nullptr;
+  QueueStats stats;
+};
+
+// Delivers the queued announcements to an external transport
+class CAnnouncementManager::CDeliveryJob : public CJob
+{
+public:
+  explicit CDeliveryJob(const std::shared_ptr<CListener>& listener) : m_listener(listener) {}
+
+  ~CDeliveryJob() override
+  {
+    // the job may be cancelled before it ran
+    std::unique_lock<CCriticalSection> lock(m_listener->critSection);
+    if (m_listener->scheduledJob == this)
+      m_listener->scheduledJob = nullptr;
+  }
+
+  const char* GetType() const override { return "AnnounceDelivery"; }
+
+  bool DoWork() override
+  {
+    std::unique_lock<CCriticalSection> delivery(m_listener->deliverySection);
+
+    while (true)
+    {
+      std::shared_ptr<const CAnnouncement> announcement;
+      {
+        std::unique_lock<CCriticalSection> lock(m_listener->critSection);
+        if (m_listener->removed || m_listener->queue.empty())
+        {
+          if (m_listener->scheduledJob == this)
+            m_listener->scheduledJob = nullptr;
+          return true;
+        }
+
+        announcement = std::move(m_listener->queue.front());
+        m_listener->queue.pop_front();
+        m_listener->stats.depth = m_listener->queue.size();
+      }
+
+      currentAnnouncement = announcement.get();
+      m_listener->announcer->Announce(announcement->flag, announcement->sender,
+                                      announcement->message, announcement->data);
+      currentAnnouncement = nullptr;
+
+      std::unique_lock<CCriticalSection> lock(m_listener->critSection);
+      m_listener->stats.delivered++;
+    }
+  }
+
+private:
+  const std::shared_ptr<CListener> m_listener;
+};
+
 const std::string CAnnouncementManager::ANNOUNCEMENT_SENDER = "xbmc";
 
-CAnnouncementManager::CAnnouncementManager() : CThread("Announce")
+CAnnouncementManager::CAnnouncementManager()
+  : CThread("Announce"),
+    m_deliveryJobs(false, MAX_CONCURRENT_DELIVERIES, CJob::PRIORITY_LOW)
 {
 }
 
@@ -48,17 +187,30 @@ void CAnnouncementManager::Deinitialize()
   m_bStop = true;
   m_queueEvent.Set();
   StopThread();
-  std::unique_lock<CCriticalSection> lock(m_announcersCritSection);
-  m_announcers.clear();
+  m_deliveryJobs.CancelJobs();
+
+  std::vector<std::shared_ptr<CListener>> listeners;
+  {
+    std::unique_lock<CCriticalSection> lock(m_announcersCritSection);
+    listeners.swap(m_listeners);
+    for (const auto& listener : listeners)
+      listener->removed = true;
+  }
+
+  // wait for the calls in progress on delivery jobs
+  for (const auto& listener : listeners)
+  {
+    std::unique_lock<CCriticalSection> lock(listener->deliverySection);
+  }
 }
 
-void CAnnouncementManager::AddAnnouncer(IAnnouncer *listener)
+void CAnnouncementManager::AddAnnouncer(IAnnouncer* listener, bool external)
 {
   if (!listener)
     return;
 
   std::unique_lock<CCriticalSection> lock(m_announcersCritSection);
-  m_announcers.push_back(listener);
+  m_listeners.emplace_back(std::make_shared<CListener>(listener, external));
 }
 
 void CAnnouncementManager::RemoveAnnouncer(IAnnouncer *listener)
@@ -66,15 +218,64 @@ void CAnnouncementManager::RemoveAnnouncer(IAnnouncer *listener)
   if (!listener)
     return;
 
+  std::shared_ptr<CListener> removed;
+  {
+    std::unique_lock<CCriticalSection> lock(m_announcersCritSection);
+    auto it = std::find_if(m_listeners.begin(), m_listeners.end(),
+                           [listener](const std::shared_ptr<CListener>& entry)
+                           { return entry->announcer == listener; });
+    if (it == m_listeners.end())
+      return;
+
+    removed = *it;
+    m_listeners.erase(it);
+    removed->removed = true;
+  }
+
+  // The announcer must not be called anymore once this returns. Its queued
+  // announcements are skipped by the delivery job, only a call in progress is
+  // waited for. Removing the announcer while it handles an announcement is
+  // fine as the section is recursive.
+  if (removed->external)
+  {
+    std::unique_lock<CCriticalSection> lock(removed->deliverySection);
+  }
+}
+
+bool CAnnouncementManager::GetQueueStats(const IAnnouncer* listener, QueueStats& stats) const
+{
   std::unique_lock<CCriticalSection> lock(m_announcersCritSection);
-  for (unsigned int i = 0; i < m_announcers.size(); i++)
+  for (const auto& entry : m_listeners)
   {
-    if (m_announcers[i] == listener)
+    if (entry->announcer == listener)
     {
-      m_announcers.erase(m_announcers.begin() + i);
-      return;
+      std::unique_lock<CCriticalSection> queueLock(entry->critSection);
+      stats = entry->stats;
+      return true;
     }
   }
+
+  return false;
+}
+
+bool CAnnouncementManager::SerializeData(const CVariant& data, bool compact, std::string& json)
+{
+  const CAnnouncement* announcement = currentAnnouncement;
+  if (announcement == nullptr || &announcement->data != &data)
+    return CJSONVariantWriter::Write(data, json, compact);
+
+  std::unique_lock<CCriticalSection> lock(announcement->critSection);
+  const int index = compact ? 1 : 0;
+  if (!announcement->serialized[index])
+  {
+    if (!CJSONVariantWriter::Write(data, announcement->json[index], compact))
+      return false;
+
+    announcement->serialized[index] = true;
+  }
+
+  json = announcement->json[index];
+  return true;
 }
 
 void CAnnouncementManager::Announce(AnnouncementFlag flag, const std::string& message)
@@ -134,17 +335,51 @@ void CAnnouncementManager::Announce(AnnouncementFlag flag,
   announcement.sender = sender;
   announcement.message = message;
   announcement.data = data;
+  announcement.due = std::chrono::steady_clock::now() + GetBatchWindow(flag);
 
   if (item != nullptr)
     announcement.item = std::make_shared<CFileItem>(*item);
 
   {
     std::unique_lock<CCriticalSection> lock(m_queueCritSection);
-    m_announcementQueue.push_back(announcement);
+    if (Coalesce(announcement))
+    {
+      m_coalesced++;
+      return;
+    }
+    m_announcementQueue.push_back(std::move(announcement));
   }
   m_queueEvent.Set();
 }
 
+bool CAnnouncementManager::Coalesce(const CAnnounceData& announcement)
+{
+  if (GetBatchWindow(announcement.flag) == std::chrono::milliseconds::zero())
+    return false;
+
+  // Look for an identical announcement which is still within its batching
+  // window. Stop at an announcement of the same type with a different
+  // message as e.g. an OnUpdate must not be moved before an OnRemove.
+  const auto now = std::chrono::steady_clock::now();
+  for (auto it = m_announcementQueue.rbegin(); it != m_announcementQueue.rend(); ++it)
+  {
+    if (it->flag != announcement.flag)
+      continue;
+    if (it->due <= now || it->message != announcement.message)
+      break;
+    if (it->sender != announcement.sender || it->data != announcement.data)
+      continue;
+
+    if (it->item == nullptr && announcement.item == nullptr)
+      return true;
+    if (it->item != nullptr && announcement.item != nullptr &&
+        IsSameLibraryItem(*it->item, *announcement.item))
+      return true;
+  }
+
+  return false;
+}
+
 void CAnnouncementManager::DoAnnounce(AnnouncementFlag flag,
                                       const std::string& sender,
                                       const std::string& message,
@@ -152,13 +387,62 @@ void CAnnouncementManager::DoAnnounce(AnnouncementFlag flag,
 {
   CLog::Log(LOGDEBUG, LOGANNOUNCE, "CAnnouncementManager - Announcement: {} from {}", message, sender);
 
+  auto announcement = std::make_shared<CAnnouncement>();
+  announcement->flag = flag;
+  announcement->sender = sender;
+  announcement->message = message;
+  announcement->data = data;
+
   std::unique_lock<CCriticalSection> lock(m_announcersCritSection);
 
   // Make a copy of announcers. They may be removed or even remove themselves during execution of IAnnouncer::Announce()!
+  const std::vector<std::shared_ptr<CListener>> listeners(m_listeners);
+
+  // Queue the announcement for the external transports, their delivery jobs call them
+  for (const auto& listener : listeners)
+  {
+    if (!listener->external)
+      continue;
 
-  std::vector<IAnnouncer *> announcers(m_announcers);
-  for (unsigned int i = 0; i < announcers.size(); i++)
-    announcers[i]->Announce(flag, sender, message, data);
+    CDeliveryJob* job = nullptr;
+    {
+      std::unique_lock<CCriticalSection> queueLock(listener->critSection);
+      if (listener->queue.size() >= MAX_QUEUED_ANNOUNCEMENTS)
+      {
+        if (listener->stats.dropped++ == 0)
+          CLog::Log(LOGWARNING, "CAnnouncementManager - Announcer is too slow, dropping its "
+                                "oldest announcements");
+        listener->queue.pop_front();
+      }
+
+      listener->queue.push_back(announcement);
+      listener->stats.depth = listener->queue.size();
+      listener->stats.maxDepth = std::max(listener->stats.maxDepth, listener->stats.depth);
+
+      if (listener->scheduledJob == nullptr)
+      {
+        job = new CDeliveryJob(listener);
+        listener->scheduledJob = job;
+      }
+    }
+
+    if (job)
+      m_deliveryJobs.AddJob(job);
+  }
+
+  // Call the other announcers in order, none of them misses an announcement
+  currentAnnouncement = announcement.get();
+  for (const auto& listener : listeners)
+  {
+    if (listener->external || listener->removed)
+      continue;
+
+    listener->announcer->Announce(flag, sender, message, announcement->data);
+
+    std::unique_lock<CCriticalSection> queueLock(listener->critSection);
+    listener->stats.delivered++;
+  }
+  currentAnnouncement = nullptr;
 }
 
 void CAnnouncementManager::DoAnnounce(AnnouncementFlag flag,
@@ -326,8 +610,27 @@ void CAnnouncementManager::Process()
     std::unique_lock<CCriticalSection> lock(m_queueCritSection);
     if (!m_announcementQueue.empty())
     {
-      auto announcement = m_announcementQueue.front();
-      m_announcementQueue.pop_front();
+      // Announcements of the same type share the batching window so they are
+      // due in order, an announcement which is due may overtake announcements
+      // of other types which are still held back
+      const auto now = std::chrono::steady_clock::now();
+      auto it = std::find_if(m_announcementQueue.begin(), m_announcementQueue.end(),
+                             [&now](const CAnnounceData& entry) { return entry.due <= now; });
+      if (it == m_announcementQueue.end())
+      {
+        // wait for the end of the first batching window
+        const auto due = std::min_element(m_announcementQueue.begin(), m_announcementQueue.end(),
+                                          [](const CAnnounceData& a, const CAnnounceData& b)
+                                          { return a.due < b.due; })
+                             ->due;
+        const auto wait = std::chrono::ceil<std::chrono::milliseconds>(due - now);
+        CSingleExit ex(m_queueCritSection);
+        m_queueEvent.Wait(wait);
+        continue;
+      }
+
+      auto announcement = std::move(*it);
+      m_announcementQueue.erase(it);
       {
         CSingleExit ex(m_queueCritSection);
         DoAnnounce(announcement.flag, announcement.sender, announcement.message, announcement.item,
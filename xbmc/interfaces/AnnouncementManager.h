@@ -12,8 +12,12 @@
 #include "threads/CriticalSection.h"
 #include "threads/Event.h"
 #include "threads/Thread.h"
+#include "utils/JobManager.h"
 #include "utils/Variant.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <vector>
@@ -23,17 +27,56 @@ class CVariant;
 
 namespace ANNOUNCEMENT
 {
+  /*!
+   \brief Delivers announcements to all registered announcers.
+
+   Announcements are queued by Announce() and processed on a separate thread.
+   Library announcements are held back for a short batching window during
+   which identical announcements (e.g. repeated VideoLibrary.OnUpdate of the
+   same item during a scan) are coalesced. Other announcements are not delayed
+   by announcements waiting in the batching window.
+
+   Announcers are called from the thread of the manager, one after another
+   and in the order of the announcements. The transports of external clients
+   (JSON-RPC, Python) instead get a bounded queue of their own, which is
+   drained by jobs of a shared job queue, so a slow client only delays its own
+   announcements. If the queue of a transport is full its oldest
+   announcements are dropped.
+   */
   class CAnnouncementManager : public CThread
   {
   public:
+    /*!
+     \brief Statistics of the queue of a single announcer, only external
+     transports queue announcements
+     */
+    struct QueueStats
+    {
+      size_t depth = 0; //!< announcements currently waiting to be delivered
+      size_t maxDepth = 0; //!< highest number of waiting announcements so far
+      uint64_t delivered = 0; //!< announcements delivered so far
+      uint64_t dropped = 0; //!< announcements dropped because the queue was full
+    };
+
     CAnnouncementManager();
     ~CAnnouncementManager() override;
 
     void Start();
     void Deinitialize();
 
-    void AddAnnouncer(IAnnouncer *listener);
-    void RemoveAnnouncer(IAnnouncer *listener);
+    /*!
+     \brief Register an announcer
+     \param listener the announcer
+     \param external true for the transport of external clients, which is
+     called from a job of its own and drops announcements it is too slow for
+     */
+    void AddAnnouncer(IAnnouncer* listener, bool external = false);
+
+    /*!
+     \brief Unregister an announcer, its queued announcements are skipped.
+     Only waits for a call of the announcer in progress on a delivery job.
+     */
+    void RemoveAnnouncer(IAnnouncer* listener);
 
     void Announce(AnnouncementFlag flag, const std::string& message);
     void Announce(AnnouncementFlag flag, const std::string& message, const CVariant& data);
@@ -56,6 +99,26 @@ namespace ANNOUNCEMENT
                   const std::shared_ptr<const CFileItem>& item,
                   const CVariant& data);
 
+    /*!
+     \brief Get the queue statistics of the given announcer
+     \return false if the announcer is not registered
+     */
+    bool GetQueueStats(const IAnnouncer* listener, QueueStats& stats) const;
+
+    /*!
+     \brief Get the number of announcements which have been coalesced with an
+     identical queued announcement
+     */
+    uint64_t GetCoalescedCount() const { return m_coalesced; }
+
+    /*!
+     \brief Serializes the data of an announcement as JSON.
+
+     When called by an announcer with the data it is being announced, the
+     data is only serialized once and shared by all announcers.
+     */
+    static bool SerializeData(const CVariant& data, bool compact, std::string& json);
+
     // The sender is not related to the application name.
     // Also it's part of Kodi's API - changing it will break
     // a big number of python addons and third party json consumers.
@@ -80,6 +143,7 @@ namespace ANNOUNCEMENT
       std::string message;
       std::shared_ptr<CFileItem> item;
       CVariant data;
+      std::chrono::steady_clock::time_point due;
     };
     std::list<CAnnounceData> m_announcementQueue;
     CEvent m_queueEvent;
@@ -88,8 +152,15 @@ namespace ANNOUNCEMENT
     CAnnouncementManager(const CAnnouncementManager&) = delete;
     CAnnouncementManager const& operator=(CAnnouncementManager const&) = delete;
 
-    CCriticalSection m_announcersCritSection;
+    class CDeliveryJob;
+    struct CListener;
+
+    bool Coalesce(const CAnnounceData& announcement);
+
+    mutable CCriticalSection m_announcersCritSection;
     CCriticalSection m_queueCritSection;
-    std::vector<IAnnouncer *> m_announcers;
+    std::vector<std::shared_ptr<CListener>> m_listeners;
+    CJobQueue m_deliveryJobs;
+    std::atomic<uint64_t> m_coalesced{0};
   };
 }
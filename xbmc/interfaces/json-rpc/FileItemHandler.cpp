@@ -10,6 +10,7 @@
 
 #include "AudioLibrary.h"
 #include "FileOperations.h"
+#include "JSONRPCResponseStream.h"
 #include "ServiceBroker.h"
 #include "TextureDatabase.h"
 #include "Util.h"
@@ -39,6 +40,7 @@
 #include <map>
 #include <memory>
 #include <string.h>
+#include <vector>
 
 using namespace MUSIC_INFO;
 using namespace JSONRPC;
@@ -269,8 +271,9 @@ void CFileItemHandler::FillDetails(const ISerializable* info,
   if (info == NULL || fields.empty())
     return;
 
+  // only materialize the requested fields
   CVariant serialization;
-  info->Serialize(serialization);
+  info->SerializeFields(serialization, fields);
 
   bool fetchedArt = false;
 
@@ -332,6 +335,91 @@ void CFileItemHandler::HandleFileItemList(const char *ID, bool allowFile, const
   delete thumbLoader;
 }
 
+void CFileItemHandler::StreamFileItemList(const char *ID, bool allowFile, const char *resultname, CFileItemList &items, const CVariant &parameterObject, CVariant &result, bool sortLimit /* = true */)
+{
+  StreamFileItemList(ID, allowFile, resultname, items, parameterObject, result, items.Size(), sortLimit);
+}
+
+void CFileItemHandler::StreamFileItemList(const char *ID, bool allowFile, const char *resultname, CFileItemList &items, const CVariant &parameterObject, CVariant &result, int size, bool sortLimit /* = true */)
+{
+  if (!CJSONRPCResponseStream::CanDeferRows(result))
+  {
+    HandleFileItemList(ID, allowFile, resultname, items, parameterObject, result, size, sortLimit);
+    return;
+  }
+
+  int start, end;
+  HandleLimits(parameterObject, result, size, start, end);
+
+  if (sortLimit)
+    Sort(items, parameterObject);
+  else
+  {
+    start = 0;
+    end = items.Size();
+  }
+
+  // everything needed to serialize the items once the response is read
+  struct SState
+  {
+    std::vector<CFileItemPtr> items;
+    size_t next = 0;
+    std::string id;
+    bool hasId = false;
+    std::string resultname;
+    bool allowFile = false;
+    CVariant parameterObject;
+    std::set<std::string> fields;
+    std::unique_ptr<CThumbLoader> thumbLoader;
+  };
+
+  auto state = std::make_shared<SState>();
+  for (int i = start; i < end; i++)
+    state->items.emplace_back(items.Get(i));
+  state->hasId = ID != nullptr;
+  if (state->hasId)
+    state->id = ID;
+  state->resultname = resultname;
+  state->allowFile = allowFile;
+  state->parameterObject = parameterObject;
+
+  if (parameterObject.isMember("properties") && parameterObject["properties"].isArray())
+  {
+    for (CVariant::const_iterator_array field = parameterObject["properties"].begin_array();
+         field != parameterObject["properties"].end_array(); ++field)
+      state->fields.insert(field->asString());
+  }
+
+  CJSONRPCResponseStream::DeferRows(result, resultname, [state](CVariant& row) {
+    if (state->next >= state->items.size())
+    {
+      state->thumbLoader.reset();
+      return false;
+    }
+
+    const CFileItemPtr& item = state->items[state->next++];
+
+    // the thumb loader is created lazily on the thread reading the response
+    if (state->next == 1)
+    {
+      if (item->HasVideoInfoTag())
+        state->thumbLoader = std::make_unique<CVideoThumbLoader>();
+      else if (item->HasMusicInfoTag())
+        state->thumbLoader = std::make_unique<CMusicThumbLoader>();
+
+      if (state->thumbLoader)
+        state->thumbLoader->OnLoaderStart();
+    }
+
+    CVariant object;
+    HandleFileItem(state->hasId ? state->id.c_str() : nullptr, state->allowFile,
+                   state->resultname.c_str(), item, state->parameterObject, state->fields, object,
+                   false, state->thumbLoader.get());
+    row = std::move(object[state->resultname]);
+    return true;
+  });
+}
+
 void CFileItemHandler::HandleFileItem(const char* ID,
                                       bool allowFile,
                                       const char* resultname,
@@ -26,6 +26,10 @@
 #include "utils/Variant.h"
 #include "video/VideoDatabase.h"
 
+#ifdef HAS_WEB_SERVER
+#include "network/httprequesthandler/HTTPFileCache.h"
+#endif
+
 #include <memory>
 
 using namespace XFILE;
@@ -62,7 +66,7 @@ JSONRPC_STATUS CFileOperations::GetRootDirectory(const std::string &method, ITra
     param["properties"] = CVariant(CVariant::VariantTypeArray);
     param["properties"].append("file");
 
-    HandleFileItemList(NULL, true, "sources", items, param, result);
+    StreamFileItemList(NULL, true, "sources", items, param, result);
   }
 
   return OK;
@@ -159,7 +163,7 @@ JSONRPC_STATUS CFileOperations::GetDirectory(const std::string &method, ITranspo
       param["properties"].append("file");
     param["properties"].append("filetype");
 
-    HandleFileItemList("id", true, "files", filteredFiles, param, result);
+    StreamFileItemList("id", true, "files", filteredFiles, param, result);
 
     return OK;
   }
@@ -285,6 +289,32 @@ JSONRPC_STATUS CFileOperations::Download(const std::string &method, ITransportLa
   return transport->Download(parameterObject["path"].asString().c_str(), result) ? OK : InvalidParams;
 }
 
+JSONRPC_STATUS CFileOperations::GetDownloadCacheStats(const std::string& method,
+                                                      ITransportLayer* transport,
+                                                      IClient* client,
+                                                      const CVariant& parameterObject,
+                                                      CVariant& result)
+{
+#ifdef HAS_WEB_SERVER
+  const CHTTPFileCache::Stats stats = CHTTPFileCache::GetInstance().GetStats();
+
+  result["hits"] = stats.hits;
+  result["misses"] = stats.misses;
+  const uint64_t requests = stats.hits + stats.misses;
+  result["hitrate"] = requests > 0 ? static_cast<double>(stats.hits) / requests : 0.0;
+  result["memory"]["used"] = stats.memoryUsed;
+  result["memory"]["budget"] = stats.memoryBudget;
+  result["disk"]["used"] = stats.diskUsed;
+  result["disk"]["budget"] = stats.diskBudget;
+  result["openfiles"] = stats.openFiles;
+  result["reusedfiles"] = stats.reusedFiles;
+
+  return OK;
+#else
+  return FailedToExecute;
+#endif
+}
+
 bool CFileOperations::FillFileItem(
     const std::shared_ptr<CFileItem>& originalItem,
     std::shared_ptr<CFileItem>& item,
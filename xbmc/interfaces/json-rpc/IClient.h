@@ -10,6 +10,8 @@
 
 namespace JSONRPC
 {
+  class CJSONRPCSubscriptions;
+
   class IClient
   {
   public:
@@ -17,5 +19,11 @@ namespace JSONRPC
     virtual int GetPermissionFlags() = 0;
     virtual int GetAnnouncementFlags() = 0;
     virtual bool SetAnnouncementFlags(int flags) = 0;
+
+    /*!
+     \brief Returns the property subscriptions of the client or nullptr
+     if the client can't be sent notifications
+     */
+    virtual CJSONRPCSubscriptions* GetSubscriptions() { return nullptr; }
   };
 }
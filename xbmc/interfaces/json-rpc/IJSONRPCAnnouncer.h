@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "interfaces/AnnouncementManager.h"
 #include "interfaces/IAnnouncer.h"
 #include "utils/JSONVariantWriter.h"
 #include "utils/Variant.h"
@@ -26,12 +27,21 @@ namespace JSONRPC
                                              const CVariant& data,
                                              bool compactOutput)
     {
-      CVariant root;
-      root["jsonrpc"] = "2.0";
-
       std::string namespaceMethod = ANNOUNCEMENT::AnnouncementFlagToString(flag);
       namespaceMethod += ".";
       namespaceMethod += method;
+
+      // The data is only serialized once for all announcers so in compact
+      // form the message is put together around it
+      std::string jsonMethod, jsonSender, jsonData;
+      if (compactOutput && CJSONVariantWriter::Write(namespaceMethod, jsonMethod, true) &&
+          CJSONVariantWriter::Write(sender, jsonSender, true) &&
+          ANNOUNCEMENT::CAnnouncementManager::SerializeData(data, true, jsonData))
+        return "{\"jsonrpc\":\"2.0\",\"method\":" + jsonMethod + ",\"params\":{\"data\":" +
+               jsonData + ",\"sender\":" + jsonSender + "}}";
+
+      CVariant root;
+      root["jsonrpc"] = "2.0";
       root["method"] = namespaceMethod;
 
       root["params"]["data"] = data;
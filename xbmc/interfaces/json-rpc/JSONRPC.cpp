@@ -8,6 +8,9 @@
 
 #include "JSONRPC.h"
 
+#include "JSONRPCResponseStream.h"
+#include "JSONRPCSubscriptions.h"
+
 #include "FileItem.h"
 #include "GUIUserMessages.h"
 #include "ServiceBroker.h"
@@ -239,9 +242,53 @@ JSONRPC_STATUS CJSONRPC::NotifyAll(const std::string &method, ITransportLayer *t
   return ACK;
 }
 
+JSONRPC_STATUS CJSONRPC::Subscribe(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result)
+{
+  CJSONRPCSubscriptions* subscriptions = client->GetSubscriptions();
+  if (subscriptions == nullptr)
+    return FailedToExecute;
+
+  return subscriptions->Subscribe(parameterObject, transport, client, result);
+}
+
+JSONRPC_STATUS CJSONRPC::Unsubscribe(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result)
+{
+  CJSONRPCSubscriptions* subscriptions = client->GetSubscriptions();
+  if (subscriptions == nullptr ||
+      !subscriptions->Unsubscribe(static_cast<int>(parameterObject["subscriptionid"].asInteger())))
+    return InvalidParams;
+
+  return ACK;
+}
+
 std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer *transport, IClient *client)
 {
-  CVariant inputroot, outputroot, result;
+  CVariant outputroot;
+
+  std::string str;
+  if (HandleRequest(inputString, outputroot, transport, client, nullptr))
+    CJSONVariantWriter::Write(outputroot, str, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact);
+
+  return str;
+}
+
+std::unique_ptr<CJSONRPCResponseStream> CJSONRPC::MethodCallStream(const std::string &inputString, ITransportLayer *transport, IClient *client)
+{
+  CVariant outputroot;
+  auto stream = std::make_unique<CJSONRPCResponseStream>();
+
+  if (HandleRequest(inputString, outputroot, transport, client, stream.get()))
+  {
+    if (!stream->SetResponse(outputroot, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact))
+      CLog::Log(LOGERROR, "JSONRPC: Failed to serialize the response");
+  }
+
+  return stream;
+}
+
+bool CJSONRPC::HandleRequest(const std::string &inputString, CVariant& outputroot, ITransportLayer *transport, IClient *client, CJSONRPCResponseStream* stream)
+{
+  CVariant inputroot;
   bool hasResponse = false;
 
   CLog::Log(LOGDEBUG, LOGJSONRPC, "JSONRPC: Incoming request: {}", inputString);
@@ -262,7 +309,7 @@ std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer
              itr != inputroot.end_array(); ++itr)
         {
           CVariant response;
-          if (HandleMethodCall(*itr, response, transport, client))
+          if (HandleMethodCall(*itr, response, transport, client, stream))
           {
             outputroot.append(response);
             hasResponse = true;
@@ -271,7 +318,7 @@ std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer
       }
     }
     else
-      hasResponse = HandleMethodCall(inputroot, outputroot, transport, client);
+      hasResponse = HandleMethodCall(inputroot, outputroot, transport, client, stream);
   }
   else
   {
@@ -280,14 +327,10 @@ std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer
     hasResponse = true;
   }
 
-  std::string str;
-  if (hasResponse)
-    CJSONVariantWriter::Write(outputroot, str, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact);
-
-  return str;
+  return hasResponse;
 }
 
-bool CJSONRPC::HandleMethodCall(const CVariant& request, CVariant& response, ITransportLayer *transport, IClient *client)
+bool CJSONRPC::HandleMethodCall(const CVariant& request, CVariant& response, ITransportLayer *transport, IClient *client, CJSONRPCResponseStream* stream /* = nullptr */)
 {
   JSONRPC_STATUS errorCode = OK;
   CVariant result;
@@ -304,7 +347,13 @@ bool CJSONRPC::HandleMethodCall(const CVariant& request, CVariant& response, ITr
     CVariant params;
 
     if ((errorCode = CJSONServiceDescription::CheckCall(methodName.c_str(), request["params"], transport, client, isNotification, method, params)) == OK)
+    {
+      // let the method defer large lists to the stream instead of adding them to the result
+      if (stream != nullptr && !isNotification)
+        stream->BeginCall(result);
+
       errorCode = method(methodName, transport, client, params, result);
+    }
     else
       result = params;
   }
@@ -319,6 +368,9 @@ bool CJSONRPC::HandleMethodCall(const CVariant& request, CVariant& response, ITr
 
   BuildResponse(request, errorCode, result, response);
 
+  if (stream != nullptr)
+    stream->EndCall(response);
+
   return !isNotification;
 }
 
@@ -0,0 +1,193 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "JSONRPCResponseStream.h"
+
+#include "utils/JSONVariantWriter.h"
+#include "utils/StringUtils.h"
+#include "utils/Variant.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace JSONRPC;
+
+namespace
+{
+// the response of the method currently handled on this thread
+thread_local CJSONRPCResponseStream* currentStream = nullptr;
+} // namespace
+
+CJSONRPCResponseStream::CJSONRPCResponseStream() : m_token(StringUtils::CreateUUID())
+{
+}
+
+CJSONRPCResponseStream::~CJSONRPCResponseStream()
+{
+  if (currentStream == this)
+    currentStream = nullptr;
+}
+
+bool CJSONRPCResponseStream::DeferRows(const CVariant& result,
+                                       const std::string& name,
+                                       RowProducer producer)
+{
+  if (!CanDeferRows(result) || !producer)
+    return false;
+
+  currentStream->m_deferredRows.emplace_back(name, std::move(producer));
+  return true;
+}
+
+bool CJSONRPCResponseStream::CanDeferRows(const CVariant& result)
+{
+  // only lists directly contained in the result object of the method can be deferred
+  return currentStream != nullptr && currentStream->m_result == &result;
+}
+
+void CJSONRPCResponseStream::BeginCall(const CVariant& result)
+{
+  m_result = &result;
+  m_deferredRows.clear();
+  currentStream = this;
+}
+
+void CJSONRPCResponseStream::EndCall(CVariant& response)
+{
+  currentStream = nullptr;
+  m_result = nullptr;
+
+  // only successful calls contain the deferred rows
+  if (response.isMember("result") && response["result"].isObject())
+  {
+    for (auto& rows : m_deferredRows)
+    {
+      // insert a unique placeholder which is replaced by the rows while reading the response
+      std::string placeholder = StringUtils::Format("{}-{}", m_token, m_producers.size());
+      response["result"][rows.first] = placeholder;
+      m_producers.emplace_back(std::move(placeholder), std::move(rows.second));
+    }
+  }
+
+  m_deferredRows.clear();
+}
+
+bool CJSONRPCResponseStream::SetResponse(const CVariant& response, bool compact)
+{
+  std::string json;
+  if (!CJSONVariantWriter::Write(response, json, compact))
+    return false;
+
+  m_compact = compact;
+
+  // find the placeholders of all deferred rows in the serialized response
+  std::vector<std::pair<size_t, size_t>> positions;
+  for (size_t i = 0; i < m_producers.size(); ++i)
+  {
+    const size_t position = json.find("\"" + m_producers[i].first + "\"");
+    if (position != std::string::npos)
+      positions.emplace_back(position, i);
+  }
+  std::sort(positions.begin(), positions.end());
+
+  // split the response into the text around the placeholders
+  size_t offset = 0;
+  for (const auto& position : positions)
+  {
+    SSegment segment;
+    segment.text = json.substr(offset, position.first - offset);
+    segment.rows = std::move(m_producers[position.second].second);
+    m_segments.emplace_back(std::move(segment));
+
+    offset = position.first + m_producers[position.second].first.size() + 2;
+  }
+
+  SSegment segment;
+  segment.text = json.substr(offset);
+  m_segments.emplace_back(std::move(segment));
+
+  m_producers.clear();
+  return true;
+}
+
+size_t CJSONRPCResponseStream::Read(char* buffer, size_t size)
+{
+  size_t written = 0;
+  while (written < size)
+  {
+    if (m_position >= m_data.size() && !Next())
+      break;
+
+    const size_t length = std::min(size - written, m_data.size() - m_position);
+    memcpy(buffer + written, m_data.data() + m_position, length);
+    written += length;
+    m_position += length;
+  }
+
+  return written;
+}
+
+bool CJSONRPCResponseStream::Next()
+{
+  m_data.clear();
+  m_position = 0;
+
+  while (m_segment < m_segments.size())
+  {
+    SSegment& segment = m_segments[m_segment];
+    switch (segment.state)
+    {
+      case SegmentState::TEXT:
+        m_data.swap(segment.text);
+        if (segment.rows)
+        {
+          m_data += '[';
+          segment.state = SegmentState::ROWS;
+        }
+        else
+          segment.state = SegmentState::DONE;
+        break;
+
+      case SegmentState::ROWS:
+      {
+        CVariant row;
+        if (segment.rows(row))
+        {
+          std::string json;
+          if (!CJSONVariantWriter::Write(row, json, m_compact))
+          {
+            CLog::Log(LOGERROR, "JSONRPC: Failed to serialize a row of the response");
+            json = "null";
+          }
+
+          if (segment.rowCount++ > 0)
+            m_data += ',';
+          m_data += json;
+        }
+        else
+        {
+          // release whatever the producer holds on to as early as possible
+          segment.rows = nullptr;
+          m_data += ']';
+          segment.state = SegmentState::DONE;
+        }
+        break;
+      }
+
+      case SegmentState::DONE:
+        m_segment++;
+        break;
+    }
+
+    if (!m_data.empty())
+      return true;
+  }
+
+  return false;
+}
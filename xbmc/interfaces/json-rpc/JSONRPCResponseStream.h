@@ -0,0 +1,106 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+class CVariant;
+
+namespace JSONRPC
+{
+  /*!
+   \ingroup jsonrpc
+   \brief JSON-RPC response which is serialized while it is being read
+
+   Methods returning large lists may defer the rows of a list to the response (see DeferRows()).
+   Instead of adding every row to the result, the rows are created and serialized one by one
+   while the transport reads the response. This keeps the memory needed for large responses
+   low and lets the transport send the first bytes before the last row has been created.
+   */
+  class CJSONRPCResponseStream
+  {
+  public:
+    /*!
+     \brief Creates the next row of a deferred list
+     \param row [out] the next row
+     \return false if there are no more rows, true otherwise
+     */
+    using RowProducer = std::function<bool(CVariant& row)>;
+
+    CJSONRPCResponseStream();
+    ~CJSONRPCResponseStream();
+
+    /*!
+     \brief Defers the rows of a list in the result of the method handled on the calling thread
+     \param result the result object passed to the method
+     \param name name of the list in the result object
+     \param producer creates the rows of the list while the response is being read
+     \return true if the rows have been deferred, false if the response of the method is not
+     streamed or result isn't the result object of the method. In that case the caller has to add
+     the rows to the result itself.
+     */
+    static bool DeferRows(const CVariant& result, const std::string& name, RowProducer producer);
+
+    /*!
+     \brief Whether DeferRows() would accept rows for the given result object
+     */
+    static bool CanDeferRows(const CVariant& result);
+
+    /*!
+     \brief Reads the next part of the serialized response
+     \param buffer buffer to write the response to
+     \param size size of the buffer
+     \return number of bytes written to the buffer, 0 once the whole response has been read
+     */
+    size_t Read(char* buffer, size_t size);
+
+    /*!
+     \brief Whether the response is empty, e.g. because the request was a notification
+     */
+    bool IsEmpty() const { return m_segments.empty(); }
+
+  private:
+    friend class CJSONRPC;
+
+    void BeginCall(const CVariant& result);
+    void EndCall(CVariant& response);
+    bool SetResponse(const CVariant& response, bool compact);
+    bool Next();
+
+    enum class SegmentState
+    {
+      TEXT,
+      ROWS,
+      DONE
+    };
+
+    struct SSegment
+    {
+      std::string text;
+      RowProducer rows;
+      SegmentState state = SegmentState::TEXT;
+      size_t rowCount = 0;
+    };
+
+    const CVariant* m_result = nullptr;
+    std::vector<std::pair<std::string, RowProducer>> m_deferredRows;
+
+    std::string m_token;
+    std::vector<std::pair<std::string, RowProducer>> m_producers;
+
+    std::vector<SSegment> m_segments;
+    bool m_compact = true;
+    size_t m_segment = 0;
+    std::string m_data;
+    size_t m_position = 0;
+  };
+}
@@ -0,0 +1,181 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "JSONRPCSubscriptions.h"
+
+#include "JSONServiceDescription.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/log.h"
+
+#include <algorithm>
+
+using namespace JSONRPC;
+
+namespace
+{
+constexpr size_t MAX_SUBSCRIPTIONS = 16;
+constexpr std::chrono::milliseconds IDLE_INTERVAL{1000};
+} // namespace
+
+JSONRPC_STATUS CJSONRPCSubscriptions::Subscribe(const CVariant& parameterObject,
+                                                ITransportLayer* transport,
+                                                IClient* client,
+                                                CVariant& result)
+{
+  if (m_subscriptions.size() >= MAX_SUBSCRIPTIONS)
+  {
+    CLog::Log(LOGDEBUG, "JSONRPC: Client already has {} subscriptions", m_subscriptions.size());
+    return FailedToExecute;
+  }
+
+  if (parameterObject["properties"].empty() && parameterObject["labels"].empty())
+    return InvalidParams;
+
+  SSubscription subscription;
+  subscription.interval = std::chrono::milliseconds(parameterObject["interval"].asInteger());
+  subscription.due = std::chrono::steady_clock::now();
+
+  // The values are retrieved through the same methods a polling client
+  // would call so their parameters are checked against the schema here
+  if (!parameterObject["properties"].empty())
+  {
+    CVariant parameters(CVariant::VariantTypeObject);
+    parameters["playerid"] = parameterObject["playerid"];
+    parameters["properties"] = parameterObject["properties"];
+
+    JSONRPC_STATUS status = Prepare("Player.GetProperties", parameters, transport, client,
+                                    subscription.properties, result);
+    if (status != OK)
+      return status;
+  }
+
+  if (!parameterObject["labels"].empty())
+  {
+    CVariant parameters(CVariant::VariantTypeObject);
+    parameters["labels"] = parameterObject["labels"];
+
+    JSONRPC_STATUS status =
+        Prepare("XBMC.GetInfoLabels", parameters, transport, client, subscription.labels, result);
+    if (status != OK)
+      return status;
+  }
+
+  subscription.id = m_nextId++;
+  m_subscriptions.push_back(std::move(subscription));
+
+  result["subscriptionid"] = m_subscriptions.back().id;
+  return OK;
+}
+
+bool CJSONRPCSubscriptions::Unsubscribe(int subscriptionId)
+{
+  auto it = std::find_if(m_subscriptions.begin(), m_subscriptions.end(),
+                         [subscriptionId](const SSubscription& subscription)
+                         { return subscription.id == subscriptionId; });
+  if (it == m_subscriptions.end())
+    return false;
+
+  m_subscriptions.erase(it);
+  return true;
+}
+
+std::chrono::milliseconds CJSONRPCSubscriptions::Process(ITransportLayer* transport,
+                                                         IClient* client,
+                                                         bool compactOutput,
+                                                         std::vector<std::string>& notifications)
+{
+  const auto now = std::chrono::steady_clock::now();
+  auto next = now + IDLE_INTERVAL;
+
+  for (auto& subscription : m_subscriptions)
+  {
+    if (subscription.due <= now)
+    {
+      CVariant properties;
+      CVariant labels;
+      const bool propertiesChanged = Update(subscription.properties, transport, client, properties);
+      const bool labelsChanged = Update(subscription.labels, transport, client, labels);
+
+      if (propertiesChanged || labelsChanged)
+      {
+        CVariant notification;
+        notification["jsonrpc"] = "2.0";
+        notification["method"] = "JSONRPC.OnPropertiesChanged";
+        notification["params"]["sender"] = "xbmc";
+        notification["params"]["data"]["subscriptionid"] = subscription.id;
+        if (propertiesChanged)
+          notification["params"]["data"]["properties"] = std::move(properties);
+        if (labelsChanged)
+          notification["params"]["data"]["labels"] = std::move(labels);
+
+        std::string str;
+        CJSONVariantWriter::Write(notification, str, compactOutput);
+        notifications.push_back(std::move(str));
+      }
+
+      subscription.due = now + subscription.interval;
+    }
+
+    next = std::min(next, subscription.due);
+  }
+
+  return std::chrono::ceil<std::chrono::milliseconds>(next - now);
+}
+
+JSONRPC_STATUS CJSONRPCSubscriptions::Prepare(const std::string& method,
+                                              const CVariant& parameters,
+                                              ITransportLayer* transport,
+                                              IClient* client,
+                                              SSource& source,
+                                              CVariant& errorData)
+{
+  CVariant checkedParameters;
+  JSONRPC_STATUS status = CJSONServiceDescription::CheckCall(
+      method.c_str(), parameters, transport, client, false, source.call, checkedParameters);
+  if (status != OK)
+  {
+    errorData = checkedParameters;
+    source.call = nullptr;
+    return status;
+  }
+
+  source.method = method;
+  source.parameters = std::move(checkedParameters);
+  return OK;
+}
+
+bool CJSONRPCSubscriptions::Update(SSource& source,
+                                   ITransportLayer* transport,
+                                   IClient* client,
+                                   CVariant& changes)
+{
+  if (source.call == nullptr)
+    return false;
+
+  // Values which can't be retrieved (e.g. because the player has been
+  // stopped) are reported as null once
+  CVariant values(CVariant::VariantTypeObject);
+  if (source.call(source.method, transport, client, source.parameters, values) != OK ||
+      !values.isObject())
+    values = CVariant(CVariant::VariantTypeObject);
+
+  changes = CVariant(CVariant::VariantTypeObject);
+  for (auto it = values.begin_map(); it != values.end_map(); ++it)
+  {
+    if (!source.values.isMember(it->first) || source.values[it->first] != it->second)
+      changes[it->first] = it->second;
+  }
+  for (auto it = source.values.begin_map(); it != source.values.end_map(); ++it)
+  {
+    if (!values.isMember(it->first))
+      changes[it->first] = CVariant();
+  }
+
+  source.values = std::move(values);
+  return !changes.empty();
+}
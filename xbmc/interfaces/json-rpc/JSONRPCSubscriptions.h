@@ -0,0 +1,104 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "JSONRPCUtils.h"
+#include "utils/Variant.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace JSONRPC
+{
+  class IClient;
+  class ITransportLayer;
+
+  /*!
+   \ingroup jsonrpc
+   \brief Property subscriptions of a single client.
+
+   Instead of polling Player.GetProperties and XBMC.GetInfoLabels a client
+   can subscribe to a set of player properties and/or info labels. The
+   subscribed values are evaluated in-process and the client is sent a
+   JSONRPC.OnPropertiesChanged notification containing only the values
+   which changed since the last notification, at most once per interval
+   of the subscription.
+   */
+  class CJSONRPCSubscriptions
+  {
+  public:
+    /*!
+     \brief Adds a subscription as described by the parameters of
+     JSONRPC.Subscribe
+     \param parameterObject Parameters of the JSONRPC.Subscribe call
+     \param transport Transport the client is connected through
+     \param client Client adding the subscription
+     \param result Receives the id of the new subscription or the error data
+     \return OK if the subscription has been added otherwise an appropriate error code
+     */
+    JSONRPC_STATUS Subscribe(const CVariant& parameterObject,
+                             ITransportLayer* transport,
+                             IClient* client,
+                             CVariant& result);
+
+    /*!
+     \brief Removes the subscription with the given id
+     \return false if there is no such subscription
+     */
+    bool Unsubscribe(int subscriptionId);
+
+    bool IsEmpty() const { return m_subscriptions.empty(); }
+
+    /*!
+     \brief Evaluates all subscriptions which are due
+     \param transport Transport the client is connected through
+     \param client Client owning the subscriptions
+     \param compactOutput Whether to write compact JSON or not
+     \param notifications Receives a notification for every subscription with changed values
+     \return Time until the next subscription is due
+     */
+    std::chrono::milliseconds Process(ITransportLayer* transport,
+                                      IClient* client,
+                                      bool compactOutput,
+                                      std::vector<std::string>& notifications);
+
+  private:
+    struct SSource
+    {
+      std::string method;
+      MethodCall call = nullptr;
+      CVariant parameters;
+      CVariant values;
+    };
+
+    struct SSubscription
+    {
+      int id;
+      std::chrono::milliseconds interval;
+      std::chrono::steady_clock::time_point due;
+      SSource properties;
+      SSource labels;
+    };
+
+    static JSONRPC_STATUS Prepare(const std::string& method,
+                                  const CVariant& parameters,
+                                  ITransportLayer* transport,
+                                  IClient* client,
+                                  SSource& source,
+                                  CVariant& errorData);
+    static bool Update(SSource& source,
+                       ITransportLayer* transport,
+                       IClient* client,
+                       CVariant& changes);
+
+    std::vector<SSubscription> m_subscriptions;
+    int m_nextId = 1;
+  };
+}
@@ -30,7 +30,9 @@
 #include "utils/StringUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <memory>
+#include <unordered_map>
 
 using namespace JSONRPC;
 
@@ -50,6 +52,8 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
   { "JSONRPC.GetConfiguration",                     CJSONRPC::GetConfiguration },
   { "JSONRPC.SetConfiguration",                     CJSONRPC::SetConfiguration },
   { "JSONRPC.NotifyAll",                            CJSONRPC::NotifyAll },
+  { "JSONRPC.Subscribe",                            CJSONRPC::Subscribe },
+  { "JSONRPC.Unsubscribe",                          CJSONRPC::Unsubscribe },
 
 // Player
   { "Player.GetActivePlayers",                      CPlayerOperations::GetActivePlayers },
@@ -98,6 +102,7 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
   { "Files.SetFileDetails",                         CFileOperations::SetFileDetails },
   { "Files.PrepareDownload",                        CFileOperations::PrepareDownload },
   { "Files.Download",                               CFileOperations::Download },
+  { "Files.GetDownloadCacheStats",                  CFileOperations::GetDownloadCacheStats },
 
 // Music Library
   { "AudioLibrary.GetProperties",                   CAudioLibrary::GetProperties },
@@ -240,6 +245,7 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
 // Textures operations
   { "Textures.GetTextures",                         CTextureOperations::GetTextures },
   { "Textures.RemoveTexture",                       CTextureOperations::RemoveTexture },
+  { "Textures.Precache",                            CTextureOperations::Precache },
 
 // Settings operations
   { "Settings.GetSections",                         CSettingsOperations::GetSections },
@@ -662,9 +668,33 @@ JSONRPC_STATUS JSONSchemaTypeDefinition::Check(const CVariant& value,
                                                CVariant& outputValue,
                                                CVariant& errorData) const
 {
-  if (!name.empty())
-    errorData["name"] = name;
-  SchemaValueTypeToJson(type, errorData["type"]);
+  // Plain scalar types only need a type check
+  if (simple && IsType(value, type) && (!value.isNull() || HasType(type, NullValue)))
+  {
+    outputValue = value;
+    return OK;
+  }
+
+  JSONRPC_STATUS status = CheckValue(value, outputValue, errorData);
+
+  // The name and type are only needed to describe an error. If the
+  // value did not match an extended type, that type has already set
+  // its own name and type which take precedence
+  if (status != OK)
+  {
+    if (!name.empty() && !errorData.isMember("name"))
+      errorData["name"] = name;
+    if (!errorData.isMember("type"))
+      SchemaValueTypeToJson(type, errorData["type"]);
+  }
+
+  return status;
+}
+
+JSONRPC_STATUS JSONSchemaTypeDefinition::CheckValue(const CVariant& value,
+                                                    CVariant& outputValue,
+                                                    CVariant& errorData) const
+{
   std::string errorMessage;
 
   // Let's check the type of the provided parameter
@@ -760,10 +790,12 @@ JSONRPC_STATUS JSONSchemaTypeDefinition::Check(const CVariant& value,
       for (unsigned int arrayIndex = 0; arrayIndex < value.size(); arrayIndex++)
       {
         CVariant temp;
-        JSONRPC_STATUS status = itemType->Check(value[arrayIndex], temp, errorData["property"]);
-        outputValue.push_back(temp);
+        CVariant propertyError;
+        JSONRPC_STATUS status = itemType->Check(value[arrayIndex], temp, propertyError);
+        outputValue.push_back(std::move(temp));
         if (status != OK)
         {
+          errorData["property"] = std::move(propertyError);
           CLog::Log(LOGDEBUG, "JSONRPC: Array element at index {} does not match in type {}",
                     arrayIndex, name);
           errorMessage =
@@ -798,9 +830,11 @@ JSONRPC_STATUS JSONSchemaTypeDefinition::Check(const CVariant& value,
       unsigned int arrayIndex;
       for (arrayIndex = 0; arrayIndex < std::min(items.size(), (size_t)value.size()); arrayIndex++)
       {
-        JSONRPC_STATUS status = items.at(arrayIndex)->Check(value[arrayIndex], outputValue[arrayIndex], errorData["property"]);
+        CVariant propertyError;
+        JSONRPC_STATUS status = items.at(arrayIndex)->Check(value[arrayIndex], outputValue[arrayIndex], propertyError);
         if (status != OK)
         {
+          errorData["property"] = std::move(propertyError);
           CLog::Log(
               LOGDEBUG,
               "JSONRPC: Array element at index {} does not match with items schema in type {}",
@@ -841,8 +875,29 @@ JSONRPC_STATUS JSONSchemaTypeDefinition::Check(const CVariant& value,
       }
     }
 
-    // If every array element is unique we need to check each one
-    if (uniqueItems)
+    // If every array element is unique we need to check each one.
+    // Arrays of strings (e.g. lists of properties) are checked
+    // using a hash table
+    if (uniqueItems && std::all_of(outputValue.begin_array(), outputValue.end_array(),
+                                   [](const CVariant& item) { return item.isString(); }))
+    {
+      std::unordered_map<std::string, unsigned int> checked;
+      for (unsigned int checkingIndex = 0; checkingIndex < outputValue.size(); checkingIndex++)
+      {
+        const auto it = checked.emplace(outputValue[checkingIndex].asString(), checkingIndex);
+        if (!it.second)
+        {
+          CLog::Log(LOGDEBUG, "JSONRPC: Not unique array element at index {} and {} in type {}",
+                    it.first->second, checkingIndex, name);
+          errorMessage = StringUtils::Format(
+              "Array element at index {} is not unique (same as array element at index {})",
+              it.first->second, checkingIndex);
+          errorData["message"] = errorMessage.c_str();
+          return InvalidParams;
+        }
+      }
+    }
+    else if (uniqueItems)
     {
       for (unsigned int checkingIndex = 0; checkingIndex < outputValue.size(); checkingIndex++)
       {
@@ -877,9 +932,11 @@ JSONRPC_STATUS JSONSchemaTypeDefinition::Check(const CVariant& value,
     {
       if (value.isMember(propertiesIterator->second->name))
       {
-        JSONRPC_STATUS status = propertiesIterator->second->Check(value[propertiesIterator->second->name], outputValue[propertiesIterator->second->name], errorData["property"]);
+        CVariant propertyError;
+        JSONRPC_STATUS status = propertiesIterator->second->Check(value[propertiesIterator->second->name], outputValue[propertiesIterator->second->name], propertyError);
         if (status != OK)
         {
+          errorData["property"] = std::move(propertyError);
           CLog::Log(LOGDEBUG, "JSONRPC: Invalid property \"{}\" in type {}",
                     propertiesIterator->second->name, name);
           return status;
@@ -920,9 +977,11 @@ JSONRPC_STATUS JSONSchemaTypeDefinition::Check(const CVariant& value,
             continue;
           }
 
-          JSONRPC_STATUS status = additionalProperties->Check(value[iter->first], outputValue[iter->first], errorData["property"]);
+          CVariant propertyError;
+          JSONRPC_STATUS status = additionalProperties->Check(value[iter->first], outputValue[iter->first], propertyError);
           if (status != OK)
           {
+            errorData["property"] = std::move(propertyError);
             CLog::Log(LOGDEBUG, "JSONRPC: Invalid additional property \"{}\" in type {}",
                       iter->first, name);
             return status;
@@ -949,12 +1008,17 @@ JSONRPC_STATUS JSONSchemaTypeDefinition::Check(const CVariant& value,
   if (enums.size() > 0)
   {
     bool valid = false;
-    for (const auto& enumItr : enums)
+    if (!enumStrings.empty())
+      valid = value.isString() && enumStrings.find(value.asString()) != enumStrings.end();
+    else
     {
-      if (enumItr == value)
+      for (const auto& enumItr : enums)
       {
-        valid = true;
-        break;
+        if (enumItr == value)
+        {
+          valid = true;
+          break;
+        }
       }
     }
 
@@ -1249,6 +1313,44 @@ void JSONSchemaTypeDefinition::ResolveReference()
   referencedTypeSet = true;
 }
 
+void JSONSchemaTypeDefinition::Compile()
+{
+  // Set the flag before recursing to guard against cycles
+  if (compiled)
+    return;
+
+  compiled = true;
+
+  for (const auto& it : extends)
+    it->Compile();
+  for (const auto& it : unionTypes)
+    it->Compile();
+  for (const auto& it : items)
+    it->Compile();
+  for (const auto& it : additionalItems)
+    it->Compile();
+  for (const auto& it : properties)
+    it.second->Compile();
+
+  if (additionalProperties)
+    additionalProperties->Compile();
+
+  // Most enums only contain strings which can be looked up
+  // in a hash set instead of comparing against every value
+  enumStrings.clear();
+  if (std::all_of(enums.begin(), enums.end(), [](const CVariant& value) { return value.isString(); }))
+  {
+    for (const auto& it : enums)
+      enumStrings.insert(it.asString());
+  }
+
+  simple = (type & (ArrayValue | ObjectValue | AnyValue)) == 0 && extends.empty() &&
+           unionTypes.empty() && enums.empty() &&
+           minimum == -std::numeric_limits<double>::max() &&
+           maximum == std::numeric_limits<double>::max() && divisibleBy == 0 && minLength < 0 &&
+           maxLength < 0;
+}
+
 JSONSchemaTypeDefinition::CJsonSchemaPropertiesMap::CJsonSchemaPropertiesMap() :
    m_propertiesmap(std::map<std::string, JSONSchemaTypeDefinitionPtr>())
 {
@@ -1370,8 +1472,8 @@ JSONRPC_STATUS JsonRpcMethod::Check(const CVariant &requestParameters, ITranspor
       // Count the number of actually handled (present)
       // parameters
       unsigned int handled = 0;
-      CVariant errorData = CVariant(CVariant::VariantTypeObject);
-      errorData["method"] = name;
+      // The error data is only filled in if a check fails
+      CVariant errorData;
 
       // Loop through all the parameters to check
       for (unsigned int i = 0; i < parameters.size(); i++)
@@ -1381,6 +1483,7 @@ JSONRPC_STATUS JsonRpcMethod::Check(const CVariant &requestParameters, ITranspor
         if (status != OK)
         {
           // Return the error data object in the outputParameters reference
+          errorData["method"] = name;
           outputParameters = errorData;
           return status;
         }
@@ -1389,6 +1492,7 @@ JSONRPC_STATUS JsonRpcMethod::Check(const CVariant &requestParameters, ITranspor
       // Check if there were unnecessary parameters
       if (handled < requestParameters.size())
       {
+        errorData["method"] = name;
         errorData["message"] = "Too many parameters";
         outputParameters = errorData;
         return InvalidParams;
@@ -1445,13 +1549,19 @@ JSONRPC_STATUS JsonRpcMethod::checkParameter(const CVariant& requestParameters,
   // Let's check if the parameter has been provided
   if (ParameterExists(requestParameters, type->name, position))
   {
-    // Get the parameter
-    CVariant parameterValue = GetParameter(requestParameters, type->name, position);
+    // Get the parameter without copying it
+    const CVariant& parameterValue = IsValueMember(requestParameters, type->name)
+                                         ? requestParameters[type->name]
+                                         : requestParameters[position];
 
     // Evaluate the type of the parameter
-    JSONRPC_STATUS status = type->Check(parameterValue, outputParameters[type->name], errorData["stack"]);
+    CVariant stackError;
+    JSONRPC_STATUS status = type->Check(parameterValue, outputParameters[type->name], stackError);
     if (status != OK)
+    {
+      errorData["stack"] = std::move(stackError);
       return status;
+    }
 
     // The parameter was present and valid
     handled++;
@@ -1476,6 +1586,16 @@ void CJSONServiceDescription::ResolveReferences()
 {
   for (const auto& it : m_types)
     it.second->ResolveReference();
+
+  // Now that the definitions are complete they can be prepared
+  // for checking the parameters of incoming method calls
+  for (const auto& it : m_types)
+    it.second->Compile();
+  for (const auto& it : m_actionMap)
+  {
+    for (const auto& parameter : it.second.parameters)
+      parameter->Compile();
+  }
 }
 
 void CJSONServiceDescription::Cleanup()
@@ -14,6 +14,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace JSONRPC
@@ -41,6 +42,16 @@ namespace JSONRPC
     void Print(bool isParameter, bool isGlobal, bool printDefault, bool printDescriptions, CVariant &output) const;
     void ResolveReference();
 
+    /*!
+     \brief Precomputes the lookup structures used by Check()
+     for this type and all of its nested types.
+
+     Must be called once all references have been resolved.
+     Types which have not been compiled are checked the slow
+     way by walking the whole definition.
+     */
+    void Compile();
+
     std::string missingReference;
 
     /*!
@@ -211,6 +222,26 @@ namespace JSONRPC
      \brief Type definition for additional properties
      */
     JSONSchemaTypeDefinitionPtr additionalProperties;
+
+    /*!
+     \brief Whether Compile() has been run on the type
+     */
+    bool compiled = false;
+
+    /*!
+     \brief Whether the type is a plain scalar type without
+     any constraints so that a value only needs a type check
+     */
+    bool simple = false;
+
+    /*!
+     \brief Hashed copy of "enums" (only used if all of the
+     allowed values are strings)
+     */
+    std::unordered_set<std::string> enumStrings;
+
+  private:
+    JSONRPC_STATUS CheckValue(const CVariant& value, CVariant& outputValue, CVariant& errorData) const;
   };
 
   /*!
@@ -128,7 +128,7 @@ JSONRPC_STATUS CPVROperations::GetChannels(const std::string &method, ITransport
     channels.Add(std::make_shared<CFileItem>(groupMember));
   }
 
-  HandleFileItemList("channelid", false, "channels", channels, parameterObject, result, true);
+  StreamFileItemList("channelid", false, "channels", channels, parameterObject, result, true);
 
   return OK;
 }
@@ -202,7 +202,7 @@ JSONRPC_STATUS CPVROperations::GetBroadcasts(const std::string &method, ITranspo
     programFull.Add(std::make_shared<CFileItem>(tag));
   }
 
-  HandleFileItemList("broadcastid", false, "broadcasts", programFull, parameterObject, result, programFull.Size(), true);
+  StreamFileItemList("broadcastid", false, "broadcasts", programFull, parameterObject, result, programFull.Size(), true);
 
   return OK;
 }
@@ -385,7 +385,7 @@ JSONRPC_STATUS CPVROperations::GetTimers(const std::string &method, ITransportLa
     timerList.Add(std::make_shared<CFileItem>(timer));
   }
 
-  HandleFileItemList("timerid", false, "timers", timerList, parameterObject, result, true);
+  StreamFileItemList("timerid", false, "timers", timerList, parameterObject, result, true);
 
   return OK;
 }
@@ -509,7 +509,7 @@ JSONRPC_STATUS CPVROperations::GetRecordings(const std::string &method, ITranspo
     recordingsList.Add(std::make_shared<CFileItem>(recording));
   }
 
-  HandleFileItemList("recordingid", true, "recordings", recordingsList, parameterObject, result, true);
+  StreamFileItemList("recordingid", true, "recordings", recordingsList, parameterObject, result, true);
 
   return OK;
 }
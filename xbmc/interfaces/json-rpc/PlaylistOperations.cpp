@@ -79,7 +79,7 @@ JSONRPC_STATUS CPlaylistOperations::GetItems(const std::string &method, ITranspo
       break;
   }
 
-  HandleFileItemList("id", true, "items", list, parameterObject, result);
+  StreamFileItemList("id", true, "items", list, parameterObject, result);
 
   return OK;
 }
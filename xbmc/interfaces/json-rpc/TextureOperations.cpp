@@ -12,7 +12,14 @@
 #include "ServiceBroker.h"
 #include "TextureCache.h"
 #include "TextureDatabase.h"
+#include "TexturePrecacheJob.h"
+#include "dialogs/GUIDialogExtendedProgressBar.h"
+#include "guilib/GUIComponent.h"
+#include "guilib/GUIWindowManager.h"
+#include "music/MusicDatabase.h"
+#include "utils/JobManager.h"
 #include "utils/Variant.h"
+#include "video/VideoDatabase.h"
 
 #include <algorithm>
 
@@ -95,3 +102,38 @@ JSONRPC_STATUS CTextureOperations::RemoveTexture(const std::string &method, ITra
 
   return ACK;
 }
+
+JSONRPC_STATUS CTextureOperations::Precache(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  std::vector<std::string> urls;
+  for (CVariant::const_iterator_array url = parameterObject["urls"].begin_array(); url != parameterObject["urls"].end_array(); ++url)
+    urls.emplace_back(url->asString());
+
+  const std::string library = parameterObject["library"].asString();
+  if (library == "video" || library == "all")
+  {
+    CVideoDatabase videodatabase;
+    if (!videodatabase.Open() || !videodatabase.GetArtURLs(urls))
+      return InternalError;
+  }
+  if (library == "music" || library == "all")
+  {
+    CMusicDatabase musicdatabase;
+    if (!musicdatabase.Open() || !musicdatabase.GetArtURLs(urls))
+      return InternalError;
+  }
+
+  if (urls.empty())
+    return ACK;
+
+  CTexturePrecacheJob* job = new CTexturePrecacheJob(std::move(urls));
+  if (parameterObject["showdialogs"].asBoolean() && CServiceBroker::GetGUI())
+  {
+    auto dialog = CServiceBroker::GetGUI()->GetWindowManager().GetWindow<CGUIDialogExtendedProgressBar>(WINDOW_DIALOG_EXT_PROGRESS);
+    if (dialog)
+      job->SetProgressIndicators(dialog->GetHandle(""), nullptr);
+  }
+  CServiceBroker::GetJobManager()->AddJob(job, nullptr, CJob::PRIORITY_LOW);
+
+  return ACK;
+}
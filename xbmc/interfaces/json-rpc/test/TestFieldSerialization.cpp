@@ -0,0 +1,199 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "music/tags/MusicInfoTag.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/Variant.h"
+#include "video/VideoInfoTag.h"
+
+#include <chrono>
+#include <iostream>
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace MUSIC_INFO;
+
+namespace
+{
+// properties requested by typical remote apps
+const std::set<std::string> MOVIE_PROPERTIES{"title", "year",   "rating",    "playcount",
+                                             "runtime", "genre", "thumbnail", "file",
+                                             "art",   "resume", "dateadded", "uniqueid"};
+const std::set<std::string> SONG_PROPERTIES{"title",    "artist",  "album",     "track",
+                                            "duration", "albumid", "thumbnail", "file",
+                                            "genre",    "year",    "playcount", "rating"};
+
+std::shared_ptr<CFileItem> CreateMovie(int id)
+{
+  auto item = std::make_shared<CFileItem>("/movies/movie" + std::to_string(id) + ".mkv", false);
+  CVideoInfoTag& tag = *item->GetVideoInfoTag();
+  tag.m_iDbId = id;
+  tag.m_type = MediaTypeMovie;
+  tag.SetTitle("Movie " + std::to_string(id));
+  tag.SetYear(2000 + id % 25);
+  tag.SetPlot(std::string(1000, 'p'));
+  tag.SetGenre({"Drama", "Thriller"});
+  tag.SetDirector({"Director"});
+  tag.SetUniqueID("tt" + std::to_string(1000000 + id), "imdb", true);
+  tag.SetRating(7.5f, 1000, "imdb", true);
+  for (int i = 0; i < 20; ++i)
+  {
+    SActorInfo actor;
+    actor.strName = "Actor " + std::to_string(i);
+    actor.strRole = "Role " + std::to_string(i);
+    actor.order = i;
+    tag.m_cast.push_back(actor);
+  }
+  return item;
+}
+
+std::shared_ptr<CFileItem> CreateSong(int id)
+{
+  auto item = std::make_shared<CFileItem>("/music/song" + std::to_string(id) + ".flac", false);
+  CMusicInfoTag& tag = *item->GetMusicInfoTag();
+  tag.SetDatabaseId(id, MediaTypeSong);
+  tag.SetTitle("Song " + std::to_string(id));
+  tag.SetArtist(std::vector<std::string>{"Artist"});
+  tag.SetAlbum("Album");
+  tag.SetTrackNumber(id % 20);
+  tag.SetDuration(240);
+  tag.SetLyrics(std::string(2000, 'l'));
+  tag.SetComment(std::string(200, 'c'));
+  return item;
+}
+
+void ExpectProjection(const ISerializable& info, const std::set<std::string>& fields)
+{
+  CVariant full;
+  info.Serialize(full);
+
+  CVariant projected;
+  info.SerializeFields(projected, fields);
+
+  for (auto it = projected.begin_map(); it != projected.end_map(); ++it)
+    EXPECT_TRUE(fields.find(it->first) != fields.end()) << it->first;
+
+  for (const auto& field : fields)
+  {
+    EXPECT_EQ(full.isMember(field), projected.isMember(field)) << field;
+    if (full.isMember(field))
+      EXPECT_EQ(full[field], projected[field]) << field;
+  }
+}
+
+struct VariantSize
+{
+  size_t nodes = 0;
+  size_t stringBytes = 0;
+};
+
+// the values and string payloads a serialization keeps in memory
+void AddVariantSize(const CVariant& variant, VariantSize& size)
+{
+  size.nodes++;
+  if (variant.isString())
+    size.stringBytes += variant.asString().size();
+  else if (variant.isArray())
+  {
+    for (auto it = variant.begin_array(); it != variant.end_array(); ++it)
+      AddVariantSize(*it, size);
+  }
+  else if (variant.isObject())
+  {
+    for (auto it = variant.begin_map(); it != variant.end_map(); ++it)
+    {
+      size.stringBytes += it->first.size();
+      AddVariantSize(it->second, size);
+    }
+  }
+}
+
+// serialize the items the way CFileItemHandler::FillDetails did before and does now
+void Benchmark(const char* name,
+               const CFileItemList& items,
+               const std::set<std::string>& fields,
+               const ISerializable* (*info)(const CFileItem&))
+{
+  for (const bool projected : {false, true})
+  {
+    VariantSize materialized;
+    size_t written = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& item : items)
+    {
+      CVariant serialization;
+      if (projected)
+        info(*item)->SerializeFields(serialization, fields);
+      else
+        info(*item)->Serialize(serialization);
+
+      CVariant row;
+      for (const auto& field : fields)
+      {
+        if (serialization.isMember(field))
+          row[field] = serialization[field];
+      }
+
+      AddVariantSize(serialization, materialized);
+
+      std::string json;
+      CJSONVariantWriter::Write(row, json, true);
+      written += json.size();
+    }
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+    std::cout << name << (projected ? " (projected): " : " (full): ")
+              << items.Size() / duration.count() << " items/s, per item "
+              << materialized.nodes / items.Size() << " CVariant nodes holding "
+              << materialized.stringBytes / items.Size() << " string bytes, "
+              << written / items.Size() << " bytes written" << std::endl;
+  }
+}
+} // namespace
+
+TEST(TestFieldSerialization, VideoInfoTag)
+{
+  ExpectProjection(*CreateMovie(1)->GetVideoInfoTag(), MOVIE_PROPERTIES);
+  ExpectProjection(*CreateMovie(2)->GetVideoInfoTag(), {"cast", "streamdetails", "ratings"});
+  ExpectProjection(*CreateMovie(3)->GetVideoInfoTag(), {});
+}
+
+TEST(TestFieldSerialization, MusicInfoTag)
+{
+  ExpectProjection(*CreateSong(1)->GetMusicInfoTag(), SONG_PROPERTIES);
+  ExpectProjection(*CreateSong(2)->GetMusicInfoTag(), {"contributors", "albumreleasetype"});
+}
+
+TEST(TestFieldSerialization, FileItem)
+{
+  ExpectProjection(*CreateMovie(1), MOVIE_PROPERTIES);
+  ExpectProjection(*CreateSong(1), {"title", "size", "lastmodified", "mimetype"});
+}
+
+// items/s and CVariant nodes created by full against projected serialization
+TEST(TestFieldSerialization, DISABLED_Benchmark)
+{
+  const int count = 10000;
+
+  CFileItemList movies;
+  CFileItemList songs;
+  for (int i = 0; i < count; ++i)
+  {
+    movies.Add(CreateMovie(i));
+    songs.Add(CreateSong(i));
+  }
+
+  Benchmark("VideoLibrary.GetMovies", movies, MOVIE_PROPERTIES,
+            [](const CFileItem& item) -> const ISerializable* { return item.GetVideoInfoTag(); });
+  Benchmark("AudioLibrary.GetSongs", songs, SONG_PROPERTIES,
+            [](const CFileItem& item) -> const ISerializable* { return item.GetMusicInfoTag(); });
+}
@@ -0,0 +1,223 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "interfaces/json-rpc/IClient.h"
+#include "interfaces/json-rpc/ITransportLayer.h"
+#include "interfaces/json-rpc/JSONServiceDescription.h"
+#include "utils/Variant.h"
+
+#include <chrono>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+using namespace JSONRPC;
+
+namespace
+{
+constexpr const char* PLAYER_ID = R"("Player.Id": {
+  "type": "integer",
+  "minimum": 0,
+  "maximum": 2,
+  "default": -1
+})";
+
+constexpr const char* PLAYER_PROPERTY_NAME = R"("Player.Property.Name": {
+  "type": "string",
+  "enum": [ "type", "partymode", "speed", "time", "percentage", "totaltime", "playlistid",
+            "position", "repeat", "shuffled", "canseek", "canchangespeed", "canmove", "canzoom",
+            "canrotate", "canshuffle", "canrepeat", "currentaudiostream", "audiostreams",
+            "subtitleenabled", "currentsubtitle", "subtitles", "live", "currentvideostream",
+            "videostreams", "cachepercentage" ]
+})";
+
+constexpr const char* PLAYER_GETPROPERTIES = R"("Player.GetProperties": {
+  "type": "method",
+  "description": "Retrieves the values of the given properties",
+  "transport": "Response",
+  "permission": "ReadData",
+  "params": [
+    { "name": "playerid", "$ref": "Player.Id", "required": true },
+    { "name": "properties", "type": "array", "uniqueItems": true, "required": true,
+      "items": { "$ref": "Player.Property.Name" } }
+  ],
+  "returns": "string"
+})";
+
+constexpr const char* PLAYER_SETSPEED = R"("Player.SetSpeed": {
+  "type": "method",
+  "description": "Set the speed of the current playback",
+  "transport": "Response",
+  "permission": "ControlPlayback",
+  "params": [
+    { "name": "playerid", "type": "integer", "required": true },
+    { "name": "speed", "type": "integer", "required": true }
+  ],
+  "returns": "string"
+})";
+
+JSONRPC_STATUS Dummy(const std::string& method,
+                     ITransportLayer* transport,
+                     IClient* client,
+                     const CVariant& parameterObject,
+                     CVariant& result)
+{
+  return OK;
+}
+
+class CTransport : public ITransportLayer
+{
+public:
+  bool PrepareDownload(const char* path, CVariant& details, std::string& protocol) override
+  {
+    return false;
+  }
+  bool Download(const char* path, CVariant& result) override { return false; }
+  int GetCapabilities() override { return Response; }
+};
+
+class CClient : public IClient
+{
+public:
+  int GetPermissionFlags() override { return OPERATION_PERMISSION_ALL; }
+  int GetAnnouncementFlags() override { return 0; }
+  bool SetAnnouncementFlags(int flags) override { return false; }
+};
+
+class TestServiceDescription : public testing::Test
+{
+protected:
+  TestServiceDescription()
+  {
+    CJSONServiceDescription::AddType(PLAYER_ID);
+    CJSONServiceDescription::AddType(PLAYER_PROPERTY_NAME);
+    CJSONServiceDescription::AddMethod(PLAYER_GETPROPERTIES, Dummy);
+    CJSONServiceDescription::AddMethod(PLAYER_SETSPEED, Dummy);
+  }
+
+  ~TestServiceDescription() override { CJSONServiceDescription::Cleanup(); }
+
+  JSONRPC_STATUS Check(const char* method, const CVariant& parameters, CVariant& output)
+  {
+    MethodCall methodCall = nullptr;
+    return CJSONServiceDescription::CheckCall(method, parameters, &m_transport, &m_client, false,
+                                              methodCall, output);
+  }
+
+  static CVariant GetPropertiesParameters(const std::vector<std::string>& properties)
+  {
+    CVariant parameters(CVariant::VariantTypeObject);
+    parameters["playerid"] = 1;
+    parameters["properties"] = CVariant(CVariant::VariantTypeArray);
+    for (const auto& property : properties)
+      parameters["properties"].push_back(property);
+    return parameters;
+  }
+
+  // validates a set of valid and invalid calls, the results must not depend
+  // on whether the schema has been compiled or not
+  void CheckCalls()
+  {
+    CVariant output;
+    ASSERT_EQ(OK, Check("Player.GetProperties",
+                        GetPropertiesParameters({"speed", "time", "totaltime"}), output));
+    EXPECT_EQ(1, output["playerid"].asInteger());
+    ASSERT_EQ(3u, output["properties"].size());
+    EXPECT_EQ("totaltime", output["properties"][2].asString());
+
+    output.clear();
+    ASSERT_EQ(InvalidParams,
+              Check("Player.GetProperties", GetPropertiesParameters({"speed", "unknown"}), output));
+    EXPECT_EQ("Player.GetProperties", output["method"].asString());
+    EXPECT_EQ("properties", output["stack"]["name"].asString());
+    EXPECT_EQ("array element at index 1 does not match", output["stack"]["message"].asString());
+    EXPECT_EQ("string", output["stack"]["property"]["type"].asString());
+
+    output.clear();
+    ASSERT_EQ(InvalidParams, Check("Player.GetProperties",
+                                   GetPropertiesParameters({"speed", "time", "speed"}), output));
+    EXPECT_EQ(
+        "Array element at index 0 is not unique (same as array element at index 2)",
+        output["stack"]["message"].asString());
+
+    output.clear();
+    CVariant parameters = GetPropertiesParameters({"speed"});
+    parameters["playerid"] = 3;
+    ASSERT_EQ(InvalidParams, Check("Player.GetProperties", parameters, output));
+    EXPECT_EQ("playerid", output["stack"]["name"].asString());
+    EXPECT_EQ("integer", output["stack"]["type"].asString());
+
+    output.clear();
+    parameters = CVariant(CVariant::VariantTypeObject);
+    parameters["playerid"] = 1;
+    parameters["speed"] = 2;
+    ASSERT_EQ(OK, Check("Player.SetSpeed", parameters, output));
+    EXPECT_EQ(2, output["speed"].asInteger());
+
+    output.clear();
+    parameters["speed"] = "fast";
+    ASSERT_EQ(InvalidParams, Check("Player.SetSpeed", parameters, output));
+    EXPECT_EQ("speed", output["stack"]["name"].asString());
+    EXPECT_EQ("Invalid type string received", output["stack"]["message"].asString());
+
+    output.clear();
+    parameters.erase("speed");
+    ASSERT_EQ(InvalidParams, Check("Player.SetSpeed", parameters, output));
+    EXPECT_EQ("Missing parameter", output["stack"]["message"].asString());
+  }
+
+  CTransport m_transport;
+  CClient m_client;
+};
+} // namespace
+
+TEST_F(TestServiceDescription, Check)
+{
+  CheckCalls();
+}
+
+TEST_F(TestServiceDescription, CheckCompiled)
+{
+  CJSONServiceDescription::ResolveReferences();
+
+  const JSONSchemaTypeDefinitionPtr propertyName =
+      CJSONServiceDescription::GetType("Player.Property.Name");
+  ASSERT_TRUE(propertyName);
+  EXPECT_TRUE(propertyName->compiled);
+  EXPECT_EQ(propertyName->enums.size(), propertyName->enumStrings.size());
+  EXPECT_FALSE(CJSONServiceDescription::GetType("Player.Id")->simple);
+
+  CheckCalls();
+}
+
+// per call overhead of validating the parameters of a small, frequently polled method
+TEST_F(TestServiceDescription, DISABLED_Benchmark)
+{
+  const int calls = 200000;
+  const CVariant parameters = GetPropertiesParameters(
+      {"type", "speed", "time", "percentage", "totaltime", "position", "live", "canseek"});
+
+  for (bool compiled : {false, true})
+  {
+    if (compiled)
+      CJSONServiceDescription::ResolveReferences();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; ++i)
+    {
+      CVariant output;
+      ASSERT_EQ(OK, Check("Player.GetProperties", parameters, output));
+    }
+    const std::chrono::duration<double, std::micro> duration =
+        std::chrono::steady_clock::now() - start;
+
+    std::cout << (compiled ? "Compiled" : "Uncompiled") << " schema: " << calls
+              << " checks of Player.GetProperties in " << duration.count() / 1000 << " ms ("
+              << duration.count() / calls << " us per call)" << std::endl;
+  }
+}
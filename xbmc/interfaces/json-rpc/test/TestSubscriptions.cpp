@@ -0,0 +1,196 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "interfaces/json-rpc/IClient.h"
+#include "interfaces/json-rpc/ITransportLayer.h"
+#include "interfaces/json-rpc/JSONRPCSubscriptions.h"
+#include "interfaces/json-rpc/JSONServiceDescription.h"
+#include "utils/JSONVariantParser.h"
+#include "utils/Variant.h"
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace JSONRPC;
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr const char* PLAYER_ID = R"("Player.Id": {
+  "type": "integer",
+  "minimum": 0,
+  "maximum": 2,
+  "default": -1
+})";
+
+constexpr const char* PLAYER_PROPERTY_NAME = R"("Player.Property.Name": {
+  "type": "string",
+  "enum": [ "speed", "time", "percentage" ]
+})";
+
+constexpr const char* PLAYER_GETPROPERTIES = R"("Player.GetProperties": {
+  "type": "method",
+  "description": "Retrieves the values of the given properties",
+  "transport": "Response",
+  "permission": "ReadData",
+  "params": [
+    { "name": "playerid", "$ref": "Player.Id", "required": true },
+    { "name": "properties", "type": "array", "uniqueItems": true, "required": true,
+      "items": { "$ref": "Player.Property.Name" } }
+  ],
+  "returns": "object"
+})";
+
+// the state of the player the subscriptions are evaluated against
+CVariant playerState;
+
+JSONRPC_STATUS GetProperties(const std::string& method,
+                             ITransportLayer* transport,
+                             IClient* client,
+                             const CVariant& parameterObject,
+                             CVariant& result)
+{
+  if (playerState.isNull())
+    return FailedToExecute;
+
+  for (auto it = parameterObject["properties"].begin_array();
+       it != parameterObject["properties"].end_array(); ++it)
+    result[it->asString()] = playerState[it->asString()];
+  return OK;
+}
+
+class CTransport : public ITransportLayer
+{
+public:
+  bool PrepareDownload(const char* path, CVariant& details, std::string& protocol) override
+  {
+    return false;
+  }
+  bool Download(const char* path, CVariant& result) override { return false; }
+  int GetCapabilities() override { return Response | Announcing; }
+};
+
+class CClient : public IClient
+{
+public:
+  int GetPermissionFlags() override { return OPERATION_PERMISSION_ALL; }
+  int GetAnnouncementFlags() override { return 0; }
+  bool SetAnnouncementFlags(int flags) override { return false; }
+  CJSONRPCSubscriptions* GetSubscriptions() override { return &m_subscriptions; }
+
+  CJSONRPCSubscriptions m_subscriptions;
+};
+
+class TestSubscriptions : public testing::Test
+{
+protected:
+  TestSubscriptions()
+  {
+    CJSONServiceDescription::AddType(PLAYER_ID);
+    CJSONServiceDescription::AddType(PLAYER_PROPERTY_NAME);
+    CJSONServiceDescription::AddMethod(PLAYER_GETPROPERTIES, GetProperties);
+    CJSONServiceDescription::ResolveReferences();
+
+    playerState = CVariant(CVariant::VariantTypeObject);
+    playerState["speed"] = 1;
+    playerState["time"] = 0;
+    playerState["percentage"] = 0.0;
+  }
+
+  ~TestSubscriptions() override
+  {
+    CJSONServiceDescription::Cleanup();
+    playerState = CVariant();
+  }
+
+  JSONRPC_STATUS Subscribe(const std::vector<std::string>& properties,
+                           int interval,
+                           CVariant& result)
+  {
+    CVariant parameters(CVariant::VariantTypeObject);
+    parameters["playerid"] = 1;
+    parameters["properties"] = CVariant(CVariant::VariantTypeArray);
+    for (const auto& property : properties)
+      parameters["properties"].push_back(property);
+    parameters["interval"] = interval;
+    return m_client.m_subscriptions.Subscribe(parameters, &m_transport, &m_client, result);
+  }
+
+  // returns the data of the notifications sent by the next evaluation
+  std::vector<CVariant> Process()
+  {
+    std::vector<std::string> notifications;
+    m_client.m_subscriptions.Process(&m_transport, &m_client, true, notifications);
+
+    std::vector<CVariant> data;
+    for (const auto& notification : notifications)
+    {
+      CVariant root;
+      EXPECT_TRUE(CJSONVariantParser::Parse(notification, root));
+      EXPECT_EQ("JSONRPC.OnPropertiesChanged", root["method"].asString());
+      data.push_back(root["params"]["data"]);
+    }
+    return data;
+  }
+
+  CTransport m_transport;
+  CClient m_client;
+};
+} // namespace
+
+TEST_F(TestSubscriptions, SendsChanges)
+{
+  CVariant result;
+  ASSERT_EQ(OK, Subscribe({"speed", "time"}, 50, result));
+  const int64_t id = result["subscriptionid"].asInteger();
+
+  // the first notification contains all values
+  std::vector<CVariant> data = Process();
+  ASSERT_EQ(1u, data.size());
+  EXPECT_EQ(id, data[0]["subscriptionid"].asInteger());
+  EXPECT_EQ(2u, data[0]["properties"].size());
+  EXPECT_EQ(1, data[0]["properties"]["speed"].asInteger());
+
+  // nothing is evaluated before the interval has passed
+  playerState["time"] = 10;
+  EXPECT_TRUE(Process().empty());
+
+  std::this_thread::sleep_for(60ms);
+  data = Process();
+  ASSERT_EQ(1u, data.size());
+  ASSERT_EQ(1u, data[0]["properties"].size());
+  EXPECT_EQ(10, data[0]["properties"]["time"].asInteger());
+
+  // nothing changed, nothing is sent
+  std::this_thread::sleep_for(60ms);
+  EXPECT_TRUE(Process().empty());
+
+  // values which are no longer available are sent as null once
+  playerState = CVariant();
+  std::this_thread::sleep_for(60ms);
+  data = Process();
+  ASSERT_EQ(1u, data.size());
+  EXPECT_TRUE(data[0]["properties"]["speed"].isNull());
+  EXPECT_TRUE(data[0]["properties"]["time"].isNull());
+
+  std::this_thread::sleep_for(60ms);
+  EXPECT_TRUE(Process().empty());
+
+  EXPECT_TRUE(m_client.m_subscriptions.Unsubscribe(static_cast<int>(id)));
+  EXPECT_FALSE(m_client.m_subscriptions.Unsubscribe(static_cast<int>(id)));
+  EXPECT_TRUE(m_client.m_subscriptions.IsEmpty());
+}
+
+TEST_F(TestSubscriptions, InvalidParameters)
+{
+  CVariant result;
+  EXPECT_EQ(InvalidParams, Subscribe({}, 50, result));
+  EXPECT_EQ(InvalidParams, Subscribe({"unknown"}, 50, result));
+  EXPECT_TRUE(m_client.m_subscriptions.IsEmpty());
+}
@@ -26,7 +26,6 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/CharsetConverter.h"
-#include "utils/JSONVariantWriter.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
 
@@ -47,7 +46,7 @@ bool XBPython::m_bInitialized = false;
 
 XBPython::XBPython()
 {
-  CServiceBroker::GetAnnouncementManager()->AddAnnouncer(this);
+  CServiceBroker::GetAnnouncementManager()->AddAnnouncer(this, true);
 }
 
 XBPython::~XBPython()
@@ -121,9 +120,9 @@ void XBPython::Announce(ANNOUNCEMENT::AnnouncementFlag flag,
   }
 
   std::string jsonData;
-  if (CJSONVariantWriter::Write(
-          data, jsonData,
-          CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact))
+  if (ANNOUNCEMENT::CAnnouncementManager::SerializeData(
+          data, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact,
+          jsonData))
     OnNotification(sender,
                    std::string(ANNOUNCEMENT::AnnouncementFlagToString(flag)) + "." +
                        std::string(message),
@@ -0,0 +1,335 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "ServiceBroker.h"
+#include "interfaces/AnnouncementManager.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "utils/JobManager.h"
+#include "utils/Variant.h"
+#include "video/VideoInfoTag.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace ANNOUNCEMENT;
+using namespace std::chrono_literals;
+
+namespace
+{
+class CTestAnnouncer : public IAnnouncer
+{
+public:
+  CTestAnnouncer() = default;
+  CTestAnnouncer(const std::string& name, std::vector<std::string>* log) : m_name(name), m_log(log)
+  {
+  }
+
+  void Announce(AnnouncementFlag flag,
+                const std::string& sender,
+                const std::string& message,
+                const CVariant& data) override
+  {
+    if (m_calls++ > 0)
+      m_concurrent = true;
+
+    if (m_block)
+      m_release.Wait();
+
+    std::string json;
+    if (CAnnouncementManager::SerializeData(data, true, json))
+    {
+      std::unique_lock<CCriticalSection> lock(m_critSection);
+      m_json = json;
+      m_messages.push_back(message + " " + json);
+      if (m_log)
+        m_log->push_back(m_name + " " + json);
+    }
+    m_received++;
+    m_calls--;
+  }
+
+  std::vector<std::string> GetMessages() const
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    return m_messages;
+  }
+
+  std::atomic<bool> m_block{false};
+  CEvent m_release{true};
+  std::atomic<int> m_received{0};
+  std::atomic<int> m_calls{0};
+  std::atomic<bool> m_concurrent{false};
+  std::string m_json;
+
+private:
+  mutable CCriticalSection m_critSection;
+  std::vector<std::string> m_messages;
+  const std::string m_name;
+  std::vector<std::string>* const m_log = nullptr;
+};
+
+std::shared_ptr<CFileItem> CreateMovie(int id)
+{
+  auto item = std::make_shared<CFileItem>("/movies/movie" + std::to_string(id) + ".mkv", false);
+  item->GetVideoInfoTag()->m_iDbId = id;
+  item->GetVideoInfoTag()->m_type = "movie";
+  return item;
+}
+
+bool WaitFor(const std::function<bool()>& condition)
+{
+  const auto end = std::chrono::steady_clock::now() + 5s;
+  while (!condition())
+  {
+    if (std::chrono::steady_clock::now() > end)
+      return false;
+    std::this_thread::sleep_for(5ms);
+  }
+  return true;
+}
+
+class TestAnnouncementManager : public testing::Test
+{
+protected:
+  TestAnnouncementManager()
+  {
+    CServiceBroker::RegisterJobManager(std::make_shared<CJobManager>());
+    m_manager.Start();
+    m_manager.AddAnnouncer(&m_slow, true);
+    m_manager.AddAnnouncer(&m_fast);
+  }
+
+  ~TestAnnouncementManager() override
+  {
+    for (CTestAnnouncer* announcer : {&m_slow, &m_fast})
+    {
+      announcer->m_block = false;
+      announcer->m_release.Set();
+    }
+    m_manager.Deinitialize();
+
+    CServiceBroker::GetJobManager()->CancelJobs();
+    CServiceBroker::GetJobManager()->Restart();
+    CServiceBroker::UnregisterJobManager();
+  }
+
+  CAnnouncementManager m_manager;
+  CTestAnnouncer m_slow;
+  CTestAnnouncer m_fast;
+};
+} // namespace
+
+TEST_F(TestAnnouncementManager, SlowAnnouncerDoesNotStallOthers)
+{
+  m_slow.m_block = true;
+
+  for (int i = 0; i < 50; i++)
+    m_manager.Announce(Other, "OnTest", CVariant(i));
+
+  EXPECT_TRUE(WaitFor([this] { return m_fast.m_received == 50; }));
+  EXPECT_EQ(0, m_slow.m_received);
+  EXPECT_EQ("49", m_fast.m_json);
+
+  m_slow.m_block = false;
+  m_slow.m_release.Set();
+  EXPECT_TRUE(WaitFor([this] { return m_slow.m_received == 50; }));
+
+  CAnnouncementManager::QueueStats stats;
+  ASSERT_TRUE(m_manager.GetQueueStats(&m_slow, stats));
+  EXPECT_EQ(50u, stats.delivered);
+  EXPECT_EQ(0u, stats.dropped);
+  EXPECT_GT(stats.maxDepth, 0u);
+}
+
+TEST_F(TestAnnouncementManager, DropsOldestWhenQueueIsFull)
+{
+  m_slow.m_block = true;
+
+  const int count = 1500;
+  for (int i = 0; i < count; i++)
+    m_manager.Announce(Other, "OnTest", CVariant(i));
+
+  EXPECT_TRUE(WaitFor([this] { return m_fast.m_received == count; }));
+
+  CAnnouncementManager::QueueStats stats;
+  ASSERT_TRUE(m_manager.GetQueueStats(&m_slow, stats));
+  EXPECT_GT(stats.dropped, 0u);
+  EXPECT_LE(stats.depth, 1000u);
+
+  // every announcement is either delivered or dropped, the newest ones are kept
+  m_slow.m_block = false;
+  m_slow.m_release.Set();
+  EXPECT_TRUE(WaitFor(
+      [this, &stats]
+      {
+        return m_manager.GetQueueStats(&m_slow, stats) &&
+               stats.delivered + stats.dropped == static_cast<uint64_t>(count);
+      }));
+  EXPECT_EQ(static_cast<int>(stats.delivered), m_slow.m_received);
+  EXPECT_EQ(std::to_string(count - 1), m_slow.m_json);
+}
+
+TEST_F(TestAnnouncementManager, CoalescesLibraryAnnouncements)
+{
+  CVariant data;
+  data["item"]["type"] = "movie";
+  data["item"]["id"] = 1;
+
+  for (int i = 0; i < 10; i++)
+    m_manager.Announce(VideoLibrary, "OnUpdate", data);
+
+  // an OnRemove in between keeps the following OnUpdate
+  m_manager.Announce(VideoLibrary, "OnRemove", data);
+  m_manager.Announce(VideoLibrary, "OnUpdate", data);
+
+  EXPECT_TRUE(WaitFor([this] { return m_fast.m_received == 3; }));
+  std::this_thread::sleep_for(200ms);
+  EXPECT_EQ(3, m_fast.m_received);
+  EXPECT_EQ(9u, m_manager.GetCoalescedCount());
+}
+
+TEST_F(TestAnnouncementManager, CoalescesLibraryItemAnnouncements)
+{
+  CVariant data;
+  data["added"] = true;
+
+  for (int i = 0; i < 10; i++)
+  {
+    m_manager.Announce(VideoLibrary, "OnUpdate", CreateMovie(1), data);
+    m_manager.Announce(VideoLibrary, "OnUpdate", CreateMovie(2), data);
+  }
+
+  EXPECT_TRUE(WaitFor([this] { return m_fast.m_received == 2; }));
+  std::this_thread::sleep_for(200ms);
+  EXPECT_EQ(2, m_fast.m_received);
+  EXPECT_EQ(18u, m_manager.GetCoalescedCount());
+}
+
+TEST_F(TestAnnouncementManager, BatchingWindowDoesNotDelayOtherAnnouncements)
+{
+  m_manager.Announce(VideoLibrary, "OnUpdate", CreateMovie(1), CVariant());
+  m_manager.Announce(Player, "OnPlay", CVariant(1));
+
+  EXPECT_TRUE(WaitFor([this] { return m_fast.m_received == 2; }));
+
+  const std::vector<std::string> messages = m_fast.GetMessages();
+  ASSERT_EQ(2u, messages.size());
+  EXPECT_EQ("OnPlay 1", messages[0]);
+  EXPECT_EQ(0u, messages[1].find("OnUpdate "));
+}
+
+TEST_F(TestAnnouncementManager, DeliversInOrderFromOneThread)
+{
+  const int count = 200;
+  for (int i = 0; i < count; i++)
+    m_manager.Announce(Other, "OnTest", CVariant(i));
+
+  EXPECT_TRUE(WaitFor([this] { return m_fast.m_received == count && m_slow.m_received == count; }));
+
+  for (const CTestAnnouncer* announcer : {&m_slow, &m_fast})
+  {
+    EXPECT_FALSE(announcer->m_concurrent);
+
+    const std::vector<std::string> messages = announcer->GetMessages();
+    ASSERT_EQ(static_cast<size_t>(count), messages.size());
+    for (int i = 0; i < count; i++)
+      EXPECT_EQ("OnTest " + std::to_string(i), messages[i]);
+  }
+}
+
+TEST_F(TestAnnouncementManager, RemoveAnnouncer)
+{
+  m_manager.RemoveAnnouncer(&m_fast);
+  m_manager.Announce(Other, "OnTest");
+
+  EXPECT_TRUE(WaitFor([this] { return m_slow.m_received == 1; }));
+  EXPECT_EQ(0, m_fast.m_received);
+
+  CAnnouncementManager::QueueStats stats;
+  EXPECT_FALSE(m_manager.GetQueueStats(&m_fast, stats));
+}
+
+TEST_F(TestAnnouncementManager, InternalAnnouncerDropsNothing)
+{
+  m_fast.m_block = true;
+
+  const int count = 1500;
+  for (int i = 0; i < count; i++)
+    m_manager.Announce(Other, "OnTest", CVariant(i));
+
+  std::this_thread::sleep_for(100ms);
+  m_fast.m_block = false;
+  m_fast.m_release.Set();
+  EXPECT_TRUE(WaitFor([this] { return m_fast.m_received == count; }));
+
+  CAnnouncementManager::QueueStats stats;
+  ASSERT_TRUE(m_manager.GetQueueStats(&m_fast, stats));
+  EXPECT_EQ(static_cast<uint64_t>(count), stats.delivered);
+  EXPECT_EQ(0u, stats.dropped);
+}
+
+TEST_F(TestAnnouncementManager, InternalAnnouncersReceiveAnnouncementsInTurn)
+{
+  m_manager.RemoveAnnouncer(&m_fast);
+
+  std::vector<std::string> log;
+  CTestAnnouncer first("first", &log);
+  CTestAnnouncer second("second", &log);
+  m_manager.AddAnnouncer(&first);
+  m_manager.AddAnnouncer(&second);
+
+  const int count = 20;
+  for (int i = 0; i < count; i++)
+    m_manager.Announce(Other, "OnTest", CVariant(i));
+
+  EXPECT_TRUE(WaitFor([&second] { return second.m_received == count; }));
+  m_manager.RemoveAnnouncer(&first);
+  m_manager.RemoveAnnouncer(&second);
+
+  // every announcement reaches both announcers before the next one is delivered
+  ASSERT_EQ(static_cast<size_t>(2 * count), log.size());
+  for (int i = 0; i < count; i++)
+  {
+    EXPECT_EQ("first " + std::to_string(i), log[2 * i]);
+    EXPECT_EQ("second " + std::to_string(i), log[2 * i + 1]);
+  }
+}
+
+TEST_F(TestAnnouncementManager, RemoveAnnouncerSkipsQueuedAnnouncements)
+{
+  m_slow.m_block = true;
+
+  for (int i = 0; i < 10; i++)
+    m_manager.Announce(Other, "OnTest", CVariant(i));
+
+  ASSERT_TRUE(WaitFor([this] { return m_slow.m_calls == 1; }));
+
+  // only the call in progress is waited for
+  std::thread release(
+      [this]
+      {
+        std::this_thread::sleep_for(50ms);
+        m_slow.m_block = false;
+        m_slow.m_release.Set();
+      });
+  m_manager.RemoveAnnouncer(&m_slow);
+  release.join();
+
+  EXPECT_EQ(1, m_slow.m_received);
+  std::this_thread::sleep_for(100ms);
+  EXPECT_EQ(1, m_slow.m_received);
+}
@@ -13143,6 +13143,34 @@ bool CMusicDatabase::GetArtTypes(const MediaType& mediaType, std::vector<std::st
   return false;
 }
 
+bool CMusicDatabase::GetArtURLs(std::vector<std::string>& urls)
+{
+  try
+  {
+    if (nullptr == m_pDB)
+      return false;
+    if (nullptr == m_pDS)
+      return false;
+
+    if (!m_pDS->query("SELECT DISTINCT url FROM art"))
+      return false;
+
+    urls.reserve(urls.size() + m_pDS->num_rows());
+    while (!m_pDS->eof())
+    {
+      urls.emplace_back(m_pDS->fv(0).get_asString());
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "{} failed", __FUNCTION__);
+  }
+  return false;
+}
+
 std::vector<std::string> CMusicDatabase::GetAvailableArtTypesForItem(int mediaId,
                                                                      const MediaType& mediaType)
 {
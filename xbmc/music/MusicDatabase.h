@@ -828,6 +828,12 @@ public:
   */
   bool GetArtTypes(const MediaType& mediaType, std::vector<std::string>& artTypes);
 
+  /*! \brief Fetch the distinct urls of all art assigned to items in the library.
+  \param urls [out] the urls of the art.
+  \return true if the query succeeded, false otherwise.
+  */
+  bool GetArtURLs(std::vector<std::string>& urls);
+
   /*! \brief Fetch the distinct types of available-but-unassigned art held in the
   database for a specific media item.
   \param mediaId the id in the media (artist/album) table.
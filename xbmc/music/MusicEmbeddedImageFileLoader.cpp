@@ -47,3 +47,17 @@ std::unique_ptr<CTexture> CMusicEmbeddedImageFileLoader::Load(const std::string&
                                           preferredHeight);
   return nullptr;
 }
+
+bool CMusicEmbeddedImageFileLoader::LoadEncoded(const std::string& specialType,
+                                                const std::string& filePath,
+                                                std::vector<uint8_t>& data,
+                                                std::string& mimeType) const
+{
+  EmbeddedArt art;
+  if (!GetEmbeddedThumb(filePath, art))
+    return false;
+
+  data = std::move(art.m_data);
+  mimeType = art.m_mime;
+  return true;
+}
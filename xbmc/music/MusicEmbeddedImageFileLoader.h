@@ -26,5 +26,9 @@ public:
                                  const std::string& filePath,
                                  unsigned int preferredWidth,
                                  unsigned int preferredHeight) const override;
+  bool LoadEncoded(const std::string& specialType,
+                   const std::string& filePath,
+                   std::vector<uint8_t>& data,
+                   std::string& mimeType) const override;
 };
 } // namespace MUSIC_INFO
@@ -40,7 +40,7 @@
 #include "music/MusicThumbLoader.h"
 #include "music/MusicUtils.h"
 #include "music/tags/MusicInfoTag.h"
-#include "music/tags/MusicInfoTagLoaderFactory.h"
+#include "music/tags/MusicInfoTagReader.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
@@ -567,11 +567,9 @@ CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
 {
   std::vector<std::string> regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioExcludeFromScanRegExps;
 
+  std::vector<CFileItemPtr> tagItems;
   for (int i = 0; i < items.Size(); ++i)
   {
-    if (m_bStop)
-      return INFO_CANCELLED;
-
     CFileItemPtr pItem = items[i];
 
     if (CUtil::ExcludeFileOrFolder(pItem->GetPath(), regexps))
@@ -580,18 +578,26 @@ CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
     if (pItem->m_bIsFolder || pItem->IsPlayList() || pItem->IsPicture() || pItem->IsLyrics())
       continue;
 
-    m_currentItem++;
-
-    CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
-    if (!tag.Loaded())
-    {
-      std::unique_ptr<IMusicInfoTagLoader> pLoader (CMusicInfoTagLoaderFactory::CreateLoader(*pItem));
-      if (nullptr != pLoader)
-        pLoader->Load(pItem->GetPath(), tag);
-    }
+    tagItems.emplace_back(pItem);
+  }
 
+  // read the tags as jobs, the results are handled below in the original order
+  const int firstItem = m_currentItem;
+  const auto progress = [this, firstItem](size_t done) {
+    m_currentItem = firstItem + static_cast<int>(done);
     if (m_handle && m_itemCount>0)
       m_handle->SetPercentage(static_cast<float>(m_currentItem * 100) / static_cast<float>(m_itemCount));
+  };
+  if (!CMusicInfoTagReader().Load(tagItems, [this]() { return m_bStop; }, progress))
+    return INFO_CANCELLED;
+  progress(tagItems.size());
+
+  for (const auto& pItem : tagItems)
+  {
+    if (m_bStop)
+      return INFO_CANCELLED;
+
+    const CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
 
     if (!tag.Loaded() && !pItem->HasCueDocument())
     {
@@ -19,6 +19,7 @@ class CVariant;
 #include "utils/ISerializable.h"
 #include "utils/ISortable.h"
 
+#include <set>
 #include <string>
 #include <vector>
 
@@ -192,6 +193,7 @@ public:
 
   void Archive(CArchive& ar) override;
   void Serialize(CVariant& ar) const override;
+  void SerializeFields(CVariant& value, const std::set<std::string>& fields) const override;
   void ToSortable(SortItem& sortable, Field field) const override;
 
   void Clear();
@@ -203,6 +205,10 @@ protected:
    */
   std::string Trim(const std::string &value) const;
 
+  /*! \brief Serialize the given fields, or everything if fields is nullptr.
+   */
+  void Serialize(CVariant& value, const std::set<std::string>* fields) const;
+
   std::string m_strURL;
   std::string m_strTitle;
   std::vector<std::string> m_artist;
@@ -0,0 +1,218 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "MusicInfoTagReader.h"
+
+#include "FileItem.h"
+#include "MusicInfoTag.h"
+#include "MusicInfoTagLoaderFactory.h"
+#include "ServiceBroker.h"
+#include "URL.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "utils/CPUInfo.h"
+#include "utils/Job.h"
+#include "utils/JobManager.h"
+#include "utils/URIUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <utility>
+
+using namespace std::chrono_literals;
+
+namespace MUSIC_INFO
+{
+// the jobs of a single Load() call
+struct CMusicInfoTagReadState
+{
+  explicit CMusicInfoTagReadState(const std::function<bool()>& stopFunc) : stop(stopFunc) {}
+
+  bool IsStopped()
+  {
+    if (!stopped && stop && stop())
+      stopped = true;
+    return stopped;
+  }
+
+  const std::function<bool()>& stop;
+  std::atomic<bool> stopped{false};
+
+  CCriticalSection critSection;
+  CEvent jobFinished;
+  size_t finishedJobs = 0;
+};
+
+class CMusicInfoTagReadJob : public CJob
+{
+public:
+  CMusicInfoTagReadJob(const CMusicInfoTagReader& reader,
+                       CFileItem& item,
+                       CMusicInfoTagReadState& state)
+    : m_reader(reader), m_item(item), m_state(state)
+  {
+  }
+
+  // the job manager deletes jobs when they are done, cancelled or could not be added
+  ~CMusicInfoTagReadJob() override
+  {
+    std::unique_lock<CCriticalSection> lock(m_state.critSection);
+    m_state.finishedJobs++;
+    m_state.jobFinished.Set();
+  }
+
+  const char* GetType() const override { return "musictagreader"; }
+
+  bool DoWork() override
+  {
+    if (m_state.IsStopped())
+      return false;
+
+    m_reader.LoadTag(m_item);
+    return true;
+  }
+
+private:
+  const CMusicInfoTagReader& m_reader;
+  CFileItem& m_item;
+  CMusicInfoTagReadState& m_state;
+};
+} // namespace MUSIC_INFO
+
+using namespace MUSIC_INFO;
+
+namespace
+{
+constexpr unsigned int MAX_LOCAL_THREADS = 8;
+
+// how often the stop function is polled while waiting for the jobs
+constexpr auto STOP_POLL_INTERVAL = 100ms;
+} // namespace
+
+CMusicInfoTagReader::CMusicInfoTagReader(unsigned int localThreads,
+                                         unsigned int remoteThreads,
+                                         LoaderFactory factory /* = {} */)
+  : m_localThreads(std::max(localThreads, 1u)),
+    m_remoteThreads(std::max(remoteThreads, 1u)),
+    m_factory(factory ? std::move(factory) : LoaderFactory(CMusicInfoTagLoaderFactory::CreateLoader))
+{
+}
+
+CMusicInfoTagReader::CMusicInfoTagReader() : m_factory(CMusicInfoTagLoaderFactory::CreateLoader)
+{
+  const auto advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+
+  int localThreads = advancedSettings->m_musicLibraryTagReadThreads;
+  if (localThreads <= 0)
+    localThreads = std::min(static_cast<unsigned int>(CServiceBroker::GetCPUInfo()->GetCPUCount()),
+                            MAX_LOCAL_THREADS);
+
+  m_localThreads = std::max(localThreads, 1);
+  m_remoteThreads = std::max(advancedSettings->m_musicLibraryRemoteTagReadThreads, 1);
+}
+
+unsigned int CMusicInfoTagReader::GetParallelism(const std::string& path) const
+{
+  // seeking on optical media is slow, never read more than one file at a time
+  if (URIUtils::IsCDDA(path) || URIUtils::IsDVD(path) || URIUtils::IsOnDVD(path))
+    return 1;
+
+  if (URIUtils::IsRemote(path))
+    return std::min(m_remoteThreads, m_localThreads);
+
+  return m_localThreads;
+}
+
+std::string CMusicInfoTagReader::GetSourceKey(const std::string& path)
+{
+  const CURL url(path);
+  return url.GetProtocol() + "://" + url.GetHostName();
+}
+
+void CMusicInfoTagReader::LoadTag(CFileItem& item) const
+{
+  CMusicInfoTag& tag = *item.GetMusicInfoTag();
+  if (tag.Loaded())
+    return;
+
+  std::unique_ptr<IMusicInfoTagLoader> loader(m_factory(item));
+  if (loader)
+    loader->Load(item.GetPath(), tag);
+}
+
+bool CMusicInfoTagReader::Load(const std::vector<std::shared_ptr<CFileItem>>& items,
+                               const std::function<bool()>& stop /* = {} */,
+                               const ProgressCallback& progress /* = {} */) const
+{
+  // group the items by source, keeping the order of the items within each source
+  std::map<std::string, std::vector<CFileItem*>> sources;
+  for (const auto& item : items)
+  {
+    // make sure the tag exists before handing the item to a job
+    if (!item->GetMusicInfoTag()->Loaded())
+      sources[GetSourceKey(item->GetPath())].emplace_back(item.get());
+  }
+
+  size_t jobs = 0;
+  for (const auto& source : sources)
+    jobs += source.second.size();
+  const size_t loadedBefore = items.size() - jobs;
+
+  CMusicInfoTagReadState state(stop);
+
+  // every source is read by a queue of its own, all sources at the same time
+  std::vector<std::unique_ptr<CJobQueue>> queues;
+  for (const auto& source : sources)
+  {
+    const std::vector<CFileItem*>& sourceItems = source.second;
+    const unsigned int threads = std::min(GetParallelism(sourceItems.front()->GetPath()),
+                                          static_cast<unsigned int>(sourceItems.size()));
+
+    CLog::Log(LOGDEBUG, "CMusicInfoTagReader::{} - reading {} file(s) from '{}' using {} thread(s)",
+              __FUNCTION__, sourceItems.size(), CURL::GetRedacted(source.first), threads);
+
+    // dedicated workers, the job manager would limit the other priorities to a few workers
+    queues.emplace_back(std::make_unique<CJobQueue>(false, threads, CJob::PRIORITY_DEDICATED));
+    for (CFileItem* item : sourceItems)
+      queues.back()->AddJob(new CMusicInfoTagReadJob(*this, *item, state));
+  }
+
+  size_t reported = 0;
+  while (true)
+  {
+    size_t finished;
+    {
+      std::unique_lock<CCriticalSection> lock(state.critSection);
+      finished = state.finishedJobs;
+    }
+
+    if (progress && finished != reported)
+      progress(loadedBefore + finished);
+    reported = finished;
+
+    if (finished == jobs)
+      break;
+
+    if (state.IsStopped())
+    {
+      // jobs already running complete their item, the queued ones are dropped
+      for (auto& queue : queues)
+        queue->CancelJobs();
+    }
+
+    state.jobFinished.Wait(STOP_POLL_INTERVAL);
+  }
+
+  return !state.stopped;
+}
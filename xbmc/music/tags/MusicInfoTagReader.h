@@ -0,0 +1,73 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class CFileItem;
+
+namespace MUSIC_INFO
+{
+class IMusicInfoTagLoader;
+
+/*! \brief Reads the tags of a list of items as jobs of the job manager.
+ Items are grouped by the source they are read from, and each source has a job queue with its own
+ degree of parallelism: local disks benefit from reading many files at once, network shares are
+ read with a few connections only and optical media strictly one file at a time. Every item is
+ handled by a single job, so the tags end up in the items exactly as if they had been read
+ sequentially.
+ */
+class CMusicInfoTagReader
+{
+public:
+  using LoaderFactory = std::function<IMusicInfoTagLoader*(const CFileItem& item)>;
+  using ProgressCallback = std::function<void(size_t done)>;
+
+  /*! \brief Create a reader
+   \param localThreads maximum number of files read at once from local sources.
+   \param remoteThreads maximum number of files read at once from a network source.
+   \param factory creates the tag loader for an item. Defaults to CMusicInfoTagLoaderFactory.
+   */
+  CMusicInfoTagReader(unsigned int localThreads,
+                      unsigned int remoteThreads,
+                      LoaderFactory factory = {});
+
+  /*! \brief Create a reader with the degree of parallelism configured in advancedsettings.xml
+   */
+  CMusicInfoTagReader();
+
+  /*! \brief Read the tags of all items which have no tag loaded yet.
+   \param items the items to read the tags for.
+   \param stop optional function polled while reading, reading stops once it returns true.
+   \param progress optional function called with the number of items done, whenever reading of
+   some items has completed. It is called on the calling thread.
+   \return false if reading was stopped, true otherwise.
+   */
+  bool Load(const std::vector<std::shared_ptr<CFileItem>>& items,
+            const std::function<bool()>& stop = {},
+            const ProgressCallback& progress = {}) const;
+
+  /*! \brief Get the number of files read at once from the source of the given path.
+   */
+  unsigned int GetParallelism(const std::string& path) const;
+
+private:
+  friend class CMusicInfoTagReadJob;
+
+  static std::string GetSourceKey(const std::string& path);
+  void LoadTag(CFileItem& item) const;
+
+  unsigned int m_localThreads;
+  unsigned int m_remoteThreads;
+  LoaderFactory m_factory;
+};
+} // namespace MUSIC_INFO
@@ -0,0 +1,218 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "ServiceBroker.h"
+#include "filesystem/File.h"
+#include "music/tags/MusicInfoTag.h"
+#include "music/tags/MusicInfoTagReader.h"
+#include "music/tags/TagLoaderTagLib.h"
+#include "test/TestUtils.h"
+#include "utils/JobManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <taglib/flacfile.h>
+#include <taglib/mpegfile.h>
+#include <taglib/tag.h>
+#include <taglib/xiphcomment.h>
+
+using namespace MUSIC_INFO;
+
+namespace
+{
+// MPEG-1 layer 3, 128 kbit/s, 44.1 kHz
+constexpr uint8_t MP3_FRAME_HEADER[] = {0xFF, 0xFB, 0x90, 0x64};
+constexpr size_t MP3_FRAME_SIZE = 417;
+constexpr int MP3_FRAMES = 8;
+
+std::vector<uint8_t> GenerateMP3()
+{
+  std::vector<uint8_t> data;
+  for (int i = 0; i < MP3_FRAMES; ++i)
+  {
+    data.insert(data.end(), std::begin(MP3_FRAME_HEADER), std::end(MP3_FRAME_HEADER));
+    data.resize(data.size() + MP3_FRAME_SIZE - sizeof(MP3_FRAME_HEADER), 0);
+  }
+  return data;
+}
+
+std::vector<uint8_t> GenerateFLAC()
+{
+  std::vector<uint8_t> data{'f', 'L', 'a', 'C'};
+
+  // STREAMINFO: 4096 samples per block, 44.1 kHz, stereo, 16 bits per sample
+  data.insert(data.end(), {0x00, 0x00, 0x00, 34});
+  data.insert(data.end(), {0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+  const uint64_t format = (44100ULL << 44) | (1ULL << 41) | (15ULL << 36);
+  for (int shift = 56; shift >= 0; shift -= 8)
+    data.push_back(static_cast<uint8_t>(format >> shift));
+  data.resize(data.size() + 16, 0); // MD5 signature
+
+  // empty PADDING block, last metadata block
+  data.insert(data.end(), {0x81, 0x00, 0x00, 0x00});
+
+  // start of the first (empty) audio frame
+  data.insert(data.end(), {0xFF, 0xF8, 0xC9, 0x18});
+  data.resize(data.size() + 64, 0);
+  return data;
+}
+
+class TestMusicInfoTagReader : public testing::Test
+{
+protected:
+  TestMusicInfoTagReader() { CServiceBroker::RegisterJobManager(std::make_shared<CJobManager>()); }
+
+  ~TestMusicInfoTagReader() override
+  {
+    CServiceBroker::GetJobManager()->CancelJobs();
+    CServiceBroker::GetJobManager()->Restart();
+    CServiceBroker::UnregisterJobManager();
+
+    for (auto file : m_files)
+      XBMC_DELETETEMPFILE(file);
+  }
+
+  // create count files alternating between mp3 and flac, tagged with their index as title
+  void CreateFiles(int count, CFileItemList& items)
+  {
+    const std::vector<uint8_t> mp3 = GenerateMP3();
+    const std::vector<uint8_t> flac = GenerateFLAC();
+
+    for (int i = 0; i < count; ++i)
+    {
+      const bool isFlac = (i % 2) != 0;
+      XFILE::CFile* file = XBMC_CREATETEMPFILE(isFlac ? ".flac" : ".mp3");
+      if (!file)
+        continue;
+      m_files.push_back(file);
+
+      const std::vector<uint8_t>& data = isFlac ? flac : mp3;
+      file->Write(data.data(), data.size());
+      file->Flush();
+
+      const std::string path = XBMC_TEMPFILEPATH(file);
+      const std::string title = "Track " + std::to_string(i);
+      if (isFlac)
+      {
+        TagLib::FLAC::File tagFile(path.c_str());
+        tagFile.xiphComment(true)->setTitle(title);
+        tagFile.xiphComment(true)->setAlbum("Album");
+        tagFile.save();
+      }
+      else
+      {
+        TagLib::MPEG::File tagFile(path.c_str());
+        tagFile.tag()->setTitle(title);
+        tagFile.tag()->setAlbum("Album");
+        tagFile.save();
+      }
+
+      items.Add(std::make_shared<CFileItem>(path, false));
+    }
+  }
+
+  static CMusicInfoTagReader::LoaderFactory TagLibFactory()
+  {
+    return [](const CFileItem&) { return new CTagLoaderTagLib(); };
+  }
+
+  std::vector<XFILE::CFile*> m_files;
+};
+} // namespace
+
+TEST_F(TestMusicInfoTagReader, ReadsAllTags)
+{
+  const int count = 24;
+  CFileItemList items;
+  CreateFiles(count, items);
+  ASSERT_EQ(count, items.Size());
+
+  CMusicInfoTagReader reader(4, 2, TagLibFactory());
+  EXPECT_TRUE(reader.Load(items.GetList()));
+
+  for (int i = 0; i < items.Size(); ++i)
+  {
+    const CMusicInfoTag& tag = *items[i]->GetMusicInfoTag();
+    EXPECT_TRUE(tag.Loaded());
+    EXPECT_EQ("Track " + std::to_string(i), tag.GetTitle());
+    EXPECT_EQ("Album", tag.GetAlbum());
+  }
+}
+
+TEST_F(TestMusicInfoTagReader, Progress)
+{
+  const int count = 16;
+  CFileItemList items;
+  CreateFiles(count, items);
+  ASSERT_EQ(count, items.Size());
+
+  // an item with its tag loaded already counts as done
+  items[0]->GetMusicInfoTag()->SetLoaded(true);
+
+  std::vector<size_t> progress;
+  CMusicInfoTagReader reader(4, 2, TagLibFactory());
+  EXPECT_TRUE(
+      reader.Load(items.GetList(), {}, [&progress](size_t done) { progress.push_back(done); }));
+
+  ASSERT_FALSE(progress.empty());
+  EXPECT_TRUE(std::is_sorted(progress.begin(), progress.end()));
+  EXPECT_LT(0u, progress.front());
+  EXPECT_EQ(static_cast<size_t>(count), progress.back());
+}
+
+TEST_F(TestMusicInfoTagReader, Stop)
+{
+  CFileItemList items;
+  CreateFiles(8, items);
+
+  CMusicInfoTagReader reader(4, 2, TagLibFactory());
+  EXPECT_FALSE(reader.Load(items.GetList(), []() { return true; }));
+
+  for (const auto& item : items)
+    EXPECT_FALSE(item->GetMusicInfoTag()->Loaded());
+}
+
+TEST_F(TestMusicInfoTagReader, Parallelism)
+{
+  CMusicInfoTagReader reader(8, 2);
+  EXPECT_EQ(8u, reader.GetParallelism("/music/album/01.flac"));
+  EXPECT_EQ(2u, reader.GetParallelism("smb://server/music/album/01.flac"));
+  EXPECT_EQ(1u, reader.GetParallelism("cdda://local/01.cdda"));
+}
+
+// sequential against parallel tag reading of generated files
+TEST_F(TestMusicInfoTagReader, DISABLED_Benchmark)
+{
+  const int count = 1000;
+  const unsigned int threads = std::max(std::thread::hardware_concurrency(), 2u);
+
+  for (unsigned int parallelism : {1u, threads})
+  {
+    CFileItemList items;
+    CreateFiles(count, items);
+    ASSERT_EQ(count, items.Size());
+
+    CMusicInfoTagReader reader(parallelism, parallelism, TagLibFactory());
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(reader.Load(items.GetList()));
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Read " << count << " tags using " << parallelism << " thread(s) in "
+              << duration.count() << " s (" << count / duration.count() << " files/s)"
+              << std::endl;
+  }
+}
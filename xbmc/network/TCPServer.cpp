@@ -11,6 +11,7 @@
 #include "ServiceBroker.h"
 #include "interfaces/AnnouncementManager.h"
 #include "interfaces/json-rpc/JSONRPC.h"
+#include "interfaces/json-rpc/JSONRPCResponseStream.h"
 #include "network/Network.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
@@ -18,6 +19,8 @@
 #include "utils/log.h"
 #include "websocket/WebSocketManager.h"
 
+#include <algorithm>
+#include <memory>
 #include <mutex>
 #include <stdio.h>
 #include <stdlib.h>
@@ -58,6 +61,7 @@ using namespace JSONRPC;
 namespace
 {
 constexpr size_t maxBufferLength = 64 * 1024;
+constexpr size_t responseChunkSize = 32 * 1024;
 }
 
 CTCPServer *CTCPServer::ServerInstance = NULL;
@@ -110,9 +114,15 @@ void CTCPServer::Process()
 
   while (!m_bStop)
   {
+    // send the changes of due subscriptions and wake up in time for the next ones
+    std::chrono::milliseconds timeout = 1000ms;
+    for (auto& connection : m_connections)
+      timeout = std::min(timeout, connection->ProcessSubscriptions(this));
+
     SOCKET          max_fd = 0;
     fd_set          rfds;
-    struct timeval  to     = {1, 0};
+    struct timeval  to     = {static_cast<long>(timeout.count() / 1000),
+                              static_cast<long>(timeout.count() % 1000) * 1000};
     FD_ZERO(&rfds);
 
     for (auto& it : m_servers)
@@ -265,7 +275,7 @@ bool CTCPServer::Initialize()
 
   if (started)
   {
-    CServiceBroker::GetAnnouncementManager()->AddAnnouncer(this);
+    CServiceBroker::GetAnnouncementManager()->AddAnnouncer(this, true);
     CLog::Log(LOGINFO, "JSONRPC Server: Successfully initialized");
     return true;
   }
@@ -541,6 +551,29 @@ bool CTCPServer::CTCPClient::SetAnnouncementFlags(int flags)
   return true;
 }
 
+CJSONRPCSubscriptions* CTCPServer::CTCPClient::GetSubscriptions()
+{
+  return &m_subscriptions;
+}
+
+std::chrono::milliseconds CTCPServer::CTCPClient::ProcessSubscriptions(CTCPServer* host)
+{
+  if (m_subscriptions.IsEmpty())
+    return 1000ms;
+
+  std::vector<std::string> notifications;
+  std::chrono::milliseconds timeout = m_subscriptions.Process(
+      host, this,
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact,
+      notifications);
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  for (const auto& notification : notifications)
+    Send(notification.c_str(), static_cast<unsigned int>(notification.size()));
+
+  return timeout;
+}
+
 void CTCPServer::CTCPClient::Send(const char *data, unsigned int size)
 {
   unsigned int sent = 0;
@@ -614,8 +647,7 @@ void CTCPServer::CTCPClient::PushBuffer(CTCPServer *host, const char *buffer, in
       }
       if (m_beginBrackets > 0 && m_endBrackets > 0 && m_beginBrackets == m_endBrackets)
       {
-        std::string line = CJSONRPC::MethodCall(m_buffer, host, this);
-        Send(line.c_str(), line.size());
+        HandleMethodCall(host, m_buffer);
         m_beginChar = m_beginBrackets = m_endBrackets = 0;
         m_buffer.clear();
       }
@@ -623,6 +655,20 @@ void CTCPServer::CTCPClient::PushBuffer(CTCPServer *host, const char *buffer, in
   }
 }
 
+void CTCPServer::CTCPClient::HandleMethodCall(CTCPServer* host, const std::string& request)
+{
+  std::unique_ptr<CJSONRPCResponseStream> response =
+      CJSONRPC::MethodCallStream(request, host, this);
+
+  // keep announcements from being sent in between the parts of the response
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  std::vector<char> buffer(responseChunkSize);
+  size_t size;
+  while ((size = response->Read(buffer.data(), buffer.size())) > 0)
+    Send(buffer.data(), static_cast<unsigned int>(size));
+}
+
 void CTCPServer::CTCPClient::Disconnect()
 {
   if (m_socket > 0)
@@ -641,6 +687,7 @@ void CTCPServer::CTCPClient::Copy(const CTCPClient& client)
   m_cliaddr           = client.m_cliaddr;
   m_addrlen           = client.m_addrlen;
   m_announcementflags = client.m_announcementflags;
+  m_subscriptions     = client.m_subscriptions;
   m_beginBrackets     = client.m_beginBrackets;
   m_endBrackets       = client.m_endBrackets;
   m_beginChar         = client.m_beginChar;
@@ -695,6 +742,13 @@ void CTCPServer::CWebSocketClient::Send(const char *data, unsigned int size)
     CTCPClient::Send(frames.at(index)->GetFrameData(), (unsigned int)frames.at(index)->GetFrameLength());
 }
 
+void CTCPServer::CWebSocketClient::HandleMethodCall(CTCPServer* host, const std::string& request)
+{
+  // every response has to be sent as a single websocket message
+  std::string response = CJSONRPC::MethodCall(request, host, this);
+  Send(response.c_str(), response.size());
+}
+
 void CTCPServer::CWebSocketClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
 {
   bool send;
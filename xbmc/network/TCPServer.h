@@ -11,10 +11,12 @@
 #include "interfaces/json-rpc/IClient.h"
 #include "interfaces/json-rpc/IJSONRPCAnnouncer.h"
 #include "interfaces/json-rpc/ITransportLayer.h"
+#include "interfaces/json-rpc/JSONRPCSubscriptions.h"
 #include "threads/CriticalSection.h"
 #include "threads/Thread.h"
 #include "websocket/WebSocket.h"
 
+#include <chrono>
 #include <vector>
 
 #include <sys/socket.h>
@@ -63,11 +65,18 @@ namespace JSONRPC
       int GetPermissionFlags() override;
       int GetAnnouncementFlags() override;
       bool SetAnnouncementFlags(int flags) override;
+      CJSONRPCSubscriptions* GetSubscriptions() override;
 
       virtual void Send(const char *data, unsigned int size);
       virtual void PushBuffer(CTCPServer *host, const char *buffer, int length);
       virtual void Disconnect();
 
+      /*!
+       \brief Sends the changes of all subscriptions which are due
+       \return Time until the next subscription is due
+       */
+      std::chrono::milliseconds ProcessSubscriptions(CTCPServer* host);
+
       virtual bool IsNew() const { return m_new; }
       virtual bool Closing() const { return false; }
 
@@ -78,9 +87,11 @@ namespace JSONRPC
 
     protected:
       void Copy(const CTCPClient& client);
+      virtual void HandleMethodCall(CTCPServer* host, const std::string& request);
     private:
       bool m_new;
       int m_announcementflags;
+      CJSONRPCSubscriptions m_subscriptions;
       int m_beginBrackets, m_endBrackets;
       char m_beginChar, m_endChar;
       std::string m_buffer;
@@ -102,6 +113,9 @@ namespace JSONRPC
       bool IsNew() const override { return m_websocket == NULL; }
       bool Closing() const override { return m_websocket != NULL && m_websocket->GetState() == WebSocketStateClosed; }
 
+    protected:
+      void HandleMethodCall(CTCPServer* host, const std::string& request) override;
+
     private:
       CWebSocket *m_websocket;
       std::string m_buffer;
@@ -12,6 +12,8 @@
 #include "ServiceBroker.h"
 #include "XBDateTime.h"
 #include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "network/httprequesthandler/HTTPFileCache.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
 #include "settings/Settings.h"
@@ -27,15 +29,20 @@
 #include <memory>
 #include <mutex>
 #include <stdexcept>
+#include <thread>
 #include <utility>
 
 #if defined(TARGET_POSIX)
+#include <fcntl.h>
 #include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 #include <inttypes.h>
 
 #define MAX_POST_BUFFER_SIZE 2048
+#define STREAM_DOWNLOAD_BLOCK_SIZE (32 * 1024)
 
 #define PAGE_FILE_NOT_FOUND \
   "<html><head><title>File not found</title></head><body>File not found</body></html>"
@@ -45,11 +52,20 @@
 
 #define HEADER_VALUE_NO_CACHE "no-cache"
 
+#define CONNECTION_LIMIT 512
+// keep-alive connections (e.g. of JSON-RPC clients) are closed after being idle for this long
+#define CONNECTION_IDLE_TIMEOUT (5 * 60)
+// clients may pause file downloads and streams for a long time without closing the connection
+#define CONNECTION_TRANSFER_TIMEOUT (60 * 60 * 24)
+
+#define MIN_THREAD_POOL_SIZE 4u
+#define MAX_THREAD_POOL_SIZE 16u
+
 #define HEADER_NEWLINE "\r\n"
 
 typedef struct
 {
-  std::shared_ptr<XFILE::CFile> file;
+  std::unique_ptr<CHTTPFileCache::CReader> file;
   CHttpRanges ranges;
   size_t rangeCountTotal;
   std::string boundary;
@@ -92,6 +108,41 @@ static MHD_Response* create_response(size_t size, const void* data, int free, in
   return MHD_create_response_from_buffer(size, const_cast<void*>(data), mode);
 }
 
+// Creates a response which is sent by libmicrohttpd straight from the file descriptor of a
+// local file. This allows it to use sendfile() instead of copying every block through
+// ContentReaderCallback().
+static MHD_Response* create_file_descriptor_response(const std::string& filePath,
+                                                     uint64_t offset,
+                                                     uint64_t length)
+{
+#if defined(TARGET_POSIX)
+  const std::string localPath = CSpecialProtocol::TranslatePath(filePath);
+  if (length == 0 || localPath.empty() || localPath.front() != '/')
+    return nullptr;
+
+  int fd = open(localPath.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return nullptr;
+
+  struct stat statBuffer;
+  if (fstat(fd, &statBuffer) != 0 || !S_ISREG(statBuffer.st_mode) ||
+      offset + length > static_cast<uint64_t>(statBuffer.st_size))
+  {
+    close(fd);
+    return nullptr;
+  }
+
+  // the file descriptor is closed by libmicrohttpd together with the response
+  MHD_Response* response = MHD_create_response_from_fd_at_offset64(length, fd, offset);
+  if (response == nullptr)
+    close(fd);
+
+  return response;
+#else
+  return nullptr;
+#endif
+}
+
 MHD_RESULT CWebServer::AskForAuthentication(const HTTPRequest& request) const
 {
   struct MHD_Response* response = create_response(0, nullptr, MHD_NO, MHD_NO);
@@ -209,12 +260,31 @@ MHD_RESULT CWebServer::HandlePartialRequest(struct MHD_Connection* connection,
         {
           bool cacheable = IsRequestCacheable(request);
 
+          // handle If-None-Match which takes precedence over If-Modified-Since
+          std::string etag;
+          std::string ifNoneMatch = HTTPRequestHandlerUtils::GetRequestHeaderValue(
+              connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_NONE_MATCH);
+          if (cacheable && !ifNoneMatch.empty() && handler->GetETag(etag) &&
+              HTTPRequestHandlerUtils::MatchesETag(ifNoneMatch, etag))
+          {
+            struct MHD_Response* response = create_response(0, nullptr, MHD_NO, MHD_NO);
+            if (response == nullptr)
+            {
+              m_logger->error("failed to create a HTTP 304 response");
+              return MHD_NO;
+            }
+
+            return FinalizeRequest(handler, MHD_HTTP_NOT_MODIFIED, response);
+          }
+
           CDateTime lastModified;
           if (handler->GetLastModifiedDate(lastModified) && lastModified.IsValid())
           {
             // handle If-Modified-Since or If-Unmodified-Since
-            std::string ifModifiedSince = HTTPRequestHandlerUtils::GetRequestHeaderValue(
-                connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_MODIFIED_SINCE);
+            std::string ifModifiedSince;
+            if (ifNoneMatch.empty())
+              ifModifiedSince = HTTPRequestHandlerUtils::GetRequestHeaderValue(
+                  connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_MODIFIED_SINCE);
             std::string ifUnmodifiedSince = HTTPRequestHandlerUtils::GetRequestHeaderValue(
                 connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_UNMODIFIED_SINCE);
 
@@ -349,6 +419,10 @@ MHD_RESULT CWebServer::HandleRequest(const std::shared_ptr<IHTTPRequestHandler>&
       ret = CreateFileDownloadResponse(handler, response);
       break;
 
+    case HTTPStreamDownload:
+      ret = CreateStreamDownloadResponse(handler, response);
+      break;
+
     case HTTPMemoryDownloadNoFreeNoCopy:
     case HTTPMemoryDownloadNoFreeCopy:
     case HTTPMemoryDownloadFreeNoCopy:
@@ -372,6 +446,10 @@ MHD_RESULT CWebServer::HandleRequest(const std::shared_ptr<IHTTPRequestHandler>&
     return SendErrorResponse(request, MHD_HTTP_INTERNAL_SERVER_ERROR, request.method);
   }
 
+  if (responseDetails.type == HTTPFileDownload || responseDetails.type == HTTPStreamDownload)
+    MHD_set_connection_option(request.connection, MHD_CONNECTION_OPTION_TIMEOUT,
+                              static_cast<unsigned int>(CONNECTION_TRANSFER_TIMEOUT));
+
   return FinalizeRequest(handler, responseDetails.status, response);
 }
 
@@ -394,6 +472,11 @@ MHD_RESULT CWebServer::FinalizeRequest(const std::shared_ptr<IHTTPRequestHandler
   if (handler->GetLastModifiedDate(lastModified) && lastModified.IsValid())
     handler->AddResponseHeader(MHD_HTTP_HEADER_LAST_MODIFIED, lastModified.GetAsRFC1123DateTime());
 
+  // if the request handler has an entity tag and it hasn't been set as a header, add it
+  std::string etag;
+  if (handler->CanBeCached() && handler->GetETag(etag))
+    handler->AddResponseHeader(MHD_HTTP_HEADER_ETAG, etag);
+
   // check if the request handler has set Cache-Control and add it if not
   if (!handler->HasResponseHeader(MHD_HTTP_HEADER_CACHE_CONTROL))
   {
@@ -791,21 +874,22 @@ MHD_RESULT CWebServer::CreateFileDownloadResponse(
   const HTTPResponseDetails& responseDetails = handler->GetResponseDetails();
   HttpResponseRanges responseRanges = handler->GetResponseData();
 
-  std::shared_ptr<XFILE::CFile> file = std::make_shared<XFILE::CFile>();
   std::string filePath = handler->GetResponseFile();
 
   // access check
   if (!CFileUtils::CheckFileAccessAllowed(filePath))
     return SendErrorResponse(request, MHD_HTTP_NOT_FOUND, request.method);
 
-  if (!file->Open(filePath, XFILE::READ_NO_CACHE))
+  // the file is read through the shared cache which also keeps it open for subsequent requests
+  std::unique_ptr<CHTTPFileCache::CReader> file = CHTTPFileCache::GetInstance().Open(filePath);
+  if (file == nullptr)
   {
     m_logger->error("Failed to open {}", filePath);
     return SendErrorResponse(request, MHD_HTTP_NOT_FOUND, request.method);
   }
 
   bool ranged = false;
-  uint64_t fileLength = static_cast<uint64_t>(file->GetLength());
+  uint64_t fileLength = file->GetLength();
 
   // get the MIME type for the Content-Type header
   std::string mimeType = responseDetails.contentType;
@@ -818,7 +902,7 @@ MHD_RESULT CWebServer::CreateFileDownloadResponse(
 
   uint64_t totalLength = 0;
   std::unique_ptr<HttpFileDownloadContext> context = std::make_unique<HttpFileDownloadContext>();
-  context->file = file;
+  context->file = std::move(file);
   context->contentType = mimeType;
   context->boundaryWritten = false;
   context->writePosition = 0;
@@ -887,18 +971,26 @@ MHD_RESULT CWebServer::CreateFileDownloadResponse(
   // set the initial write position
   context->ranges.GetFirstPosition(context->writePosition);
 
-  // create the response object
-  response =
-      MHD_create_response_from_callback(totalLength, 2048, &CWebServer::ContentReaderCallback,
-                                        context.get(), &CWebServer::ContentReaderFreeCallback);
+  // a single range of a local file doesn't need to be read through the content reader, unless
+  // it has to be encrypted anyway
+  if (context->rangeCountTotal == 1 && !m_tls)
+    response = create_file_descriptor_response(filePath, context->writePosition, totalLength);
+
   if (response == nullptr)
   {
-    m_logger->error("failed to create a HTTP response for {} to be filled from{}", request.pathUrl,
-                    filePath);
-    return MHD_NO;
-  }
+    // create the response object
+    response =
+        MHD_create_response_from_callback(totalLength, 2048, &CWebServer::ContentReaderCallback,
+                                          context.get(), &CWebServer::ContentReaderFreeCallback);
+    if (response == nullptr)
+    {
+      m_logger->error("failed to create a HTTP response for {} to be filled from{}",
+                      request.pathUrl, filePath);
+      return MHD_NO;
+    }
 
-  context.release(); // ownership was passed to mhd
+    context.release(); // ownership was passed to mhd
+  }
 
   // add Content-Range header
   if (ranged)
@@ -944,6 +1036,29 @@ MHD_RESULT CWebServer::CreateErrorResponse(struct MHD_Connection* connection,
   return MHD_YES;
 }
 
+MHD_RESULT CWebServer::CreateStreamDownloadResponse(
+    const std::shared_ptr<IHTTPRequestHandler>& handler, struct MHD_Response*& response) const
+{
+  if (handler == nullptr)
+    return MHD_NO;
+
+  // the response is created while it is sent so its length is unknown and it can't be ranged
+  auto context = std::make_unique<std::shared_ptr<IHTTPRequestHandler>>(handler);
+  response = MHD_create_response_from_callback(MHD_SIZE_UNKNOWN, STREAM_DOWNLOAD_BLOCK_SIZE,
+                                               &CWebServer::StreamReaderCallback, context.get(),
+                                               &CWebServer::StreamReaderFreeCallback);
+  if (response == nullptr)
+  {
+    m_logger->error("failed to create a HTTP stream response for {}",
+                    handler->GetRequest().pathUrl);
+    return MHD_NO;
+  }
+
+  context.release(); // ownership was passed to mhd
+
+  return MHD_YES;
+}
+
 MHD_RESULT CWebServer::CreateMemoryDownloadResponse(struct MHD_Connection* connection,
                                                     const void* data,
                                                     size_t size,
@@ -1074,13 +1189,9 @@ ssize_t CWebServer::ContentReaderCallback(void* cls, uint64_t pos, char* buf, si
   // adjust the maximum number of read bytes
   maximum = std::min(maximum, end - context->writePosition + 1);
 
-  // seek to the position if necessary
-  if (context->file->GetPosition() < 0 ||
-      context->writePosition != static_cast<uint64_t>(context->file->GetPosition()))
-    context->file->Seek(context->writePosition);
-
   // read data from the file
-  ssize_t res = context->file->Read(buf, static_cast<size_t>(maximum));
+  ssize_t res = static_cast<ssize_t>(
+      context->file->Read(context->writePosition, buf, static_cast<size_t>(maximum)));
   if (res <= 0)
     return -1;
 
@@ -1114,6 +1225,30 @@ void CWebServer::ContentReaderFreeCallback(void* cls)
     GetLogger()->debug("[OUT] done");
 }
 
+ssize_t CWebServer::StreamReaderCallback(void* cls, uint64_t pos, char* buf, size_t max)
+{
+  auto handler = static_cast<std::shared_ptr<IHTTPRequestHandler>*>(cls);
+  if (handler == nullptr || *handler == nullptr)
+    return MHD_CONTENT_READER_END_WITH_ERROR;
+
+  size_t read = (*handler)->ReadResponseStream(buf, max);
+  if (read == 0)
+    return MHD_CONTENT_READER_END_OF_STREAM;
+
+  if (CServiceBroker::GetLogging().CanLogComponent(LOGWEBSERVER))
+    GetLogger()->debug("[OUT] streamed {} bytes from {}", read, pos);
+
+  return static_cast<ssize_t>(read);
+}
+
+void CWebServer::StreamReaderFreeCallback(void* cls)
+{
+  delete static_cast<std::shared_ptr<IHTTPRequestHandler>*>(cls);
+
+  if (CServiceBroker::GetLogging().CanLogComponent(LOGWEBSERVER))
+    GetLogger()->debug("[OUT] done");
+}
+
 static Logger GetMhdLogger()
 {
   return CServiceBroker::GetLogging().GetLogger("libmicrohttpd");
@@ -1189,57 +1324,77 @@ bool CWebServer::LoadCert(std::string& skey, std::string& scert)
   return false;
 }
 
+unsigned int CWebServer::GetThreadPoolSize() const
+{
+  if (m_connectionMode != ConnectionMode::EventLoop)
+    return 0;
+
+  if (m_threadPoolSize > 0)
+    return m_threadPoolSize;
+
+  // request handlers may block (e.g. while reading from a network share or waiting for the
+  // application thread) so use more threads than there are cores
+  const unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+  return std::clamp(cores * 2, MIN_THREAD_POOL_SIZE, MAX_THREAD_POOL_SIZE);
+}
+
 struct MHD_Daemon* CWebServer::StartMHD(unsigned int flags, int port)
 {
-  unsigned int timeout = 60 * 60 * 24;
   const char* ciphers = "NORMAL:-VERS-TLS1.0";
 
   MHD_set_panic_func(&panicHandlerForMHD, nullptr);
 
+  unsigned int threadPoolSize = GetThreadPoolSize();
+#if (MHD_VERSION >= 0x00095300)
+  if (threadPoolSize > 0)
+  {
+    // a pool of threads each running an event loop over its share of the connections using
+    // the best polling method of the platform (epoll on Linux), idle keep-alive connections
+    // don't occupy a thread in this mode
+    flags |= MHD_USE_AUTO_INTERNAL_THREAD;
+  }
+  else
+#else
+  threadPoolSize = 0;
+#endif
+  {
+    // one thread per connection
+    // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
+    // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
+    flags |= MHD_USE_THREAD_PER_CONNECTION;
+#if (MHD_VERSION >= 0x00095207)
+    flags |= MHD_USE_INTERNAL_POLLING_THREAD; /* MHD_USE_THREAD_PER_CONNECTION must be used only
+                                                 with MHD_USE_INTERNAL_POLLING_THREAD since 0.9.54 */
+#endif
+  }
+
+  flags |= MHD_USE_DEBUG; /* Print MHD error messages to log */
+
   if (CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(
           CSettings::SETTING_SERVICES_WEBSERVERSSL) &&
       MHD_is_feature_supported(MHD_FEATURE_SSL) == MHD_YES && LoadCert(m_key, m_cert))
+  {
     // SSL enabled
+    m_tls = true;
     return MHD_start_daemon(
-        flags |
-            // one thread per connection
-            // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
-            // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
-            MHD_USE_THREAD_PER_CONNECTION
-#if (MHD_VERSION >= 0x00095207)
-            |
-            MHD_USE_INTERNAL_POLLING_THREAD /* MHD_USE_THREAD_PER_CONNECTION must be used only with
-                                               MHD_USE_INTERNAL_POLLING_THREAD since 0.9.54 */
-#endif
-            | MHD_USE_DEBUG /* Print MHD error messages to log */
-            | MHD_USE_SSL,
-        port, 0, 0, &CWebServer::AnswerToConnection, this,
-
-        MHD_OPTION_EXTERNAL_LOGGER, &logFromMHD, 0, MHD_OPTION_CONNECTION_LIMIT, 512,
-        MHD_OPTION_CONNECTION_TIMEOUT, timeout, MHD_OPTION_URI_LOG_CALLBACK,
-        &CWebServer::UriRequestLogger, this, MHD_OPTION_THREAD_STACK_SIZE, m_thread_stacksize,
-        MHD_OPTION_HTTPS_MEM_KEY, m_key.c_str(), MHD_OPTION_HTTPS_MEM_CERT, m_cert.c_str(),
-        MHD_OPTION_HTTPS_PRIORITIES, ciphers, MHD_OPTION_END);
+        flags | MHD_USE_SSL, port, 0, 0, &CWebServer::AnswerToConnection, this,
+
+        MHD_OPTION_EXTERNAL_LOGGER, &logFromMHD, 0, MHD_OPTION_CONNECTION_LIMIT, CONNECTION_LIMIT,
+        MHD_OPTION_CONNECTION_TIMEOUT, CONNECTION_IDLE_TIMEOUT, MHD_OPTION_THREAD_POOL_SIZE,
+        threadPoolSize, MHD_OPTION_URI_LOG_CALLBACK, &CWebServer::UriRequestLogger, this,
+        MHD_OPTION_THREAD_STACK_SIZE, m_thread_stacksize, MHD_OPTION_HTTPS_MEM_KEY, m_key.c_str(),
+        MHD_OPTION_HTTPS_MEM_CERT, m_cert.c_str(), MHD_OPTION_HTTPS_PRIORITIES, ciphers,
+        MHD_OPTION_END);
+  }
 
   // No SSL
   return MHD_start_daemon(
-      flags |
-          // one thread per connection
-          // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
-          // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
-          MHD_USE_THREAD_PER_CONNECTION
-#if (MHD_VERSION >= 0x00095207)
-          | MHD_USE_INTERNAL_POLLING_THREAD /* MHD_USE_THREAD_PER_CONNECTION must be used only with
-                                               MHD_USE_INTERNAL_POLLING_THREAD since 0.9.54 */
-#endif
-          | MHD_USE_DEBUG /* Print MHD error messages to log */
-      ,
-      port, 0, 0, &CWebServer::AnswerToConnection, this,
-
-      MHD_OPTION_EXTERNAL_LOGGER, &logFromMHD, 0, MHD_OPTION_CONNECTION_LIMIT, 512,
-      MHD_OPTION_CONNECTION_TIMEOUT, timeout, MHD_OPTION_URI_LOG_CALLBACK,
-      &CWebServer::UriRequestLogger, this, MHD_OPTION_THREAD_STACK_SIZE, m_thread_stacksize,
-      MHD_OPTION_END);
+      flags, port, 0, 0, &CWebServer::AnswerToConnection, this,
+
+      MHD_OPTION_EXTERNAL_LOGGER, &logFromMHD, 0, MHD_OPTION_CONNECTION_LIMIT, CONNECTION_LIMIT,
+      MHD_OPTION_CONNECTION_TIMEOUT, CONNECTION_IDLE_TIMEOUT, MHD_OPTION_THREAD_POOL_SIZE,
+      threadPoolSize, MHD_OPTION_URI_LOG_CALLBACK, &CWebServer::UriRequestLogger, this,
+      MHD_OPTION_THREAD_STACK_SIZE, m_thread_stacksize, MHD_OPTION_END);
 }
 
 bool CWebServer::Start(uint16_t port, const std::string& username, const std::string& password)
@@ -1249,6 +1404,7 @@ bool CWebServer::Start(uint16_t port, const std::string& username, const std::st
   {
     // use a new logger containing the port in the name
     m_logger = CServiceBroker::GetLogging().GetLogger(StringUtils::Format("CWebserver[{}]", port));
+    m_tls = false;
 
     int v6testSock;
     if ((v6testSock = socket(AF_INET6, SOCK_STREAM, 0)) >= 0)
@@ -1262,7 +1418,11 @@ bool CWebServer::Start(uint16_t port, const std::string& username, const std::st
     if (m_running)
     {
       m_port = port;
-      m_logger->info("Started");
+      const unsigned int threadPoolSize = GetThreadPoolSize();
+      if (threadPoolSize > 0)
+        m_logger->info("Started with {} worker threads", threadPoolSize);
+      else
+        m_logger->info("Started with one thread per connection");
     }
     else
       m_logger->error("Failed to start");
@@ -1282,6 +1442,9 @@ bool CWebServer::Stop()
   if (m_daemon_ip4 != nullptr)
     MHD_stop_daemon(m_daemon_ip4);
 
+  // close the files kept open for subsequent requests
+  CHTTPFileCache::GetInstance().Clear();
+
   m_running = false;
   m_logger->info("Stopped");
   m_port = 0;
@@ -1289,6 +1452,12 @@ bool CWebServer::Stop()
   return true;
 }
 
+void CWebServer::SetConnectionMode(ConnectionMode mode, unsigned int threadPoolSize /* = 0 */)
+{
+  m_connectionMode = mode;
+  m_threadPoolSize = threadPoolSize;
+}
+
 bool CWebServer::IsStarted()
 {
   return m_running;
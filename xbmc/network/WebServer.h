@@ -25,9 +25,30 @@ class CVariant;
 class CWebServer
 {
 public:
+  /*!
+   \brief The way connections are served by libmicrohttpd
+   */
+  enum class ConnectionMode
+  {
+    ThreadPerConnection, ///< Every connection is served by its own thread
+    EventLoop, ///< All connections are multiplexed (epoll where available) onto a thread pool,
+               ///< a request handler which blocks stalls the other connections of its thread
+  };
+
   CWebServer();
   virtual ~CWebServer() = default;
 
+  /*!
+   \brief Sets the way connections are served, only has an effect on the next call to Start()
+
+   Defaults to ConnectionMode::ThreadPerConnection as several request handlers block (reading
+   from network shares, JSON-RPC methods waiting for the application thread).
+   \param mode The connection mode to use
+   \param threadPoolSize Number of worker threads in event loop mode, 0 picks a value based on
+   the number of available cores
+   */
+  void SetConnectionMode(ConnectionMode mode, unsigned int threadPoolSize = 0);
+
   bool Start(uint16_t port, const std::string &username, const std::string &password);
   bool Stop();
   bool IsStarted();
@@ -58,6 +79,7 @@ protected:
 
 private:
   struct MHD_Daemon* StartMHD(unsigned int flags, int port);
+  unsigned int GetThreadPoolSize() const;
 
   std::shared_ptr<IHTTPRequestHandler> FindRequestHandler(const HTTPRequest& request) const;
 
@@ -76,6 +98,7 @@ private:
 
   MHD_RESULT CreateRedirect(struct MHD_Connection *connection, const std::string &strURL, struct MHD_Response *&response) const;
   MHD_RESULT CreateFileDownloadResponse(const std::shared_ptr<IHTTPRequestHandler>& handler, struct MHD_Response *&response) const;
+  MHD_RESULT CreateStreamDownloadResponse(const std::shared_ptr<IHTTPRequestHandler>& handler, struct MHD_Response *&response) const;
   MHD_RESULT CreateErrorResponse(struct MHD_Connection *connection, int responseType, HTTPMethod method, struct MHD_Response *&response) const;
   MHD_RESULT CreateMemoryDownloadResponse(struct MHD_Connection *connection, const void *data, size_t size, bool free, bool copy, struct MHD_Response *&response) const;
 
@@ -94,6 +117,8 @@ private:
 
   static ssize_t ContentReaderCallback (void *cls, uint64_t pos, char *buf, size_t max);
   static void ContentReaderFreeCallback(void *cls);
+  static ssize_t StreamReaderCallback(void *cls, uint64_t pos, char *buf, size_t max);
+  static void StreamReaderFreeCallback(void *cls);
 
   static MHD_RESULT AnswerToConnection (void *cls, struct MHD_Connection *connection,
                         const char *url, const char *method,
@@ -113,6 +138,9 @@ private:
   struct MHD_Daemon *m_daemon_ip4 = nullptr;
   bool m_running = false;
   size_t m_thread_stacksize = 0;
+  bool m_tls = false;
+  ConnectionMode m_connectionMode = ConnectionMode::ThreadPerConnection;
+  unsigned int m_threadPoolSize = 0;
   bool m_authenticationRequired = false;
   std::string m_authenticationUsername;
   std::string m_authenticationPassword;
@@ -0,0 +1,486 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "HTTPFileCache.h"
+
+#include "ServiceBroker.h"
+#include "filesystem/Directory.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+namespace
+{
+constexpr size_t MAX_IDLE_HANDLES = 16;
+constexpr std::chrono::seconds IDLE_HANDLE_TIMEOUT{30};
+constexpr size_t MAX_FILES = 256;
+constexpr uint64_t MB = 1024 * 1024;
+} // namespace
+
+CHTTPFileCache::CReader::CReader(CHTTPFileCache& cache, std::unique_ptr<CHandle> handle)
+  : m_cache(cache), m_handle(std::move(handle))
+{
+}
+
+CHTTPFileCache::CReader::~CReader()
+{
+  m_cache.Release(std::move(m_handle));
+}
+
+int CHTTPFileCache::CReader::Stat(struct __stat64* buffer)
+{
+  if (m_handle->file == nullptr)
+    return -1;
+
+  return m_handle->file->Stat(buffer);
+}
+
+int64_t CHTTPFileCache::CReader::Read(uint64_t position, void* buffer, size_t size)
+{
+  if (size == 0)
+    return 0;
+
+  if (!m_handle->cacheBlocks)
+  {
+    XFILE::CFile* file = m_handle->file.get();
+    if (file == nullptr)
+      return -1;
+
+    // seek to the position if necessary
+    if (file->GetPosition() < 0 || position != static_cast<uint64_t>(file->GetPosition()))
+      file->Seek(position);
+
+    return file->Read(buffer, size);
+  }
+
+  if (position >= m_handle->length)
+    return 0;
+
+  const BlockData block = m_cache.GetBlock(*m_handle, position / BLOCK_SIZE);
+  if (block == nullptr)
+    return -1;
+
+  const size_t offset = static_cast<size_t>(position % BLOCK_SIZE);
+  if (offset >= block->size())
+    return 0;
+
+  const size_t length = std::min(size, block->size() - offset);
+  memcpy(buffer, block->data() + offset, length);
+  return static_cast<int64_t>(length);
+}
+
+CHTTPFileCache::CHTTPFileCache(uint64_t memoryBudget,
+                               uint64_t diskBudget,
+                               const std::string& diskPath,
+                               bool cacheLocalFiles /* = false */)
+  : m_memoryBudget(memoryBudget),
+    m_diskBudget(memoryBudget > 0 ? diskBudget : 0),
+    m_diskPath(diskPath),
+    m_cacheLocalFiles(cacheLocalFiles)
+{
+  if (m_diskBudget > 0)
+  {
+    // blocks spilled to disk by a previous instance can't be trusted anymore
+    if (XFILE::CDirectory::Exists(m_diskPath))
+      XFILE::CDirectory::RemoveRecursive(m_diskPath);
+    XFILE::CDirectory::Create(m_diskPath);
+  }
+}
+
+CHTTPFileCache::~CHTTPFileCache()
+{
+  Clear();
+}
+
+CHTTPFileCache& CHTTPFileCache::GetInstance()
+{
+  static CHTTPFileCache cache(
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_webserverCacheMemorySize *
+          MB,
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_webserverCacheDiskSize * MB,
+      "special://temp/webservercache/");
+  return cache;
+}
+
+std::unique_ptr<CHTTPFileCache::CReader> CHTTPFileCache::Open(const std::string& path)
+{
+  // the file may have changed while it was idle, e.g. a recording in progress grows
+  struct __stat64 statBuffer = {};
+  const bool hasStat = XFILE::CFile::Stat(path, &statBuffer) == 0;
+
+  std::vector<std::unique_ptr<CHandle>> expired;
+  std::unique_ptr<CHandle> handle;
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    ExpireIdleHandles(expired);
+
+    auto it = std::find_if(m_idleHandles.begin(), m_idleHandles.end(),
+                           [&path](const std::unique_ptr<CHandle>& idleHandle)
+                           { return idleHandle->path == path; });
+    if (it != m_idleHandles.end())
+    {
+      if (hasStat && (*it)->length == static_cast<uint64_t>(statBuffer.st_size) &&
+          (*it)->modified == statBuffer.st_mtime)
+      {
+        handle = std::move(*it);
+        m_reusedFiles++;
+      }
+      else
+      {
+        // the file is opened again below, which also drops its cached blocks
+        expired.push_back(std::move(*it));
+      }
+      m_idleHandles.erase(it);
+    }
+  }
+  // close the expired files without holding the lock
+  expired.clear();
+
+  if (handle != nullptr)
+    return std::unique_ptr<CReader>(new CReader(*this, std::move(handle)));
+
+  auto file = std::make_unique<XFILE::CFile>();
+  if (!file->Open(path, XFILE::READ_NO_CACHE))
+    return nullptr;
+
+  handle = std::make_unique<CHandle>();
+  handle->path = path;
+  handle->length = static_cast<uint64_t>(std::max<int64_t>(file->GetLength(), 0));
+  handle->reusable = m_cacheLocalFiles || !URIUtils::IsHD(path);
+  handle->modified = hasStat ? statBuffer.st_mtime : 0;
+  handle->cacheBlocks = handle->reusable && m_memoryBudget > 0 && handle->length > 0;
+
+  if (handle->cacheBlocks)
+  {
+    const int64_t modified = handle->modified;
+
+    std::vector<std::string> obsoleteFiles;
+    {
+      std::unique_lock<CCriticalSection> lock(m_critSection);
+
+      // drop the cached blocks if the file has changed since they were read
+      auto info = m_files.find(path);
+      if (info != m_files.end() &&
+          (info->second.length != handle->length || info->second.modified != modified))
+      {
+        Invalidate(path, obsoleteFiles);
+        info = m_files.end();
+      }
+
+      if (info == m_files.end())
+      {
+        if (m_files.size() >= MAX_FILES)
+        {
+          // forget about the files without any cached blocks
+          for (auto it = m_files.begin(); it != m_files.end();)
+          {
+            const BlockKey first(it->first, 0);
+            const auto block = m_blockIndex.lower_bound(first);
+            const auto diskBlock = m_diskBlockIndex.lower_bound(first);
+            if ((block == m_blockIndex.end() || block->first.first != it->first) &&
+                (diskBlock == m_diskBlockIndex.end() || diskBlock->first.first != it->first))
+              it = m_files.erase(it);
+            else
+              ++it;
+          }
+        }
+
+        m_files.emplace(path, CFileInfo{m_nextFileId++, handle->length, modified});
+      }
+    }
+
+    for (const auto& obsoleteFile : obsoleteFiles)
+      XFILE::CFile::Delete(obsoleteFile);
+  }
+
+  handle->file = std::move(file);
+  return std::unique_ptr<CReader>(new CReader(*this, std::move(handle)));
+}
+
+CHTTPFileCache::Stats CHTTPFileCache::GetStats() const
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  Stats stats;
+  stats.hits = m_hits;
+  stats.misses = m_misses;
+  stats.memoryUsed = m_memoryUsed;
+  stats.memoryBudget = m_memoryBudget;
+  stats.diskUsed = m_diskUsed;
+  stats.diskBudget = m_diskBudget;
+  stats.openFiles = m_idleHandles.size();
+  stats.reusedFiles = m_reusedFiles;
+  return stats;
+}
+
+void CHTTPFileCache::Clear()
+{
+  std::list<std::unique_ptr<CHandle>> idleHandles;
+  std::list<CDiskBlock> diskBlocks;
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    idleHandles.swap(m_idleHandles);
+    diskBlocks.swap(m_diskBlocks);
+    m_diskBlockIndex.clear();
+    m_diskUsed = 0;
+    m_blocks.clear();
+    m_blockIndex.clear();
+    m_memoryUsed = 0;
+    m_files.clear();
+  }
+
+  for (const auto& diskBlock : diskBlocks)
+    XFILE::CFile::Delete(diskBlock.file);
+}
+
+void CHTTPFileCache::Release(std::unique_ptr<CHandle> handle)
+{
+  // local files and files which failed to read aren't kept open
+  if (handle == nullptr || !handle->reusable || handle->file == nullptr)
+    return;
+
+  std::vector<std::unique_ptr<CHandle>> expired;
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    handle->lastUsed = std::chrono::steady_clock::now();
+    m_idleHandles.push_front(std::move(handle));
+
+    while (m_idleHandles.size() > MAX_IDLE_HANDLES)
+    {
+      expired.push_back(std::move(m_idleHandles.back()));
+      m_idleHandles.pop_back();
+    }
+    ExpireIdleHandles(expired);
+  }
+}
+
+CHTTPFileCache::BlockData CHTTPFileCache::GetBlock(CHandle& handle, uint64_t index)
+{
+  const BlockKey key(handle.path, index);
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    auto it = m_blockIndex.find(key);
+    if (it != m_blockIndex.end())
+    {
+      m_blocks.splice(m_blocks.begin(), m_blocks, it->second);
+      m_hits++;
+      return it->second->data;
+    }
+  }
+
+  BlockData data = ReadDiskBlock(key);
+  if (data != nullptr)
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    m_hits++;
+  }
+  else
+  {
+    const uint64_t start = index * BLOCK_SIZE;
+    if (handle.file == nullptr || start >= handle.length)
+      return nullptr;
+
+    auto block =
+        std::make_shared<std::vector<uint8_t>>(std::min<uint64_t>(BLOCK_SIZE, handle.length - start));
+    if (handle.file->Seek(static_cast<int64_t>(start)) != static_cast<int64_t>(start))
+    {
+      handle.file.reset();
+      return nullptr;
+    }
+
+    size_t read = 0;
+    while (read < block->size())
+    {
+      const ssize_t result = handle.file->Read(block->data() + read, block->size() - read);
+      if (result <= 0)
+        break;
+      read += static_cast<size_t>(result);
+    }
+
+    {
+      std::unique_lock<CCriticalSection> lock(m_critSection);
+      m_misses++;
+    }
+
+    // a partial block (e.g. because the file has been truncated) is passed on but not cached
+    if (read < block->size())
+    {
+      CLog::Log(LOGDEBUG, "CHTTPFileCache: short read of block {} of {}", index, handle.path);
+      if (read == 0)
+      {
+        handle.file.reset();
+        return nullptr;
+      }
+
+      block->resize(read);
+      return block;
+    }
+
+    data = std::move(block);
+  }
+
+  AddBlock(key, data);
+  return data;
+}
+
+CHTTPFileCache::BlockData CHTTPFileCache::ReadDiskBlock(const BlockKey& key)
+{
+  std::string fileName;
+  size_t size = 0;
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    auto it = m_diskBlockIndex.find(key);
+    if (it == m_diskBlockIndex.end())
+      return nullptr;
+
+    // the block is moved back into memory
+    fileName = it->second->file;
+    size = it->second->size;
+    m_diskUsed -= size;
+    m_diskBlocks.erase(it->second);
+    m_diskBlockIndex.erase(it);
+  }
+
+  auto data = std::make_shared<std::vector<uint8_t>>(size);
+  XFILE::CFile file;
+  const bool success =
+      file.Open(fileName) && file.Read(data->data(), size) == static_cast<ssize_t>(size);
+  file.Close();
+  XFILE::CFile::Delete(fileName);
+
+  if (!success)
+    return nullptr;
+
+  return data;
+}
+
+void CHTTPFileCache::AddBlock(const BlockKey& key, const BlockData& data)
+{
+  std::vector<CBlock> evicted;
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    if (m_blockIndex.find(key) != m_blockIndex.end())
+      return;
+
+    m_blocks.push_front(CBlock{key, data});
+    m_blockIndex.emplace(key, m_blocks.begin());
+    m_memoryUsed += data->size();
+
+    while (m_memoryUsed > m_memoryBudget && !m_blocks.empty())
+    {
+      CBlock& block = m_blocks.back();
+      m_memoryUsed -= block.data->size();
+      m_blockIndex.erase(block.key);
+      if (m_diskBudget > 0)
+        evicted.push_back(std::move(block));
+      m_blocks.pop_back();
+    }
+  }
+
+  if (!evicted.empty())
+    WriteDiskBlocks(evicted);
+}
+
+void CHTTPFileCache::WriteDiskBlocks(std::vector<CBlock>& blocks)
+{
+  for (const auto& block : blocks)
+  {
+    uint64_t fileId;
+    std::string fileName;
+    {
+      std::unique_lock<CCriticalSection> lock(m_critSection);
+      const auto info = m_files.find(block.key.first);
+      if (info == m_files.end() || m_diskBlockIndex.find(block.key) != m_diskBlockIndex.end())
+        continue;
+
+      fileId = info->second.id;
+      fileName = URIUtils::AddFileToFolder(
+          m_diskPath, StringUtils::Format("{}-{}.blk", fileId, block.key.second));
+    }
+
+    const size_t size = block.data->size();
+    XFILE::CFile file;
+    const bool success = file.OpenForWrite(fileName, true) &&
+                         file.Write(block.data->data(), size) == static_cast<ssize_t>(size);
+    file.Close();
+    if (!success)
+    {
+      CLog::Log(LOGWARNING, "CHTTPFileCache: failed to write {}", fileName);
+      XFILE::CFile::Delete(fileName);
+      continue;
+    }
+
+    std::vector<std::string> obsoleteFiles;
+    {
+      std::unique_lock<CCriticalSection> lock(m_critSection);
+
+      // the file may have been invalidated while the block was written
+      const auto info = m_files.find(block.key.first);
+      if (info == m_files.end() || info->second.id != fileId)
+        obsoleteFiles.push_back(fileName);
+      else
+      {
+        m_diskBlocks.push_front(CDiskBlock{block.key, fileName, size});
+        m_diskBlockIndex.emplace(block.key, m_diskBlocks.begin());
+        m_diskUsed += size;
+
+        while (m_diskUsed > m_diskBudget && !m_diskBlocks.empty())
+        {
+          const CDiskBlock& diskBlock = m_diskBlocks.back();
+          m_diskUsed -= diskBlock.size;
+          m_diskBlockIndex.erase(diskBlock.key);
+          obsoleteFiles.push_back(diskBlock.file);
+          m_diskBlocks.pop_back();
+        }
+      }
+    }
+
+    for (const auto& obsoleteFile : obsoleteFiles)
+      XFILE::CFile::Delete(obsoleteFile);
+  }
+}
+
+void CHTTPFileCache::Invalidate(const std::string& path, std::vector<std::string>& obsoleteFiles)
+{
+  const BlockKey first(path, 0);
+
+  for (auto it = m_blockIndex.lower_bound(first);
+       it != m_blockIndex.end() && it->first.first == path;)
+  {
+    m_memoryUsed -= it->second->data->size();
+    m_blocks.erase(it->second);
+    it = m_blockIndex.erase(it);
+  }
+
+  for (auto it = m_diskBlockIndex.lower_bound(first);
+       it != m_diskBlockIndex.end() && it->first.first == path;)
+  {
+    m_diskUsed -= it->second->size;
+    obsoleteFiles.push_back(it->second->file);
+    m_diskBlocks.erase(it->second);
+    it = m_diskBlockIndex.erase(it);
+  }
+
+  m_files.erase(path);
+}
+
+void CHTTPFileCache::ExpireIdleHandles(std::vector<std::unique_ptr<CHandle>>& expired)
+{
+  const auto now = std::chrono::steady_clock::now();
+  while (!m_idleHandles.empty() && m_idleHandles.back()->lastUsed + IDLE_HANDLE_TIMEOUT < now)
+  {
+    expired.push_back(std::move(m_idleHandles.back()));
+    m_idleHandles.pop_back();
+  }
+}
@@ -0,0 +1,172 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "filesystem/File.h"
+#include "threads/CriticalSection.h"
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*!
+ \brief Shared read-through cache for the files served by the web server.
+
+ Files downloaded or streamed through HTTPVfsHandler / HTTPFileHandler are read in blocks of a
+ fixed size which are kept in memory (and optionally spilled to disk) indexed by the path of the
+ file and the number of the block. Seeking clients and multiple clients streaming the same file
+ therefore don't read the same data from the source twice.
+
+ Opened files are kept open for a while after a request has been served so subsequent (range)
+ requests for the same file don't have to e.g. set up a new SMB session.
+ */
+class CHTTPFileCache
+{
+public:
+  static constexpr size_t BLOCK_SIZE = 256 * 1024;
+
+  struct Stats
+  {
+    uint64_t hits = 0; ///< Number of blocks served from memory or disk
+    uint64_t misses = 0; ///< Number of blocks read from the source
+    uint64_t memoryUsed = 0;
+    uint64_t memoryBudget = 0;
+    uint64_t diskUsed = 0;
+    uint64_t diskBudget = 0;
+    size_t openFiles = 0; ///< Number of idle files kept open
+    uint64_t reusedFiles = 0; ///< Number of requests served from an already opened file
+  };
+
+private:
+  struct CHandle
+  {
+    std::string path;
+    std::unique_ptr<XFILE::CFile> file;
+    uint64_t length = 0;
+    int64_t modified = 0;
+    bool reusable = false;
+    bool cacheBlocks = false;
+    std::chrono::steady_clock::time_point lastUsed;
+  };
+
+public:
+  /*!
+   \brief Reads a single file through the cache, the file is handed back to the cache when the
+   reader is destroyed
+   */
+  class CReader
+  {
+  public:
+    ~CReader();
+
+    uint64_t GetLength() const { return m_handle->length; }
+    int Stat(struct __stat64* buffer);
+
+    /*!
+     \brief Reads up to the given number of bytes from the given position
+     \return Number of bytes read, 0 at the end of the file or -1 on error
+     */
+    int64_t Read(uint64_t position, void* buffer, size_t size);
+
+  private:
+    friend class CHTTPFileCache;
+    CReader(CHTTPFileCache& cache, std::unique_ptr<CHandle> handle);
+
+    CHTTPFileCache& m_cache;
+    std::unique_ptr<CHandle> m_handle;
+  };
+
+  /*!
+   \param memoryBudget Maximum number of bytes of cached blocks kept in memory, 0 disables caching
+   \param diskBudget Maximum number of bytes of cached blocks spilled to disk, 0 disables it
+   \param diskPath Directory the blocks spilled to disk are stored in
+   \param cacheLocalFiles Whether to cache and keep open files on local drives which are already
+   cached by the operating system and cheap to open
+   */
+  CHTTPFileCache(uint64_t memoryBudget,
+                 uint64_t diskBudget,
+                 const std::string& diskPath,
+                 bool cacheLocalFiles = false);
+  ~CHTTPFileCache();
+
+  /*!
+   \brief The cache shared by all request handlers, configured through advancedsettings.xml
+   */
+  static CHTTPFileCache& GetInstance();
+
+  /*!
+   \brief Opens the given file reusing an idle opened file if possible. An idle file is only reused
+   if the size and modification time of the file haven't changed since it was opened.
+   \return A reader or nullptr if the file can't be opened
+   */
+  std::unique_ptr<CReader> Open(const std::string& path);
+
+  Stats GetStats() const;
+
+  /*!
+   \brief Drops all cached blocks and closes all idle files
+   */
+  void Clear();
+
+private:
+  using BlockKey = std::pair<std::string, uint64_t>;
+  using BlockData = std::shared_ptr<const std::vector<uint8_t>>;
+
+  struct CBlock
+  {
+    BlockKey key;
+    BlockData data;
+  };
+
+  struct CDiskBlock
+  {
+    BlockKey key;
+    std::string file;
+    size_t size;
+  };
+
+  struct CFileInfo
+  {
+    uint64_t id;
+    uint64_t length;
+    int64_t modified;
+  };
+
+  void Release(std::unique_ptr<CHandle> handle);
+  BlockData GetBlock(CHandle& handle, uint64_t index);
+  BlockData ReadDiskBlock(const BlockKey& key);
+  void AddBlock(const BlockKey& key, const BlockData& data);
+  void WriteDiskBlocks(std::vector<CBlock>& blocks);
+  void Invalidate(const std::string& path, std::vector<std::string>& obsoleteFiles);
+  void ExpireIdleHandles(std::vector<std::unique_ptr<CHandle>>& expired);
+
+  const uint64_t m_memoryBudget;
+  const uint64_t m_diskBudget;
+  const std::string m_diskPath;
+  const bool m_cacheLocalFiles;
+
+  mutable CCriticalSection m_critSection;
+  std::list<std::unique_ptr<CHandle>> m_idleHandles; // most recently used first
+  std::map<std::string, CFileInfo> m_files;
+  uint64_t m_nextFileId = 1;
+  std::list<CBlock> m_blocks; // most recently used first
+  std::map<BlockKey, std::list<CBlock>::iterator> m_blockIndex;
+  uint64_t m_memoryUsed = 0;
+  std::list<CDiskBlock> m_diskBlocks; // most recently used first
+  std::map<BlockKey, std::list<CDiskBlock>::iterator> m_diskBlockIndex;
+  uint64_t m_diskUsed = 0;
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
+  uint64_t m_reusedFiles = 0;
+};
@@ -8,7 +8,7 @@
 
 #include "HTTPFileHandler.h"
 
-#include "filesystem/File.h"
+#include "network/httprequesthandler/HTTPFileCache.h"
 #include "utils/Mime.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -62,9 +62,10 @@ void CHTTPFileHandler::SetFile(const std::string& file, int responseStatus)
     StringUtils::ToLower(ext);
     m_response.contentType = CMime::GetMimeType(ext);
 
-    // determine the last modified date
-    XFILE::CFile fileObj;
-    if (!fileObj.Open(m_url, XFILE::READ_NO_CACHE))
+    // determine the last modified date, the opened file is kept open by the cache for
+    // serving the actual response
+    std::unique_ptr<CHTTPFileCache::CReader> file = CHTTPFileCache::GetInstance().Open(m_url);
+    if (file == nullptr)
     {
       m_response.type = HTTPError;
       m_response.status = MHD_HTTP_INTERNAL_SERVER_ERROR;
@@ -72,7 +73,7 @@ void CHTTPFileHandler::SetFile(const std::string& file, int responseStatus)
     else
     {
       struct __stat64 statBuffer;
-      if (fileObj.Stat(&statBuffer) == 0)
+      if (file->Stat(&statBuffer) == 0)
         SetLastModifiedDate(&statBuffer);
     }
   }
@@ -0,0 +1,272 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "HTTPImageTransformationCache.h"
+
+#include "FileItem.h"
+#include "ServiceBroker.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/Crc32.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <tuple>
+
+namespace
+{
+constexpr uint64_t MB = 1024 * 1024;
+constexpr std::chrono::seconds TRANSFORMATION_TIMEOUT{10};
+
+std::string Sanitize(const std::string& value)
+{
+  std::string sanitized;
+  for (const char c : value)
+  {
+    if (StringUtils::isasciialphanum(c))
+      sanitized += static_cast<char>(::tolower(static_cast<unsigned char>(c)));
+  }
+  return sanitized;
+}
+} // namespace
+
+CHTTPImageTransformationCache::CHTTPImageTransformationCache(const std::string& path,
+                                                             uint64_t budget,
+                                                             unsigned int maxTransformations,
+                                                             std::chrono::milliseconds timeout)
+  : m_path(path),
+    m_budget(budget),
+    m_maxTransformations(std::max(1u, maxTransformations)),
+    m_timeout(timeout)
+{
+}
+
+CHTTPImageTransformationCache& CHTTPImageTransformationCache::GetInstance()
+{
+  // leave half of the cores to playback and the GUI
+  static CHTTPImageTransformationCache cache(
+      "special://thumbnails/transformed/",
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_webserverImageCacheSize * MB,
+      std::max(1u, std::thread::hardware_concurrency() / 2),
+      TRANSFORMATION_TIMEOUT);
+  return cache;
+}
+
+std::string CHTTPImageTransformationCache::GetKey(const std::string& url,
+                                                  const std::string& imageHash,
+                                                  unsigned int width,
+                                                  unsigned int height,
+                                                  const std::string& scalingAlgorithm,
+                                                  const std::string& format)
+{
+  std::string key = StringUtils::Format("{:08x}-{}-{}x{}", Crc32::ComputeFromLowerCase(url),
+                                        Sanitize(imageHash), width, height);
+  const std::string algorithm = Sanitize(scalingAlgorithm);
+  if (!algorithm.empty())
+    key += "-" + algorithm;
+
+  return key + "." + Sanitize(format);
+}
+
+CHTTPImageTransformationCache::Result CHTTPImageTransformationCache::Get(
+    const std::string& key, const Transformation& transform, std::vector<uint8_t>& data)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (!m_loaded)
+  {
+    Load();
+    m_loaded = true;
+  }
+
+  // identical transformations requested at the same time are only performed once
+  if (!m_condition.wait(lock, m_timeout,
+                        [this, &key] { return m_pending.find(key) == m_pending.end(); }))
+    return Result::Busy;
+  m_pending.insert(key);
+  lock.unlock();
+
+  Result result = Read(key, data) ? Result::Success : Result::Failed;
+  lock.lock();
+
+  if (result != Result::Success)
+  {
+    if (m_condition.wait(lock, m_timeout,
+                         [this] { return m_transformations < m_maxTransformations; }))
+    {
+      m_transformations++;
+      lock.unlock();
+
+      data.clear();
+      if (transform(data) && !data.empty())
+      {
+        Store(key, data);
+        result = Result::Success;
+      }
+
+      lock.lock();
+      m_transformations--;
+    }
+    else
+    {
+      CLog::Log(LOGDEBUG, "CHTTPImageTransformationCache: no transformation slot for {}", key);
+      result = Result::Busy;
+    }
+  }
+
+  m_pending.erase(key);
+  m_condition.notifyAll();
+  return result;
+}
+
+void CHTTPImageTransformationCache::Clear()
+{
+  std::vector<std::string> files;
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    for (const auto& entry : m_entries)
+      files.push_back(URIUtils::AddFileToFolder(m_path, entry.key));
+
+    m_entries.clear();
+    m_index.clear();
+    m_size = 0;
+  }
+
+  for (const auto& file : files)
+    XFILE::CFile::Delete(file);
+}
+
+void CHTTPImageTransformationCache::Load()
+{
+  if (m_budget == 0)
+    return;
+
+  if (!XFILE::CDirectory::Exists(m_path))
+  {
+    XFILE::CDirectory::Create(m_path);
+    return;
+  }
+
+  CFileItemList items;
+  if (!XFILE::CDirectory::GetDirectory(m_path, items, "",
+                                       XFILE::DIR_FLAG_NO_FILE_DIRS | XFILE::DIR_FLAG_BYPASS_CACHE))
+    return;
+
+  // restore the order of use from the modification dates, most recent first
+  std::vector<std::tuple<CDateTime, std::string, uint64_t>> files;
+  for (const auto& item : items)
+  {
+    if (item->m_bIsFolder)
+      continue;
+
+    const std::string fileName = URIUtils::GetFileName(item->GetPath());
+    if (URIUtils::HasExtension(fileName, ".tmp"))
+      XFILE::CFile::Delete(item->GetPath());
+    else
+      files.emplace_back(item->m_dateTime, fileName, static_cast<uint64_t>(item->m_dwSize));
+  }
+  std::sort(files.begin(), files.end(), [](const auto& lhs, const auto& rhs)
+            { return std::get<0>(lhs) > std::get<0>(rhs); });
+
+  for (const auto& file : files)
+  {
+    if (m_size + std::get<2>(file) > m_budget)
+    {
+      XFILE::CFile::Delete(URIUtils::AddFileToFolder(m_path, std::get<1>(file)));
+      continue;
+    }
+
+    m_entries.push_back(CEntry{std::get<1>(file), std::get<2>(file)});
+    m_index.emplace(std::get<1>(file), std::prev(m_entries.end()));
+    m_size += std::get<2>(file);
+  }
+
+  CLog::Log(LOGDEBUG, "CHTTPImageTransformationCache: loaded {} transformed images ({} bytes)",
+            m_entries.size(), m_size);
+}
+
+bool CHTTPImageTransformationCache::Read(const std::string& key, std::vector<uint8_t>& data)
+{
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    const auto it = m_index.find(key);
+    if (it == m_index.end())
+      return false;
+
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+  }
+
+  XFILE::CFile file;
+  if (file.LoadFile(URIUtils::AddFileToFolder(m_path, key), data) > 0)
+    return true;
+
+  // the file has been removed behind our back
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  const auto it = m_index.find(key);
+  if (it != m_index.end())
+  {
+    m_size -= it->second->size;
+    m_entries.erase(it->second);
+    m_index.erase(it);
+  }
+  return false;
+}
+
+void CHTTPImageTransformationCache::Store(const std::string& key, const std::vector<uint8_t>& data)
+{
+  if (data.size() > m_budget)
+    return;
+
+  // write to a temporary file first so a crash doesn't leave a truncated image behind
+  const std::string fileName = URIUtils::AddFileToFolder(m_path, key);
+  const std::string tempFileName = fileName + ".tmp";
+  XFILE::CFile file;
+  const bool success =
+      file.OpenForWrite(tempFileName, true) &&
+      file.Write(data.data(), data.size()) == static_cast<ssize_t>(data.size());
+  file.Close();
+  if (!success || !XFILE::CFile::Rename(tempFileName, fileName))
+  {
+    CLog::Log(LOGWARNING, "CHTTPImageTransformationCache: failed to write {}", fileName);
+    XFILE::CFile::Delete(tempFileName);
+    return;
+  }
+
+  std::vector<std::string> obsoleteFiles;
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+    const auto it = m_index.find(key);
+    if (it != m_index.end())
+    {
+      m_size -= it->second->size;
+      m_entries.erase(it->second);
+      m_index.erase(it);
+    }
+
+    m_entries.push_front(CEntry{key, data.size()});
+    m_index.emplace(key, m_entries.begin());
+    m_size += data.size();
+
+    while (m_size > m_budget && !m_entries.empty())
+    {
+      const CEntry& entry = m_entries.back();
+      obsoleteFiles.push_back(URIUtils::AddFileToFolder(m_path, entry.key));
+      m_size -= entry.size;
+      m_index.erase(entry.key);
+      m_entries.pop_back();
+    }
+  }
+
+  for (const auto& obsoleteFile : obsoleteFiles)
+    XFILE::CFile::Delete(obsoleteFile);
+}
@@ -0,0 +1,112 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+/*!
+ \brief Persistent cache of the images transformed by CHTTPImageTransformationHandler.
+
+ Every transformed variant of an image is stored on disk under a key made up of the image, its
+ modification date and size, the requested dimensions and the image format. The same key is used
+ as the ETag of the response so clients revalidating a cached image get a 304 response without
+ the image being loaded at all.
+
+ The number of concurrent transformations is limited so loading a grid of posters doesn't occupy
+ all cores, and identical transformations requested at the same time are only performed once.
+ */
+class CHTTPImageTransformationCache
+{
+public:
+  using Transformation = std::function<bool(std::vector<uint8_t>& data)>;
+
+  enum class Result
+  {
+    Success,
+    Failed, ///< the transformation failed
+    Busy, ///< no transformation slot became available in time
+  };
+
+  /*!
+   \param path Directory the transformed images are stored in
+   \param budget Maximum number of bytes of transformed images stored
+   \param maxTransformations Maximum number of concurrent transformations
+   \param timeout Maximum time to wait for a transformation slot
+   */
+  CHTTPImageTransformationCache(const std::string& path,
+                                uint64_t budget,
+                                unsigned int maxTransformations,
+                                std::chrono::milliseconds timeout);
+
+  /*!
+   \brief The cache used by the web server, configured through advancedsettings.xml
+   */
+  static CHTTPImageTransformationCache& GetInstance();
+
+  /*!
+   \brief Builds the key of a transformed image
+   \param url URL of the original image
+   \param imageHash Hash of the modification date and size of the original image
+   \param width Requested width or 0
+   \param height Requested height or 0
+   \param scalingAlgorithm Requested scaling algorithm or an empty string
+   \param format Format (extension) of the transformed image
+   */
+  static std::string GetKey(const std::string& url,
+                            const std::string& imageHash,
+                            unsigned int width,
+                            unsigned int height,
+                            const std::string& scalingAlgorithm,
+                            const std::string& format);
+
+  /*!
+   \brief Gets the transformed image from the cache or transforms and stores it
+   \param key Key of the transformed image
+   \param transform Transformation to perform if the image isn't cached
+   \param data Receives the transformed image
+   */
+  Result Get(const std::string& key, const Transformation& transform, std::vector<uint8_t>& data);
+
+  void Clear();
+
+private:
+  struct CEntry
+  {
+    std::string key;
+    uint64_t size;
+  };
+
+  void Load();
+  bool Read(const std::string& key, std::vector<uint8_t>& data);
+  void Store(const std::string& key, const std::vector<uint8_t>& data);
+
+  const std::string m_path;
+  const uint64_t m_budget;
+  const unsigned int m_maxTransformations;
+  const std::chrono::milliseconds m_timeout;
+
+  CCriticalSection m_critSection;
+  XbmcThreads::ConditionVariable m_condition;
+  bool m_loaded = false;
+  std::list<CEntry> m_entries; // most recently used first
+  std::map<std::string, std::list<CEntry>::iterator> m_index;
+  uint64_t m_size = 0;
+  std::set<std::string> m_pending;
+  unsigned int m_transformations = 0;
+};
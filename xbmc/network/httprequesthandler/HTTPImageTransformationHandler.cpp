@@ -12,11 +12,14 @@
 #include "URL.h"
 #include "filesystem/ImageFile.h"
 #include "network/WebServer.h"
+#include "network/httprequesthandler/HTTPImageTransformationCache.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
+#include "pictures/PictureScalingAlgorithm.h"
 #include "utils/Mime.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 
+#include <cstdlib>
 #include <map>
 
 #define TRANSFORMATION_OPTION_WIDTH             "width"
@@ -28,7 +31,6 @@ static const std::string ImageBasePath = "/image/";
 CHTTPImageTransformationHandler::CHTTPImageTransformationHandler()
   : m_url(),
     m_lastModified(),
-    m_buffer(NULL),
     m_responseData()
 { }
 
@@ -36,7 +38,6 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
   : IHTTPRequestHandler(request),
     m_url(),
     m_lastModified(),
-    m_buffer(NULL),
     m_responseData()
 {
   m_url = m_request.pathUrl.substr(ImageBasePath.size());
@@ -64,6 +65,47 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
   StringUtils::ToLower(ext);
   m_response.contentType = CMime::GetMimeType(ext);
 
+  // get the transformation options
+  std::map<std::string, std::string> options;
+  HTTPRequestHandlerUtils::GetRequestHeaderValues(m_request.connection, MHD_GET_ARGUMENT_KIND, options);
+
+  std::vector<std::string> urlOptions;
+  unsigned int width = 0;
+  unsigned int height = 0;
+  std::string scalingAlgorithm;
+  std::map<std::string, std::string>::const_iterator option = options.find(TRANSFORMATION_OPTION_WIDTH);
+  if (option != options.end())
+  {
+    urlOptions.push_back(TRANSFORMATION_OPTION_WIDTH "=" + option->second);
+    if (StringUtils::IsInteger(option->second))
+      width = strtoul(option->second.c_str(), nullptr, 0);
+  }
+
+  option = options.find(TRANSFORMATION_OPTION_HEIGHT);
+  if (option != options.end())
+  {
+    urlOptions.push_back(TRANSFORMATION_OPTION_HEIGHT "=" + option->second);
+    if (StringUtils::IsInteger(option->second))
+      height = strtoul(option->second.c_str(), nullptr, 0);
+  }
+
+  option = options.find(TRANSFORMATION_OPTION_SCALING_ALGORITHM);
+  if (option != options.end())
+  {
+    urlOptions.push_back(TRANSFORMATION_OPTION_SCALING_ALGORITHM "=" + option->second);
+    const CPictureScalingAlgorithm::Algorithm algorithm =
+        CPictureScalingAlgorithm::FromString(option->second);
+    if (algorithm != CPictureScalingAlgorithm::NoAlgorithm)
+      scalingAlgorithm = CPictureScalingAlgorithm::ToString(algorithm);
+  }
+
+  m_imagePath = m_url;
+  if (!urlOptions.empty())
+  {
+    m_imagePath += "?";
+    m_imagePath += StringUtils::Join(urlOptions, "&");
+  }
+
   //! @todo determine the maximum age
 
   // determine the last modified date
@@ -71,6 +113,13 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
   if (imageFile.Stat(pathToUrl, &statBuffer) != 0)
     return;
 
+  // transformed images are cached (and revalidated) by the modification date and size of the
+  // original image so a replaced image is transformed again
+  const std::string imageHash = StringUtils::Format(
+      "d{}s{}", static_cast<int64_t>(statBuffer.st_mtime), static_cast<int64_t>(statBuffer.st_size));
+  m_cacheKey = CHTTPImageTransformationCache::GetKey(m_url, imageHash, width, height,
+                                                     scalingAlgorithm, ext);
+
   struct tm *time;
 #ifdef HAVE_LOCALTIME_R
   struct tm result = {};
@@ -87,8 +136,6 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
 CHTTPImageTransformationHandler::~CHTTPImageTransformationHandler()
 {
   m_responseData.clear();
-  delete m_buffer;
-  m_buffer = NULL;
 }
 
 bool CHTTPImageTransformationHandler::CanHandleRequest(const HTTPRequest &request) const
@@ -110,53 +157,51 @@ MHD_RESULT CHTTPImageTransformationHandler::HandleRequest()
   if (m_response.type == HTTPError)
     return MHD_YES;
 
-  // get the transformation options
-  std::map<std::string, std::string> options;
-  HTTPRequestHandlerUtils::GetRequestHeaderValues(m_request.connection, MHD_GET_ARGUMENT_KIND, options);
-
-  std::vector<std::string> urlOptions;
-  std::map<std::string, std::string>::const_iterator option = options.find(TRANSFORMATION_OPTION_WIDTH);
-  if (option != options.end())
-    urlOptions.push_back(TRANSFORMATION_OPTION_WIDTH "=" + option->second);
-
-  option = options.find(TRANSFORMATION_OPTION_HEIGHT);
-  if (option != options.end())
-    urlOptions.push_back(TRANSFORMATION_OPTION_HEIGHT "=" + option->second);
-
-  option = options.find(TRANSFORMATION_OPTION_SCALING_ALGORITHM);
-  if (option != options.end())
-    urlOptions.push_back(TRANSFORMATION_OPTION_SCALING_ALGORITHM "=" + option->second);
-
-  std::string imagePath = m_url;
-  if (!urlOptions.empty())
-  {
-    imagePath += "?";
-    imagePath += StringUtils::Join(urlOptions, "&");
-  }
-
   // resize the image into the local buffer
-  size_t bufferSize;
-  if (!CTextureCacheJob::ResizeTexture(imagePath, m_buffer, bufferSize))
+  const auto resize = [this](std::vector<uint8_t>& data)
   {
-    m_response.status = MHD_HTTP_INTERNAL_SERVER_ERROR;
+    uint8_t* buffer = nullptr;
+    size_t bufferSize = 0;
+    if (!CTextureCacheJob::ResizeTexture(m_imagePath, buffer, bufferSize))
+      return false;
+
+    data.assign(buffer, buffer + bufferSize);
+    delete[] buffer;
+    return true;
+  };
+
+  // without a cache key the image can't be cached
+  CHTTPImageTransformationCache::Result result;
+  if (m_cacheKey.empty())
+    result = resize(m_buffer) ? CHTTPImageTransformationCache::Result::Success
+                              : CHTTPImageTransformationCache::Result::Failed;
+  else
+    result = CHTTPImageTransformationCache::GetInstance().Get(m_cacheKey, resize, m_buffer);
+
+  if (result != CHTTPImageTransformationCache::Result::Success)
+  {
+    // if too many images are being transformed let the client retry later
+    m_response.status = result == CHTTPImageTransformationCache::Result::Busy
+                            ? MHD_HTTP_SERVICE_UNAVAILABLE
+                            : MHD_HTTP_INTERNAL_SERVER_ERROR;
     m_response.type = HTTPError;
 
     return MHD_YES;
   }
 
   // store the size of the image
-  m_response.totalLength = bufferSize;
+  m_response.totalLength = m_buffer.size();
 
   // nothing else to do if the request is not ranged
   if (!GetRequestedRanges(m_response.totalLength))
   {
-    m_responseData.emplace_back(m_buffer, 0, m_response.totalLength - 1);
+    m_responseData.emplace_back(m_buffer.data(), 0, m_response.totalLength - 1);
     return MHD_YES;
   }
 
   for (HttpRanges::const_iterator range = m_request.ranges.Begin(); range != m_request.ranges.End(); ++range)
-    m_responseData.emplace_back(m_buffer + range->GetFirstPosition(), range->GetFirstPosition(),
-                                range->GetLastPosition());
+    m_responseData.emplace_back(m_buffer.data() + range->GetFirstPosition(),
+                                range->GetFirstPosition(), range->GetLastPosition());
 
   return MHD_YES;
 }
@@ -169,3 +214,12 @@ bool CHTTPImageTransformationHandler::GetLastModifiedDate(CDateTime &lastModifie
   lastModified = m_lastModified;
   return true;
 }
+
+bool CHTTPImageTransformationHandler::GetETag(std::string& etag) const
+{
+  if (m_cacheKey.empty())
+    return false;
+
+  etag = "\"" + m_cacheKey + "\"";
+  return true;
+}
@@ -13,6 +13,7 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 class CHTTPImageTransformationHandler : public IHTTPRequestHandler
 {
@@ -28,6 +29,7 @@ public:
   bool CanHandleRanges() const override { return true; }
   bool CanBeCached() const override { return true; }
   bool GetLastModifiedDate(CDateTime &lastModified) const override;
+  bool GetETag(std::string& etag) const override;
 
   HttpResponseRanges GetResponseData() const override { return m_responseData; }
 
@@ -39,8 +41,10 @@ protected:
 
 private:
   std::string m_url;
+  std::string m_imagePath;
   CDateTime m_lastModified;
+  std::string m_cacheKey;
 
-  uint8_t* m_buffer;
+  std::vector<uint8_t> m_buffer;
   HttpResponseRanges m_responseData;
 };
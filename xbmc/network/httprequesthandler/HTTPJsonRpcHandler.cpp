@@ -11,6 +11,7 @@
 #include "ServiceBroker.h"
 #include "URL.h"
 #include "interfaces/json-rpc/JSONRPC.h"
+#include "interfaces/json-rpc/JSONRPCResponseStream.h"
 #include "interfaces/json-rpc/JSONServiceDescription.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
 #include "utils/FileUtils.h"
@@ -20,6 +21,14 @@
 
 #define MAX_HTTP_POST_SIZE 65536
 
+CHTTPJsonRpcHandler::CHTTPJsonRpcHandler() = default;
+
+CHTTPJsonRpcHandler::CHTTPJsonRpcHandler(const HTTPRequest& request) : IHTTPRequestHandler(request)
+{
+}
+
+CHTTPJsonRpcHandler::~CHTTPJsonRpcHandler() = default;
+
 bool CHTTPJsonRpcHandler::CanHandleRequest(const HTTPRequest &request) const
 {
   return (request.pathUrl.compare("/jsonrpc") == 0);
@@ -70,12 +79,28 @@ MHD_RESULT CHTTPJsonRpcHandler::HandleRequest()
       jsonpCallback = argument->second;
   }
 
-  if (isRequest)
+  if (isRequest && jsonpCallback.empty())
   {
-    m_responseData = JSONRPC::CJSONRPC::MethodCall(m_requestData, &m_transportLayer, &client);
+    // stream the response so that large lists don't have to be serialized in one go
+    m_responseStream =
+        JSONRPC::CJSONRPC::MethodCallStream(m_requestData, &m_transportLayer, &client);
+    m_requestData.clear();
+
+    if (!m_responseStream->IsEmpty())
+    {
+      m_response.type = HTTPStreamDownload;
+      m_response.status = MHD_HTTP_OK;
+      m_response.contentType = "application/json";
+
+      return MHD_YES;
+    }
 
-    if (!jsonpCallback.empty())
-      m_responseData = jsonpCallback + "(" + m_responseData + ");";
+    m_responseStream.reset();
+  }
+  else if (isRequest)
+  {
+    m_responseData = JSONRPC::CJSONRPC::MethodCall(m_requestData, &m_transportLayer, &client);
+    m_responseData = jsonpCallback + "(" + m_responseData + ");";
   }
   else if (jsonpCallback.empty())
   {
@@ -118,6 +143,14 @@ HttpResponseRanges CHTTPJsonRpcHandler::GetResponseData() const
   return ranges;
 }
 
+size_t CHTTPJsonRpcHandler::ReadResponseStream(char* buffer, size_t size)
+{
+  if (m_responseStream == nullptr)
+    return 0;
+
+  return m_responseStream->Read(buffer, size);
+}
+
 bool CHTTPJsonRpcHandler::appendPostData(const char *data, size_t size)
 {
   if (m_requestData.size() + size > MAX_HTTP_POST_SIZE)
@@ -62,6 +62,30 @@ bool HTTPRequestHandlerUtils::GetRequestedRanges(struct MHD_Connection *connecti
   return ranges.Parse(GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_RANGE), totalLength);
 }
 
+bool HTTPRequestHandlerUtils::MatchesETag(const std::string& ifNoneMatch, const std::string& etag)
+{
+  if (etag.empty())
+    return false;
+
+  const auto stripWeak = [](std::string tag)
+  {
+    StringUtils::Trim(tag);
+    if (StringUtils::StartsWith(tag, "W/"))
+      tag.erase(0, 2);
+    return tag;
+  };
+
+  const std::string strongETag = stripWeak(etag);
+  for (const auto& tag : StringUtils::Split(ifNoneMatch, ","))
+  {
+    const std::string value = stripWeak(tag);
+    if (value == "*" || value == strongETag)
+      return true;
+  }
+
+  return false;
+}
+
 MHD_RESULT HTTPRequestHandlerUtils::FillArgumentMap(void *cls, enum MHD_ValueKind kind, const char *key, const char *value)
 {
   if (cls == nullptr || key == nullptr)
@@ -22,6 +22,12 @@ public:
 
   static bool GetRequestedRanges(struct MHD_Connection *connection, uint64_t totalLength, CHttpRanges &ranges);
 
+  /*!
+   * \brief Checks whether the value of an If-None-Match header matches the given entity tag using
+   * the weak comparison function.
+   */
+  static bool MatchesETag(const std::string& ifNoneMatch, const std::string& etag);
+
 private:
   HTTPRequestHandlerUtils() = delete;
 
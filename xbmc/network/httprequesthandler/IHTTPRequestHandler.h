@@ -60,7 +60,10 @@ typedef enum HTTPResponseType
   HTTPMemoryDownloadFreeNoCopy,
   // creates a HTTP response from a buffer by copying followed by freeing the buffer
   // the buffer must have been malloc'ed and not new'ed
-  HTTPMemoryDownloadFreeCopy
+  HTTPMemoryDownloadFreeCopy,
+  // creates a HTTP response of unknown length which is read from the request handler while it
+  // is being sent
+  HTTPStreamDownload
 } HTTPResponseType;
 
 typedef struct HTTPRequest
@@ -146,6 +149,13 @@ public:
   */
   virtual bool GetLastModifiedDate(CDateTime &lastModified) const { return false; }
 
+  /*!
+  * \brief Returns the entity tag (including the quotes) of the response.
+  *
+  * \details This is only used if the response can be cached.
+  */
+  virtual bool GetETag(std::string& etag) const { return false; }
+
   /*!
    * \brief Returns the ranges with raw data belonging to the response.
    *
@@ -167,6 +177,15 @@ public:
   */
   virtual std::string GetResponseFile() const { return ""; }
 
+  /*!
+  * \brief Reads the next part of the response into the given buffer.
+  *
+  * \details This is only used if the response type is HTTPStreamDownload.
+  *
+  * \return Number of bytes written to the buffer or 0 at the end of the response.
+  */
+  virtual size_t ReadResponseStream(char* buffer, size_t size) { return 0; }
+
   /*!
   * \brief Returns the HTTP request handled by the HTTP request handler.
   */
@@ -0,0 +1,185 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "network/httprequesthandler/HTTPFileCache.h"
+#include "test/TestUtils.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr size_t BLOCK_SIZE = CHTTPFileCache::BLOCK_SIZE;
+constexpr size_t FILE_SIZE = 3 * BLOCK_SIZE + 100;
+constexpr const char* DISK_PATH = "special://temp/httpfilecachetest/";
+
+uint8_t GetByte(uint64_t position)
+{
+  return static_cast<uint8_t>((position * 7) % 251);
+}
+
+class TestHTTPFileCache : public testing::Test
+{
+protected:
+  TestHTTPFileCache()
+  {
+    XFILE::CFile* file = XBMC_CREATETEMPFILE(".bin");
+    std::vector<uint8_t> data(FILE_SIZE);
+    for (size_t i = 0; i < data.size(); ++i)
+      data[i] = GetByte(i);
+    file->Write(data.data(), data.size());
+    file->Flush();
+
+    m_path = XBMC_TEMPFILEPATH(file);
+    m_file = file;
+  }
+
+  // rewrites the file with the given size, the content starts at the given byte of the sequence
+  void RewriteFile(size_t size, uint64_t first)
+  {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < data.size(); ++i)
+      data[i] = GetByte(first + i);
+
+    XFILE::CFile file;
+    ASSERT_TRUE(file.OpenForWrite(m_path, true));
+    ASSERT_EQ(static_cast<ssize_t>(data.size()), file.Write(data.data(), data.size()));
+  }
+
+  ~TestHTTPFileCache() override { XBMC_DELETETEMPFILE(m_file); }
+
+  // reads from the given position and checks the content
+  void CheckRead(CHTTPFileCache::CReader& reader, uint64_t position, size_t size)
+  {
+    std::vector<uint8_t> buffer(size);
+    const int64_t read = reader.Read(position, buffer.data(), buffer.size());
+    ASSERT_GT(read, 0);
+    for (int64_t i = 0; i < read; ++i)
+      ASSERT_EQ(GetByte(position + i), buffer[i]) << "at position " << position + i;
+  }
+
+  XFILE::CFile* m_file;
+  std::string m_path;
+};
+} // namespace
+
+TEST_F(TestHTTPFileCache, ReadsBlocksThroughCache)
+{
+  CHTTPFileCache cache(2 * BLOCK_SIZE, 0, DISK_PATH, true);
+
+  auto reader = cache.Open(m_path);
+  ASSERT_NE(nullptr, reader);
+  EXPECT_EQ(FILE_SIZE, reader->GetLength());
+
+  CheckRead(*reader, 10, 1000);
+  CheckRead(*reader, 20, 1000);
+  CheckRead(*reader, BLOCK_SIZE + 10, 1000);
+
+  CHTTPFileCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(2u, stats.misses);
+  EXPECT_EQ(1u, stats.hits);
+  EXPECT_EQ(2 * BLOCK_SIZE, stats.memoryUsed);
+
+  // reads never cross the end of a block
+  char buffer[100];
+  EXPECT_EQ(50, reader->Read(BLOCK_SIZE - 50, buffer, sizeof(buffer)));
+
+  // the last block is shorter
+  EXPECT_EQ(50, reader->Read(3 * BLOCK_SIZE + 50, buffer, sizeof(buffer)));
+  EXPECT_EQ(0, reader->Read(FILE_SIZE, buffer, sizeof(buffer)));
+
+  // the least recently used blocks have been evicted
+  stats = cache.GetStats();
+  EXPECT_LE(stats.memoryUsed, 2 * BLOCK_SIZE);
+  EXPECT_EQ(0u, stats.diskUsed);
+}
+
+TEST_F(TestHTTPFileCache, ReusesOpenedFiles)
+{
+  CHTTPFileCache cache(BLOCK_SIZE, 0, DISK_PATH, true);
+
+  auto reader = cache.Open(m_path);
+  ASSERT_NE(nullptr, reader);
+  CheckRead(*reader, 0, 100);
+  reader.reset();
+
+  EXPECT_EQ(1u, cache.GetStats().openFiles);
+
+  reader = cache.Open(m_path);
+  ASSERT_NE(nullptr, reader);
+  CheckRead(*reader, 2 * BLOCK_SIZE, 100);
+
+  CHTTPFileCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(0u, stats.openFiles);
+  EXPECT_EQ(1u, stats.reusedFiles);
+
+  reader.reset();
+  cache.Clear();
+  EXPECT_EQ(0u, cache.GetStats().openFiles);
+  EXPECT_EQ(0u, cache.GetStats().memoryUsed);
+
+  EXPECT_EQ(nullptr, cache.Open(m_path + ".missing"));
+}
+
+TEST_F(TestHTTPFileCache, SpillsBlocksToDisk)
+{
+  CHTTPFileCache cache(BLOCK_SIZE, 2 * BLOCK_SIZE, DISK_PATH, true);
+
+  auto reader = cache.Open(m_path);
+  ASSERT_NE(nullptr, reader);
+  CheckRead(*reader, 0, 100);
+  CheckRead(*reader, BLOCK_SIZE, 100);
+  CheckRead(*reader, 2 * BLOCK_SIZE, 100);
+
+  CHTTPFileCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(3u, stats.misses);
+  EXPECT_EQ(BLOCK_SIZE, stats.memoryUsed);
+  EXPECT_EQ(2 * BLOCK_SIZE, stats.diskUsed);
+
+  // the first block is read back from disk
+  CheckRead(*reader, 100, BLOCK_SIZE);
+  stats = cache.GetStats();
+  EXPECT_EQ(3u, stats.misses);
+  EXPECT_EQ(1u, stats.hits);
+  EXPECT_EQ(BLOCK_SIZE, stats.memoryUsed);
+  EXPECT_EQ(2 * BLOCK_SIZE, stats.diskUsed);
+}
+
+TEST_F(TestHTTPFileCache, RevalidatesReusedFiles)
+{
+  CHTTPFileCache cache(4 * BLOCK_SIZE, 0, DISK_PATH, true);
+
+  auto reader = cache.Open(m_path);
+  ASSERT_NE(nullptr, reader);
+  CheckRead(*reader, 0, 100);
+  reader.reset();
+  ASSERT_EQ(1u, cache.GetStats().openFiles);
+
+  // the file grows, like a recording in progress, and its first block changes
+  const size_t grownSize = FILE_SIZE + BLOCK_SIZE;
+  RewriteFile(grownSize, 1);
+
+  reader = cache.Open(m_path);
+  ASSERT_NE(nullptr, reader);
+  EXPECT_EQ(grownSize, reader->GetLength());
+  EXPECT_EQ(0u, cache.GetStats().reusedFiles);
+
+  std::vector<uint8_t> buffer(100);
+  ASSERT_EQ(100, reader->Read(0, buffer.data(), buffer.size()));
+  for (size_t i = 0; i < buffer.size(); ++i)
+    ASSERT_EQ(GetByte(i + 1), buffer[i]) << "at position " << i;
+  ASSERT_EQ(100, reader->Read(grownSize - 100, buffer.data(), buffer.size()));
+  reader.reset();
+
+  // an unchanged file is reused
+  reader = cache.Open(m_path);
+  ASSERT_NE(nullptr, reader);
+  EXPECT_EQ(1u, cache.GetStats().reusedFiles);
+}
@@ -0,0 +1,182 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/Directory.h"
+#include "network/httprequesthandler/HTTPImageTransformationCache.h"
+#include "threads/Event.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr const char* CACHE_PATH = "special://temp/httpimagetransformationcachetest/";
+
+using Result = CHTTPImageTransformationCache::Result;
+
+class TestHTTPImageTransformationCache : public testing::Test
+{
+protected:
+  ~TestHTTPImageTransformationCache() override { XFILE::CDirectory::RemoveRecursive(CACHE_PATH); }
+
+  // returns a transformation producing an image of the given size and counting its calls
+  CHTTPImageTransformationCache::Transformation Transform(size_t size)
+  {
+    return [this, size](std::vector<uint8_t>& data)
+    {
+      m_transformations++;
+      data.assign(size, static_cast<uint8_t>(size));
+      return true;
+    };
+  }
+
+  std::atomic<int> m_transformations{0};
+};
+} // namespace
+
+TEST_F(TestHTTPImageTransformationCache, GetKey)
+{
+  EXPECT_EQ(CHTTPImageTransformationCache::GetKey("image://a.jpg/", "d100s2", 200, 0, "", "jpg"),
+            CHTTPImageTransformationCache::GetKey("IMAGE://A.JPG/", "d100s2", 200, 0, "", "JPG"));
+
+  const std::string key =
+      CHTTPImageTransformationCache::GetKey("image://a.jpg/", "d100s2", 200, 300, "bicubic", "jpg");
+  EXPECT_NE(std::string::npos, key.find("-d100s2-200x300-bicubic.jpg"));
+
+  // any part of the key changing results in a different image
+  EXPECT_NE(key, CHTTPImageTransformationCache::GetKey("image://a.jpg/", "d101s2", 200, 300,
+                                                       "bicubic", "jpg"));
+  EXPECT_NE(key, CHTTPImageTransformationCache::GetKey("image://a.jpg/", "d100s2", 200, 300, "",
+                                                       "jpg"));
+
+  // the key is used as a file name and as an ETag
+  EXPECT_EQ(std::string::npos,
+            CHTTPImageTransformationCache::GetKey("image://a.jpg/", "../\"", 1, 1, "/", "\"")
+                .find_first_of("/\"\\"));
+}
+
+TEST_F(TestHTTPImageTransformationCache, StoresTransformedImages)
+{
+  std::vector<uint8_t> data;
+  {
+    CHTTPImageTransformationCache cache(CACHE_PATH, 1024, 2, 1s);
+    EXPECT_EQ(Result::Success, cache.Get("a.jpg", Transform(100), data));
+    EXPECT_EQ(100u, data.size());
+    EXPECT_EQ(Result::Success, cache.Get("a.jpg", Transform(100), data));
+    EXPECT_EQ(100u, data.size());
+    EXPECT_EQ(1, m_transformations);
+
+    // failed transformations aren't stored
+    EXPECT_EQ(Result::Failed,
+              cache.Get("b.jpg", [](std::vector<uint8_t>& data) { return false; }, data));
+  }
+
+  // the transformed images are persistent
+  CHTTPImageTransformationCache cache(CACHE_PATH, 1024, 2, 1s);
+  EXPECT_EQ(Result::Success, cache.Get("a.jpg", Transform(100), data));
+  EXPECT_EQ(100u, data.size());
+  EXPECT_EQ(100, data[0]);
+  EXPECT_EQ(1, m_transformations);
+
+  cache.Clear();
+  EXPECT_EQ(Result::Success, cache.Get("a.jpg", Transform(100), data));
+  EXPECT_EQ(2, m_transformations);
+}
+
+TEST_F(TestHTTPImageTransformationCache, EvictsLeastRecentlyUsed)
+{
+  CHTTPImageTransformationCache cache(CACHE_PATH, 250, 2, 1s);
+
+  std::vector<uint8_t> data;
+  EXPECT_EQ(Result::Success, cache.Get("a.jpg", Transform(100), data));
+  EXPECT_EQ(Result::Success, cache.Get("b.jpg", Transform(100), data));
+  EXPECT_EQ(Result::Success, cache.Get("a.jpg", Transform(100), data));
+  EXPECT_EQ(Result::Success, cache.Get("c.jpg", Transform(100), data));
+  EXPECT_EQ(3, m_transformations);
+
+  // b.jpg has been evicted to make room for c.jpg
+  EXPECT_EQ(Result::Success, cache.Get("a.jpg", Transform(100), data));
+  EXPECT_EQ(3, m_transformations);
+  EXPECT_EQ(Result::Success, cache.Get("b.jpg", Transform(100), data));
+  EXPECT_EQ(4, m_transformations);
+
+  // images larger than the cache are transformed but not stored
+  EXPECT_EQ(Result::Success, cache.Get("d.jpg", Transform(300), data));
+  EXPECT_EQ(Result::Success, cache.Get("d.jpg", Transform(300), data));
+  EXPECT_EQ(6, m_transformations);
+}
+
+TEST_F(TestHTTPImageTransformationCache, TransformsIdenticalRequestsOnce)
+{
+  CHTTPImageTransformationCache cache(CACHE_PATH, 1024, 4, 5s);
+
+  std::vector<std::thread> threads;
+  std::atomic<int> succeeded{0};
+  for (int i = 0; i < 4; i++)
+  {
+    threads.emplace_back(
+        [this, &cache, &succeeded]
+        {
+          std::vector<uint8_t> data;
+          const auto transform = [this](std::vector<uint8_t>& data)
+          {
+            m_transformations++;
+            std::this_thread::sleep_for(100ms);
+            data.assign(100, 1);
+            return true;
+          };
+          if (cache.Get("a.jpg", transform, data) == Result::Success && data.size() == 100)
+            succeeded++;
+        });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(4, succeeded);
+  EXPECT_EQ(1, m_transformations);
+}
+
+TEST_F(TestHTTPImageTransformationCache, LimitsConcurrentTransformations)
+{
+  CHTTPImageTransformationCache cache(CACHE_PATH, 1024, 1, 100ms);
+
+  CEvent started;
+  CEvent release;
+  std::thread thread(
+      [&cache, &started, &release]
+      {
+        std::vector<uint8_t> data;
+        cache.Get("a.jpg",
+                  [&started, &release](std::vector<uint8_t>& data)
+                  {
+                    started.Set();
+                    release.Wait();
+                    data.assign(100, 1);
+                    return true;
+                  },
+                  data);
+      });
+
+  ASSERT_TRUE(started.Wait(5s));
+
+  // the only transformation slot is occupied
+  std::vector<uint8_t> data;
+  EXPECT_EQ(Result::Busy, cache.Get("b.jpg", Transform(100), data));
+  EXPECT_EQ(0, m_transformations);
+
+  release.Set();
+  thread.join();
+
+  EXPECT_EQ(Result::Success, cache.Get("b.jpg", Transform(100), data));
+  EXPECT_EQ(1, m_transformations);
+}
@@ -16,6 +16,7 @@
 #include <gtest/gtest.h>
 #include "URL.h"
 #include "filesystem/CurlFile.h"
+#include "filesystem/DllLibCurl.h"
 #include "filesystem/File.h"
 #include "interfaces/json-rpc/JSONRPC.h"
 #include "network/WebServer.h"
@@ -28,7 +29,11 @@
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 
+#include <atomic>
+#include <chrono>
+#include <iostream>
 #include <random>
+#include <thread>
 
 using namespace XFILE;
 
@@ -351,6 +356,54 @@ protected:
     return StringUtils::Format("bytes={}-{}", start, end);
   }
 
+  void Restart(CWebServer::ConnectionMode mode, unsigned int threadPoolSize = 0)
+  {
+    webserver.Stop();
+    webserver.SetConnectionMode(mode, threadPoolSize);
+    ASSERT_TRUE(webserver.Start(webserverPort, "", ""));
+  }
+
+  // runs the given number of clients in parallel, each of them sending requests alternating
+  // between JSON-RPC and file downloads over a kept-alive connection, returns the number of
+  // failed requests
+  int RunClients(int clients, int requestsPerClient)
+  {
+    const std::string jsonRpcUrl = GetUrl(
+        TEST_URL_JSONRPC "?request=" +
+        CURL::Encode("{ \"jsonrpc\": \"2.0\", \"method\": \"JSONRPC.Version\", \"id\": 1 }"));
+    const std::string fileUrl = GetUrlOfTestFile(TEST_FILES_RANGES);
+
+    std::atomic<int> failed{0};
+    std::vector<std::thread> threads;
+    for (int client = 0; client < clients; ++client)
+    {
+      threads.emplace_back(
+          [&]()
+          {
+            CCurlFile curl;
+            for (int request = 0; request < requestsPerClient; ++request)
+            {
+              std::string result;
+              if (request % 2 == 0)
+              {
+                CVariant resultObj;
+                if (!curl.Get(jsonRpcUrl, result) ||
+                    !CJSONVariantParser::Parse(result, resultObj) ||
+                    !resultObj.isMember("result"))
+                  failed++;
+              }
+              else if (!curl.Get(fileUrl, result) || result != TEST_FILES_DATA_RANGES)
+                failed++;
+            }
+          });
+    }
+
+    for (auto& thread : threads)
+      thread.join();
+
+    return failed;
+  }
+
   CWebServer webserver;
   CHTTPJsonRpcHandler m_jsonRpcHandler;
   CHTTPVfsHandler m_vfsHandler;
@@ -567,6 +620,64 @@ TEST_F(TestWebServer, CanGetFile)
   CheckHtmlTestFileResponse(curl);
 }
 
+TEST_F(TestWebServer, CanReuseCurlConnections)
+{
+  const int requests = 5;
+  const auto before = g_curlInterface.GetStats();
+
+  for (int i = 0; i < requests; i++)
+  {
+    std::string result;
+    CCurlFile curl;
+    ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_HTML), result));
+    ASSERT_STREQ(TEST_FILES_DATA, result.c_str());
+  }
+
+  // every request after the first one reuses the connection of the released session
+  const auto after = g_curlInterface.GetStats();
+  EXPECT_EQ(before.requests + requests, after.requests);
+  EXPECT_GE(after.reusedConnections - before.reusedConnections,
+            static_cast<uint64_t>(requests - 1));
+  EXPECT_EQ(before.busySessions, after.busySessions);
+}
+
+TEST_F(TestWebServer, CurlLimitsSessionsPerHost)
+{
+  // occupy all sessions to the host
+  std::vector<CURL_HANDLE*> handles;
+  for (int i = 0; i < 8; i++)
+  {
+    CURL_HANDLE* handle = nullptr;
+    g_curlInterface.easy_acquire("http", WEBSERVER_HOST, &handle, nullptr);
+    ASSERT_NE(nullptr, handle);
+    handles.push_back(handle);
+  }
+
+  const auto before = g_curlInterface.GetStats();
+  std::atomic<bool> acquired{false};
+  CURL_HANDLE* waitingHandle = nullptr;
+  std::thread thread(
+      [&acquired, &waitingHandle]
+      {
+        g_curlInterface.easy_acquire("http", WEBSERVER_HOST, &waitingHandle, nullptr);
+        acquired = true;
+      });
+
+  // the session is only acquired once another one has been released
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_FALSE(acquired);
+  g_curlInterface.easy_release(&handles.back(), nullptr);
+  handles.pop_back();
+  thread.join();
+
+  EXPECT_TRUE(acquired);
+  EXPECT_EQ(before.hostWaits + 1, g_curlInterface.GetStats().hostWaits);
+
+  handles.push_back(waitingHandle);
+  for (auto& handle : handles)
+    g_curlInterface.easy_release(&handle, nullptr);
+}
+
 TEST_F(TestWebServer, CanGetFileForcingNoCache)
 {
   // check non-cacheable HTML with Control-Cache: no-cache
@@ -922,3 +1033,54 @@ TEST_F(TestWebServer, CanGetCachedRangedFileWithNewerIfRange)
   ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
   CheckRangesTestFileResponse(curl, result, ranges);
 }
+
+TEST_F(TestWebServer, CanGetFileWithEventLoop)
+{
+  Restart(CWebServer::ConnectionMode::EventLoop);
+
+  std::string result;
+  CCurlFile curl;
+  ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_HTML), result));
+  ASSERT_STREQ(TEST_FILES_DATA, result.c_str());
+
+  CheckHtmlTestFileResponse(curl);
+}
+
+TEST_F(TestWebServer, CanServeMoreClientsThanWorkerThreads)
+{
+  Restart(CWebServer::ConnectionMode::EventLoop, 2);
+  JSONRPC::CJSONRPC::Initialize();
+
+  EXPECT_EQ(0, RunClients(16, 10));
+
+  JSONRPC::CJSONRPC::Cleanup();
+}
+
+// many concurrent keep-alive clients against both connection modes
+TEST_F(TestWebServer, DISABLED_LoadTest)
+{
+  const int clients = 64;
+  const int requestsPerClient = 200;
+
+  JSONRPC::CJSONRPC::Initialize();
+
+  for (auto mode :
+       {CWebServer::ConnectionMode::ThreadPerConnection, CWebServer::ConnectionMode::EventLoop})
+  {
+    Restart(mode);
+
+    const auto start = std::chrono::steady_clock::now();
+    const int failed = RunClients(clients, requestsPerClient);
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(0, failed);
+    std::cout << (mode == CWebServer::ConnectionMode::EventLoop ? "Event loop"
+                                                                : "Thread per connection")
+              << ": " << clients * requestsPerClient << " requests from " << clients
+              << " clients in " << duration.count() << " s ("
+              << clients * requestsPerClient / duration.count() << " requests/s, " << failed
+              << " failed)" << std::endl;
+  }
+
+  JSONRPC::CJSONRPC::Cleanup();
+}
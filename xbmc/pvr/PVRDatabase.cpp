@@ -975,7 +975,7 @@ bool CPVRDatabase::PersistChannels(const CPVRChannelGroup& group)
   std::shared_ptr<CPVRChannel> channel;
   for (const auto& groupMember : group.m_members)
   {
-    channel = groupMember.second->Channel();
+    channel = groupMember->Channel();
     if (channel->IsChanged() || channel->IsNew())
     {
       if (Persist(*channel, false))
@@ -994,7 +994,7 @@ bool CPVRDatabase::PersistChannels(const CPVRChannelGroup& group)
     std::string strValue;
     for (const auto& groupMember : group.m_members)
     {
-      channel = groupMember.second->Channel();
+      channel = groupMember->Channel();
       strQuery =
           PrepareSQL("iUniqueId = %i AND iClientId = %i", channel->UniqueID(), channel->ClientID());
       strValue = GetSingleValue("channels", "idChannel", strQuery);
@@ -1002,7 +1002,7 @@ bool CPVRDatabase::PersistChannels(const CPVRChannelGroup& group)
       {
         const int iChannelID = std::atoi(strValue.c_str());
         channel->SetChannelID(iChannelID);
-        groupMember.second->m_iChannelDatabaseID = iChannelID;
+        groupMember->m_iChannelDatabaseID = iChannelID;
       }
     }
   }
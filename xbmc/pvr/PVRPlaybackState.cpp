@@ -351,54 +351,55 @@ void CPVRPlaybackState::StartPlayback(
     ContentUtils::PlayMode mode /* = ContentUtils::PlayMode::CHECK_AUTO_PLAY_NEXT_ITEM */) const
 {
   // Obtain dynamic playback url and properties from the respective pvr client
-  const std::shared_ptr<const CPVRClient> client = CServiceBroker::GetPVRManager().GetClient(*item);
-  if (client)
+  if (FillStreamProperties(*item) && item->IsEPG())
   {
-    CPVRStreamProperties props;
-
-    if (item->IsPVRChannel())
+    if (mode == ContentUtils::PlayMode::CHECK_AUTO_PLAY_NEXT_ITEM)
     {
-      client->GetChannelStreamProperties(item->GetPVRChannelInfoTag(), props);
+      if (CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(
+              CSettings::SETTING_PVRPLAYBACK_AUTOPLAYNEXTPROGRAMME))
+        item->SetProperty("epg_playlist_item", true);
     }
-    else if (item->IsPVRRecording())
+    else if (mode == ContentUtils::PlayMode::PLAY_FROM_HERE)
     {
-      client->GetRecordingStreamProperties(item->GetPVRRecordingInfoTag(), props);
+      item->SetProperty("epg_playlist_item", true);
     }
-    else if (item->IsEPG())
-    {
-      client->GetEpgTagStreamProperties(item->GetEPGInfoTag(), props);
+  }
 
-      if (mode == ContentUtils::PlayMode::CHECK_AUTO_PLAY_NEXT_ITEM)
-      {
-        if (CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(
-                CSettings::SETTING_PVRPLAYBACK_AUTOPLAYNEXTPROGRAMME))
-          item->SetProperty("epg_playlist_item", true);
-      }
-      else if (mode == ContentUtils::PlayMode::PLAY_FROM_HERE)
-      {
-        item->SetProperty("epg_playlist_item", true);
-      }
-    }
+  CServiceBroker::GetAppMessenger()->PostMsg(TMSG_MEDIA_PLAY, 0, 0, static_cast<void*>(item));
+}
 
-    if (props.size())
-    {
-      const std::string url = props.GetStreamURL();
-      if (!url.empty())
-        item->SetDynPath(url);
+bool CPVRPlaybackState::FillStreamProperties(CFileItem& item) const
+{
+  const std::shared_ptr<const CPVRClient> client = CServiceBroker::GetPVRManager().GetClient(item);
+  if (!client)
+    return false;
 
-      const std::string mime = props.GetStreamMimeType();
-      if (!mime.empty())
-      {
-        item->SetMimeType(mime);
-        item->SetContentLookup(false);
-      }
+  CPVRStreamProperties props;
+
+  if (item.IsPVRChannel())
+    client->GetChannelStreamProperties(item.GetPVRChannelInfoTag(), props);
+  else if (item.IsPVRRecording())
+    client->GetRecordingStreamProperties(item.GetPVRRecordingInfoTag(), props);
+  else if (item.IsEPG())
+    client->GetEpgTagStreamProperties(item.GetEPGInfoTag(), props);
 
-      for (const auto& prop : props)
-        item->SetProperty(prop.first, prop.second);
+  if (props.size())
+  {
+    const std::string url = props.GetStreamURL();
+    if (!url.empty())
+      item.SetDynPath(url);
+
+    const std::string mime = props.GetStreamMimeType();
+    if (!mime.empty())
+    {
+      item.SetMimeType(mime);
+      item.SetContentLookup(false);
     }
-  }
 
-  CServiceBroker::GetAppMessenger()->PostMsg(TMSG_MEDIA_PLAY, 0, 0, static_cast<void*>(item));
+    for (const auto& prop : props)
+      item.SetProperty(prop.first, prop.second);
+  }
+  return true;
 }
 
 bool CPVRPlaybackState::IsPlaying() const
@@ -78,6 +78,13 @@ public:
       CFileItem* item,
       ContentUtils::PlayMode mode = ContentUtils::PlayMode::CHECK_AUTO_PLAY_NEXT_ITEM) const;
 
+  /*!
+   * @brief Set the playback url and stream properties obtained from the respective pvr client.
+   * @param item containing a channel, a recording or an epg tag.
+   * @return True if the client of the item was found, false otherwise.
+   */
+  bool FillStreamProperties(CFileItem& item) const;
+
   /*!
    * @brief Check if a TV channel, radio channel or recording is playing.
    * @return True if it's playing, false otherwise.
@@ -104,22 +104,23 @@ bool CPVRChannelGroup::LoadFromDatabase(
 
   for (const auto& groupMember : m_members)
   {
-    groupMember.second->SetGroupName(GroupName());
+    groupMember->SetGroupName(GroupName());
 
-    auto channel = groupMember.second->Channel();
+    auto channel = groupMember->Channel();
     if (channel)
       continue;
 
-    auto channelIt = channels.find(groupMember.first);
+    auto channelIt =
+        channels.find(std::make_pair(groupMember->ChannelClientID(), groupMember->ChannelUID()));
     if (channelIt == channels.end())
     {
-      CLog::Log(LOGERROR, "Cannot find group member '{},{}' in channels!", groupMember.first.first,
-                groupMember.first.second);
+      CLog::Log(LOGERROR, "Cannot find group member '{},{}' in channels!",
+                groupMember->ChannelClientID(), groupMember->ChannelUID());
       // No workaround here, please. We need to find and fix the root cause of this case!
     }
 
     channel = (*channelIt).second;
-    groupMember.second->SetChannel(channel);
+    groupMember->SetChannel(channel);
 
     // Create EPG for loaded channel
     channel->CreateEPG();
@@ -133,7 +134,7 @@ void CPVRChannelGroup::Unload()
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
   m_sortedMembers.clear();
-  m_members.clear();
+  m_members.Clear();
   m_failedClients.clear();
 }
 
@@ -180,31 +181,6 @@ void CPVRChannelGroup::SetPath(const CPVRChannelsPath& path)
 
 /********** sort methods **********/
 
-struct sortByClientChannelNumber
-{
-  bool operator()(const std::shared_ptr<const CPVRChannelGroupMember>& channel1,
-                  const std::shared_ptr<const CPVRChannelGroupMember>& channel2) const
-  {
-    if (channel1->ClientPriority() == channel2->ClientPriority())
-    {
-      if (channel1->ClientChannelNumber() == channel2->ClientChannelNumber())
-        return channel1->Channel()->ChannelName() < channel2->Channel()->ChannelName();
-
-      return channel1->ClientChannelNumber() < channel2->ClientChannelNumber();
-    }
-    return channel1->ClientPriority() > channel2->ClientPriority();
-  }
-};
-
-struct sortByChannelNumber
-{
-  bool operator()(const std::shared_ptr<const CPVRChannelGroupMember>& channel1,
-                  const std::shared_ptr<const CPVRChannelGroupMember>& channel2) const
-  {
-    return channel1->ChannelNumber() < channel2->ChannelNumber();
-  }
-};
-
 void CPVRChannelGroup::Sort()
 {
   if (GetSettings()->UseBackendChannelOrder())
@@ -223,13 +199,13 @@ bool CPVRChannelGroup::SortAndRenumber()
 void CPVRChannelGroup::SortByClientChannelNumber()
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
-  std::sort(m_sortedMembers.begin(), m_sortedMembers.end(), sortByClientChannelNumber());
+  CPVRChannelGroupMembers::SortByClientChannelNumber(m_sortedMembers);
 }
 
 void CPVRChannelGroup::SortByChannelNumber()
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
-  std::sort(m_sortedMembers.begin(), m_sortedMembers.end(), sortByChannelNumber());
+  CPVRChannelGroupMembers::SortByChannelNumber(m_sortedMembers);
 }
 
 void CPVRChannelGroup::UpdateClientPriorities()
@@ -284,8 +260,7 @@ std::shared_ptr<CPVRChannelGroupMember> CPVRChannelGroup::GetByUniqueID(
     const std::pair<int, int>& id) const
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
-  const auto it = m_members.find(id);
-  return it != m_members.end() ? it->second : std::shared_ptr<CPVRChannelGroupMember>();
+  return m_members.Get(id);
 }
 
 std::shared_ptr<CPVRChannel> CPVRChannelGroup::GetByUniqueID(int iUniqueChannelId,
@@ -300,10 +275,10 @@ std::shared_ptr<CPVRChannel> CPVRChannelGroup::GetByChannelID(int iChannelID) co
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
   const auto it =
-      std::find_if(m_members.cbegin(), m_members.cend(), [iChannelID](const auto& member) {
-        return member.second->Channel()->ChannelID() == iChannelID;
+      std::find_if(m_members.begin(), m_members.end(), [iChannelID](const auto& member) {
+        return member->Channel()->ChannelID() == iChannelID;
       });
-  return it != m_members.cend() ? (*it).second->Channel() : std::shared_ptr<CPVRChannel>();
+  return it != m_members.end() ? (*it)->Channel() : std::shared_ptr<CPVRChannel>();
 }
 
 std::shared_ptr<CPVRChannelGroupMember> CPVRChannelGroup::GetLastPlayedChannelGroupMember(
@@ -312,15 +287,15 @@ std::shared_ptr<CPVRChannelGroupMember> CPVRChannelGroup::GetLastPlayedChannelGr
   std::unique_lock<CCriticalSection> lock(m_critSection);
 
   std::shared_ptr<CPVRChannelGroupMember> groupMember;
-  for (const auto& memberPair : m_members)
+  for (const auto& member : m_members)
   {
-    const std::shared_ptr<const CPVRChannel> channel = memberPair.second->Channel();
+    const std::shared_ptr<const CPVRChannel> channel = member->Channel();
     if (channel->ChannelID() != iCurrentChannel &&
         CServiceBroker::GetPVRManager().Clients()->IsCreatedClient(channel->ClientID()) &&
         channel->LastWatched() > 0 &&
         (!groupMember || channel->LastWatched() > groupMember->Channel()->LastWatched()))
     {
-      groupMember = memberPair.second;
+      groupMember = member;
     }
   }
 
@@ -498,6 +473,9 @@ int CPVRChannelGroup::LoadFromDatabase(const std::vector<std::shared_ptr<CPVRCli
     const std::shared_ptr<const CPVRClients> allClients = CServiceBroker::GetPVRManager().Clients();
 
     std::unique_lock<CCriticalSection> lock(m_critSection);
+    m_sortedMembers.reserve(m_sortedMembers.size() + results.size());
+    m_members.Reserve(m_members.Size() + results.size());
+
     for (const auto& member : results)
     {
       // Consistency checks.
@@ -520,8 +498,7 @@ int CPVRChannelGroup::LoadFromDatabase(const std::vector<std::shared_ptr<CPVRCli
         if (allClients->IsEnabledClient(member->ChannelClientID()))
         {
           m_sortedMembers.emplace_back(member);
-          m_members.emplace(std::make_pair(member->ChannelClientID(), member->ChannelUID()),
-                            member);
+          m_members.Add(std::make_pair(member->ChannelClientID(), member->ChannelUID()), member);
         }
       }
       else
@@ -610,7 +587,7 @@ bool CPVRChannelGroup::UpdateFromClient(const std::shared_ptr<CPVRChannelGroupMe
       groupMember->SetGroupID(GroupID());
 
     m_sortedMembers.emplace_back(groupMember);
-    m_members.emplace(channel->StorageId(), groupMember);
+    m_members.Add(channel->StorageId(), groupMember);
 
     CLog::LogFC(LOGDEBUG, LOGPVR, "Added {} channel group member '{}' to group '{}'",
                 IsRadio() ? "radio" : "TV", channel->ChannelName(), GroupName());
@@ -676,52 +653,47 @@ std::vector<std::shared_ptr<CPVRChannelGroupMember>> CPVRChannelGroup::RemoveDel
 
   std::unique_lock<CCriticalSection> lock(m_critSection);
 
-  // put group members into map to speedup the following lookups
-  std::map<std::pair<int, int>, std::shared_ptr<CPVRChannelGroupMember>> membersMap;
-  std::transform(groupMembers.begin(), groupMembers.end(),
-                 std::inserter(membersMap, membersMap.end()),
-                 [](const std::shared_ptr<CPVRChannelGroupMember>& member) {
-                   return std::make_pair(member->Channel()->StorageId(), member);
-                 });
+  // put group members into a hashed index to speedup the following lookups
+  CPVRChannelGroupMembers membersMap;
+  membersMap.Reserve(groupMembers.size());
+  for (const auto& member : groupMembers)
+    membersMap.Add(member->Channel()->StorageId(), member);
 
-  // check for deleted/invalid channels
-  for (auto it = m_sortedMembers.begin(); it != m_sortedMembers.end();)
+  // check for deleted/invalid channels. the remaining members are moved to the front in place,
+  // erasing them one by one would be quadratic for large groups.
+  const int iClientID = GetClientID();
+  auto remaining = m_sortedMembers.begin();
+  for (auto it = m_sortedMembers.begin(); it != m_sortedMembers.end(); ++it)
   {
     const std::shared_ptr<const CPVRChannel> channel = (*it)->Channel();
 
-    if (GetClientID() >= 0 && GetClientID() != channel->ClientID())
+    if (iClientID >= 0 && iClientID != channel->ClientID())
     {
       CLog::LogF(LOGDEBUG,
                  "Removed {} channel '{}' from group '{}' because it has the wrong client id",
                  IsRadio() ? "radio" : "TV", channel->ChannelName(), GroupName());
       membersToRemove.emplace_back(*it);
 
-      m_members.erase(channel->StorageId());
-      it = m_sortedMembers.erase(it);
+      m_members.Remove(channel->StorageId());
       continue;
     }
 
-    auto mapIt = membersMap.find(channel->StorageId());
-    if (mapIt == membersMap.end())
+    if (!membersMap.Contains(channel->StorageId()) && HasValidDataForClient(channel->ClientID()))
     {
-      if (HasValidDataForClient(channel->ClientID()))
-      {
-        CLog::LogFC(LOGDEBUG, LOGPVR, "Removed stale {} channel '{}' from group '{}'. clientId={}",
-                    IsRadio() ? "radio" : "TV", channel->ChannelName(), GroupName(),
-                    channel->ClientID());
-        membersToRemove.emplace_back(*it);
+      CLog::LogFC(LOGDEBUG, LOGPVR, "Removed stale {} channel '{}' from group '{}'. clientId={}",
+                  IsRadio() ? "radio" : "TV", channel->ChannelName(), GroupName(),
+                  channel->ClientID());
+      membersToRemove.emplace_back(*it);
 
-        m_members.erase(channel->StorageId());
-        it = m_sortedMembers.erase(it);
-        continue;
-      }
-    }
-    else
-    {
-      membersMap.erase(mapIt);
+      m_members.Remove(channel->StorageId());
+      continue;
     }
-    ++it;
+
+    if (remaining != it)
+      *remaining = std::move(*it);
+    ++remaining;
   }
+  m_sortedMembers.erase(remaining, m_sortedMembers.end());
 
   DeleteGroupMembersFromDb(membersToRemove);
 
@@ -771,7 +743,7 @@ bool CPVRChannelGroup::RemoveFromGroup(
     const auto storageId = (*it)->Channel()->StorageId();
     if (channel->StorageId() == storageId)
     {
-      m_members.erase(storageId);
+      m_members.Remove(storageId);
       m_sortedMembers.erase(it);
       bReturn = true;
       break;
@@ -809,7 +781,7 @@ bool CPVRChannelGroup::AppendToGroup(
     newMember->SetClientPriority(groupMember->ClientPriority());
 
     m_sortedMembers.emplace_back(newMember);
-    m_members.emplace(channel->StorageId(), newMember);
+    m_members.Add(channel->StorageId(), newMember);
 
     SortAndRenumber();
     bReturn = true;
@@ -821,7 +793,7 @@ bool CPVRChannelGroup::IsGroupMember(
     const std::shared_ptr<const CPVRChannelGroupMember>& groupMember) const
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
-  return m_members.find(groupMember->Channel()->StorageId()) != m_members.end();
+  return m_members.Contains(groupMember->Channel()->StorageId());
 }
 
 bool CPVRChannelGroup::Persist()
@@ -842,7 +814,7 @@ bool CPVRChannelGroup::Persist()
   if (database)
   {
     CLog::LogFC(LOGDEBUG, LOGPVR, "Persisting channel group '{}' with {} channels", GroupName(),
-                static_cast<int>(m_members.size()));
+                static_cast<int>(m_members.Size()));
 
     bReturn = database->Persist(*this);
     m_bChanged = false;
@@ -927,8 +899,8 @@ bool CPVRChannelGroup::Renumber(RenumberMode mode /* = NORMAL */)
 bool CPVRChannelGroup::HasNewChannels() const
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
-  return std::any_of(m_members.cbegin(), m_members.cend(),
-                     [](const auto& member) { return member.second->Channel()->ChannelID() <= 0; });
+  return std::any_of(m_members.begin(), m_members.end(),
+                     [](const auto& member) { return member->Channel()->ChannelID() <= 0; });
 }
 
 bool CPVRChannelGroup::HasChanges() const
@@ -999,7 +971,7 @@ void CPVRChannelGroup::SetGroupID(int iGroupId)
 
     // propagate the new id to the group members
     for (const auto& member : m_members)
-      member.second->SetGroupID(iGroupId);
+      member->SetGroupID(iGroupId);
   }
 }
 
@@ -1102,20 +1074,20 @@ void CPVRChannelGroup::SetLastOpened(uint64_t iLastOpened)
 size_t CPVRChannelGroup::Size() const
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
-  return m_members.size();
+  return m_members.Size();
 }
 
 bool CPVRChannelGroup::HasChannels() const
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
-  return !m_members.empty();
+  return !m_members.IsEmpty();
 }
 
 bool CPVRChannelGroup::HasHiddenChannels() const
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
-  return std::any_of(m_members.cbegin(), m_members.cend(),
-                     [](const auto& member) { return member.second->Channel()->IsHidden(); });
+  return std::any_of(m_members.begin(), m_members.end(),
+                     [](const auto& member) { return member->Channel()->IsHidden(); });
 }
 
 bool CPVRChannelGroup::SetHidden(bool bHidden)
@@ -1180,8 +1152,8 @@ int CPVRChannelGroup::CleanupCachedImages()
   {
     std::unique_lock<CCriticalSection> lock(m_critSection);
     std::transform(
-        m_members.cbegin(), m_members.cend(), std::back_inserter(urlsToCheck),
-        [](const auto& groupMember) { return groupMember.second->Channel()->ClientIconPath(); });
+        m_members.begin(), m_members.end(), std::back_inserter(urlsToCheck),
+        [](const auto& groupMember) { return groupMember->Channel()->ClientIconPath(); });
   }
 
   const std::string owner =
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "pvr/channels/PVRChannelGroupMembers.h"
 #include "pvr/channels/PVRChannelGroupSettings.h"
 #include "pvr/channels/PVRChannelNumber.h"
 #include "pvr/channels/PVRChannelsPath.h"
@@ -526,8 +527,7 @@ protected:
   int m_iPosition = 0; /*!< the local position of this group within the group list */
   std::vector<std::shared_ptr<CPVRChannelGroupMember>>
       m_sortedMembers; /*!< members sorted by channel number */
-  std::map<std::pair<int, int>, std::shared_ptr<CPVRChannelGroupMember>>
-      m_members; /*!< members with key clientid+uniqueid */
+  CPVRChannelGroupMembers m_members; /*!< members with key clientid+uniqueid */
   mutable CCriticalSection m_critSection;
   std::vector<int> m_failedClients;
   CEventSource<PVREvent> m_events;
@@ -14,13 +14,49 @@
 #include "pvr/addons/PVRClient.h"
 #include "pvr/channels/PVRChannel.h"
 #include "pvr/channels/PVRChannelsPath.h"
+#include "threads/CriticalSection.h"
 #include "utils/DatabaseUtils.h"
 #include "utils/SortUtils.h"
+#include "utils/StringUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
 
+#include <mutex>
+#include <unordered_map>
+
 using namespace PVR;
 
+namespace
+{
+// The paths of the members of a group only differ in the client and the channel uid. Share the
+// path prefix between all members of a group from the same client, instead of storing the full
+// path per member. Large IPTV lineups easily have thousands of members per group.
+std::shared_ptr<const std::string> GetSharedPathPrefix(const std::string& prefix)
+{
+  static CCriticalSection critSection;
+  static std::unordered_map<std::string, std::weak_ptr<const std::string>> prefixes;
+
+  std::unique_lock<CCriticalSection> lock(critSection);
+
+  std::shared_ptr<const std::string> sharedPrefix = prefixes[prefix].lock();
+  if (!sharedPrefix)
+  {
+    // drop the prefixes of deleted or renamed groups. there are only a few prefixes per group.
+    for (auto it = prefixes.begin(); it != prefixes.end();)
+    {
+      if (it->second.expired() && it->first != prefix)
+        it = prefixes.erase(it);
+      else
+        ++it;
+    }
+
+    sharedPrefix = std::make_shared<const std::string>(prefix);
+    prefixes[prefix] = sharedPrefix;
+  }
+  return sharedPrefix;
+}
+} // unnamed namespace
+
 CPVRChannelGroupMember::CPVRChannelGroupMember(const std::string& groupName,
                                                int groupClientID,
                                                int order,
@@ -91,12 +127,27 @@ void CPVRChannelGroupMember::SetGroupName(const std::string& groupName)
   const std::shared_ptr<const CPVRClient> client =
       CServiceBroker::GetPVRManager().GetClient(m_iChannelClientID);
   if (client)
-    m_path = CPVRChannelsPath(m_bIsRadio, groupName, m_iGroupClientID, client->ID(),
-                              client->InstanceId(), m_iChannelUID);
+  {
+    const std::string path = CPVRChannelsPath(m_bIsRadio, groupName, m_iGroupClientID,
+                                              client->ID(), client->InstanceId(), m_iChannelUID);
+    const std::string suffix = std::to_string(m_iChannelUID) + ".pvr";
+    if (StringUtils::EndsWith(path, suffix))
+      m_pathPrefix = GetSharedPathPrefix(path.substr(0, path.size() - suffix.size()));
+    else
+      m_pathPrefix.reset();
+  }
   else
     CLog::LogF(LOGERROR, "Unable to obtain instance for client id: {}", m_iChannelClientID);
 }
 
+std::string CPVRChannelGroupMember::Path() const
+{
+  if (!m_pathPrefix)
+    return {};
+
+  return *m_pathPrefix + std::to_string(m_iChannelUID) + ".pvr";
+}
+
 void CPVRChannelGroupMember::SetChannelNumber(const CPVRChannelNumber& channelNumber)
 {
   if (m_channelNumber != channelNumber)
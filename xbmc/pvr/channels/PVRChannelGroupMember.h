@@ -51,7 +51,12 @@ public:
   int GroupID() const { return m_iGroupID; }
   void SetGroupID(int iGroupID);
 
-  const std::string& Path() const { return m_path; }
+  /*!
+   * @brief Get the path of this member.
+   * @return The path, built from the path prefix shared by the group's members of the same client
+   * and the unique id of the channel.
+   */
+  std::string Path() const;
   void SetGroupName(const std::string& groupName);
 
   const CPVRChannelNumber& ChannelNumber() const { return m_channelNumber; }
@@ -91,7 +96,7 @@ private:
   int m_iChannelDatabaseID = -1;
   bool m_bIsRadio = false;
   std::shared_ptr<CPVRChannel> m_channel;
-  std::string m_path;
+  std::shared_ptr<const std::string> m_pathPrefix; // path up to the channel uid, shared
   CPVRChannelNumber m_channelNumber; // the channel number this channel has in the group
   CPVRChannelNumber
       m_clientChannelNumber; // the client channel number this channel has in the group
@@ -0,0 +1,163 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PVRChannelGroupMembers.h"
+
+#include "pvr/channels/PVRChannel.h"
+#include "pvr/channels/PVRChannelGroupMember.h"
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+
+using namespace PVR;
+
+namespace
+{
+uint64_t GetSortKey(const CPVRChannelNumber& number)
+{
+  return (static_cast<uint64_t>(number.GetChannelNumber()) << 32) | number.GetSubChannelNumber();
+}
+
+template<typename Key>
+void SortByKeys(CPVRChannelGroupMembers::Members& members, const std::vector<Key>& keys)
+{
+  CPVRChannelGroupMembers::Members sorted;
+  sorted.reserve(members.size());
+  for (const auto& key : keys)
+    sorted.emplace_back(std::move(members[key.index]));
+
+  members.swap(sorted);
+}
+} // unnamed namespace
+
+void CPVRChannelGroupMembers::Reserve(size_t size)
+{
+  m_members.reserve(size);
+  m_keys.reserve(size);
+  m_positions.reserve(size);
+}
+
+bool CPVRChannelGroupMembers::Add(const std::pair<int, int>& id,
+                                  const std::shared_ptr<CPVRChannelGroupMember>& member)
+{
+  const uint64_t key = GetKey(id);
+  if (!m_positions.emplace(key, m_members.size()).second)
+    return false;
+
+  m_members.emplace_back(member);
+  m_keys.emplace_back(key);
+  return true;
+}
+
+bool CPVRChannelGroupMembers::Remove(const std::pair<int, int>& id)
+{
+  const auto it = m_positions.find(GetKey(id));
+  if (it == m_positions.end())
+    return false;
+
+  const size_t position = it->second;
+  m_positions.erase(it);
+
+  if (position != m_members.size() - 1)
+  {
+    m_members[position] = std::move(m_members.back());
+    m_keys[position] = m_keys.back();
+    m_positions[m_keys[position]] = position;
+  }
+  m_members.pop_back();
+  m_keys.pop_back();
+  return true;
+}
+
+std::shared_ptr<CPVRChannelGroupMember> CPVRChannelGroupMembers::Get(
+    const std::pair<int, int>& id) const
+{
+  const auto it = m_positions.find(GetKey(id));
+  return it != m_positions.end() ? m_members[it->second]
+                                 : std::shared_ptr<CPVRChannelGroupMember>();
+}
+
+bool CPVRChannelGroupMembers::Contains(const std::pair<int, int>& id) const
+{
+  return m_positions.find(GetKey(id)) != m_positions.end();
+}
+
+void CPVRChannelGroupMembers::Clear()
+{
+  m_members.clear();
+  m_keys.clear();
+  m_positions.clear();
+}
+
+size_t CPVRChannelGroupMembers::GetMemoryUsage() const
+{
+  // approximation of the nodes and buckets of the index
+  return sizeof(*this) + m_members.capacity() * sizeof(Members::value_type) +
+         m_keys.capacity() * sizeof(uint64_t) +
+         m_positions.size() * (sizeof(void*) + sizeof(uint64_t) + sizeof(size_t)) +
+         m_positions.bucket_count() * sizeof(void*);
+}
+
+void CPVRChannelGroupMembers::SortByChannelNumber(Members& members)
+{
+  struct Key
+  {
+    uint64_t number;
+    size_t index;
+  };
+
+  std::vector<Key> keys;
+  keys.reserve(members.size());
+  for (size_t i = 0; i < members.size(); ++i)
+    keys.push_back({GetSortKey(members[i]->ChannelNumber()), i});
+
+  std::sort(keys.begin(), keys.end(),
+            [](const Key& key1, const Key& key2) { return key1.number < key2.number; });
+
+  SortByKeys(members, keys);
+}
+
+void CPVRChannelGroupMembers::SortByClientChannelNumber(Members& members)
+{
+  struct Key
+  {
+    int priority;
+    uint64_t number;
+    size_t index;
+    std::string name;
+  };
+
+  std::vector<Key> keys;
+  keys.reserve(members.size());
+  for (size_t i = 0; i < members.size(); ++i)
+    keys.push_back(
+        {members[i]->ClientPriority(), GetSortKey(members[i]->ClientChannelNumber()), i, {}});
+
+  // higher priorities first
+  const auto lessNumber = [](const Key& key1, const Key& key2) {
+    return std::tie(key2.priority, key1.number) < std::tie(key1.priority, key2.number);
+  };
+  std::sort(keys.begin(), keys.end(), lessNumber);
+
+  // only members with equal numbers are sorted by name, fetch the names of those members only
+  for (auto it = keys.begin(); it != keys.end();)
+  {
+    const auto last = std::upper_bound(it, keys.end(), *it, lessNumber);
+    if (std::distance(it, last) > 1)
+    {
+      for (auto key = it; key != last; ++key)
+        key->name = members[key->index]->Channel()->ChannelName();
+
+      std::sort(it, last, [](const Key& key1, const Key& key2) { return key1.name < key2.name; });
+    }
+    it = last;
+  }
+
+  SortByKeys(members, keys);
+}
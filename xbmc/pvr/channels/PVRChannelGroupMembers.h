@@ -0,0 +1,83 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace PVR
+{
+class CPVRChannelGroupMember;
+
+/*!
+ \brief Storage of the members of a channel group, looked up by client id and unique channel id.
+
+ The members are stored in one contiguous array, in no particular order. A hash index maps the
+ combined client id and unique channel id of a member to its position in the array, so lookups
+ do not depend on the size of the group. Removal moves the last member into the freed position.
+ */
+class CPVRChannelGroupMembers
+{
+public:
+  using Members = std::vector<std::shared_ptr<CPVRChannelGroupMember>>;
+
+  void Reserve(size_t size);
+
+  /*!
+   \brief Add a member.
+   \param id The client id and unique channel id of the member.
+   \param member The member.
+   \return true if the member was added, false if the group already contains a member with this id.
+   */
+  bool Add(const std::pair<int, int>& id, const std::shared_ptr<CPVRChannelGroupMember>& member);
+
+  /*!
+   \brief Remove a member.
+   \param id The client id and unique channel id of the member.
+   \return true if the member was removed, false if the group contains no member with this id.
+   */
+  bool Remove(const std::pair<int, int>& id);
+
+  std::shared_ptr<CPVRChannelGroupMember> Get(const std::pair<int, int>& id) const;
+  bool Contains(const std::pair<int, int>& id) const;
+
+  void Clear();
+  size_t Size() const { return m_members.size(); }
+  bool IsEmpty() const { return m_members.empty(); }
+  size_t GetMemoryUsage() const;
+
+  Members::const_iterator begin() const { return m_members.cbegin(); }
+  Members::const_iterator end() const { return m_members.cend(); }
+
+  /*!
+   \brief Sort members by channel number.
+   */
+  static void SortByChannelNumber(Members& members);
+
+  /*!
+   \brief Sort members by client priority, client channel number and channel name.
+   */
+  static void SortByClientChannelNumber(Members& members);
+
+private:
+  static uint64_t GetKey(const std::pair<int, int>& id)
+  {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(id.first)) << 32) |
+           static_cast<uint32_t>(id.second);
+  }
+
+  Members m_members;
+  std::vector<uint64_t> m_keys; // the keys of the members, at the same positions
+  std::unordered_map<uint64_t, size_t> m_positions;
+};
+} // namespace PVR
@@ -0,0 +1,199 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/pvr/pvr_channels.h"
+#include "pvr/channels/PVRChannel.h"
+#include "pvr/channels/PVRChannelGroupMember.h"
+#include "pvr/channels/PVRChannelGroupMembers.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+std::shared_ptr<CPVRChannelGroupMember> CreateMember(int clientId,
+                                                     int uniqueId,
+                                                     const std::string& name,
+                                                     const CPVRChannelNumber& clientNumber)
+{
+  PVR_CHANNEL channel = {};
+  channel.iUniqueId = uniqueId;
+  channel.iChannelNumber = clientNumber.GetChannelNumber();
+  channel.iSubChannelNumber = clientNumber.GetSubChannelNumber();
+  strncpy(channel.strChannelName, name.c_str(), sizeof(channel.strChannelName) - 1);
+
+  const auto member = std::make_shared<CPVRChannelGroupMember>();
+  member->SetChannel(std::make_shared<CPVRChannel>(channel, clientId));
+  member->SetClientChannelNumber(clientNumber);
+  return member;
+}
+
+std::vector<int> GetUniqueIds(const CPVRChannelGroupMembers::Members& members)
+{
+  std::vector<int> ids;
+  std::transform(members.cbegin(), members.cend(), std::back_inserter(ids),
+                 [](const auto& member) { return member->ChannelUID(); });
+  return ids;
+}
+} // unnamed namespace
+
+TEST(TestPVRChannelGroupMembers, AddGetRemove)
+{
+  CPVRChannelGroupMembers members;
+  EXPECT_TRUE(members.IsEmpty());
+
+  const auto member1 = CreateMember(1, 10, "One", {1, 0});
+  const auto member2 = CreateMember(1, 20, "Two", {2, 0});
+  const auto member3 = CreateMember(2, 10, "Three", {3, 0});
+
+  EXPECT_TRUE(members.Add({1, 10}, member1));
+  EXPECT_TRUE(members.Add({1, 20}, member2));
+  EXPECT_TRUE(members.Add({2, 10}, member3));
+  EXPECT_FALSE(members.Add({1, 10}, member3));
+  EXPECT_EQ(3u, members.Size());
+
+  EXPECT_EQ(member1, members.Get({1, 10}));
+  EXPECT_EQ(member3, members.Get({2, 10}));
+  EXPECT_EQ(nullptr, members.Get({2, 20}));
+
+  // the last member takes the place of the removed one and must still be found
+  EXPECT_TRUE(members.Remove({1, 10}));
+  EXPECT_FALSE(members.Remove({1, 10}));
+  EXPECT_FALSE(members.Contains({1, 10}));
+  EXPECT_EQ(member2, members.Get({1, 20}));
+  EXPECT_EQ(member3, members.Get({2, 10}));
+  EXPECT_EQ(2u, members.Size());
+
+  EXPECT_TRUE(members.Remove({2, 10}));
+  EXPECT_TRUE(members.Remove({1, 20}));
+  EXPECT_TRUE(members.IsEmpty());
+}
+
+TEST(TestPVRChannelGroupMembers, SortByChannelNumber)
+{
+  CPVRChannelGroupMembers::Members members;
+  const CPVRChannelNumber numbers[] = {{3, 0}, {1, 2}, {2, 0}, {1, 1}};
+  for (size_t i = 0; i < 4; ++i)
+  {
+    members.emplace_back(CreateMember(1, static_cast<int>(i), "", {}));
+    members.back()->SetChannelNumber(numbers[i]);
+  }
+
+  CPVRChannelGroupMembers::SortByChannelNumber(members);
+  EXPECT_EQ((std::vector<int>{3, 1, 2, 0}), GetUniqueIds(members));
+}
+
+TEST(TestPVRChannelGroupMembers, SortByClientChannelNumber)
+{
+  CPVRChannelGroupMembers::Members members;
+  members.emplace_back(CreateMember(1, 0, "B", {2, 0}));
+  members.emplace_back(CreateMember(1, 1, "C", {1, 0}));
+  members.emplace_back(CreateMember(2, 2, "Z", {5, 0}));
+  members.emplace_back(CreateMember(1, 3, "A", {2, 0}));
+  members.emplace_back(CreateMember(1, 4, "D", {1, 1}));
+  members[2]->SetClientPriority(10);
+
+  // higher client priority first, then by client channel number, then by name
+  CPVRChannelGroupMembers::SortByClientChannelNumber(members);
+  EXPECT_EQ((std::vector<int>{2, 1, 4, 3, 0}), GetUniqueIds(members));
+}
+
+// load, lookup and sort times for an IPTV lineup of 20000 channels
+TEST(TestPVRChannelGroupMembers, DISABLED_Benchmark)
+{
+  using Clock = std::chrono::steady_clock;
+  const auto ms = [](Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  };
+
+  const int count = 20000;
+  CPVRChannelGroupMembers::Members sortedMembers;
+  sortedMembers.reserve(count);
+  for (int i = 0; i < count; ++i)
+  {
+    // many playlists carry no or duplicate channel numbers
+    sortedMembers.emplace_back(CreateMember(1 + i % 2, 100000 + i * 7,
+                                            "Channel " + std::to_string(i),
+                                            {static_cast<unsigned int>(i % 5000), 0}));
+    sortedMembers.back()->SetChannelNumber({static_cast<unsigned int>(count - i), 0});
+  }
+
+  // load
+  auto start = Clock::now();
+  CPVRChannelGroupMembers members;
+  members.Reserve(sortedMembers.size());
+  for (const auto& member : sortedMembers)
+    members.Add({member->ChannelClientID(), member->ChannelUID()}, member);
+  const double load = ms(Clock::now() - start);
+
+  start = Clock::now();
+  std::map<std::pair<int, int>, std::shared_ptr<CPVRChannelGroupMember>> map;
+  for (const auto& member : sortedMembers)
+    map.emplace(std::make_pair(member->ChannelClientID(), member->ChannelUID()), member);
+  const double mapLoad = ms(Clock::now() - start);
+
+  // lookup
+  size_t found = 0;
+  start = Clock::now();
+  for (int round = 0; round < 10; ++round)
+  {
+    for (const auto& member : sortedMembers)
+      found += members.Contains({member->ChannelClientID(), member->ChannelUID()}) ? 1 : 0;
+  }
+  const double lookup = ms(Clock::now() - start);
+
+  start = Clock::now();
+  for (int round = 0; round < 10; ++round)
+  {
+    for (const auto& member : sortedMembers)
+      found += map.count({member->ChannelClientID(), member->ChannelUID()});
+  }
+  const double mapLookup = ms(Clock::now() - start);
+  EXPECT_EQ(20u * count, found);
+
+  // sort
+  start = Clock::now();
+  CPVRChannelGroupMembers::SortByChannelNumber(sortedMembers);
+  const double sortByNumber = ms(Clock::now() - start);
+
+  std::mt19937 random(42);
+  std::shuffle(sortedMembers.begin(), sortedMembers.end(), random);
+  start = Clock::now();
+  CPVRChannelGroupMembers::SortByClientChannelNumber(sortedMembers);
+  const double sortByClientNumber = ms(Clock::now() - start);
+
+  std::shuffle(sortedMembers.begin(), sortedMembers.end(), random);
+  start = Clock::now();
+  std::sort(sortedMembers.begin(), sortedMembers.end(),
+            [](const auto& member1, const auto& member2) {
+              if (member1->ClientChannelNumber() == member2->ClientChannelNumber())
+                return member1->Channel()->ChannelName() < member2->Channel()->ChannelName();
+              return member1->ClientChannelNumber() < member2->ClientChannelNumber();
+            });
+  const double comparatorSort = ms(Clock::now() - start);
+
+  std::cout << count << " members: load " << load << " ms (std::map " << mapLoad << " ms), "
+            << 10 * count << " lookups " << lookup << " ms (std::map " << mapLookup << " ms), "
+            << "index " << members.GetMemoryUsage() / 1024 << " KiB" << std::endl;
+  std::cout << "Sort by channel number " << sortByNumber << " ms, by client channel number "
+            << sortByClientNumber << " ms (comparator fetching names " << comparatorSort << " ms)"
+            << std::endl;
+}
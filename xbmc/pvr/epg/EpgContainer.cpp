@@ -17,6 +17,7 @@
 #include "pvr/epg/EpgContainer.h"
 #include "pvr/epg/EpgDatabase.h"
 #include "pvr/epg/EpgInfoTag.h"
+#include "pvr/epg/EpgUpdateScheduler.h"
 #include "pvr/guilib/PVRGUIProgressHandler.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
@@ -25,6 +26,7 @@
 #include "utils/log.h"
 
 #include <algorithm>
+#include <chrono>
 #include <iterator>
 #include <memory>
 #include <mutex>
@@ -267,7 +269,13 @@ bool CPVREpgContainer::PersistAll(unsigned int iMaxTimeslice) const
     // Note: We must lock the db the whole time, otherwise races may occur.
     database->Lock();
 
+    // write all changes of this pass in a single transaction
+    const auto start = std::chrono::steady_clock::now();
+    database->ResetPersistCounts();
+    database->BeginPersistTransaction();
+
     XbmcThreads::EndTime<> processTimeslice{std::chrono::milliseconds(iMaxTimeslice)};
+    size_t persistedEpgs = 0;
     for (const auto& epg : changedEpgs)
     {
       if (!processTimeslice.IsTimePast())
@@ -276,6 +284,7 @@ bool CPVREpgContainer::PersistAll(unsigned int iMaxTimeslice) const
                     epg->GetChannelData()->ChannelName());
 
         bReturn &= epg->QueuePersistQuery(database);
+        persistedEpgs++;
 
         size_t queryCount = database->GetInsertQueriesCount() + database->GetDeleteQueriesCount();
         if (queryCount > EPG_COMMIT_QUERY_COUNT_LIMIT)
@@ -297,6 +306,17 @@ bool CPVREpgContainer::PersistAll(unsigned int iMaxTimeslice) const
       database->CommitInsertQueries();
     }
 
+    database->CommitPersistTransaction();
+
+    const CPVREpgDatabase::PersistCounts counts = database->ResetPersistCounts();
+    CLog::LogF(LOGDEBUG,
+               "Persisted {} of {} changed EPGs: {} events inserted, {} updated, {} deleted in {} "
+               "ms",
+               persistedEpgs, changedEpgs.size(), counts.inserted, counts.updated, counts.deleted,
+               std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now() - start)
+                   .count());
+
     database->Unlock();
   }
 
@@ -543,6 +563,28 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgContainer::GetTags(
   return results;
 }
 
+std::optional<std::vector<std::shared_ptr<CPVREpgInfoTag>>> CPVREpgContainer::GetTagsContaining(
+    const std::vector<std::string>& texts, bool bTitleOnly) const
+{
+  // make sure we have up-to-date data in the database.
+  PersistAll(std::numeric_limits<unsigned int>::max());
+
+  const std::shared_ptr<const CPVREpgDatabase> database = GetEpgDatabase();
+  auto results = database->GetEpgTagsContaining(texts, bTitleOnly);
+  if (!results)
+    return results;
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  for (const auto& tag : *results)
+  {
+    const auto& it = m_epgIdToEpgMap.find(tag->EpgID());
+    if (it != m_epgIdToEpgMap.cend())
+      tag->SetChannelData((*it).second->GetChannelData());
+  }
+
+  return results;
+}
+
 void CPVREpgContainer::InsertFromDB(const std::shared_ptr<CPVREpg>& newEpg)
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
@@ -707,8 +749,6 @@ void CPVREpgContainer::WaitForUpdateFinish()
 
 bool CPVREpgContainer::UpdateEPG(bool bOnlyPending /* = false */)
 {
-  bool bInterrupted = false;
-  unsigned int iUpdatedTables = 0;
   const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
 
   /* set start and end time */
@@ -733,7 +773,6 @@ bool CPVREpgContainer::UpdateEPG(bool bOnlyPending /* = false */)
 
   std::vector<std::shared_ptr<CPVREpg>> invalidTables;
 
-  unsigned int iCounter = 0;
   const std::shared_ptr<CPVREpgDatabase> database = GetEpgDatabase();
 
   m_critSection.lock();
@@ -745,38 +784,51 @@ bool CPVREpgContainer::UpdateEPG(bool bOnlyPending /* = false */)
     progressHandler = std::make_unique<CPVRGUIProgressHandler>(
         g_localizeStrings.Get(19004)); // Loading programme guide
 
+  // the EPGs of different clients are fetched concurrently, the EPGs of one client by a limited
+  // number of jobs. the container lock is not held while calling the clients.
+  CPVREpgUpdateScheduler scheduler(static_cast<unsigned int>(
+      std::max(1, advancedSettings->m_iEpgMaxConcurrentUpdatesPerClient)));
+
+  const int iUpdateTime = m_settings.GetIntValue(CSettings::SETTING_EPG_EPGUPDATE) * 60;
+  const int iPastDays = m_settings.GetIntValue(CSettings::SETTING_EPG_PAST_DAYSTODISPLAY);
+
+  CCriticalSection updateSection;
+  unsigned int iUpdatedTables = 0;
+  unsigned int iCounter = 0;
+
   for (const auto& epgEntry : epgsToUpdate)
   {
-    if (InterruptUpdate())
-    {
-      bInterrupted = true;
-      break;
-    }
-
     const std::shared_ptr<CPVREpg> epg = epgEntry.second;
     if (!epg)
       continue;
 
-    if (progressHandler)
-      progressHandler->UpdateProgress(epg->GetChannelData()->ChannelName(), ++iCounter,
-                                      epgsToUpdate.size());
-
-    if ((!bOnlyPending || epg->UpdatePending()) &&
-        epg->Update(start,
-                    end,
-                    m_settings.GetIntValue(CSettings::SETTING_EPG_EPGUPDATE) * 60,
-                    m_settings.GetIntValue(CSettings::SETTING_EPG_PAST_DAYSTODISPLAY),
-                    database,
-                    bOnlyPending))
-    {
-      iUpdatedTables++;
-    }
-    else if (!epg->IsValid())
-    {
-      invalidTables.push_back(epg);
-    }
+    scheduler.AddUpdate(epg->GetChannelData()->ClientId(), [&, epg] {
+      if (progressHandler)
+      {
+        std::unique_lock<CCriticalSection> lock(updateSection);
+        progressHandler->UpdateProgress(epg->GetChannelData()->ChannelName(), ++iCounter,
+                                        epgsToUpdate.size());
+      }
+
+      if ((!bOnlyPending || epg->UpdatePending()) &&
+          epg->Update(start, end, iUpdateTime, iPastDays, database, bOnlyPending))
+      {
+        std::unique_lock<CCriticalSection> lock(updateSection);
+        iUpdatedTables++;
+      }
+      else if (!epg->IsValid())
+      {
+        std::unique_lock<CCriticalSection> lock(updateSection);
+        invalidTables.push_back(epg);
+      }
+    });
   }
 
+  const bool bInterrupted = !scheduler.Run([this] { return InterruptUpdate(); });
+
+  CLog::LogFC(LOGDEBUG, LOGEPG, "EPG Container: updated {} of {} EPGs", iUpdatedTables,
+              epgsToUpdate.size());
+
   progressHandler.reset();
 
   QueueDeleteEpgs(invalidTables);
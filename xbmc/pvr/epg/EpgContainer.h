@@ -19,6 +19,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -161,6 +162,17 @@ namespace PVR
      */
     std::vector<std::shared_ptr<CPVREpgInfoTag>> GetTags(const PVREpgSearchData& searchData) const;
 
+    /*!
+     * @brief Get all EPG tags containing at least one of the given texts, using the full-text
+     * search index of the EPG database.
+     * @param texts The texts to search for. Matched case-insensitive anywhere in the tag's texts.
+     * @param bTitleOnly Whether to search the title only or all texts of the tags.
+     * @return The tags containing one of the texts or std::nullopt if the texts cannot be looked up
+     * in the index. Callers must still check the tags against their actual criteria.
+     */
+    std::optional<std::vector<std::shared_ptr<CPVREpgInfoTag>>> GetTagsContaining(
+        const std::vector<std::string>& texts, bool bTitleOnly) const;
+
     /*!
      * @brief Notify EPG container that there are pending manual EPG updates
      * @param bHasPendingUpdates The new value
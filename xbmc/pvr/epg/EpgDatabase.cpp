@@ -19,18 +19,49 @@
 #include "utils/StringUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace dbiplus;
 using namespace PVR;
 
+namespace
+{
+// number of broadcast ids written by one query to the table of the tags of a persist pass
+constexpr size_t PERSISTED_IDS_PER_QUERY = 500;
+} // unnamed namespace
+
 bool CPVREpgDatabase::Open()
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
-  return CDatabase::Open(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_databaseEpg);
+  if (!CDatabase::Open(
+          CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_databaseEpg))
+    return false;
+
+  InitSearchIndex();
+  return true;
+}
+
+void CPVREpgDatabase::InitSearchIndex()
+{
+  m_bHasSearchIndex = HasSearchIndexTable();
+  if (m_bHasSearchIndex)
+  {
+    try
+    {
+      // tags replaced by 'REPLACE INTO' must be removed from the search index by the delete trigger
+      m_pDS->exec("PRAGMA recursive_triggers = ON");
+    }
+    catch (...)
+    {
+      CLog::LogF(LOGERROR, "Failed to enable recursive triggers, not using the search index");
+      m_bHasSearchIndex = false;
+    }
+  }
 }
 
 void CPVREpgDatabase::Close()
@@ -131,6 +162,8 @@ void CPVREpgDatabase::CreateTables()
               "bIgnorePresentRecordings  bool,"
               "iChannelGroup             integer"
               ")");
+
+  CreateSearchIndex();
 }
 
 void CPVREpgDatabase::CreateAnalytics()
@@ -140,6 +173,64 @@ void CPVREpgDatabase::CreateAnalytics()
   std::unique_lock<CCriticalSection> lock(m_critSection);
   m_pDS->exec("CREATE UNIQUE INDEX idx_epg_idEpg_iStartTime on epgtags(idEpg, iStartTime desc);");
   m_pDS->exec("CREATE INDEX idx_epg_iEndTime on epgtags(iEndTime);");
+
+  if (HasSearchIndexTable())
+  {
+    // keep the search index in sync with the tags
+    m_pDS->exec("CREATE TRIGGER epgtags_fts_insert AFTER INSERT ON epgtags BEGIN "
+                "INSERT INTO epgtags_fts(rowid, sTitle, sPlotOutline, sPlot, sEpisodeName) "
+                "VALUES (new.idBroadcast, new.sTitle, new.sPlotOutline, new.sPlot, "
+                "new.sEpisodeName); "
+                "END");
+    m_pDS->exec("CREATE TRIGGER epgtags_fts_delete AFTER DELETE ON epgtags BEGIN "
+                "INSERT INTO epgtags_fts(epgtags_fts, rowid, sTitle, sPlotOutline, sPlot, "
+                "sEpisodeName) "
+                "VALUES ('delete', old.idBroadcast, old.sTitle, old.sPlotOutline, old.sPlot, "
+                "old.sEpisodeName); "
+                "END");
+    m_pDS->exec("CREATE TRIGGER epgtags_fts_update AFTER UPDATE ON epgtags BEGIN "
+                "INSERT INTO epgtags_fts(epgtags_fts, rowid, sTitle, sPlotOutline, sPlot, "
+                "sEpisodeName) "
+                "VALUES ('delete', old.idBroadcast, old.sTitle, old.sPlotOutline, old.sPlot, "
+                "old.sEpisodeName); "
+                "INSERT INTO epgtags_fts(rowid, sTitle, sPlotOutline, sPlot, sEpisodeName) "
+                "VALUES (new.idBroadcast, new.sTitle, new.sPlotOutline, new.sPlot, "
+                "new.sEpisodeName); "
+                "END");
+  }
+}
+
+void CPVREpgDatabase::CreateSearchIndex()
+{
+  // The trigram tokenizer (SQLite 3.34+) matches any substring of at least three characters, like
+  // the 'LIKE' based search does, so the index can be used to find the candidates of a search.
+  if (!m_sqlite)
+    return;
+
+  CLog::LogFC(LOGDEBUG, LOGEPG, "Creating table 'epgtags_fts'");
+  try
+  {
+    m_pDS->exec("CREATE VIRTUAL TABLE epgtags_fts USING fts5("
+                "sTitle, sPlotOutline, sPlot, sEpisodeName, "
+                "content='epgtags', content_rowid='idBroadcast', tokenize='trigram'"
+                ")");
+    m_pDS->exec("INSERT INTO epgtags_fts(epgtags_fts) VALUES ('rebuild')");
+  }
+  catch (...)
+  {
+    CLog::Log(LOGWARNING, "EPG search index not supported by the database, searching without it");
+    m_pDS->exec("DROP TABLE IF EXISTS epgtags_fts");
+  }
+}
+
+bool CPVREpgDatabase::HasSearchIndexTable() const
+{
+  if (!m_sqlite)
+    return false;
+
+  return !GetSingleValue(
+              "SELECT name FROM sqlite_master WHERE type = 'table' AND name = 'epgtags_fts'")
+              .empty();
 }
 
 void CPVREpgDatabase::UpdateTables(int iVersion)
@@ -324,6 +415,9 @@ void CPVREpgDatabase::UpdateTables(int iVersion)
     m_pDS->exec("ALTER TABLE savedsearches ADD iChannelGroup integer;");
     m_pDS->exec("UPDATE savedsearches SET iChannelGroup = -1");
   }
+
+  if (iVersion < 17)
+    CreateSearchIndex();
 }
 
 bool CPVREpgDatabase::DeleteEpg()
@@ -374,7 +468,11 @@ bool CPVREpgDatabase::QueueDeleteTagQuery(const CPVREpgInfoTag& tag)
 
   std::string strQuery;
   BuildSQL(PrepareSQL("DELETE FROM %s ", "epgtags"), filter, strQuery);
-  return QueueDeleteQuery(strQuery);
+  if (!QueueDeleteQuery(strQuery))
+    return false;
+
+  m_persistCounts.deleted++;
+  return true;
 }
 
 std::vector<std::shared_ptr<CPVREpg>> CPVREpgDatabase::GetAll()
@@ -542,11 +640,60 @@ CDateTime CPVREpgDatabase::GetMaxEndTime(int iEpgID, const CDateTime& maxEnd) co
 namespace
 {
 
+// the trigram tokenizer of the search index can only look up texts of at least three characters
+constexpr size_t MIN_INDEXED_TEXT_LENGTH = 3;
+
+bool IsIndexable(const std::string& text)
+{
+  // count utf-8 characters, not bytes
+  const auto length = std::count_if(text.cbegin(), text.cend(),
+                                    [](char c) { return (c & 0xC0) != 0x80; });
+  return static_cast<size_t>(length) >= MIN_INDEXED_TEXT_LENGTH;
+}
+
+std::string ToFullTextString(const std::string& text)
+{
+  std::string escaped(text);
+  StringUtils::Replace(escaped, "\"", "\"\"");
+  return "\"" + escaped + "\"";
+}
+
+std::string BuildFullTextQuery(const std::vector<std::string>& texts, const std::string& columns)
+{
+  std::string query = "{" + columns + "} : (";
+  for (auto it = texts.cbegin(); it != texts.cend(); ++it)
+  {
+    if (it != texts.cbegin())
+      query += " OR ";
+    query += ToFullTextString(*it);
+  }
+  return query + ")";
+}
+
 class CSearchTermConverter
 {
 public:
   explicit CSearchTermConverter(const std::string& strSearchTerm) { Parse(strSearchTerm); }
 
+  /*!
+   * @brief Get a query for the search index matching every tag the search term could match.
+   * @param strColumns The columns to search.
+   * @return The query or an empty string if the search term can't be looked up in the index.
+   */
+  std::string ToFullTextQuery(const std::string& strColumns) const
+  {
+    // any tag matching the term contains at least one of the terms, unless terms are negated or
+    // contain 'LIKE' wildcards
+    if (m_bNegated || m_terms.empty() ||
+        !std::all_of(m_terms.cbegin(), m_terms.cend(),
+                     [](const std::string& term) {
+                       return IsIndexable(term) && term.find_first_of("%_") == std::string::npos;
+                     }))
+      return {};
+
+    return BuildFullTextQuery(m_terms, strColumns);
+  }
+
   std::string ToSQL(const std::string& strFieldName) const
   {
     std::string result = "(";
@@ -585,6 +732,7 @@ private:
         GetAndCutNextTerm(strParsedSearchTerm, strDummy);
         strFragment += " NOT ";
         bNextOR = false;
+        m_bNegated = true;
       }
       else if (StringUtils::StartsWith(strParsedSearchTerm, "+") ||
                StringUtils::StartsWithNoCase(strParsedSearchTerm, "and"))
@@ -617,6 +765,7 @@ private:
           strFragment.clear();
 
           strFragment += ") LIKE UPPER('%";
+          m_terms.emplace_back(strTerm);
           StringUtils::Replace(strTerm, "'", "''"); // escape '
           strFragment += strTerm;
           strFragment += "%')) ";
@@ -660,6 +809,8 @@ private:
   }
 
   std::vector<std::string> m_fragments;
+  std::vector<std::string> m_terms;
+  bool m_bNegated = false;
 };
 
 } // unnamed namespace
@@ -758,6 +909,17 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetEpgTags(
     }
 
     filter.AppendWhere(strWhere);
+
+    if (m_bHasSearchIndex)
+    {
+      // let the search index find the candidates, 'LIKE' only has to check those
+      const std::string strMatch = conv.ToFullTextQuery(
+          searchData.m_bSearchInDescription ? "sTitle sPlotOutline sPlot" : "sTitle sPlotOutline");
+      if (!strMatch.empty())
+        filter.AppendWhere(PrepareSQL(
+            "idBroadcast IN (SELECT rowid FROM epgtags_fts WHERE epgtags_fts MATCH '%s')",
+            strMatch.c_str()));
+    }
   }
 
   if (BuildSQL(strQuery, filter, strQuery))
@@ -785,6 +947,44 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetEpgTags(
   return {};
 }
 
+std::optional<std::vector<std::shared_ptr<CPVREpgInfoTag>>> CPVREpgDatabase::GetEpgTagsContaining(
+    const std::vector<std::string>& texts, bool bTitleOnly) const
+{
+  if (!m_bHasSearchIndex || texts.empty() ||
+      !std::all_of(texts.cbegin(), texts.cend(), IsIndexable))
+    return {};
+
+  const std::string strMatch =
+      BuildFullTextQuery(texts, bTitleOnly ? "sTitle" : "sTitle sPlotOutline sPlot sEpisodeName");
+
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  const std::string strQuery =
+      PrepareSQL("SELECT * FROM epgtags "
+                 "WHERE idBroadcast IN (SELECT rowid FROM epgtags_fts WHERE epgtags_fts MATCH '%s');",
+                 strMatch.c_str());
+
+  if (ResultQuery(strQuery))
+  {
+    try
+    {
+      std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+      while (!m_pDS->eof())
+      {
+        tags.emplace_back(CreateEpgTag(m_pDS));
+        m_pDS->next();
+      }
+      m_pDS->close();
+      return tags;
+    }
+    catch (...)
+    {
+      CLog::LogF(LOGERROR, "Could not load tags containing the given texts");
+    }
+  }
+
+  return {};
+}
+
 std::shared_ptr<CPVREpgInfoTag> CPVREpgDatabase::GetEpgTagByUniqueBroadcastID(
     int iEpgID, unsigned int iUniqueBroadcastId) const
 {
@@ -1201,6 +1401,47 @@ bool CPVREpgDatabase::QueueDeleteEpgTags(int iEpgId)
 }
 
 bool CPVREpgDatabase::QueuePersistQuery(const CPVREpgInfoTag& tag)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  return QueuePersistTagQueries(tag, false);
+}
+
+bool CPVREpgDatabase::QueuePersistQueries(const std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags)
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  // the ids of the tags which already have a row. These rows are moved by the update of their tag,
+  // so the overlap delete of another tag must not remove them.
+  std::vector<std::string> ids;
+  for (const auto& tag : tags)
+  {
+    if (tag->DatabaseID() > 0)
+      ids.emplace_back(std::to_string(tag->DatabaseID()));
+  }
+
+  const bool keepUpdatedRows = !ids.empty();
+  if (keepUpdatedRows)
+  {
+    QueueInsertQuery("CREATE TEMPORARY TABLE IF NOT EXISTS epgtags_persisted "
+                     "(idBroadcast integer primary key);");
+    QueueInsertQuery("DELETE FROM epgtags_persisted;");
+    for (size_t i = 0; i < ids.size(); i += PERSISTED_IDS_PER_QUERY)
+    {
+      const auto first = ids.cbegin() + i;
+      const auto last = ids.cbegin() + std::min(i + PERSISTED_IDS_PER_QUERY, ids.size());
+      QueueInsertQuery("INSERT INTO epgtags_persisted (idBroadcast) VALUES (" +
+                       StringUtils::Join(std::vector<std::string>(first, last), "), (") + ");");
+    }
+  }
+
+  bool bReturn = true;
+  for (const auto& tag : tags)
+    bReturn &= QueuePersistTagQueries(*tag, keepUpdatedRows);
+
+  return bReturn;
+}
+
+bool CPVREpgDatabase::QueuePersistTagQueries(const CPVREpgInfoTag& tag, bool keepUpdatedRows)
 {
   if (tag.EpgID() <= 0)
   {
@@ -1216,60 +1457,123 @@ bool CPVREpgDatabase::QueuePersistQuery(const CPVREpgInfoTag& tag)
   if (tag.FirstAired().IsValid())
     sFirstAired = tag.FirstAired().GetAsW3CDate();
 
-  int iBroadcastId = tag.DatabaseID();
-  std::string strQuery;
-
-  std::unique_lock<CCriticalSection> lock(m_critSection);
+  const int iBroadcastId = tag.DatabaseID();
+
+  // remove any conflicting events before persisting the event
+  std::string strQuery = PrepareSQL("DELETE FROM epgtags WHERE idEpg = %u AND iEndTime >= %u AND "
+                                    "iStartTime <= %u AND idBroadcast <> %i",
+                                    tag.EpgID(), static_cast<unsigned int>(iStartTime + 1),
+                                    static_cast<unsigned int>(iEndTime - 1), iBroadcastId);
+  if (keepUpdatedRows)
+    strQuery += " AND idBroadcast NOT IN (SELECT idBroadcast FROM epgtags_persisted)";
+  QueueInsertQuery(strQuery + ";");
+
+  const std::vector<std::pair<std::string, std::string>> columns = {
+      {"idEpg", PrepareSQL("%u", tag.EpgID())},
+      {"iStartTime", PrepareSQL("%u", static_cast<unsigned int>(iStartTime))},
+      {"iEndTime", PrepareSQL("%u", static_cast<unsigned int>(iEndTime))},
+      {"sTitle", PrepareSQL("'%s'", tag.Title().c_str())},
+      {"sPlotOutline", PrepareSQL("'%s'", tag.PlotOutline().c_str())},
+      {"sPlot", PrepareSQL("'%s'", tag.Plot().c_str())},
+      {"sOriginalTitle", PrepareSQL("'%s'", tag.OriginalTitle().c_str())},
+      {"sCast", PrepareSQL("'%s'", tag.DeTokenize(tag.Cast()).c_str())},
+      {"sDirector", PrepareSQL("'%s'", tag.DeTokenize(tag.Directors()).c_str())},
+      {"sWriter", PrepareSQL("'%s'", tag.DeTokenize(tag.Writers()).c_str())},
+      {"iYear", PrepareSQL("%i", tag.Year())},
+      {"sIMDBNumber", PrepareSQL("'%s'", tag.IMDBNumber().c_str())},
+      {"sIconPath", PrepareSQL("'%s'", tag.ClientIconPath().c_str())},
+      {"iGenreType", PrepareSQL("%i", tag.GenreType())},
+      {"iGenreSubType", PrepareSQL("%i", tag.GenreSubType())},
+      {"sGenre", PrepareSQL("'%s'", tag.GenreDescription().c_str())},
+      {"sFirstAired", PrepareSQL("'%s'", sFirstAired.c_str())},
+      {"iParentalRating", PrepareSQL("%i", tag.ParentalRating())},
+      {"iStarRating", PrepareSQL("%i", tag.StarRating())},
+      {"iSeriesId", PrepareSQL("%i", tag.SeriesNumber())},
+      {"iEpisodeId", PrepareSQL("%i", tag.EpisodeNumber())},
+      {"iEpisodePart", PrepareSQL("%i", tag.EpisodePart())},
+      {"sEpisodeName", PrepareSQL("'%s'", tag.EpisodeName().c_str())},
+      {"iFlags", PrepareSQL("%i", tag.Flags())},
+      {"sSeriesLink", PrepareSQL("'%s'", tag.SeriesLink().c_str())},
+      {"sParentalRatingCode", PrepareSQL("'%s'", tag.ParentalRatingCode().c_str())},
+      {"iBroadcastUid", PrepareSQL("%i", tag.UniqueBroadcastID())},
+  };
+
+  std::string names;
+  std::string values;
+  std::string assignments;
+  for (const auto& column : columns)
+  {
+    if (!names.empty())
+    {
+      names += ", ";
+      values += ", ";
+      assignments += ", ";
+    }
+    names += column.first;
+    values += column.second;
+    assignments += column.first + " = " + column.second;
+  }
 
   if (iBroadcastId < 0)
   {
-    strQuery = PrepareSQL(
-        "REPLACE INTO epgtags (idEpg, iStartTime, "
-        "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, "
-        "sIMDBNumber, "
-        "sIconPath, iGenreType, iGenreSubType, sGenre, sFirstAired, iParentalRating, iStarRating, "
-        "iSeriesId, "
-        "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, sSeriesLink, sParentalRatingCode, "
-        "iBroadcastUid) "
-        "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, "
-        "'%s', '%s', %i, %i, %i, %i, %i, '%s', %i, '%s', '%s', %i);",
-        tag.EpgID(), static_cast<unsigned int>(iStartTime), static_cast<unsigned int>(iEndTime),
-        tag.Title().c_str(), tag.PlotOutline().c_str(), tag.Plot().c_str(),
-        tag.OriginalTitle().c_str(), tag.DeTokenize(tag.Cast()).c_str(),
-        tag.DeTokenize(tag.Directors()).c_str(), tag.DeTokenize(tag.Writers()).c_str(), tag.Year(),
-        tag.IMDBNumber().c_str(), tag.ClientIconPath().c_str(), tag.GenreType(), tag.GenreSubType(),
-        tag.GenreDescription().c_str(), sFirstAired.c_str(), tag.ParentalRating(), tag.StarRating(),
-        tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(),
-        tag.Flags(), tag.SeriesLink().c_str(), tag.ParentalRatingCode().c_str(),
-        tag.UniqueBroadcastID());
+    // the start time may still be taken by the old row of a tag updated later in this pass, which
+    // is then written again by the update of that tag
+    QueueInsertQuery("REPLACE INTO epgtags (" + names + ") VALUES (" + values + ");");
+    m_persistCounts.inserted++;
+  }
+  else if (m_sqlite)
+  {
+    // update the row in place. If another tag of this pass took the new start time of the tag
+    // before its old row moved on, that row is replaced and re-inserted by its own tag, as is any
+    // row that was removed this way.
+    const std::string id = std::to_string(iBroadcastId);
+    QueueInsertQuery("UPDATE OR REPLACE epgtags SET " + assignments + " WHERE idBroadcast = " + id +
+                     ";");
+    QueueInsertQuery("INSERT OR IGNORE INTO epgtags (idBroadcast, " + names + ") VALUES (" + id +
+                     ", " + values + ");");
+    m_persistCounts.updated++;
   }
   else
   {
-    strQuery = PrepareSQL(
-        "REPLACE INTO epgtags (idEpg, iStartTime, "
-        "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, "
-        "sIMDBNumber, "
-        "sIconPath, iGenreType, iGenreSubType, sGenre, sFirstAired, iParentalRating, iStarRating, "
-        "iSeriesId, "
-        "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, sSeriesLink, sParentalRatingCode, "
-        "iBroadcastUid, idBroadcast) "
-        "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, "
-        "'%s', '%s', %i, %i, %i, %i, %i, '%s', %i, '%s', '%s', %i, %i);",
-        tag.EpgID(), static_cast<unsigned int>(iStartTime), static_cast<unsigned int>(iEndTime),
-        tag.Title().c_str(), tag.PlotOutline().c_str(), tag.Plot().c_str(),
-        tag.OriginalTitle().c_str(), tag.DeTokenize(tag.Cast()).c_str(),
-        tag.DeTokenize(tag.Directors()).c_str(), tag.DeTokenize(tag.Writers()).c_str(), tag.Year(),
-        tag.IMDBNumber().c_str(), tag.ClientIconPath().c_str(), tag.GenreType(), tag.GenreSubType(),
-        tag.GenreDescription().c_str(), sFirstAired.c_str(), tag.ParentalRating(), tag.StarRating(),
-        tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(),
-        tag.Flags(), tag.SeriesLink().c_str(), tag.ParentalRatingCode().c_str(),
-        tag.UniqueBroadcastID(), iBroadcastId);
+    // MySQL can't resolve a conflict of an update, and it has no full-text index to maintain
+    QueueInsertQuery("REPLACE INTO epgtags (idBroadcast, " + names + ") VALUES (" +
+                     std::to_string(iBroadcastId) + ", " + values + ");");
+    m_persistCounts.updated++;
   }
 
-  QueueInsertQuery(strQuery);
   return true;
 }
 
+void CPVREpgDatabase::BeginPersistTransaction()
+{
+  BeginTransaction();
+
+  // the queued queries must not start and commit a transaction of their own
+  if (m_pDB && m_pDB->in_transaction())
+  {
+    m_pDS->set_autocommit(false);
+    m_pDS2->set_autocommit(false);
+  }
+}
+
+bool CPVREpgDatabase::CommitPersistTransaction()
+{
+  if (m_pDS)
+    m_pDS->set_autocommit(true);
+  if (m_pDS2)
+    m_pDS2->set_autocommit(true);
+
+  return CommitTransaction();
+}
+
+CPVREpgDatabase::PersistCounts CPVREpgDatabase::ResetPersistCounts()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  const PersistCounts counts = m_persistCounts;
+  m_persistCounts = {};
+  return counts;
+}
+
 int CPVREpgDatabase::GetLastEPGId() const
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
@@ -12,6 +12,8 @@
 #include "threads/CriticalSection.h"
 
 #include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
 class CDateTime;
@@ -66,7 +68,7 @@ namespace PVR
      * @brief Get the minimal database version that is required to operate correctly.
      * @return The minimal database version.
      */
-    int GetSchemaVersion() const override { return 16; }
+    int GetSchemaVersion() const override { return 17; }
 
     /*!
      * @brief Get the default sqlite database filename.
@@ -161,6 +163,18 @@ namespace PVR
     std::vector<std::shared_ptr<CPVREpgInfoTag>> GetEpgTags(
         const PVREpgSearchData& searchData) const;
 
+    /*!
+     * @brief Get all EPG tags containing at least one of the given texts, using the full-text search
+     * index of the database.
+     * @param texts The texts to search for. Matched case-insensitive anywhere in the tag's texts.
+     * @param bTitleOnly Whether to search the title only or title, episode name, plot outline and
+     * plot.
+     * @return The tags containing one of the texts (might contain tags not containing any of the
+     * texts if case folding differs) or std::nullopt if the texts cannot be looked up in the index.
+     */
+    std::optional<std::vector<std::shared_ptr<CPVREpgInfoTag>>> GetEpgTagsContaining(
+        const std::vector<std::string>& texts, bool bTitleOnly) const;
+
     /*!
      * @brief Get an EPG tag given its EPG id and unique broadcast ID.
      * @param iEpgID The ID of the EPG for the tag to get.
@@ -291,12 +305,51 @@ namespace PVR
     bool QueueDeleteEpgTags(int iEpgId);
 
     /*!
-     * @brief Write the query to persist the given EPG tag to db query queue.
+     * @brief Write the queries to persist the given EPG tag to db query queue. Events overlapped by
+     * the tag are deleted, then a new tag is inserted and a tag that already has a database id is
+     * updated in place.
      * @param tag The tag to persist.
      * @return True on success, false otherwise.
      */
     bool QueuePersistQuery(const CPVREpgInfoTag& tag);
 
+    /*!
+     * @brief Write the queries to persist the given EPG tags to db query queue, like
+     * QueuePersistQuery() for each tag. The overlap deletes of the tags spare the rows of the
+     * other given tags, which are moved by their own update.
+     * @param tags The tags to persist.
+     * @return True on success, false otherwise.
+     */
+    bool QueuePersistQueries(const std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags);
+
+    /*!
+     * @brief Start a transaction for persisting EPG tags. Queued queries committed before
+     * CommitPersistTransaction() is called become part of it.
+     */
+    void BeginPersistTransaction();
+
+    /*!
+     * @brief Commit the transaction started by BeginPersistTransaction().
+     * @return True on success, false otherwise.
+     */
+    bool CommitPersistTransaction();
+
+    /*!
+     * @brief The numbers of EPG tag rows written by the queued queries.
+     */
+    struct PersistCounts
+    {
+      unsigned int inserted = 0;
+      unsigned int updated = 0;
+      unsigned int deleted = 0;
+    };
+
+    /*!
+     * @brief Get the numbers of EPG tag rows written since the last call.
+     * @return The counts.
+     */
+    PersistCounts ResetPersistCounts();
+
     /*!
      * @return Last EPG id in the database
      */
@@ -351,6 +404,13 @@ namespace PVR
 
     //@}
 
+  protected:
+    /*!
+     * @brief Check whether the full-text search index can be used, must be called after connecting
+     * to the database.
+     */
+    void InitSearchIndex();
+
   private:
     /*!
      * @brief Create the EPG database tables.
@@ -368,6 +428,26 @@ namespace PVR
      */
     void UpdateTables(int version) override;
 
+    /*!
+     * @brief Create the full-text search index for the EPG tags, if supported by the database.
+     */
+    void CreateSearchIndex();
+
+    /*!
+     * @brief Check whether the full-text search index exists.
+     * @return True if the index exists, false otherwise.
+     */
+    bool HasSearchIndexTable() const;
+
+    /*!
+     * @brief Write the queries to persist the given EPG tag to db query queue.
+     * @param tag The tag to persist.
+     * @param keepUpdatedRows True to spare the rows listed in the epgtags_persisted table from the
+     * overlap delete.
+     * @return True on success, false otherwise.
+     */
+    bool QueuePersistTagQueries(const CPVREpgInfoTag& tag, bool keepUpdatedRows);
+
     int GetMinSchemaVersion() const override { return 4; }
 
     std::shared_ptr<CPVREpgInfoTag> CreateEpgTag(
@@ -377,5 +457,7 @@ namespace PVR
         bool bRadio, const std::unique_ptr<dbiplus::Dataset>& pDS) const;
 
     mutable CCriticalSection m_critSection;
+    bool m_bHasSearchIndex = false;
+    PersistCounts m_persistCounts;
   };
 }
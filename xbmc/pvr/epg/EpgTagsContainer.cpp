@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <vector>
 
 using namespace PVR;
 
@@ -644,14 +645,13 @@ void CPVREpgTagsContainer::QueuePersistQuery()
 
     FixOverlappingEvents(m_changedTags);
 
+    // only new and changed tags are written, in the order of their start times
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+    tags.reserve(m_changedTags.size());
     for (const auto& tag : m_changedTags)
-    {
-      // remove any conflicting events from database before persisting the new event
-      m_database->QueueDeleteEpgTagsByMinEndMaxStartTimeQuery(
-          m_iEpgID, tag.second->StartAsUTC() + ONE_SECOND, tag.second->EndAsUTC() - ONE_SECOND);
+      tags.emplace_back(tag.second);
 
-      tag.second->QueuePersistQuery(m_database);
-    }
+    m_database->QueuePersistQueries(tags);
 
     Clear();
 
@@ -0,0 +1,141 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "EpgUpdateScheduler.h"
+
+#include "ServiceBroker.h"
+#include "utils/Job.h"
+#include "utils/JobManager.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace PVR
+{
+class CPVREpgUpdateJob : public CJob
+{
+public:
+  CPVREpgUpdateJob(CPVREpgUpdateScheduler& scheduler,
+                   CPVREpgUpdateScheduler::ClientUpdates& client,
+                   const std::function<bool()>& interrupt)
+    : m_scheduler(scheduler), m_client(client), m_interrupt(interrupt)
+  {
+  }
+
+  // the job manager deletes jobs when they are done, cancelled or could not be added
+  ~CPVREpgUpdateJob() override { m_scheduler.OnJobFinished(); }
+
+  const char* GetType() const override { return "pvr-epg-update"; }
+
+  bool DoWork() override
+  {
+    m_scheduler.ProcessUpdates(m_client, m_interrupt);
+    return true;
+  }
+
+private:
+  CPVREpgUpdateScheduler& m_scheduler;
+  CPVREpgUpdateScheduler::ClientUpdates& m_client;
+  const std::function<bool()>& m_interrupt;
+};
+} // namespace PVR
+
+using namespace PVR;
+
+CPVREpgUpdateScheduler::CPVREpgUpdateScheduler(unsigned int maxUpdatesPerClient)
+  : m_maxUpdatesPerClient(std::max(1u, maxUpdatesPerClient))
+{
+}
+
+void CPVREpgUpdateScheduler::AddUpdate(int clientId, const std::function<void()>& update)
+{
+  m_clients[clientId].updates.emplace_back(update);
+}
+
+bool CPVREpgUpdateScheduler::Run(const std::function<bool()>& interrupt)
+{
+  m_bInterrupted = false;
+
+  // one worker of the last client and workers that could not be added run on this thread
+  std::vector<ClientUpdates*> ownWorkers;
+
+  for (auto it = m_clients.begin(); it != m_clients.end(); ++it)
+  {
+    ClientUpdates& client = it->second;
+    size_t workers = std::min<size_t>(m_maxUpdatesPerClient, client.updates.size());
+
+    if (std::next(it) == m_clients.end() && workers > 0)
+    {
+      ownWorkers.emplace_back(&client);
+      workers--;
+    }
+
+    for (size_t i = 0; i < workers; ++i)
+    {
+      {
+        std::unique_lock<CCriticalSection> lock(m_critSection);
+        m_runningJobs++;
+      }
+
+      if (!CServiceBroker::GetJobManager()->AddJob(new CPVREpgUpdateJob(*this, client, interrupt),
+                                                   nullptr, CJob::PRIORITY_DEDICATED))
+        ownWorkers.emplace_back(&client);
+    }
+  }
+
+  for (ClientUpdates* client : ownWorkers)
+    ProcessUpdates(*client, interrupt);
+
+  while (true)
+  {
+    {
+      std::unique_lock<CCriticalSection> lock(m_critSection);
+      if (m_runningJobs == 0)
+        break;
+    }
+    m_jobsFinished.Wait();
+  }
+
+  // jobs cancelled by the job manager leave updates behind, too
+  return std::all_of(m_clients.cbegin(), m_clients.cend(), [](const auto& client) {
+    return client.second.next >= client.second.updates.size();
+  });
+}
+
+void CPVREpgUpdateScheduler::ProcessUpdates(ClientUpdates& client,
+                                            const std::function<bool()>& interrupt)
+{
+  while (true)
+  {
+    const bool bInterrupt = interrupt && interrupt();
+
+    std::function<void()> update;
+    {
+      std::unique_lock<CCriticalSection> lock(m_critSection);
+      if (m_bInterrupted || client.next >= client.updates.size())
+        return;
+
+      if (bInterrupt)
+      {
+        m_bInterrupted = true;
+        return;
+      }
+
+      update = client.updates[client.next++];
+    }
+
+    update();
+  }
+}
+
+void CPVREpgUpdateScheduler::OnJobFinished()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+  if (--m_runningJobs == 0)
+    m_jobsFinished.Set();
+}
@@ -0,0 +1,70 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace PVR
+{
+/*!
+ * @brief Runs the EPG updates of the PVR clients. The updates of different clients run
+ * concurrently, but at most the given number of updates of one client at the same time.
+ */
+class CPVREpgUpdateScheduler
+{
+public:
+  /*!
+   * @brief Create a scheduler.
+   * @param maxUpdatesPerClient The maximum number of updates of one client running at the same
+   * time, at least one.
+   */
+  explicit CPVREpgUpdateScheduler(unsigned int maxUpdatesPerClient);
+
+  /*!
+   * @brief Add an update.
+   * @param clientId The id of the client the update fetches data from.
+   * @param update The update.
+   */
+  void AddUpdate(int clientId, const std::function<void()>& update);
+
+  /*!
+   * @brief Run all updates, on jobs of the job manager and the calling thread, and wait until
+   * they are done.
+   * @param interrupt Checked before an update is started. If it returns true, no further updates
+   * are started.
+   * @return True if all updates have been run, false if the run has been interrupted.
+   */
+  bool Run(const std::function<bool()>& interrupt);
+
+private:
+  friend class CPVREpgUpdateJob;
+
+  struct ClientUpdates
+  {
+    std::vector<std::function<void()>> updates;
+    size_t next = 0;
+  };
+
+  void ProcessUpdates(ClientUpdates& client, const std::function<bool()>& interrupt);
+  void OnJobFinished();
+
+  const unsigned int m_maxUpdatesPerClient;
+  std::map<int, ClientUpdates> m_clients;
+
+  CCriticalSection m_critSection;
+  CEvent m_jobsFinished;
+  unsigned int m_runningJobs = 0;
+  bool m_bInterrupted = false;
+};
+} // namespace PVR
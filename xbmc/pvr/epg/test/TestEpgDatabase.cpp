@@ -0,0 +1,328 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "XBDateTime.h"
+#include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/pvr/pvr_epg.h"
+#include "dbwrappers/dataset.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "pvr/epg/EpgDatabase.h"
+#include "pvr/epg/EpgInfoTag.h"
+#include "pvr/epg/EpgSearchData.h"
+#include "pvr/timers/PVRTimerRuleMatcher.h"
+#include "settings/AdvancedSettings.h"
+#include "utils/RegExp.h"
+
+#include <ctime>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+constexpr int EPG_ID = 1;
+constexpr const char* DATABASE_NAME = "TestEpg";
+
+class CTestEpgDatabase : public CPVREpgDatabase
+{
+public:
+  bool Open() override
+  {
+    DatabaseSettings settings;
+    settings.type = "sqlite3";
+    settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+    if (!Connect(DATABASE_NAME, settings, true))
+      return false;
+
+    InitSearchIndex();
+    return true;
+  }
+
+  bool InTransaction() const { return m_pDB && m_pDB->in_transaction(); }
+};
+
+struct TagData
+{
+  std::string title;
+  std::string plotOutline;
+  std::string plot;
+  std::string episodeName;
+};
+
+class TestEpgDatabase : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    DeleteDatabase();
+    ASSERT_TRUE(m_database.Open());
+  }
+
+  void TearDown() override
+  {
+    m_database.Close();
+    DeleteDatabase();
+  }
+
+  static void DeleteDatabase()
+  {
+    XFILE::CFile::Delete("special://temp/" + std::string(DATABASE_NAME) + ".db");
+  }
+
+  static std::shared_ptr<CPVREpgInfoTag> CreateTag(unsigned int uniqueBroadcastId,
+                                                   const TagData& tagData,
+                                                   time_t start,
+                                                   time_t end)
+  {
+    EPG_TAG data = {};
+    data.iUniqueBroadcastId = uniqueBroadcastId;
+    data.strTitle = tagData.title.c_str();
+    data.strPlotOutline = tagData.plotOutline.c_str();
+    data.strPlot = tagData.plot.c_str();
+    data.strEpisodeName = tagData.episodeName.c_str();
+    data.startTime = start;
+    data.endTime = end;
+    return std::make_shared<CPVREpgInfoTag>(data, 1, nullptr, EPG_ID);
+  }
+
+  // persist the tags one hour after another, the unique broadcast id is the index of the tag
+  void PersistTags(const std::vector<TagData>& tags)
+  {
+    const time_t start = std::time(nullptr);
+    for (size_t i = 0; i < tags.size(); i++)
+    {
+      const time_t tagStart = start + static_cast<time_t>(i) * 3600;
+      const auto tag = CreateTag(static_cast<unsigned int>(i), tags[i], tagStart, tagStart + 3600);
+      ASSERT_TRUE(m_database.QueuePersistQuery(*tag));
+    }
+    ASSERT_TRUE(m_database.CommitInsertQueries());
+  }
+
+  static time_t ToTime(const CDateTime& dateTime)
+  {
+    time_t time;
+    dateTime.GetAsTime(time);
+    return time;
+  }
+
+  std::shared_ptr<CPVREpgInfoTag> GetTag(unsigned int uniqueBroadcastId) const
+  {
+    return m_database.GetEpgTagByUniqueBroadcastID(EPG_ID, uniqueBroadcastId);
+  }
+
+  bool HasSearchIndex() const
+  {
+    return m_database.GetEpgTagsContaining({"abc"}, true).has_value();
+  }
+
+  static std::set<unsigned int> GetIds(const std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags)
+  {
+    std::set<unsigned int> ids;
+    for (const auto& tag : tags)
+      ids.insert(tag->UniqueBroadcastID());
+    return ids;
+  }
+
+  void PersistTag(const CPVREpgInfoTag& tag)
+  {
+    ASSERT_TRUE(m_database.QueuePersistQuery(tag));
+    ASSERT_TRUE(m_database.CommitInsertQueries());
+  }
+
+  CTestEpgDatabase m_database;
+};
+} // namespace
+
+TEST_F(TestEpgDatabase, SearchIndexIgnoresShortTexts)
+{
+  PersistTags({{"ab"}, {"The ab show"}, {"Cabaret"}, {"Something else"}});
+
+  // trigrams can't find texts of less than three characters
+  EXPECT_FALSE(m_database.GetEpgTagsContaining({"ab"}, true).has_value());
+  EXPECT_FALSE(m_database.GetEpgTagsContaining({"abare", "ab"}, false).has_value());
+
+  // the search falls back to 'LIKE' for them
+  PVREpgSearchData searchData;
+  searchData.Reset();
+  searchData.m_bIgnoreFinishedBroadcasts = false;
+  searchData.m_strSearchTerm = "ab";
+  EXPECT_EQ((std::set<unsigned int>{0, 1, 2}), GetIds(m_database.GetEpgTags(searchData)));
+}
+
+TEST_F(TestEpgDatabase, SearchIndexFindsAllTimerRuleMatches)
+{
+  if (!HasSearchIndex())
+    GTEST_SKIP() << "SQLite has no FTS5 trigram tokenizer";
+
+  const std::vector<TagData> tags = {
+      {"Tagesschau"},
+      {"tagesschau 24", "", "", "Ausgabe 1"},
+      {"Die TAGESSCHAU vor 20 Jahren"},
+      {"Sportschau", "Bundesliga", "Alle Spiele, alle Tore"},
+      {"Heute Journal", "", "Mit dem Wetter"},
+      {"The News at Ten", "World news", "", "Weather special"},
+      {"Weather"},
+      {"Straße der Lieder", "", "Volksmusik aus der STRASSE"},
+      {"ÄRGER im Revier", "Ärger", "", "ärger"},
+      {"Tatort", "", "", "Tagesschau-Krimi"},
+  };
+  PersistTags(tags);
+
+  const std::vector<std::shared_ptr<CPVREpgInfoTag>> allTags = m_database.GetAllEpgTags(EPG_ID);
+  ASSERT_EQ(tags.size(), allTags.size());
+
+  for (const std::string text : {"Tagesschau", "schau", "news", "WEATHER", "wetter", "Straße",
+                                 "ärger", "journal", "24 ", "Krimi", "nothing"})
+  {
+    for (bool bTitleOnly : {true, false})
+    {
+      SCOPED_TRACE(text + (bTitleOnly ? " (title)" : " (full text)"));
+
+      CRegExp textSearch(true /* case insensitive */);
+      ASSERT_TRUE(textSearch.RegComp(text));
+
+      std::set<unsigned int> expected;
+      for (const auto& tag : allTags)
+      {
+        if (CPVRTimerRuleMatcher::MatchSearchText(textSearch, *tag, bTitleOnly))
+          expected.insert(tag->UniqueBroadcastID());
+      }
+
+      const auto found = m_database.GetEpgTagsContaining({text}, bTitleOnly);
+      ASSERT_TRUE(found.has_value());
+
+      // the index may find more tags (e.g. different case folding), but never less
+      const std::set<unsigned int> foundIds = GetIds(*found);
+      for (unsigned int id : expected)
+        EXPECT_EQ(1u, foundIds.count(id)) << "missing tag " << tags[id].title;
+    }
+  }
+}
+
+TEST_F(TestEpgDatabase, SearchIndexFollowsUpdatedTags)
+{
+  if (!HasSearchIndex())
+    GTEST_SKIP() << "SQLite has no FTS5 trigram tokenizer";
+
+  PersistTags({{"Tagesschau"}, {"Sportschau"}});
+
+  // rename the first tag, the index must no longer find it under its old title
+  const std::shared_ptr<CPVREpgInfoTag> tag = GetTag(0);
+  ASSERT_NE(nullptr, tag);
+  ASSERT_TRUE(tag->Update(
+      *CreateTag(0, {"Nachrichten"}, ToTime(tag->StartAsUTC()), ToTime(tag->EndAsUTC())), false));
+  ASSERT_TRUE(m_database.QueuePersistQuery(*tag));
+  ASSERT_TRUE(m_database.CommitInsertQueries());
+
+  const auto found = m_database.GetEpgTagsContaining({"tagesschau"}, true);
+  ASSERT_TRUE(found.has_value());
+  EXPECT_TRUE(found->empty());
+
+  const auto renamed = m_database.GetEpgTagsContaining({"nachricht"}, true);
+  ASSERT_TRUE(renamed.has_value());
+  EXPECT_EQ((std::set<unsigned int>{0}), GetIds(*renamed));
+}
+
+TEST_F(TestEpgDatabase, PersistTransactionContainsCommittedQueries)
+{
+  const time_t start = std::time(nullptr);
+
+  m_database.BeginPersistTransaction();
+  ASSERT_TRUE(m_database.InTransaction());
+  PersistTag(*CreateTag(0, {"Tagesschau"}, start, start + 3600));
+  EXPECT_TRUE(m_database.InTransaction());
+  ASSERT_TRUE(m_database.CommitPersistTransaction());
+  EXPECT_FALSE(m_database.InTransaction());
+  EXPECT_NE(nullptr, GetTag(0));
+
+  // outside of the transaction the queued queries are committed on their own again
+  PersistTag(*CreateTag(1, {"Sportschau"}, start + 3600, start + 7200));
+  EXPECT_FALSE(m_database.InTransaction());
+  EXPECT_NE(nullptr, GetTag(1));
+}
+
+TEST_F(TestEpgDatabase, PersistKeepsChangedTagDeletedAsOverlapped)
+{
+  const time_t evening = std::time(nullptr) + 24 * 3600;
+  constexpr unsigned int UID_A = 4;
+  constexpr unsigned int UID_B = 5;
+
+  // four earlier tags, so that tag A gets database id 5
+  PersistTags({{"One"}, {"Two"}, {"Three"}, {"Four"}});
+  PersistTag(*CreateTag(UID_A, {"A"}, evening + 1800, evening + 5400));
+
+  const std::shared_ptr<CPVREpgInfoTag> tagA = GetTag(UID_A);
+  ASSERT_NE(nullptr, tagA);
+  ASSERT_EQ(5, tagA->DatabaseID());
+
+  // A moves from 20:30-21:30 to 21:00-22:00, new tag B takes 20:00-21:00. B is persisted first
+  // and overlaps the old row of A.
+  ASSERT_TRUE(tagA->Update(*CreateTag(UID_A, {"A"}, evening + 3600, evening + 7200), false));
+  const std::shared_ptr<CPVREpgInfoTag> tagB = CreateTag(UID_B, {"B"}, evening, evening + 3600);
+
+  m_database.BeginPersistTransaction();
+  ASSERT_TRUE(m_database.QueuePersistQueries({tagB, tagA}));
+  ASSERT_TRUE(m_database.CommitInsertQueries());
+  ASSERT_TRUE(m_database.CommitPersistTransaction());
+
+  const std::shared_ptr<CPVREpgInfoTag> persistedA = GetTag(UID_A);
+  ASSERT_NE(nullptr, persistedA);
+  EXPECT_EQ(5, persistedA->DatabaseID());
+  EXPECT_EQ(evening + 3600, ToTime(persistedA->StartAsUTC()));
+  EXPECT_EQ(evening + 7200, ToTime(persistedA->EndAsUTC()));
+
+  const std::shared_ptr<CPVREpgInfoTag> persistedB = GetTag(UID_B);
+  ASSERT_NE(nullptr, persistedB);
+  EXPECT_EQ(evening, ToTime(persistedB->StartAsUTC()));
+
+  EXPECT_EQ(6u, m_database.GetAllEpgTags(EPG_ID).size());
+}
+
+TEST_F(TestEpgDatabase, PersistMovesChangedTagsInPlace)
+{
+  const time_t evening = std::time(nullptr) + 24 * 3600;
+  constexpr unsigned int UID_A = 0;
+  constexpr unsigned int UID_C = 1;
+
+  // A at 20:00-20:30 and C at 20:30-21:00 are both delayed by half an hour in one pass, so A
+  // takes the old time of C before C moves on
+  PersistTag(*CreateTag(UID_A, {"A"}, evening, evening + 1800));
+  PersistTag(*CreateTag(UID_C, {"C"}, evening + 1800, evening + 3600));
+
+  const std::shared_ptr<CPVREpgInfoTag> tagA = GetTag(UID_A);
+  const std::shared_ptr<CPVREpgInfoTag> tagC = GetTag(UID_C);
+  ASSERT_NE(nullptr, tagA);
+  ASSERT_NE(nullptr, tagC);
+  const int idA = tagA->DatabaseID();
+  const int idC = tagC->DatabaseID();
+
+  ASSERT_TRUE(tagA->Update(*CreateTag(UID_A, {"A"}, evening + 1800, evening + 3600), false));
+  ASSERT_TRUE(tagC->Update(*CreateTag(UID_C, {"C"}, evening + 3600, evening + 5400), false));
+
+  m_database.BeginPersistTransaction();
+  ASSERT_TRUE(m_database.QueuePersistQueries({tagA, tagC}));
+  ASSERT_TRUE(m_database.CommitInsertQueries());
+  ASSERT_TRUE(m_database.CommitPersistTransaction());
+
+  const std::shared_ptr<CPVREpgInfoTag> persistedA = GetTag(UID_A);
+  ASSERT_NE(nullptr, persistedA);
+  EXPECT_EQ(idA, persistedA->DatabaseID());
+  EXPECT_EQ(evening + 1800, ToTime(persistedA->StartAsUTC()));
+
+  const std::shared_ptr<CPVREpgInfoTag> persistedC = GetTag(UID_C);
+  ASSERT_NE(nullptr, persistedC);
+  EXPECT_EQ(idC, persistedC->DatabaseID());
+  EXPECT_EQ(evening + 3600, ToTime(persistedC->StartAsUTC()));
+
+  EXPECT_EQ(2u, m_database.GetAllEpgTags(EPG_ID).size());
+}
@@ -0,0 +1,142 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "filesystem/File.h"
+#include "pvr/epg/EpgUpdateScheduler.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "threads/CriticalSection.h"
+#include "utils/JobManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr int CLIENTS = 3;
+constexpr int UPDATES_PER_CLIENT = 8;
+
+class TestEpgUpdateScheduler : public testing::Test
+{
+protected:
+  TestEpgUpdateScheduler() { CServiceBroker::RegisterJobManager(std::make_shared<CJobManager>()); }
+
+  ~TestEpgUpdateScheduler() override
+  {
+    CServiceBroker::GetJobManager()->CancelJobs();
+    CServiceBroker::GetJobManager()->Restart();
+    CServiceBroker::UnregisterJobManager();
+  }
+
+  // the updates wait until the given numbers of updates of their client and of all clients have
+  // been running at the same time once, so these are reached whenever the scheduler allows it
+  void AddUpdates(CPVREpgUpdateScheduler& scheduler, int clientConcurrency, int allConcurrency)
+  {
+    for (int client = 0; client < CLIENTS; client++)
+    {
+      for (int i = 0; i < UPDATES_PER_CLIENT; i++)
+      {
+        scheduler.AddUpdate(client, [this, client, clientConcurrency, allConcurrency] {
+          std::unique_lock<std::mutex> lock(m_mutex);
+          const int running = ++m_running[client];
+          m_maxRunning[client] = std::max(m_maxRunning[client], running);
+          m_allRunning = std::max(m_allRunning, RunningUpdates());
+          m_condition.notify_all();
+          m_condition.wait_for(lock, 1s, [this, client, clientConcurrency, allConcurrency] {
+            return m_maxRunning[client] >= clientConcurrency && m_allRunning >= allConcurrency;
+          });
+          m_running[client]--;
+          m_updates++;
+        });
+      }
+    }
+  }
+
+  int RunningUpdates() const
+  {
+    int running = 0;
+    for (const auto& client : m_running)
+      running += client.second;
+    return running;
+  }
+
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::map<int, int> m_running;
+  std::map<int, int> m_maxRunning;
+  int m_allRunning = 0;
+  int m_updates = 0;
+};
+} // namespace
+
+TEST_F(TestEpgUpdateScheduler, UpdatesOfOneClientRunOneAfterAnother)
+{
+  CPVREpgUpdateScheduler scheduler(1);
+  AddUpdates(scheduler, 1, CLIENTS);
+
+  EXPECT_TRUE(scheduler.Run({}));
+  EXPECT_EQ(CLIENTS * UPDATES_PER_CLIENT, m_updates);
+  for (int client = 0; client < CLIENTS; client++)
+    EXPECT_EQ(1, m_maxRunning[client]);
+
+  // the clients are updated concurrently
+  EXPECT_EQ(CLIENTS, m_allRunning);
+}
+
+TEST_F(TestEpgUpdateScheduler, RespectsMaxConcurrentUpdatesPerClient)
+{
+  const std::string file = "special://temp/TestEpgUpdateScheduler.xml";
+  XFILE::CFile xml;
+  ASSERT_TRUE(xml.OpenForWrite(file, true));
+  const std::string content = "<advancedsettings><epg><maxconcurrentupdatesperclient>3"
+                              "</maxconcurrentupdatesperclient></epg></advancedsettings>";
+  ASSERT_EQ(static_cast<ssize_t>(content.size()), xml.Write(content.data(), content.size()));
+  xml.Close();
+
+  const std::shared_ptr<CAdvancedSettings> settings =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  const int oldValue = settings->m_iEpgMaxConcurrentUpdatesPerClient;
+  settings->ParseSettingsFile(file);
+  const int maxUpdates = settings->m_iEpgMaxConcurrentUpdatesPerClient;
+  settings->m_iEpgMaxConcurrentUpdatesPerClient = oldValue;
+  XFILE::CFile::Delete(file);
+  ASSERT_EQ(3, maxUpdates);
+
+  CPVREpgUpdateScheduler scheduler(static_cast<unsigned int>(maxUpdates));
+  AddUpdates(scheduler, maxUpdates, CLIENTS * maxUpdates);
+
+  EXPECT_TRUE(scheduler.Run({}));
+  EXPECT_EQ(CLIENTS * UPDATES_PER_CLIENT, m_updates);
+  for (int client = 0; client < CLIENTS; client++)
+    EXPECT_EQ(maxUpdates, m_maxRunning[client]);
+}
+
+TEST_F(TestEpgUpdateScheduler, InterruptStopsAllClients)
+{
+  CPVREpgUpdateScheduler scheduler(2);
+  AddUpdates(scheduler, 1, 1);
+
+  CCriticalSection section;
+  int checks = 0;
+  EXPECT_FALSE(scheduler.Run([&section, &checks] {
+    std::unique_lock<CCriticalSection> lock(section);
+    return ++checks > 4;
+  }));
+  EXPECT_LE(m_updates, 4);
+}
@@ -28,6 +28,21 @@
 using namespace PVR;
 
 static const unsigned int GRID_START_PADDING = 30; // minutes
+static const int32_t SECONDSPERBLOCK = CGUIEPGGridContainerModel::MINSPERBLOCK * 60;
+
+void CGUIEPGGridContainerModel::EpgTags::Append(EpgTags&& other)
+{
+  timeline.Append(other.timeline);
+  std::move(other.tags.begin(), other.tags.end(), std::back_inserter(tags));
+  std::move(other.items.begin(), other.items.end(), std::back_inserter(items));
+}
+
+void CGUIEPGGridContainerModel::EpgTags::Clear()
+{
+  timeline.Clear();
+  tags.clear();
+  items.clear();
+}
 
 void CGUIEPGGridContainerModel::SetInvalid()
 {
@@ -138,16 +153,43 @@ void CGUIEPGGridContainerModel::Initialize(const std::unique_ptr<CFileItemList>&
     m_rulerItems.emplace_back(rulerItem);
   }
 
+  m_gridEndOffset = GetOffset(m_gridEnd);
+
   m_firstActiveChannel = iFirstChannel;
   m_lastActiveChannel = iFirstChannel + iChannelsPerPage - 1;
   m_firstActiveBlock = iFirstBlock;
   m_lastActiveBlock = iFirstBlock + iBlocksPerPage - 1;
 }
 
-std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::CreateEpgTags(int iChannel, int iBlock) const
+bool CGUIEPGGridContainerModel::AddEpgTag(EpgTags& epgTags,
+                                          const std::shared_ptr<CPVREpgInfoTag>& tag) const
 {
-  std::shared_ptr<CFileItem> result;
+  if (!epgTags.timeline.Add(GetOffset(tag->StartAsUTC()), GetOffset(tag->EndAsUTC()),
+                            tag->GenreType()))
+    return false;
+
+  epgTags.tags.emplace_back(tag);
+  epgTags.items.emplace_back();
+  return true;
+}
 
+std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetEpgTagItem(EpgTags& epgTags,
+                                                                    int index) const
+{
+  std::shared_ptr<CFileItem>& item = epgTags.items[index];
+  if (!item)
+  {
+    item = std::make_shared<CFileItem>(epgTags.tags[index]);
+
+    //! @todo it seems that this should be done somewhere else. CFileItem ctor maybe.
+    item->SetProperty("GenreType", epgTags.timeline.GetGenreType(index));
+  }
+  return item;
+}
+
+CGUIEPGGridContainerModel::EpgTags* CGUIEPGGridContainerModel::CreateEpgTags(int iChannel,
+                                                                             int iBlock) const
+{
   const int firstBlock = iBlock < m_firstActiveBlock ? iBlock : m_firstActiveBlock;
   const int lastBlock = iBlock > m_lastActiveBlock ? iBlock : m_lastActiveBlock;
 
@@ -157,64 +199,39 @@ std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::CreateEpgTags(int iChannel
   const int firstResultBlock = GetFirstEventBlock(tags.front());
   const int lastResultBlock = GetLastEventBlock(tags.back());
   if (firstResultBlock > lastResultBlock)
-    return result;
+    return nullptr;
 
-  auto it = m_epgItems.insert({iChannel, EpgTags()}).first;
+  auto it = m_epgItems.try_emplace(iChannel, m_gridEndOffset).first;
   EpgTags& epgTags = (*it).second;
 
   epgTags.firstBlock = firstResultBlock;
   epgTags.lastBlock = lastResultBlock;
 
   for (const auto& tag : tags)
-  {
-    if (GetFirstEventBlock(tag) > GetLastEventBlock(tag))
-      continue;
-
-    const std::shared_ptr<CFileItem> item = std::make_shared<CFileItem>(tag);
-    if (!result && IsEventMemberOfBlock(tag, iBlock))
-      result = item;
+    AddEpgTag(epgTags, tag);
 
-    epgTags.tags.emplace_back(item);
-  }
-
-  return result;
+  return &epgTags;
 }
 
-std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetEpgTags(EpgTagsMap::iterator& itEpg,
-                                                                 int iChannel,
-                                                                 int iBlock) const
+CGUIEPGGridContainerModel::EpgTags* CGUIEPGGridContainerModel::GetEpgTags(int iChannel,
+                                                                          int iBlock) const
 {
-  std::shared_ptr<CFileItem> result;
+  auto itEpg = m_epgItems.find(iChannel);
+  if (itEpg == m_epgItems.end())
+    return CreateEpgTags(iChannel, iBlock);
 
   EpgTags& epgTags = (*itEpg).second;
 
   if (iBlock < epgTags.firstBlock)
-  {
-    result = GetEpgTagsBefore(epgTags, iChannel, iBlock);
-  }
+    GetEpgTagsBefore(epgTags, iChannel, iBlock);
   else if (iBlock > epgTags.lastBlock)
-  {
-    result = GetEpgTagsAfter(epgTags, iChannel, iBlock);
-  }
-  else
-  {
-    const auto it =
-        std::find_if(epgTags.tags.cbegin(), epgTags.tags.cend(), [this, iBlock](const auto& item) {
-          return IsEventMemberOfBlock(item->GetEPGInfoTag(), iBlock);
-        });
-    if (it != epgTags.tags.cend())
-      result = (*it);
-  }
+    GetEpgTagsAfter(epgTags, iChannel, iBlock);
 
-  return result;
+  return &epgTags;
 }
 
-std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetEpgTagsBefore(EpgTags& epgTags,
-                                                                       int iChannel,
-                                                                       int iBlock) const
+void CGUIEPGGridContainerModel::GetEpgTagsBefore(EpgTags& epgTags, int iChannel, int iBlock) const
 {
-  std::shared_ptr<CFileItem> result;
-
   int lastBlock = epgTags.firstBlock - 1;
   if (lastBlock < 0)
     lastBlock = 0;
@@ -234,49 +251,35 @@ std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetEpgTagsBefore(EpgTags&
     const int firstResultBlock = GetFirstEventBlock(tags.front());
     const int lastResultBlock = GetLastEventBlock(tags.back());
     if (firstResultBlock > lastResultBlock)
-      return result;
+      return;
 
     // insert before the existing tags
     epgTags.firstBlock = firstResultBlock;
 
-    auto it = tags.crbegin();
+    auto end = tags.cend();
     if (!epgTags.tags.empty())
     {
       // ptr comp does not work for gap tags!
-      // if ((*it) == epgTags.tags.front()->GetEPGInfoTag())
-
-      const std::shared_ptr<const CPVREpgInfoTag> t = epgTags.tags.front()->GetEPGInfoTag();
-      if ((*it)->StartAsUTC() == t->StartAsUTC() && (*it)->EndAsUTC() == t->EndAsUTC())
-      {
-        if (!result && IsEventMemberOfBlock(*it, iBlock))
-          result = epgTags.tags.front();
+      // if (tags.back() == epgTags.tags.front())
 
-        ++it; // skip, because we already have that epg tag
-      }
+      const std::shared_ptr<const CPVREpgInfoTag> t = epgTags.tags.front();
+      if (tags.back()->StartAsUTC() == t->StartAsUTC() && tags.back()->EndAsUTC() == t->EndAsUTC())
+        --end; // skip, because we already have that epg tag
     }
 
-    for (; it != tags.crend(); ++it)
-    {
-      if (GetFirstEventBlock(*it) > GetLastEventBlock(*it))
-        continue;
-
-      const std::shared_ptr<CFileItem> item = std::make_shared<CFileItem>(*it);
-      if (!result && IsEventMemberOfBlock(*it, iBlock))
-        result = item;
+    EpgTags before(m_gridEndOffset);
+    for (auto it = tags.cbegin(); it != end; ++it)
+      AddEpgTag(before, *it);
 
-      epgTags.tags.insert(epgTags.tags.begin(), item);
-    }
+    before.firstBlock = epgTags.firstBlock;
+    before.lastBlock = epgTags.lastBlock;
+    before.Append(std::move(epgTags));
+    epgTags = std::move(before);
   }
-
-  return result;
 }
 
-std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetEpgTagsAfter(EpgTags& epgTags,
-                                                                      int iChannel,
-                                                                      int iBlock) const
+void CGUIEPGGridContainerModel::GetEpgTagsAfter(EpgTags& epgTags, int iChannel, int iBlock) const
 {
-  std::shared_ptr<CFileItem> result;
-
   int firstBlock = epgTags.lastBlock + 1;
   if (firstBlock >= GetLastBlock())
     firstBlock = GetLastBlock();
@@ -296,7 +299,7 @@ std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetEpgTagsAfter(EpgTags& e
     const int firstResultBlock = GetFirstEventBlock(tags.front());
     const int lastResultBlock = GetLastEventBlock(tags.back());
     if (firstResultBlock > lastResultBlock)
-      return result;
+      return;
 
     // append to the existing tags
     epgTags.lastBlock = lastResultBlock;
@@ -305,55 +308,16 @@ std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetEpgTagsAfter(EpgTags& e
     if (!epgTags.tags.empty())
     {
       // ptr comp does not work for gap tags!
-      // if ((*it) == epgTags.tags.back()->GetEPGInfoTag())
+      // if ((*it) == epgTags.tags.back())
 
-      const std::shared_ptr<const CPVREpgInfoTag> t = epgTags.tags.back()->GetEPGInfoTag();
+      const std::shared_ptr<const CPVREpgInfoTag> t = epgTags.tags.back();
       if ((*it)->StartAsUTC() == t->StartAsUTC() && (*it)->EndAsUTC() == t->EndAsUTC())
-      {
-        if (!result && IsEventMemberOfBlock(*it, iBlock))
-          result = epgTags.tags.back();
-
         ++it; // skip, because we already have that epg tag
-      }
     }
 
     for (; it != tags.cend(); ++it)
-    {
-      if (GetFirstEventBlock(*it) > GetLastEventBlock(*it))
-        continue;
-
-      const std::shared_ptr<CFileItem> item = std::make_shared<CFileItem>(*it);
-      if (!result && IsEventMemberOfBlock(*it, iBlock))
-        result = item;
-
-      epgTags.tags.emplace_back(item);
-    }
-  }
-
-  return result;
-}
-
-std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetItem(int iChannel, int iBlock) const
-{
-  std::shared_ptr<CFileItem> result;
-
-  auto itEpg = m_epgItems.find(iChannel);
-  if (itEpg == m_epgItems.end())
-  {
-    result = CreateEpgTags(iChannel, iBlock);
+      AddEpgTag(epgTags, *it);
   }
-  else
-  {
-    result = GetEpgTags(itEpg, iChannel, iBlock);
-  }
-
-  if (!result)
-  {
-    // Must never happen. if it does, fix the root cause, don't tolerate nullptr!
-    CLog::LogF(LOGERROR, "EPG tag ({}, {}) not found!", iChannel, iBlock);
-  }
-
-  return result;
 }
 
 void CGUIEPGGridContainerModel::FindChannelAndBlockIndex(int channelUid,
@@ -399,20 +363,19 @@ GridItem* CGUIEPGGridContainerModel::GetGridItemPtr(int iChannel, int iBlock) co
       return nullptr;
     }
 
-    const std::shared_ptr<CFileItem> item = GetItem(iChannel, iBlock);
-    if (!item)
+    EpgTags* epgTags = GetEpgTags(iChannel, iBlock);
+    const int index = epgTags ? epgTags->timeline.Find(iBlock) : -1;
+    if (index < 0)
     {
-      CLog::LogF(LOGERROR, "Got no EPG tag ({}, {})!", iChannel, iBlock);
+      // Must never happen. if it does, fix the root cause, don't tolerate nullptr!
+      CLog::LogF(LOGERROR, "EPG tag ({}, {}) not found!", iChannel, iBlock);
       return nullptr;
     }
 
-    const std::shared_ptr<const CPVREpgInfoTag> epgTag = item->GetEPGInfoTag();
+    const std::shared_ptr<CFileItem> item = GetEpgTagItem(*epgTags, index);
 
-    const int startBlock = GetFirstEventBlock(epgTag);
-    const int endBlock = GetLastEventBlock(epgTag);
-
-    //! @todo it seems that this should be done somewhere else. CFileItem ctor maybe.
-    item->SetProperty("GenreType", epgTag->GenreType());
+    const int startBlock = epgTags->timeline.GetFirstBlock(index);
+    const int endBlock = epgTags->timeline.GetLastBlock(index);
 
     const float fItemWidth = (endBlock - startBlock + 1) * m_fBlockSize;
     it = m_gridIndex.insert({{iChannel, iBlock}, {item, fItemWidth, startBlock, endBlock}}).first;
@@ -539,15 +502,13 @@ bool CGUIEPGGridContainerModel::FreeProgrammeMemory(int firstChannel,
     std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
     for (int i = firstChannel; i <= lastChannel; ++i)
     {
-      auto it = m_epgItems.find(i);
-      if (it == m_epgItems.end())
-        it = m_epgItems.insert({i, EpgTags()}).first;
+      auto it = m_epgItems.try_emplace(i, m_gridEndOffset).first;
 
       if (blocksChanged || i < m_firstActiveChannel || i > m_lastActiveChannel)
       {
         EpgTags& epgTags = (*it).second;
 
-        (*it).second.tags.clear();
+        epgTags.Clear();
 
         tags = GetEPGTimeline(i, maxEnd, minStart);
         const int firstResultBlock = GetFirstEventBlock(tags.front());
@@ -559,12 +520,7 @@ bool CGUIEPGGridContainerModel::FreeProgrammeMemory(int firstChannel,
         epgTags.lastBlock = lastResultBlock;
 
         for (const auto& tag : tags)
-        {
-          if (GetFirstEventBlock(tag) > GetLastEventBlock(tag))
-            continue;
-
-          epgTags.tags.emplace_back(std::make_shared<CFileItem>(tag));
-        }
+          AddEpgTag(epgTags, tag);
       }
     }
   }
@@ -615,25 +571,24 @@ CDateTime CGUIEPGGridContainerModel::GetStartTimeForBlock(int block) const
   return m_gridStart + CDateTimeSpan(0, 0, block * MINSPERBLOCK, 0);
 }
 
-int CGUIEPGGridContainerModel::GetBlock(const CDateTime& datetime) const
+int32_t CGUIEPGGridContainerModel::GetOffset(const CDateTime& datetime) const
 {
-  int diff;
-
   if (m_gridStart == datetime)
-    return 0; // block is at grid start
+    return 0; // at grid start
   else if (m_gridStart > datetime)
-    diff = -1 * (m_gridStart - datetime).GetSecondsTotal(); // block is before grid start
-  else
-    diff = (datetime - m_gridStart).GetSecondsTotal(); // block is after grid start
-
-  // Note: Subtract 1 second from diff to ensure that events ending exactly at block boundary
-  //       are unambiguous. Example: An event ending at 5:00:00 shall be mapped to block 9 and
-  //       an event starting at 5:00:00 shall be mapped to block 10, not both at block 10.
-  //       Only exception is grid end, because there is no successor.
-  if (datetime >= m_gridEnd)
-    return diff / 60 / MINSPERBLOCK; // block is equal or after grid end
+    return -1 * (m_gridStart - datetime).GetSecondsTotal(); // before grid start
   else
-    return (diff - 1) / 60 / MINSPERBLOCK;
+    return (datetime - m_gridStart).GetSecondsTotal(); // after grid start
+}
+
+int CGUIEPGGridContainerModel::GetBlock(const CDateTime& datetime) const
+{
+  // Note: Events ending exactly at block boundary are unambiguous. Example: An event ending at
+  //       5:00:00 shall be mapped to block 9 and an event starting at 5:00:00 shall be mapped to
+  //       block 10, not both at block 10. Only exception is grid end, because there is no
+  //       successor.
+  return CGUIEPGGridTimeline::GetLastBlock(GetOffset(datetime), GetOffset(m_gridEnd),
+                                           SECONDSPERBLOCK);
 }
 
 int CGUIEPGGridContainerModel::GetNowBlock() const
@@ -644,19 +599,8 @@ int CGUIEPGGridContainerModel::GetNowBlock() const
 int CGUIEPGGridContainerModel::GetFirstEventBlock(
     const std::shared_ptr<const CPVREpgInfoTag>& event) const
 {
-  const CDateTime eventStart = event->StartAsUTC();
-  int diff;
-
-  if (m_gridStart == eventStart)
-    return 0; // block is at grid start
-  else if (m_gridStart > eventStart)
-    diff = -1 * (m_gridStart - eventStart).GetSecondsTotal();
-  else
-    diff = (eventStart - m_gridStart).GetSecondsTotal();
-
   // First block of a tag is always the block calculated using event's start time, rounded up.
-  float fBlockIndex = diff / 60.0f / MINSPERBLOCK;
-  return static_cast<int>(std::ceil(fBlockIndex));
+  return CGUIEPGGridTimeline::GetFirstBlock(GetOffset(event->StartAsUTC()), SECONDSPERBLOCK);
 }
 
 int CGUIEPGGridContainerModel::GetLastEventBlock(
@@ -706,8 +650,10 @@ std::unique_ptr<CFileItemList> CGUIEPGGridContainerModel::GetCurrentTimeLineItem
     if (itEpg != m_epgItems.end())
     {
       // tags are sorted, so we can iterate and append
-      for (const auto& tag : (*itEpg).second.tags)
+      EpgTags& epgTags = (*itEpg).second;
+      for (int index = 0; index < static_cast<int>(epgTags.tags.size()); ++index)
       {
+        const std::shared_ptr<CFileItem> tag = GetEpgTagItem(epgTags, index);
         tag->SetProperty("TimelineIndex", i);
         items->Add(tag);
         ++i;
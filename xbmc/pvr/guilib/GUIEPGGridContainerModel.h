@@ -9,10 +9,12 @@
 #pragma once
 
 #include "XBDateTime.h"
+#include "pvr/guilib/GUIEPGGridTimeline.h"
 
 #include <functional>
 #include <map>
 #include <memory>
+#include <stdint.h>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -114,7 +116,6 @@ public:
 private:
   GridItem* GetGridItemPtr(int iChannel, int iBlock) const;
   std::shared_ptr<CFileItem> CreateGapItem(int iChannel) const;
-  std::shared_ptr<CFileItem> GetItem(int iChannel, int iBlock) const;
 
   std::vector<std::shared_ptr<CPVREpgInfoTag>> GetEPGTimeline(int iChannel,
                                                               const CDateTime& minEventEnd,
@@ -122,24 +123,34 @@ private:
 
   struct EpgTags
   {
-    std::vector<std::shared_ptr<CFileItem>> tags;
+    explicit EpgTags(int32_t gridEnd) : timeline(gridEnd, MINSPERBLOCK * 60) {}
+
+    void Append(EpgTags&& other);
+    void Clear();
+
+    CGUIEPGGridTimeline timeline; // layout of the tags
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> tags; // in the order of the timeline
+    std::vector<std::shared_ptr<CFileItem>> items; // created on demand for visible tags only
     int firstBlock = -1;
     int lastBlock = -1;
   };
 
   using EpgTagsMap = std::unordered_map<int, EpgTags>;
 
-  std::shared_ptr<CFileItem> CreateEpgTags(int iChannel, int iBlock) const;
-  std::shared_ptr<CFileItem> GetEpgTags(EpgTagsMap::iterator& itEpg,
-                                        int iChannel,
-                                        int iBlock) const;
-  std::shared_ptr<CFileItem> GetEpgTagsBefore(EpgTags& epgTags, int iChannel, int iBlock) const;
-  std::shared_ptr<CFileItem> GetEpgTagsAfter(EpgTags& epgTags, int iChannel, int iBlock) const;
+  EpgTags* GetEpgTags(int iChannel, int iBlock) const;
+  EpgTags* CreateEpgTags(int iChannel, int iBlock) const;
+  void GetEpgTagsBefore(EpgTags& epgTags, int iChannel, int iBlock) const;
+  void GetEpgTagsAfter(EpgTags& epgTags, int iChannel, int iBlock) const;
+  bool AddEpgTag(EpgTags& epgTags, const std::shared_ptr<CPVREpgInfoTag>& tag) const;
+  std::shared_ptr<CFileItem> GetEpgTagItem(EpgTags& epgTags, int index) const;
+
+  int32_t GetOffset(const CDateTime& datetime) const;
 
   mutable EpgTagsMap m_epgItems;
 
   CDateTime m_gridStart;
   CDateTime m_gridEnd;
+  int32_t m_gridEndOffset = 0;
 
   std::vector<std::shared_ptr<CFileItem>> m_channelItems;
   std::vector<std::shared_ptr<CFileItem>> m_rulerItems;
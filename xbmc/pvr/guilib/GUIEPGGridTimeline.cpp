@@ -0,0 +1,81 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIEPGGridTimeline.h"
+
+#include <algorithm>
+
+using namespace PVR;
+
+CGUIEPGGridTimeline::CGUIEPGGridTimeline(int32_t gridEnd, int32_t secondsPerBlock)
+  : m_gridEnd(gridEnd), m_secondsPerBlock(secondsPerBlock)
+{
+}
+
+bool CGUIEPGGridTimeline::Add(int32_t start, int32_t end, int genreType)
+{
+  if (GetFirstBlock(start, m_secondsPerBlock) > GetLastBlock(end, m_gridEnd, m_secondsPerBlock))
+    return false;
+
+  m_start.emplace_back(start);
+  m_end.emplace_back(end);
+  m_genreType.emplace_back(static_cast<uint16_t>(genreType));
+  return true;
+}
+
+void CGUIEPGGridTimeline::Append(const CGUIEPGGridTimeline& other)
+{
+  m_start.insert(m_start.end(), other.m_start.cbegin(), other.m_start.cend());
+  m_end.insert(m_end.end(), other.m_end.cbegin(), other.m_end.cend());
+  m_genreType.insert(m_genreType.end(), other.m_genreType.cbegin(), other.m_genreType.cend());
+}
+
+void CGUIEPGGridTimeline::Clear()
+{
+  m_start.clear();
+  m_end.clear();
+  m_genreType.clear();
+}
+
+int CGUIEPGGridTimeline::Find(int block) const
+{
+  // the last event starting in or before the block covers it, unless the events overlap
+  const int64_t blockStart = static_cast<int64_t>(block) * m_secondsPerBlock;
+  const auto it = std::partition_point(m_start.cbegin(), m_start.cend(),
+                                       [blockStart](int32_t start) { return start <= blockStart; });
+
+  for (int index = static_cast<int>(std::distance(m_start.cbegin(), it)) - 1; index >= 0; --index)
+  {
+    if (GetLastBlock(index) >= block)
+      return index;
+  }
+  return -1;
+}
+
+size_t CGUIEPGGridTimeline::GetMemoryUsage() const
+{
+  return sizeof(*this) + m_start.capacity() * sizeof(int32_t) +
+         m_end.capacity() * sizeof(int32_t) + m_genreType.capacity() * sizeof(uint16_t);
+}
+
+int CGUIEPGGridTimeline::GetFirstBlock(int32_t start, int32_t secondsPerBlock)
+{
+  // division truncates towards zero, which rounds up for events starting before the grid
+  if (start > 0)
+    return (start + secondsPerBlock - 1) / secondsPerBlock;
+
+  return start / secondsPerBlock;
+}
+
+int CGUIEPGGridTimeline::GetLastBlock(int32_t end, int32_t gridEnd, int32_t secondsPerBlock)
+{
+  if (end >= gridEnd)
+    return end / secondsPerBlock;
+
+  return (end - 1) / secondsPerBlock;
+}
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace PVR
+{
+/*!
+ \brief Compact, time-indexed layout of the events of one channel of the guide grid.
+
+ The events are stored sorted by start time as columns of start and end (in seconds relative to
+ the grid start) and genre type. Events are looked up by block using a binary search,
+ so the layout of the grid needs neither date arithmetic nor a CFileItem per event.
+ */
+class CGUIEPGGridTimeline
+{
+public:
+  /*!
+   \param gridEnd End of the grid in seconds relative to the grid start
+   \param secondsPerBlock Duration of a block of the grid
+   */
+  CGUIEPGGridTimeline(int32_t gridEnd, int32_t secondsPerBlock);
+
+  /*!
+   \brief Adds an event after the events already added.
+   \return false if the event is too short to cover a block and was not added
+   */
+  bool Add(int32_t start, int32_t end, int genreType);
+
+  /*!
+   \brief Appends the events of another timeline of the same grid.
+   */
+  void Append(const CGUIEPGGridTimeline& other);
+
+  void Clear();
+
+  size_t Size() const { return m_start.size(); }
+  bool IsEmpty() const { return m_start.empty(); }
+
+  int32_t GetStart(size_t index) const { return m_start[index]; }
+  int32_t GetEnd(size_t index) const { return m_end[index]; }
+  int GetGenreType(size_t index) const { return m_genreType[index]; }
+  int GetFirstBlock(size_t index) const { return GetFirstBlock(m_start[index], m_secondsPerBlock); }
+  int GetLastBlock(size_t index) const
+  {
+    return GetLastBlock(m_end[index], m_gridEnd, m_secondsPerBlock);
+  }
+
+  /*!
+   \brief Finds the event covering a block.
+   \return The index of the event or -1 if no event covers the block
+   */
+  int Find(int block) const;
+
+  size_t GetMemoryUsage() const;
+
+  /*!
+   \brief First block of an event, the block containing its start rounded up.
+   */
+  static int GetFirstBlock(int32_t start, int32_t secondsPerBlock);
+
+  /*!
+   \brief Block containing a point in time. An event ending exactly at a block boundary ends in
+   the block before the boundary, except at the end of the grid which has no successor.
+   */
+  static int GetLastBlock(int32_t end, int32_t gridEnd, int32_t secondsPerBlock);
+
+private:
+  int32_t m_gridEnd;
+  int32_t m_secondsPerBlock;
+
+  std::vector<int32_t> m_start;
+  std::vector<int32_t> m_end;
+  std::vector<uint16_t> m_genreType;
+};
+} // namespace PVR
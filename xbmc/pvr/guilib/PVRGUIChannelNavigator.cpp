@@ -11,20 +11,30 @@
 #include "FileItem.h"
 #include "GUIInfoManager.h"
 #include "ServiceBroker.h"
+#include "application/ApplicationComponents.h"
+#include "application/ApplicationPlayer.h"
 #include "guilib/GUIComponent.h"
 #include "pvr/PVRManager.h"
 #include "pvr/PVRPlaybackState.h"
+#include "pvr/channels/PVRChannel.h"
 #include "pvr/channels/PVRChannelGroup.h"
+#include "pvr/channels/PVRChannelGroupMember.h"
 #include "pvr/guilib/PVRGUIActionsPlayback.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SystemClock.h"
 #include "utils/Job.h"
 #include "utils/JobManager.h"
+#include "utils/URIUtils.h"
 #include "utils/XTimeUtils.h"
+#include "utils/log.h"
 
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 using namespace KODI::GUILIB::GUIINFO;
 using namespace PVR;
@@ -95,6 +105,19 @@ public:
   const char* GetType() const override { return "pvr-channel-info-timeout-job"; }
   void OnTimeout() override { m_channelNavigator.HideInfo(); }
 };
+
+class CPVRChannelPreTuneTimeoutJob : public CPVRChannelTimeoutJobBase
+{
+public:
+  CPVRChannelPreTuneTimeoutJob(PVR::CPVRGUIChannelNavigator& channelNavigator,
+                               std::chrono::milliseconds timeout)
+    : CPVRChannelTimeoutJobBase(channelNavigator, timeout)
+  {
+  }
+  ~CPVRChannelPreTuneTimeoutJob() override = default;
+  const char* GetType() const override { return "pvr-channel-pretune-timeout-job"; }
+  void OnTimeout() override { m_channelNavigator.PreTuneAdjacentChannels(); }
+};
 } // unnamed namespace
 
 CPVRGUIChannelNavigator::CPVRGUIChannelNavigator()
@@ -155,6 +178,8 @@ void CPVRGUIChannelNavigator::SelectNextChannel(ChannelSwitchMode eSwitchMode)
     return;
   }
 
+  m_bLastSelectNext = true;
+
   const std::shared_ptr<CPVRChannelGroupMember> nextMember = GetNextOrPrevChannel(true);
   if (nextMember)
     SelectChannel(nextMember, eSwitchMode);
@@ -171,6 +196,8 @@ void CPVRGUIChannelNavigator::SelectPreviousChannel(ChannelSwitchMode eSwitchMod
     return;
   }
 
+  m_bLastSelectNext = false;
+
   const std::shared_ptr<CPVRChannelGroupMember> prevMember = GetNextOrPrevChannel(false);
   if (prevMember)
     SelectChannel(prevMember, eSwitchMode);
@@ -355,6 +382,7 @@ void CPVRGUIChannelNavigator::SetPlayingChannel(
     }
 
     CheckAndPublishPreviewAndPlayerShowInfoChangedEvent();
+    SchedulePreTune();
   }
 
   if (item)
@@ -368,7 +396,94 @@ void CPVRGUIChannelNavigator::ClearPlayingChannel()
   std::unique_lock<CCriticalSection> lock(m_critSection);
 
   m_playingChannel.reset();
+  SchedulePreTune();
   HideInfo();
 
   CheckAndPublishPreviewAndPlayerShowInfoChangedEvent();
 }
+
+void CPVRGUIChannelNavigator::SchedulePreTune()
+{
+  std::unique_lock<CCriticalSection> lock(m_critSection);
+
+  if (m_iChannelPreTuneJobId >= 0)
+  {
+    CServiceBroker::GetJobManager()->CancelJob(m_iChannelPreTuneJobId);
+    m_iChannelPreTuneJobId = -1;
+  }
+
+  const auto timeout = std::chrono::milliseconds(
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iPVRPreTuneDelay);
+  if (m_playingChannel && timeout > 0ms)
+  {
+    CPVRChannelPreTuneTimeoutJob* job = new CPVRChannelPreTuneTimeoutJob(*this, timeout);
+    m_iChannelPreTuneJobId =
+        CServiceBroker::GetJobManager()->AddJob(job, dynamic_cast<IJobCallback*>(job));
+  }
+}
+
+void CPVRGUIChannelNavigator::PreTuneAdjacentChannels()
+{
+  std::shared_ptr<CPVRChannelGroupMember> playingChannel;
+  bool bNextFirst = true;
+
+  {
+    std::unique_lock<CCriticalSection> lock(m_critSection);
+
+    m_iChannelPreTuneJobId = -1;
+    playingChannel = m_playingChannel;
+    bNextFirst = m_bLastSelectNext;
+  }
+
+  if (!playingChannel)
+    return;
+
+  const std::shared_ptr<const CPVRChannelGroup> group =
+      CServiceBroker::GetPVRManager().PlaybackState()->GetActiveChannelGroup(
+          playingChannel->Channel()->IsRadio());
+  if (!group)
+    return;
+
+  // the channel in the direction the user zapped last is the most likely one to be selected next
+  const std::shared_ptr<CPVRChannelGroupMember> nextMember =
+      group->GetNextChannelGroupMember(playingChannel);
+  const std::shared_ptr<CPVRChannelGroupMember> prevMember =
+      group->GetPreviousChannelGroupMember(playingChannel);
+  const std::shared_ptr<CPVRChannelGroupMember> candidates[] = {
+      bNextFirst ? nextMember : prevMember, bNextFirst ? prevMember : nextMember};
+
+  const int maxStreams =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iPVRPreTuneStreams;
+  std::map<int, int> clientStreams;
+  std::vector<std::shared_ptr<CFileItem>> items;
+
+  for (const auto& member : candidates)
+  {
+    if (!member || member == playingChannel || member->Channel()->IsLocked() ||
+        std::any_of(items.cbegin(), items.cend(),
+                    [&member](const auto& item) { return item->GetPath() == member->Path(); }))
+      continue;
+
+    // many providers limit the number of concurrent streams per account
+    int& streams = clientStreams[member->ChannelClientID()];
+    if (streams >= maxStreams)
+      continue;
+
+    // channels without a stream url are streamed by the client itself, which can only stream
+    // one channel at a time
+    const auto item = std::make_shared<CFileItem>(member);
+    if (!CServiceBroker::GetPVRManager().PlaybackState()->FillStreamProperties(*item) ||
+        URIUtils::IsPVRChannel(item->GetDynPath()))
+      continue;
+
+    ++streams;
+    items.emplace_back(item);
+  }
+
+  CLog::LogFC(LOGDEBUG, LOGPVR, "Pre-tuning {} channel(s) adjacent to channel '{}'", items.size(),
+              playingChannel->Channel()->ChannelName());
+
+  auto& components = CServiceBroker::GetAppComponents();
+  const auto appPlayer = components.GetComponent<CApplicationPlayer>();
+  appPlayer->PrepareFiles(items);
+}
@@ -141,6 +141,13 @@ public:
    */
   void ClearPlayingChannel();
 
+  /*!
+   * @brief Let the player open the streams of the channels adjacent to the playing channel in the
+   * background, so that switching to one of them is faster. Only channels with a stream url are
+   * opened, and at most the configured number of channels per client.
+   */
+  void PreTuneAdjacentChannels();
+
 private:
   /*!
    * @brief Get next or previous channel group member of the playing channel group, relative to the
@@ -177,11 +184,19 @@ private:
    */
   void CheckAndPublishPreviewAndPlayerShowInfoChangedEvent();
 
+  /*!
+   * @brief (Re)start the delay after that the channels adjacent to the playing channel get
+   * pre-tuned, if enabled.
+   */
+  void SchedulePreTune();
+
   mutable CCriticalSection m_critSection;
   std::shared_ptr<CPVRChannelGroupMember> m_playingChannel;
   std::shared_ptr<CPVRChannelGroupMember> m_currentChannel;
   int m_iChannelEntryJobId = -1;
   int m_iChannelInfoJobId = -1;
+  int m_iChannelPreTuneJobId = -1;
+  bool m_bLastSelectNext{true};
   CEventSource<PVRPreviewAndPlayerShowInfoChangedEvent> m_events;
   bool m_playerShowInfo{false};
   bool m_previewAndPlayerShowInfo{false};
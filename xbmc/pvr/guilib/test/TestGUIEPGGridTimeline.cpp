@@ -0,0 +1,160 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "pvr/epg/EpgInfoTag.h"
+#include "pvr/guilib/GUIEPGGridTimeline.h"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+constexpr int32_t BLOCK = 5 * 60;
+constexpr int32_t GRID_END = 24 * 60 * 60;
+} // namespace
+
+TEST(TestGUIEPGGridTimeline, Blocks)
+{
+  // events starting within a block start in the next block
+  EXPECT_EQ(0, CGUIEPGGridTimeline::GetFirstBlock(0, BLOCK));
+  EXPECT_EQ(1, CGUIEPGGridTimeline::GetFirstBlock(1, BLOCK));
+  EXPECT_EQ(1, CGUIEPGGridTimeline::GetFirstBlock(BLOCK, BLOCK));
+  EXPECT_EQ(0, CGUIEPGGridTimeline::GetFirstBlock(-1, BLOCK));
+  EXPECT_EQ(-1, CGUIEPGGridTimeline::GetFirstBlock(-BLOCK - 1, BLOCK));
+
+  // events ending at a block boundary end in the block before, except at the grid end
+  EXPECT_EQ(0, CGUIEPGGridTimeline::GetLastBlock(BLOCK, GRID_END, BLOCK));
+  EXPECT_EQ(1, CGUIEPGGridTimeline::GetLastBlock(BLOCK + 1, GRID_END, BLOCK));
+  EXPECT_EQ(0, CGUIEPGGridTimeline::GetLastBlock(0, GRID_END, BLOCK));
+  EXPECT_EQ(GRID_END / BLOCK, CGUIEPGGridTimeline::GetLastBlock(GRID_END, GRID_END, BLOCK));
+  EXPECT_EQ(GRID_END / BLOCK, CGUIEPGGridTimeline::GetLastBlock(GRID_END + 1, GRID_END, BLOCK));
+}
+
+TEST(TestGUIEPGGridTimeline, Find)
+{
+  CGUIEPGGridTimeline timeline(GRID_END, BLOCK);
+  EXPECT_EQ(-1, timeline.Find(0));
+
+  EXPECT_TRUE(timeline.Add(-600, 1800, 0x10)); // blocks -2 to 5
+  EXPECT_FALSE(timeline.Add(1810, 1860, 0x20)); // too short to cover a block
+  EXPECT_TRUE(timeline.Add(1860, 3600, 0x30)); // blocks 7 to 11
+  EXPECT_TRUE(timeline.Add(5400, GRID_END, 0x40)); // blocks 18 to the grid end
+  ASSERT_EQ(3u, timeline.Size());
+
+  EXPECT_EQ(0, timeline.Find(-2));
+  EXPECT_EQ(0, timeline.Find(5));
+  EXPECT_EQ(-1, timeline.Find(6));
+  EXPECT_EQ(1, timeline.Find(7));
+  EXPECT_EQ(1, timeline.Find(11));
+  EXPECT_EQ(-1, timeline.Find(12));
+  EXPECT_EQ(2, timeline.Find(18));
+  EXPECT_EQ(2, timeline.Find(GRID_END / BLOCK));
+  EXPECT_EQ(-1, timeline.Find(GRID_END / BLOCK + 1));
+
+  EXPECT_EQ(7, timeline.GetFirstBlock(1));
+  EXPECT_EQ(11, timeline.GetLastBlock(1));
+  EXPECT_EQ(0x30, timeline.GetGenreType(1));
+}
+
+TEST(TestGUIEPGGridTimeline, FindOverlapping)
+{
+  CGUIEPGGridTimeline timeline(GRID_END, BLOCK);
+  EXPECT_TRUE(timeline.Add(0, 7200, 0));
+  EXPECT_TRUE(timeline.Add(600, 1200, 0));
+
+  // the long event still covers the blocks after the short one
+  EXPECT_EQ(1, timeline.Find(2));
+  EXPECT_EQ(0, timeline.Find(10));
+}
+
+TEST(TestGUIEPGGridTimeline, Append)
+{
+  CGUIEPGGridTimeline timeline(GRID_END, BLOCK);
+  EXPECT_TRUE(timeline.Add(0, 1800, 0x10));
+
+  CGUIEPGGridTimeline other(GRID_END, BLOCK);
+  EXPECT_TRUE(other.Add(1800, 3600, 0x20));
+  timeline.Append(other);
+
+  ASSERT_EQ(2u, timeline.Size());
+  EXPECT_EQ(1, timeline.Find(6));
+  EXPECT_EQ(0x20, timeline.GetGenreType(1));
+
+  timeline.Clear();
+  EXPECT_TRUE(timeline.IsEmpty());
+}
+
+// guide open time and memory for a synthetic EPG of 600 channels and 14 days
+TEST(TestGUIEPGGridTimeline, DISABLED_Benchmark)
+{
+  const int channels = 600;
+  const int32_t gridEnd = 14 * 24 * 60 * 60;
+  const int32_t durations[] = {5 * 60, 15 * 60, 30 * 60, 45 * 60, 60 * 60, 90 * 60, 120 * 60};
+
+  // open the guide
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<CGUIEPGGridTimeline> timelines;
+  timelines.reserve(channels);
+  size_t events = 0;
+  for (int channel = 0; channel < channels; ++channel)
+  {
+    CGUIEPGGridTimeline& timeline = timelines.emplace_back(gridEnd, BLOCK);
+    int32_t time = -(channel % 7) * 60 * 10;
+    for (int i = 0; time < gridEnd; ++i)
+    {
+      const int32_t end = time + durations[(channel + i * 3) % 7];
+      if (timeline.Add(time, end, ((i % 15) + 1) << 4))
+        ++events;
+      time = end;
+    }
+  }
+  const std::chrono::duration<double> buildDuration = std::chrono::steady_clock::now() - start;
+
+  size_t memory = 0;
+  for (const auto& timeline : timelines)
+    memory += timeline.GetMemoryUsage();
+
+  std::cout << "Guide open: " << events << " events laid out in " << buildDuration.count() * 1000
+            << " ms, " << memory / 1024 << " KiB (" << memory / events
+            << " bytes per event, at least " << sizeof(CFileItem) + sizeof(CPVREpgInfoTag)
+            << " bytes per CFileItem with an EPG tag)" << std::endl;
+
+  // scroll through the guide page by page, 12 channels and 2 hours per page
+  const int channelsPerPage = 12;
+  const int blocksPerPage = 24;
+  const int blocks = gridEnd / BLOCK;
+  size_t cells = 0;
+  const auto layoutStart = std::chrono::steady_clock::now();
+  for (int firstChannel = 0; firstChannel < channels; firstChannel += channelsPerPage)
+  {
+    for (int firstBlock = 0; firstBlock < blocks; firstBlock += blocksPerPage * 7)
+    {
+      for (int channel = firstChannel; channel < firstChannel + channelsPerPage; ++channel)
+      {
+        for (int block = firstBlock; block < firstBlock + blocksPerPage;)
+        {
+          const int index = timelines[channel].Find(block);
+          ASSERT_GE(index, 0);
+          block = timelines[channel].GetLastBlock(index) + 1;
+          ++cells;
+        }
+      }
+    }
+  }
+  const std::chrono::duration<double> layoutDuration =
+      std::chrono::steady_clock::now() - layoutStart;
+
+  std::cout << "Page layout: " << cells << " cells in " << layoutDuration.count() * 1000 << " ms ("
+            << layoutDuration.count() * 1e9 / cells << " ns per cell)" << std::endl;
+}
@@ -250,6 +250,12 @@ void CPVRRecording::Serialize(CVariant& value) const
   value["clientid"] = m_iClientId;
 }
 
+void CPVRRecording::SerializeFields(CVariant& value, const std::set<std::string>& fields) const
+{
+  // the recording specific values are cheap, serialize everything
+  Serialize(value);
+}
+
 void CPVRRecording::ToSortable(SortItem& sortable, Field field) const
 {
   std::unique_lock<CCriticalSection> lock(m_critSection);
@@ -67,6 +67,7 @@ public:
   void FillAddonData(PVR_RECORDING& recording) const;
 
   void Serialize(CVariant& value) const override;
+  void SerializeFields(CVariant& value, const std::set<std::string>& fields) const override;
 
   // ISortable implementation
   void ToSortable(SortItem& sortable, Field field) const override;
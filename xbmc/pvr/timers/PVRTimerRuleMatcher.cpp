@@ -13,7 +13,9 @@
 #include "pvr/epg/EpgInfoTag.h"
 #include "pvr/timers/PVRTimerInfoTag.h"
 #include "utils/RegExp.h"
+#include "utils/StringUtils.h"
 
+#include <algorithm>
 #include <memory>
 
 using namespace PVR;
@@ -78,6 +80,25 @@ bool CPVRTimerRuleMatcher::Matches(const std::shared_ptr<const CPVREpgInfoTag>&
          MatchEnd(epgTag) && MatchDayOfWeek(epgTag) && MatchSearchText(epgTag);
 }
 
+bool CPVRTimerRuleMatcher::GetSearchTexts(std::vector<std::string>& texts, bool& bTitleOnly) const
+{
+  if (m_timerRule->GetTimerType()->SupportsEpgFulltextMatch() && m_timerRule->IsFullTextEpgSearch())
+    bTitleOnly = false;
+  else if (m_timerRule->GetTimerType()->SupportsEpgTitleMatch())
+    bTitleOnly = true;
+  else
+    return false; // matches any text
+
+  // anything but plain texts needs the regular expression to be evaluated on every tag
+  const std::string& searchString = m_timerRule->EpgSearchString();
+  if (searchString.find_first_of("\\^$.?*+()[]{}") != std::string::npos)
+    return false;
+
+  texts = StringUtils::Split(searchString, '|');
+  return !texts.empty() && std::none_of(texts.cbegin(), texts.cend(),
+                                        [](const std::string& text) { return text.empty(); });
+}
+
 bool CPVRTimerRuleMatcher::MatchSeriesLink(
     const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const
 {
@@ -178,10 +199,7 @@ bool CPVRTimerRuleMatcher::MatchSearchText(
       m_textSearch = std::make_unique<CRegExp>(true /* case insensitive */);
       m_textSearch->RegComp(m_timerRule->EpgSearchString());
     }
-    return m_textSearch->RegFind(epgTag->Title()) >= 0 ||
-           m_textSearch->RegFind(epgTag->EpisodeName()) >= 0 ||
-           m_textSearch->RegFind(epgTag->PlotOutline()) >= 0 ||
-           m_textSearch->RegFind(epgTag->Plot()) >= 0;
+    return MatchSearchText(*m_textSearch, *epgTag, false);
   }
   else if (m_timerRule->GetTimerType()->SupportsEpgTitleMatch())
   {
@@ -190,8 +208,19 @@ bool CPVRTimerRuleMatcher::MatchSearchText(
       m_textSearch = std::make_unique<CRegExp>(true /* case insensitive */);
       m_textSearch->RegComp(m_timerRule->EpgSearchString());
     }
-    return m_textSearch->RegFind(epgTag->Title()) >= 0;
+    return MatchSearchText(*m_textSearch, *epgTag, true);
   }
   else
     return true;
 }
+
+bool CPVRTimerRuleMatcher::MatchSearchText(CRegExp& textSearch,
+                                           const CPVREpgInfoTag& epgTag,
+                                           bool bTitleOnly)
+{
+  if (bTitleOnly)
+    return textSearch.RegFind(epgTag.Title()) >= 0;
+
+  return textSearch.RegFind(epgTag.Title()) >= 0 || textSearch.RegFind(epgTag.EpisodeName()) >= 0 ||
+         textSearch.RegFind(epgTag.PlotOutline()) >= 0 || textSearch.RegFind(epgTag.Plot()) >= 0;
+}
@@ -11,6 +11,8 @@
 #include "XBDateTime.h"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 class CRegExp;
 
@@ -32,6 +34,24 @@ public:
   CDateTime GetNextTimerStart() const;
   bool Matches(const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const;
 
+  /*!
+   * @brief Get the texts of which an EPG tag must contain at least one to match the rule.
+   * @param texts Filled with the texts. Matched case-insensitive anywhere in the tag's texts.
+   * @param bTitleOnly Set to true if the texts must be contained in the title.
+   * @return False if the rule has no text criteria or its search string is not a plain text (or
+   * alternatives of plain texts), true otherwise.
+   */
+  bool GetSearchTexts(std::vector<std::string>& texts, bool& bTitleOnly) const;
+
+  /*!
+   * @brief Check whether the texts of an EPG tag match the search string of a timer rule.
+   * @param textSearch The compiled, case-insensitive search string.
+   * @param epgTag The EPG tag.
+   * @param bTitleOnly Whether to match the title only or also episode name, plot outline and plot.
+   * @return True if one of the texts matches, false otherwise.
+   */
+  static bool MatchSearchText(CRegExp& textSearch, const CPVREpgInfoTag& epgTag, bool bTitleOnly);
+
 private:
   bool MatchSeriesLink(const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const;
   bool MatchChannel(const std::shared_ptr<const CPVREpgInfoTag>& epgTag) const;
@@ -29,6 +29,7 @@
 #include <memory>
 #include <mutex>
 #include <numeric>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -409,6 +410,21 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> GetEpgTagsForTimerRule(
 {
   std::vector<std::shared_ptr<CPVREpgInfoTag>> matches;
 
+  // let the epg search index find the candidates instead of matching every epg tag
+  std::vector<std::string> texts;
+  bool bTitleOnly = false;
+  if (matcher.GetSearchTexts(texts, bTitleOnly))
+  {
+    const auto tags =
+        CServiceBroker::GetPVRManager().EpgContainer().GetTagsContaining(texts, bTitleOnly);
+    if (tags)
+    {
+      std::copy_if(tags->cbegin(), tags->cend(), std::back_inserter(matches),
+                   [&matcher](const auto& tag) { return matcher.Matches(tag); });
+      return matches;
+    }
+  }
+
   const std::shared_ptr<const CPVRChannel> channel = matcher.GetChannel();
   if (channel)
   {
@@ -489,6 +505,46 @@ void AddTimerRuleToEpgMap(
     }
   }
 }
+
+std::optional<std::map<int, std::vector<std::shared_ptr<CPVREpgInfoTag>>>>
+GetEpgTagsForTimerRules(
+    const std::map<std::shared_ptr<CPVREpg>, std::vector<std::shared_ptr<CPVRTimerRuleMatcher>>>&
+        epgMap)
+{
+  // the epg search index can only be used if all rules search for plain texts
+  std::vector<std::string> allTexts;
+  bool bAllTitleOnly = true;
+  for (const auto& epgMapEntry : epgMap)
+  {
+    for (const auto& matcher : epgMapEntry.second)
+    {
+      std::vector<std::string> texts;
+      bool bTitleOnly = false;
+      if (!matcher->GetSearchTexts(texts, bTitleOnly))
+        return {};
+
+      allTexts.insert(allTexts.end(), texts.cbegin(), texts.cend());
+      bAllTitleOnly &= bTitleOnly;
+    }
+  }
+
+  if (allTexts.empty())
+    return {};
+
+  std::sort(allTexts.begin(), allTexts.end());
+  allTexts.erase(std::unique(allTexts.begin(), allTexts.end()), allTexts.end());
+
+  const auto tags =
+      CServiceBroker::GetPVRManager().EpgContainer().GetTagsContaining(allTexts, bAllTitleOnly);
+  if (!tags)
+    return {};
+
+  std::map<int, std::vector<std::shared_ptr<CPVREpgInfoTag>>> tagsByEpg;
+  for (const auto& tag : *tags)
+    tagsByEpg[tag->EpgID()].emplace_back(tag);
+
+  return tagsByEpg;
+}
 } // unnamed namespace
 
 bool CPVRTimers::UpdateEntries(int iMaxNotificationDelay)
@@ -676,9 +732,21 @@ bool CPVRTimers::UpdateEntries(int iMaxNotificationDelay)
   }
 
   // create new children of local epg-based reminder timer rules
+  const auto candidates = GetEpgTagsForTimerRules(epgMap);
   for (const auto& epgMapEntry : epgMap)
   {
-    const auto epgTags = epgMapEntry.first->GetTags();
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> epgTags;
+    if (candidates)
+    {
+      const auto it = candidates->find(epgMapEntry.first->EpgID());
+      if (it != candidates->end())
+        epgTags = it->second;
+    }
+    else
+    {
+      epgTags = epgMapEntry.first->GetTags();
+    }
+
     for (const auto& epgTag : epgTags)
     {
       if (GetTimerForEpgTag(epgTag))
@@ -173,6 +173,9 @@ void CAdvancedSettings::Initialize()
   m_videoFpsDetect = 1;
   m_maxTempo = 1.55f;
   m_videoPreferStereoStream = false;
+  m_videoProbeCacheSize = 50;
+  m_videoSeekIndex = true;
+  m_videoAdaptiveThreads = true;
 
   m_videoDefaultLatency = 0.0;
 
@@ -296,6 +299,7 @@ void CAdvancedSettings::Initialize()
   m_imageRes = 720;
   m_imageScalingAlgorithm = CPictureScalingAlgorithm::Default;
   m_imageQualityJpeg = 4;
+  m_imageDecodedCacheUseCount = 0;
 
   m_sambaclienttimeout = 30;
   m_sambadoscodepage = "";
@@ -321,12 +325,16 @@ void CAdvancedSettings::Initialize()
   m_iMusicLibraryDateAdded = 1; // prefer mtime over ctime and current time
   m_bMusicLibraryUseISODates = false;
   m_bMusicLibraryArtistNavigatesToSongs = false;
+  m_musicLibraryTagReadThreads = 0; // number of CPU cores
+  m_musicLibraryRemoteTagReadThreads = 2;
 
   m_bVideoLibraryAllItemsOnBottom = false;
   m_iVideoLibraryRecentlyAddedItems = 25;
   m_bVideoLibraryCleanOnUpdate = false;
   m_bVideoLibraryUseFastHash = true;
   m_bVideoScannerIgnoreErrors = false;
+  m_videoScannerScraperThreads = 4;
+  m_videoScannerScraperDelay = 0;
   m_iVideoLibraryDateAdded = 1; // prefer mtime over ctime and current time
 
   m_iEpgUpdateCheckInterval = 300; /* Check every X seconds, if EPG data need to be updated. This does not mean that
@@ -350,6 +358,9 @@ void CAdvancedSettings::Initialize()
                                                       updateemptytagsinterval = 3600 => trigger an EPG update for every
                                                       channel without EPG data every 2 hours and trigger an EPG update
                                                       for every channel with EPG data every 1 hour. */
+  m_iEpgMaxConcurrentUpdatesPerClient = 1; /* Maximum number of channels of a client whose EPG data is
+                                              fetched concurrently. The EPG data of different clients is
+                                              always fetched concurrently. */
   m_bEpgDisplayUpdatePopup = true; /* Display a progress popup while updating EPG data from clients */
   m_bEpgDisplayIncrementalUpdatePopup = false; /* Display a progress popup while doing incremental EPG updates, but
                                                   only if 'displayupdatepopup' is also enabled. */
@@ -406,6 +417,11 @@ void CAdvancedSettings::Initialize()
   m_iPVRNumericChannelSwitchTimeout = 2000;
   m_iPVRTimeshiftThreshold = 10;
   m_bPVRTimeshiftSimpleOSD = true;
+  m_bPVRTimeshiftBufferEnabled = false;
+  m_iPVRTimeshiftBufferSize = 1024;
+  m_strPVRTimeshiftBufferPath = "special://temp/timeshift/";
+  m_iPVRPreTuneDelay = 0;
+  m_iPVRPreTuneStreams = 1;
   m_PVRDefaultSortOrder.sortBy = SortByDate;
   m_PVRDefaultSortOrder.sortOrder = SortOrderDescending;
 
@@ -414,6 +430,10 @@ void CAdvancedSettings::Initialize()
   m_jsonOutputCompact = true;
   m_jsonTcpPort = 9090;
 
+  m_webserverCacheMemorySize = 32;
+  m_webserverCacheDiskSize = 0;
+  m_webserverImageCacheSize = 64;
+
   m_enableMultimediaKeys = false;
 
   m_canWindowed = true;
@@ -755,6 +775,9 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "fpsdetect", m_videoFpsDetect, 0, 2);
     XMLUtils::GetFloat(pElement, "maxtempo", m_maxTempo, 1.5, 2.1);
     XMLUtils::GetBoolean(pElement, "preferstereostream", m_videoPreferStereoStream);
+    XMLUtils::GetInt(pElement, "probecachesize", m_videoProbeCacheSize, 0, 1000);
+    XMLUtils::GetBoolean(pElement, "seekindex", m_videoSeekIndex);
+    XMLUtils::GetBoolean(pElement, "adaptivethreads", m_videoAdaptiveThreads);
 
     // Store global display latency settings
     TiXmlElement* pVideoLatency = pElement->FirstChildElement("latency");
@@ -809,6 +832,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "dateadded", m_iMusicLibraryDateAdded);
     XMLUtils::GetBoolean(pElement, "useisodates", m_bMusicLibraryUseISODates);
     XMLUtils::GetBoolean(pElement, "artistnavigatestosongs", m_bMusicLibraryArtistNavigatesToSongs);
+    XMLUtils::GetInt(pElement, "tagreadthreads", m_musicLibraryTagReadThreads, 0, 64);
+    XMLUtils::GetInt(pElement, "remotetagreadthreads", m_musicLibraryRemoteTagReadThreads, 1, 64);
     //Music artist name separators
     TiXmlElement* separators = pElement->FirstChildElement("artistseparators");
     if (separators)
@@ -841,6 +866,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
   if (pElement)
   {
     XMLUtils::GetBoolean(pElement, "ignoreerrors", m_bVideoScannerIgnoreErrors);
+    XMLUtils::GetInt(pElement, "scraperthreads", m_videoScannerScraperThreads, 1, 16);
+    XMLUtils::GetInt(pElement, "scraperdelay", m_videoScannerScraperDelay, 0, 60000);
   }
 
   // Backward-compatibility of ExternalPlayer config
@@ -876,6 +903,14 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetUInt(pElement, "tcpport", m_jsonTcpPort);
   }
 
+  pElement = pRootElement->FirstChildElement("webserver");
+  if (pElement)
+  {
+    XMLUtils::GetUInt(pElement, "cachememorysize", m_webserverCacheMemorySize, 0, 1024);
+    XMLUtils::GetUInt(pElement, "cachedisksize", m_webserverCacheDiskSize, 0, 16384);
+    XMLUtils::GetUInt(pElement, "imagecachesize", m_webserverImageCacheSize, 0, 16384);
+  }
+
   pElement = pRootElement->FirstChildElement("samba");
   if (pElement)
   {
@@ -949,6 +984,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "activetagcheckinterval", m_iEpgActiveTagCheckInterval);
     XMLUtils::GetInt(pElement, "retryinterruptedupdateinterval", m_iEpgRetryInterruptedUpdateInterval);
     XMLUtils::GetInt(pElement, "updateemptytagsinterval", m_iEpgUpdateEmptyTagsInterval);
+    XMLUtils::GetInt(pElement, "maxconcurrentupdatesperclient",
+                     m_iEpgMaxConcurrentUpdatesPerClient, 1, 16);
     XMLUtils::GetBoolean(pElement, "displayupdatepopup", m_bEpgDisplayUpdatePopup);
     XMLUtils::GetBoolean(pElement, "displayincrementalupdatepopup", m_bEpgDisplayIncrementalUpdatePopup);
   }
@@ -1083,6 +1120,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
   if (XMLUtils::GetString(pRootElement, "imagescalingalgorithm", tmp))
     m_imageScalingAlgorithm = CPictureScalingAlgorithm::FromString(tmp);
   XMLUtils::GetUInt(pRootElement, "imagequalityjpeg", m_imageQualityJpeg, 0, 21);
+  XMLUtils::GetUInt(pRootElement, "imagedecodedcacheusecount", m_imageDecodedCacheUseCount, 0,
+                    1000000);
   XMLUtils::GetBoolean(pRootElement, "playlistasfolders", m_playlistAsFolders);
   XMLUtils::GetBoolean(pRootElement, "uselocalecollation", m_useLocaleCollation);
   XMLUtils::GetBoolean(pRootElement, "detectasudf", m_detectAsUdf);
@@ -1139,6 +1178,11 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pPVR, "numericchannelswitchtimeout", m_iPVRNumericChannelSwitchTimeout, 50, 60000);
     XMLUtils::GetInt(pPVR, "timeshiftthreshold", m_iPVRTimeshiftThreshold, 0, 60);
     XMLUtils::GetBoolean(pPVR, "timeshiftsimpleosd", m_bPVRTimeshiftSimpleOSD);
+    XMLUtils::GetBoolean(pPVR, "timeshiftbuffer", m_bPVRTimeshiftBufferEnabled);
+    XMLUtils::GetInt(pPVR, "timeshiftbuffersize", m_iPVRTimeshiftBufferSize, 64, 65536);
+    XMLUtils::GetPath(pPVR, "timeshiftbufferpath", m_strPVRTimeshiftBufferPath);
+    XMLUtils::GetInt(pPVR, "pretunedelay", m_iPVRPreTuneDelay, 0, 60000);
+    XMLUtils::GetInt(pPVR, "pretunestreams", m_iPVRPreTuneStreams, 1, 2);
     TiXmlElement* pSortDecription = pPVR->FirstChildElement("pvrrecordings");
     if (pSortDecription)
     {
@@ -174,6 +174,9 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int  m_videoFpsDetect;
     float m_maxTempo;
     bool m_videoPreferStereoStream = false;
+    bool m_videoSeekIndex; /*!< @brief store an index of the keyframes of files played whose container has none, to speed up seeking. */
+    int m_videoProbeCacheSize; /*!< @brief number of files whose probed stream parameters are kept for the next playback, 0 to disable. */
+    bool m_videoAdaptiveThreads; /*!< @brief choose the threads of software decoding by codec and picture size and raise them when decoding falls behind. */
 
     std::string m_videoDefaultPlayer;
     float m_videoPlayCountMinimumPercent;
@@ -233,6 +236,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     CPictureScalingAlgorithm::Algorithm m_imageScalingAlgorithm;
     unsigned int
         m_imageQualityJpeg; ///< \brief the stored jpeg quality the lower the better (default: 4)
+    unsigned int m_imageDecodedCacheUseCount; ///< \brief use count from which cached images are
+                                              ///< also stored pre-decoded, 0 to disable (default: 0)
 
     int m_sambaclienttimeout;
     std::string m_sambadoscodepage;
@@ -252,6 +257,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_bMusicLibraryArtistSortOnUpdate;
     bool m_bMusicLibraryUseISODates;
     bool m_bMusicLibraryArtistNavigatesToSongs;
+    int m_musicLibraryTagReadThreads; // files read at once from local sources, 0 = auto
+    int m_musicLibraryRemoteTagReadThreads; // files read at once from a network source
     std::string m_strMusicLibraryAlbumFormat;
     bool m_prioritiseAPEv2tags;
     std::string m_musicItemSeparator;
@@ -267,6 +274,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_bVideoLibraryImportResumePoint{true};
 
     bool m_bVideoScannerIgnoreErrors;
+    int m_videoScannerScraperThreads; // concurrent lookups per scraper
+    int m_videoScannerScraperDelay; // ms between two scraper invocations
     int m_iVideoLibraryDateAdded;
 
     std::set<std::string> m_vecTokens;
@@ -276,6 +285,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_iEpgActiveTagCheckInterval; // seconds
     int m_iEpgRetryInterruptedUpdateInterval; // seconds
     int m_iEpgUpdateEmptyTagsInterval; // seconds
+    int m_iEpgMaxConcurrentUpdatesPerClient;
     bool m_bEpgDisplayUpdatePopup;
     bool m_bEpgDisplayIncrementalUpdatePopup;
 
@@ -324,6 +334,11 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_iPVRNumericChannelSwitchTimeout; /*!< @brief time in msecs after that a channel switch occurs after entering a channel number, if confirmchannelswitch is disabled */
     int m_iPVRTimeshiftThreshold; /*!< @brief time diff between current playing time and timeshift buffer end, in seconds, before a playing stream is displayed as timeshifting. */
     bool m_bPVRTimeshiftSimpleOSD; /*!< @brief use simple timeshift OSD (with progress only for the playing event instead of progress for the whole ts buffer). */
+    bool m_bPVRTimeshiftBufferEnabled; /*!< @brief buffer live streams of clients without timeshift support on disk, to allow pause and seek. */
+    int m_iPVRTimeshiftBufferSize; /*!< @brief size of the on-disk timeshift buffer in megabytes. */
+    std::string m_strPVRTimeshiftBufferPath; /*!< @brief directory of the on-disk timeshift buffer, used exclusively by it. */
+    int m_iPVRPreTuneDelay; /*!< @brief time in msecs a channel must be playing before the adjacent channels get opened in the background, 0 to disable. */
+    int m_iPVRPreTuneStreams; /*!< @brief maximum number of adjacent channels of the same client opened in the background. */
     SortDescription m_PVRDefaultSortOrder; /*!< @brief SortDecription used to store default recording sort type and sort order */
 
     DatabaseSettings m_databaseMusic; // advanced music database setup
@@ -344,6 +359,10 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_jsonOutputCompact;
     unsigned int m_jsonTcpPort;
 
+    unsigned int m_webserverCacheMemorySize; ///< in MB, files served by the web server
+    unsigned int m_webserverCacheDiskSize; ///< in MB, files served by the web server
+    unsigned int m_webserverImageCacheSize; ///< in MB, images transformed by the web server
+
     bool m_enableMultimediaKeys;
     std::vector<std::string> m_settingsFiles;
     void ParseSettingsFile(const std::string &file);
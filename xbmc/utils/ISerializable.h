@@ -8,6 +8,9 @@
 
 #pragma once
 
+#include <set>
+#include <string>
+
 class CVariant;
 
 class ISerializable
@@ -18,4 +21,16 @@ protected:
 
  public:
   virtual void Serialize(CVariant& value) const = 0;
+
+  /*!
+   \brief Serialize only the given fields.
+
+   Implementations may skip every value whose key isn't part of fields. The
+   default implementation serializes everything. Classes overriding Serialize()
+   of a class implementing this have to override it as well.
+   */
+  virtual void SerializeFields(CVariant& value, const std::set<std::string>& fields) const
+  {
+    Serialize(value);
+  }
 };
@@ -58,3 +58,17 @@ std::unique_ptr<CTexture> CVideoEmbeddedImageFileLoader::Load(const std::string&
                                           preferredHeight);
   return {};
 }
+
+bool CVideoEmbeddedImageFileLoader::LoadEncoded(const std::string& specialType,
+                                                const std::string& filePath,
+                                                std::vector<uint8_t>& data,
+                                                std::string& mimeType) const
+{
+  EmbeddedArt art;
+  if (!GetEmbeddedThumb(filePath, specialType.substr(6), art))
+    return false;
+
+  data = std::move(art.m_data);
+  mimeType = art.m_mime;
+  return true;
+}
@@ -0,0 +1,191 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoInfoPrefetcher.h"
+
+#include "utils/XTimeUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
+using namespace VIDEO;
+
+class CVideoInfoPrefetcher::CPrefetchJob : public CJob
+{
+public:
+  CPrefetchJob(std::shared_ptr<SShared> shared,
+               std::shared_ptr<SEntry> entry,
+               LookupFunction lookup,
+               ADDON::ScraperPtr scraper,
+               std::string title,
+               int year)
+    : m_shared(std::move(shared)),
+      m_entry(std::move(entry)),
+      m_lookup(std::move(lookup)),
+      m_scraper(std::move(scraper)),
+      m_title(std::move(title)),
+      m_year(year)
+  {
+  }
+
+  const char* GetType() const override { return "videoinfoprefetch"; }
+
+  bool DoWork() override
+  {
+    std::chrono::steady_clock::time_point slot;
+    {
+      std::unique_lock<CCriticalSection> lock(m_shared->critSection);
+      if (m_entry->state != State::QUEUED)
+        return false;
+
+      m_entry->state = State::RUNNING;
+
+      // reserve the next free slot for a scraper invocation
+      slot = std::max(std::chrono::steady_clock::now(), m_shared->nextSlot);
+      m_shared->nextSlot = slot + m_shared->minInterval;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (slot > now)
+      KODI::TIME::Sleep(std::chrono::duration_cast<std::chrono::milliseconds>(slot - now));
+
+    SPrefetchResult result;
+    m_lookup(m_scraper, m_title, m_year, result);
+
+    std::unique_lock<CCriticalSection> lock(m_shared->critSection);
+    if (m_entry->state == State::RUNNING)
+    {
+      m_entry->result = std::move(result);
+      m_entry->state = State::DONE;
+    }
+    m_shared->condition.notifyAll();
+    return true;
+  }
+
+private:
+  std::shared_ptr<SShared> m_shared;
+  std::shared_ptr<SEntry> m_entry;
+  LookupFunction m_lookup;
+  ADDON::ScraperPtr m_scraper;
+  std::string m_title;
+  int m_year;
+};
+
+CVideoInfoPrefetcher::CVideoInfoPrefetcher(unsigned int maxConcurrent,
+                                           std::chrono::milliseconds minInterval,
+                                           LookupFunction lookup /* = LookupFunction() */)
+  : m_lookup(lookup ? std::move(lookup) : LookupFunction(ScraperLookup)),
+    m_shared(std::make_shared<SShared>()),
+    m_jobQueue(false, std::max(maxConcurrent, 1u), CJob::PRIORITY_LOW)
+{
+  m_shared->minInterval = minInterval;
+}
+
+CVideoInfoPrefetcher::~CVideoInfoPrefetcher()
+{
+  Cancel();
+}
+
+std::string CVideoInfoPrefetcher::GetKey(const ADDON::ScraperPtr& scraper,
+                                         const std::string& title,
+                                         int year)
+{
+  return (scraper ? scraper->ID() : std::string()) + "|" + std::to_string(year) + "|" + title;
+}
+
+bool CVideoInfoPrefetcher::Prefetch(const ADDON::ScraperPtr& scraper,
+                                    const std::string& title,
+                                    int year)
+{
+  const std::string key = GetKey(scraper, title, year);
+  if (m_entries.find(key) != m_entries.end())
+    return false;
+
+  auto entry = std::make_shared<SEntry>();
+  if (!m_jobQueue.AddJob(new CPrefetchJob(m_shared, entry, m_lookup, scraper, title, year)))
+    return false;
+
+  m_entries.emplace(key, std::move(entry));
+  return true;
+}
+
+bool CVideoInfoPrefetcher::Take(const ADDON::ScraperPtr& scraper,
+                                const std::string& title,
+                                int year,
+                                SPrefetchResult& result)
+{
+  const auto it = m_entries.find(GetKey(scraper, title, year));
+  if (it == m_entries.end())
+    return false;
+
+  const std::shared_ptr<SEntry> entry = it->second;
+  m_entries.erase(it);
+
+  std::unique_lock<CCriticalSection> lock(m_shared->critSection);
+  if (entry->state == State::QUEUED)
+  {
+    // not started yet, the caller is faster doing the lookup itself
+    entry->state = State::CANCELLED;
+    return false;
+  }
+
+  m_shared->condition.wait(lock, [&entry] { return entry->state != State::RUNNING; });
+  if (entry->state != State::DONE)
+    return false;
+
+  result = std::move(entry->result);
+
+  m_hasDetails = result.hasDetails && !result.movies.empty();
+  if (m_hasDetails)
+  {
+    m_detailsUrl = result.movies[0].GetFirstThumbUrl();
+    m_details = result.details;
+  }
+  return true;
+}
+
+bool CVideoInfoPrefetcher::TakeDetails(const CScraperUrl& url, CVideoInfoTag& details)
+{
+  if (!m_hasDetails || url.GetFirstThumbUrl() != m_detailsUrl)
+    return false;
+
+  details = std::move(m_details);
+  m_hasDetails = false;
+  return true;
+}
+
+void CVideoInfoPrefetcher::Cancel()
+{
+  {
+    std::unique_lock<CCriticalSection> lock(m_shared->critSection);
+    for (const auto& entry : m_entries)
+    {
+      if (entry.second->state != State::DONE)
+        entry.second->state = State::CANCELLED;
+    }
+  }
+  m_entries.clear();
+  m_hasDetails = false;
+  m_jobQueue.CancelJobs();
+}
+
+void CVideoInfoPrefetcher::ScraperLookup(const ADDON::ScraperPtr& scraper,
+                                         const std::string& title,
+                                         int year,
+                                         SPrefetchResult& result)
+{
+  CVideoInfoDownloader downloader(scraper);
+  result.findResult = downloader.FindMovie(title, year, result.movies);
+  if (result.findResult > 0 && !result.movies.empty())
+    result.hasDetails = downloader.GetDetails({}, result.movies[0], result.details);
+
+  CLog::Log(LOGDEBUG, "VideoInfoPrefetcher: Looked up '{}' ({}) using {} scraper: {} result(s)",
+            title, year, scraper->Name(), result.movies.size());
+}
@@ -0,0 +1,146 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "VideoInfoDownloader.h"
+#include "VideoInfoTag.h"
+#include "addons/Scraper.h"
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "utils/JobManager.h"
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace VIDEO
+{
+
+/*! \brief Result of a prefetched scraper lookup.
+ Mirrors the data CVideoInfoScanner obtains from FindVideo() followed by GetDetails() for the
+ first search result.
+ */
+struct SPrefetchResult
+{
+  int findResult{0}; //!< return code of CVideoInfoDownloader::FindMovie
+  MOVIELIST movies; //!< search results, sorted by relevance
+  bool hasDetails{false}; //!< whether details for the first search result have been fetched
+  CVideoInfoTag details; //!< details for the first search result
+};
+
+/*! \brief Resolves scraper lookups for upcoming items concurrently.
+ The video scanner processes items strictly in order and commits every item to the database
+ before moving on to the next one. Most of that time is spent waiting for the scraper, so the
+ prefetcher performs the search and detail lookups for the next few items in the background
+ while the scanner is still busy with the current one. The scanner then picks up the results in
+ its usual order, which keeps database writes ordered and single threaded.
+
+ Lookups are limited to a maximum number of concurrent scraper invocations and, optionally, to a
+ minimum interval between two scraper invocations to respect the rate limits of online sources.
+ */
+class CVideoInfoPrefetcher
+{
+public:
+  using LookupFunction = std::function<void(
+      const ADDON::ScraperPtr& scraper, const std::string& title, int year, SPrefetchResult& result)>;
+
+  /*! \brief Create a prefetcher
+   \param maxConcurrent maximum number of lookups running at the same time.
+   \param minInterval minimum time between the start of two scraper invocations.
+   \param lookup function performing the actual lookup. Defaults to the scraper addon lookup.
+   */
+  CVideoInfoPrefetcher(unsigned int maxConcurrent,
+                       std::chrono::milliseconds minInterval,
+                       LookupFunction lookup = LookupFunction());
+  ~CVideoInfoPrefetcher();
+
+  /*! \brief Queue a lookup for the given title.
+   \param scraper the scraper to use for the lookup.
+   \param title title of the item to look up.
+   \param year year of the item to look up, -1 if unknown.
+   \return true if the lookup was queued, false if it is already queued or could not be queued.
+   */
+  bool Prefetch(const ADDON::ScraperPtr& scraper, const std::string& title, int year);
+
+  /*! \brief Take the result of a previously queued lookup.
+   Waits for lookups which are currently running. Lookups which have not been started yet are
+   dropped, as the caller will perform them in its own thread anyway.
+   \param scraper the scraper used for the lookup.
+   \param title title of the item.
+   \param year year of the item.
+   \param result [out] the result of the lookup.
+   \return true if a result is available, false otherwise.
+   */
+  bool Take(const ADDON::ScraperPtr& scraper,
+            const std::string& title,
+            int year,
+            SPrefetchResult& result);
+
+  /*! \brief Take the details prefetched for the given search result.
+   Details are handed out once, after the search result they belong to has been taken via Take().
+   \param url the search result details are requested for.
+   \param details [out] the details for the search result.
+   \return true if details are available, false otherwise.
+   */
+  bool TakeDetails(const CScraperUrl& url, CVideoInfoTag& details);
+
+  /*! \brief Drop all pending lookups. Running lookups are finished but their results are discarded.
+   */
+  void Cancel();
+
+  /*! \brief The scraper addon lookup, performing FindMovie() followed by GetDetails() for the
+   first result.
+   */
+  static void ScraperLookup(const ADDON::ScraperPtr& scraper,
+                            const std::string& title,
+                            int year,
+                            SPrefetchResult& result);
+
+private:
+  CVideoInfoPrefetcher(const CVideoInfoPrefetcher&) = delete;
+  CVideoInfoPrefetcher& operator=(const CVideoInfoPrefetcher&) = delete;
+
+  enum class State
+  {
+    QUEUED,
+    RUNNING,
+    DONE,
+    CANCELLED,
+  };
+
+  struct SEntry
+  {
+    State state{State::QUEUED};
+    SPrefetchResult result;
+  };
+
+  struct SShared
+  {
+    CCriticalSection critSection;
+    XbmcThreads::ConditionVariable condition;
+    std::chrono::steady_clock::time_point nextSlot;
+    std::chrono::milliseconds minInterval{0};
+  };
+
+  class CPrefetchJob;
+
+  static std::string GetKey(const ADDON::ScraperPtr& scraper, const std::string& title, int year);
+
+  LookupFunction m_lookup;
+  std::shared_ptr<SShared> m_shared;
+  std::map<std::string, std::shared_ptr<SEntry>> m_entries;
+  std::string m_detailsUrl;
+  CVideoInfoTag m_details;
+  bool m_hasDetails{false};
+  CJobQueue m_jobQueue;
+};
+
+} // namespace VIDEO
@@ -16,6 +16,7 @@
 #include "URL.h"
 #include "Util.h"
 #include "VideoInfoDownloader.h"
+#include "VideoInfoPrefetcher.h"
 #include "cores/VideoPlayer/DVDFileInfo.h"
 #include "dialogs/GUIDialogExtendedProgressBar.h"
 #include "dialogs/GUIDialogProgress.h"
@@ -457,10 +458,30 @@ namespace VIDEO
 
     bool FoundSomeInfo = false;
     std::vector<int> seenPaths;
+
+    // resolve scraper lookups of upcoming movies and music videos concurrently, unless the
+    // lookup is driven interactively by a given url or progress dialog
+    ScraperPtr prefetchScraper;
+    int nextPrefetch = 0;
+    if (!pURL && !pDlgProgress && items.Size() > 1 &&
+        CServiceBroker::GetSettingsComponent()
+                ->GetAdvancedSettings()
+                ->m_videoScannerScraperThreads > 1)
+    {
+      prefetchScraper = m_database.GetScraperForPath(items.GetPath());
+      if (prefetchScraper && (!prefetchScraper->IsPython() ||
+                              (prefetchScraper->Content() != CONTENT_MOVIES &&
+                               prefetchScraper->Content() != CONTENT_MUSICVIDEOS)))
+        prefetchScraper.reset();
+    }
+
     for (int i = 0; i < items.Size(); ++i)
     {
       CFileItemPtr pItem = items[i];
 
+      if (prefetchScraper)
+        PrefetchVideoInfo(items, i, bDirNames, useLocal, prefetchScraper, nextPrefetch);
+
       // we do this since we may have a override per dir
       ScraperPtr info2 = m_database.GetScraperForPath(pItem->m_bIsFolder ? pItem->GetPath() : items.GetPath());
       if (!info2) // skip
@@ -555,10 +576,63 @@ namespace VIDEO
     if(pDlgProgress)
       pDlgProgress->ShowProgressBar(false);
 
+    m_prefetchers.clear();
+
     m_database.Close();
     return FoundSomeInfo;
   }
 
+  void CVideoInfoScanner::PrefetchVideoInfo(const CFileItemList& items,
+                                            int current,
+                                            bool bDirNames,
+                                            bool useLocal,
+                                            const ScraperPtr& scraper,
+                                            int& next)
+  {
+    const auto advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+    const unsigned int threads = advancedSettings->m_videoScannerScraperThreads;
+
+    auto& prefetcher = m_prefetchers[scraper->ID()];
+    if (!prefetcher)
+      prefetcher = std::make_unique<CVideoInfoPrefetcher>(
+          threads, std::chrono::milliseconds(advancedSettings->m_videoScannerScraperDelay));
+
+    // keep a window of twice the number of lookup threads ahead of the current item
+    const int last = std::min(items.Size(), current + 1 + static_cast<int>(2 * threads));
+    for (next = std::max(next, current + 1); next < last && !m_bStop; ++next)
+    {
+      const CFileItemPtr item = items[next];
+      if (item->m_bIsFolder || !item->IsVideo() || item->IsNFO() ||
+          (item->IsPlayList() && !URIUtils::HasExtension(item->GetPath(), ".strm")))
+        continue;
+
+      if (CUtil::ExcludeFileOrFolder(item->GetPath(),
+                                     advancedSettings->m_moviesExcludeFromScanRegExps))
+        continue;
+
+      if (scraper->Content() == CONTENT_MOVIES ? m_database.HasMovieInfo(item->GetDynPath())
+                                               : m_database.HasMusicVideoInfo(item->GetPath()))
+        continue;
+
+      // items with local information are looked up by the scanner itself
+      if (useLocal)
+      {
+        std::unique_ptr<IVideoInfoTagLoader> loader(
+            CVideoInfoTagLoaderFactory::CreateLoader(*item, scraper, bDirNames));
+        if (loader)
+          continue;
+      }
+
+      const std::string title = item->GetMovieName(bDirNames);
+      std::string identifierType;
+      std::string identifier;
+      if (CUtil::GetFilenameIdentifier(title, identifierType, identifier))
+        continue;
+
+      prefetcher->Prefetch(scraper, title, -1);
+    }
+  }
+
   CInfoScanner::INFO_RET
   CVideoInfoScanner::RetrieveInfoForTvShow(CFileItem *pItem,
                                            bool bDirNames,
@@ -2142,8 +2216,16 @@ namespace VIDEO
     if (m_handle && !url.GetTitle().empty())
       m_handle->SetText(url.GetTitle());
 
-    CVideoInfoDownloader imdb(scraper);
-    bool ret = imdb.GetDetails(uniqueIDs, url, movieDetails, pDialog);
+    bool ret;
+    const auto prefetcher = m_prefetchers.find(scraper->ID());
+    if (uniqueIDs.empty() && prefetcher != m_prefetchers.end() &&
+        prefetcher->second->TakeDetails(url, movieDetails))
+      ret = true;
+    else
+    {
+      CVideoInfoDownloader imdb(scraper);
+      ret = imdb.GetDetails(uniqueIDs, url, movieDetails, pDialog);
+    }
 
     if (ret)
     {
@@ -2424,8 +2506,20 @@ namespace VIDEO
   int CVideoInfoScanner::FindVideo(const std::string &title, int year, const ScraperPtr &scraper, CScraperUrl &url, CGUIDialogProgress *progress)
   {
     MOVIELIST movielist;
-    CVideoInfoDownloader imdb(scraper);
-    int returncode = imdb.FindMovie(title, year, movielist, progress);
+    int returncode;
+    SPrefetchResult prefetched;
+    const auto prefetcher = m_prefetchers.find(scraper->ID());
+    if (prefetcher != m_prefetchers.end() &&
+        prefetcher->second->Take(scraper, title, year, prefetched))
+    {
+      returncode = prefetched.findResult;
+      movielist = std::move(prefetched.movies);
+    }
+    else
+    {
+      CVideoInfoDownloader imdb(scraper);
+      returncode = imdb.FindMovie(title, year, movielist, progress);
+    }
     if (returncode < 0 || (returncode == 0 && (m_bStop || !DownloadFailed(progress))))
     { // scraper reported an error, or we had an error and user wants to cancel the scan
       m_bStop = true;
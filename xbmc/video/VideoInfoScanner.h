@@ -13,6 +13,8 @@
 #include "addons/Scraper.h"
 #include "guilib/GUIListItem.h"
 
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -24,6 +26,7 @@ class CFileItemList;
 namespace VIDEO
 {
   class IVideoInfoTagLoader;
+  class CVideoInfoPrefetcher;
 
   typedef struct SScanSettings
   {
@@ -239,6 +242,24 @@ namespace VIDEO
     bool EnumerateSeriesFolder(CFileItem* item, EPISODELIST& episodeList);
     bool ProcessItemByVideoInfoTag(const CFileItem *item, EPISODELIST &episodeList);
 
+    /*! \brief Queue scraper lookups for the items following the current one
+     Lookups of movies and music videos without local information are resolved concurrently
+     while the scanner is busy with the current item. The results are picked up by FindVideo()
+     and GetDetails() in the regular scan order.
+     \param items the list of items being scanned.
+     \param current index of the item currently processed.
+     \param bDirNames whether we should use folder or file names for lookups.
+     \param useLocal whether local data (.nfo) is used.
+     \param scraper scraper of the path being scanned.
+     \param next [in/out] index of the next item to be considered for prefetching.
+     */
+    void PrefetchVideoInfo(const CFileItemList& items,
+                           int current,
+                           bool bDirNames,
+                           bool useLocal,
+                           const ADDON::ScraperPtr& scraper,
+                           int& next);
+
     bool AddVideoExtras(CFileItemList& items, const CONTENT_TYPE& content, const std::string& path);
     bool ProcessVideoVersion(VideoDbContentType itemType, int dbId);
 
@@ -250,6 +271,7 @@ namespace VIDEO
     CVideoDatabase m_database;
     std::set<std::string> m_pathsToCount;
     std::set<int> m_pathsToClean;
+    std::map<std::string, std::unique_ptr<CVideoInfoPrefetcher>> m_prefetchers;
 
   private:
     static void AddLocalItemArtwork(CGUIListItem::ArtMap& itemArt,
@@ -723,89 +723,168 @@ void CVideoInfoTag::Archive(CArchive& ar)
 
 void CVideoInfoTag::Serialize(CVariant& value) const
 {
-  value["director"] = m_director;
-  value["writer"] = m_writingCredits;
-  value["genre"] = m_genre;
-  value["country"] = m_country;
-  value["tagline"] = m_strTagLine;
-  value["plotoutline"] = m_strPlotOutline;
-  value["plot"] = m_strPlot;
-  value["title"] = m_strTitle;
-  value["votes"] = std::to_string(GetRating().votes);
-  value["studio"] = m_studio;
-  value["trailer"] = m_strTrailer;
-  value["cast"] = CVariant(CVariant::VariantTypeArray);
-  for (unsigned int i = 0; i < m_cast.size(); ++i)
+  Serialize(value, nullptr);
+}
+
+void CVideoInfoTag::SerializeFields(CVariant& value, const std::set<std::string>& fields) const
+{
+  Serialize(value, &fields);
+}
+
+void CVideoInfoTag::Serialize(CVariant& value, const std::set<std::string>* fields) const
+{
+  const auto wanted = [fields](const char* field)
+  { return fields == nullptr || fields->find(field) != fields->end(); };
+
+  if (wanted("director"))
+    value["director"] = m_director;
+  if (wanted("writer"))
+    value["writer"] = m_writingCredits;
+  if (wanted("genre"))
+    value["genre"] = m_genre;
+  if (wanted("country"))
+    value["country"] = m_country;
+  if (wanted("tagline"))
+    value["tagline"] = m_strTagLine;
+  if (wanted("plotoutline"))
+    value["plotoutline"] = m_strPlotOutline;
+  if (wanted("plot"))
+    value["plot"] = m_strPlot;
+  if (wanted("title"))
+    value["title"] = m_strTitle;
+  if (wanted("votes"))
+    value["votes"] = std::to_string(GetRating().votes);
+  if (wanted("studio"))
+    value["studio"] = m_studio;
+  if (wanted("trailer"))
+    value["trailer"] = m_strTrailer;
+  if (wanted("cast"))
   {
-    CVariant actor;
-    actor["name"] = m_cast[i].strName;
-    actor["role"] = m_cast[i].strRole;
-    actor["order"] = m_cast[i].order;
-    if (!m_cast[i].thumb.empty())
-      actor["thumbnail"] = CTextureUtils::GetWrappedImageURL(m_cast[i].thumb);
-    value["cast"].push_back(actor);
+    value["cast"] = CVariant(CVariant::VariantTypeArray);
+    for (unsigned int i = 0; i < m_cast.size(); ++i)
+    {
+      CVariant actor;
+      actor["name"] = m_cast[i].strName;
+      actor["role"] = m_cast[i].strRole;
+      actor["order"] = m_cast[i].order;
+      if (!m_cast[i].thumb.empty())
+        actor["thumbnail"] = CTextureUtils::GetWrappedImageURL(m_cast[i].thumb);
+      value["cast"].push_back(actor);
+    }
   }
-  value["set"] = m_set.title;
-  value["setid"] = m_set.id;
-  value["setoverview"] = m_set.overview;
-  value["tag"] = m_tags;
-  m_assetInfo.Serialize(value);
-  value["hasvideoversions"] = m_hasVideoVersions;
-  value["hasvideoextras"] = m_hasVideoExtras;
-  value["isdefaultvideoversion"] = m_isDefaultVideoVersion;
-  value["runtime"] = GetDuration();
-  value["file"] = m_strFile;
-  value["path"] = m_strPath;
-  value["imdbnumber"] = GetUniqueID();
-  value["mpaa"] = m_strMPAARating;
-  value["filenameandpath"] = m_strFileNameAndPath;
-  value["originaltitle"] = m_strOriginalTitle;
-  value["sorttitle"] = m_strSortTitle;
-  value["episodeguide"] = m_strEpisodeGuide;
-  value["premiered"] = m_premiered.IsValid() ? m_premiered.GetAsDBDate() : StringUtils::Empty;
-  value["status"] = m_strStatus;
-  value["productioncode"] = m_strProductionCode;
-  value["firstaired"] = m_firstAired.IsValid() ? m_firstAired.GetAsDBDate() : StringUtils::Empty;
-  value["showtitle"] = m_strShowTitle;
-  value["album"] = m_strAlbum;
-  value["artist"] = m_artist;
-  value["playcount"] = GetPlayCount();
-  value["lastplayed"] = m_lastPlayed.IsValid() ? m_lastPlayed.GetAsDBDateTime() : StringUtils::Empty;
-  value["top250"] = m_iTop250;
-  value["year"] = GetYear();
-  value["season"] = m_iSeason;
-  value["episode"] = m_iEpisode;
-  for (const auto& i : m_uniqueIDs)
-    value["uniqueid"][i.first] = i.second;
-
-  value["rating"] = GetRating().rating;
-  CVariant ratings = CVariant(CVariant::VariantTypeObject);
-  for (const auto& i : m_ratings)
+  if (wanted("set"))
+    value["set"] = m_set.title;
+  if (wanted("setid"))
+    value["setid"] = m_set.id;
+  if (wanted("setoverview"))
+    value["setoverview"] = m_set.overview;
+  if (wanted("tag"))
+    value["tag"] = m_tags;
+  if (wanted("videoassettitle") || wanted("videoassetid") || wanted("videoassettype"))
+    m_assetInfo.Serialize(value);
+  if (wanted("hasvideoversions"))
+    value["hasvideoversions"] = m_hasVideoVersions;
+  if (wanted("hasvideoextras"))
+    value["hasvideoextras"] = m_hasVideoExtras;
+  if (wanted("isdefaultvideoversion"))
+    value["isdefaultvideoversion"] = m_isDefaultVideoVersion;
+  if (wanted("runtime"))
+    value["runtime"] = GetDuration();
+  if (wanted("file"))
+    value["file"] = m_strFile;
+  if (wanted("path"))
+    value["path"] = m_strPath;
+  if (wanted("imdbnumber"))
+    value["imdbnumber"] = GetUniqueID();
+  if (wanted("mpaa"))
+    value["mpaa"] = m_strMPAARating;
+  if (wanted("filenameandpath"))
+    value["filenameandpath"] = m_strFileNameAndPath;
+  if (wanted("originaltitle"))
+    value["originaltitle"] = m_strOriginalTitle;
+  if (wanted("sorttitle"))
+    value["sorttitle"] = m_strSortTitle;
+  if (wanted("episodeguide"))
+    value["episodeguide"] = m_strEpisodeGuide;
+  if (wanted("premiered"))
+    value["premiered"] = m_premiered.IsValid() ? m_premiered.GetAsDBDate() : StringUtils::Empty;
+  if (wanted("status"))
+    value["status"] = m_strStatus;
+  if (wanted("productioncode"))
+    value["productioncode"] = m_strProductionCode;
+  if (wanted("firstaired"))
+    value["firstaired"] = m_firstAired.IsValid() ? m_firstAired.GetAsDBDate() : StringUtils::Empty;
+  if (wanted("showtitle"))
+    value["showtitle"] = m_strShowTitle;
+  if (wanted("album"))
+    value["album"] = m_strAlbum;
+  if (wanted("artist"))
+    value["artist"] = m_artist;
+  if (wanted("playcount"))
+    value["playcount"] = GetPlayCount();
+  if (wanted("lastplayed"))
+    value["lastplayed"] = m_lastPlayed.IsValid() ? m_lastPlayed.GetAsDBDateTime() : StringUtils::Empty;
+  if (wanted("top250"))
+    value["top250"] = m_iTop250;
+  if (wanted("year"))
+    value["year"] = GetYear();
+  if (wanted("season"))
+    value["season"] = m_iSeason;
+  if (wanted("episode"))
+    value["episode"] = m_iEpisode;
+  if (wanted("uniqueid"))
   {
-    CVariant rating;
-    rating["rating"] = i.second.rating;
-    rating["votes"] = i.second.votes;
-    rating["default"] = i.first == m_strDefaultRating;
+    for (const auto& i : m_uniqueIDs)
+      value["uniqueid"][i.first] = i.second;
+  }
 
-    ratings[i.first] = rating;
+  if (wanted("rating"))
+    value["rating"] = GetRating().rating;
+  if (wanted("ratings"))
+  {
+    CVariant ratings = CVariant(CVariant::VariantTypeObject);
+    for (const auto& i : m_ratings)
+    {
+      CVariant rating;
+      rating["rating"] = i.second.rating;
+      rating["votes"] = i.second.votes;
+      rating["default"] = i.first == m_strDefaultRating;
+
+      ratings[i.first] = rating;
+    }
+    value["ratings"] = ratings;
+  }
+  if (wanted("userrating"))
+    value["userrating"] = m_iUserRating;
+  if (wanted("dbid"))
+    value["dbid"] = m_iDbId;
+  if (wanted("fileid"))
+    value["fileid"] = m_iFileId;
+  if (wanted("track"))
+    value["track"] = m_iTrack;
+  if (wanted("showlink"))
+    value["showlink"] = m_showLink;
+  if (wanted("streamdetails"))
+    m_streamDetails.Serialize(value["streamdetails"]);
+  if (wanted("resume"))
+  {
+    CVariant resume = CVariant(CVariant::VariantTypeObject);
+    resume["position"] = m_resumePoint.timeInSeconds;
+    resume["total"] = m_resumePoint.totalTimeInSeconds;
+    value["resume"] = resume;
   }
-  value["ratings"] = ratings;
-  value["userrating"] = m_iUserRating;
-  value["dbid"] = m_iDbId;
-  value["fileid"] = m_iFileId;
-  value["track"] = m_iTrack;
-  value["showlink"] = m_showLink;
-  m_streamDetails.Serialize(value["streamdetails"]);
-  CVariant resume = CVariant(CVariant::VariantTypeObject);
-  resume["position"] = m_resumePoint.timeInSeconds;
-  resume["total"] = m_resumePoint.totalTimeInSeconds;
-  value["resume"] = resume;
-  value["tvshowid"] = m_iIdShow;
-  value["dateadded"] = m_dateAdded.IsValid() ? m_dateAdded.GetAsDBDateTime() : StringUtils::Empty;
-  value["type"] = m_type;
-  value["seasonid"] = m_iIdSeason;
-  value["specialsortseason"] = m_iSpecialSortSeason;
-  value["specialsortepisode"] = m_iSpecialSortEpisode;
+  if (wanted("tvshowid"))
+    value["tvshowid"] = m_iIdShow;
+  if (wanted("dateadded"))
+    value["dateadded"] = m_dateAdded.IsValid() ? m_dateAdded.GetAsDBDateTime() : StringUtils::Empty;
+  if (wanted("type"))
+    value["type"] = m_type;
+  if (wanted("seasonid"))
+    value["seasonid"] = m_iIdSeason;
+  if (wanted("specialsortseason"))
+    value["specialsortseason"] = m_iSpecialSortSeason;
+  if (wanted("specialsortepisode"))
+    value["specialsortepisode"] = m_iSpecialSortEpisode;
 }
 
 void CVideoInfoTag::ToSortable(SortItem& sortable, Field field) const
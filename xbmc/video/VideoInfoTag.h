@@ -16,6 +16,7 @@
 #include "utils/StreamDetails.h"
 #include "video/Bookmark.h"
 
+#include <set>
 #include <string>
 #include <vector>
 
@@ -76,6 +77,7 @@ public:
   void Merge(CVideoInfoTag& other);
   void Archive(CArchive& ar) override;
   void Serialize(CVariant& value) const override;
+  void SerializeFields(CVariant& value, const std::set<std::string>& fields) const override;
   void ToSortable(SortItem& sortable, Field field) const override;
   const CRating GetRating(std::string type = "") const;
   const std::string& GetDefaultRating() const;
@@ -416,6 +418,10 @@ public:
   unsigned int m_duration; ///< duration in seconds
 
 private:
+  /*! \brief Serialize the given fields, or everything if fields is nullptr.
+   */
+  void Serialize(CVariant& value, const std::set<std::string>* fields) const;
+
   /* \brief Parse our native XML format for video info.
    See Load for a description of the available tag types.
 
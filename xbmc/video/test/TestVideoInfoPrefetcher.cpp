@@ -0,0 +1,158 @@
+/*
+ *  Copyright (C) 2024 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "utils/JobManager.h"
+#include "utils/XTimeUtils.h"
+#include "video/VideoInfoPrefetcher.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace VIDEO;
+using namespace std::chrono_literals;
+
+namespace
+{
+// a lookup resolving titles from a local table instead of an online source
+class CLocalLookup
+{
+public:
+  void operator()(const ADDON::ScraperPtr&,
+                  const std::string& title,
+                  int year,
+                  SPrefetchResult& result)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_starts.push_back(std::chrono::steady_clock::now());
+      m_maxRunning = std::max(m_maxRunning, ++m_running);
+    }
+
+    KODI::TIME::Sleep(20ms);
+
+    CScraperUrl url;
+    url.AppendUrl(CScraperUrl::SUrlEntry("file://" + title + ".xml"));
+    result.movies.push_back(url);
+    result.findResult = 1;
+    result.details.SetTitle(title);
+    result.details.SetYear(year);
+    result.hasDetails = true;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    --m_running;
+    ++m_finished;
+    m_condition.notify_all();
+  }
+
+  // wait until the given number of lookups has finished
+  bool WaitFinished(unsigned int count)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_condition.wait_for(lock, 10s, [this, count] { return m_finished >= count; });
+  }
+
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::vector<std::chrono::steady_clock::time_point> m_starts;
+  unsigned int m_running{0};
+  unsigned int m_maxRunning{0};
+  unsigned int m_finished{0};
+};
+
+class TestVideoInfoPrefetcher : public testing::Test
+{
+protected:
+  TestVideoInfoPrefetcher() { CServiceBroker::RegisterJobManager(std::make_shared<CJobManager>()); }
+
+  ~TestVideoInfoPrefetcher() override
+  {
+    CServiceBroker::GetJobManager()->CancelJobs();
+    CServiceBroker::GetJobManager()->Restart();
+    CServiceBroker::UnregisterJobManager();
+  }
+
+  CVideoInfoPrefetcher::LookupFunction Lookup()
+  {
+    return [this](const ADDON::ScraperPtr& scraper, const std::string& title, int year,
+                  SPrefetchResult& result) { m_lookup(scraper, title, year, result); };
+  }
+
+  CLocalLookup m_lookup;
+};
+} // namespace
+
+TEST_F(TestVideoInfoPrefetcher, ResultsInOrder)
+{
+  CVideoInfoPrefetcher prefetcher(3, 0ms, Lookup());
+
+  const std::vector<std::string> titles{"alpha", "bravo", "charlie", "delta", "echo", "foxtrot"};
+  for (const auto& title : titles)
+    EXPECT_TRUE(prefetcher.Prefetch(nullptr, title, 2000));
+
+  // queuing the same lookup twice is refused
+  EXPECT_FALSE(prefetcher.Prefetch(nullptr, "alpha", 2000));
+
+  // lookups which have not been started are dropped by Take()
+  ASSERT_TRUE(m_lookup.WaitFinished(titles.size()));
+
+  for (const auto& title : titles)
+  {
+    SPrefetchResult result;
+    ASSERT_TRUE(prefetcher.Take(nullptr, title, 2000, result));
+    EXPECT_EQ(1, result.findResult);
+    ASSERT_EQ(1u, result.movies.size());
+
+    CVideoInfoTag details;
+    EXPECT_TRUE(prefetcher.TakeDetails(result.movies[0], details));
+    EXPECT_EQ(title, details.GetTitle());
+    EXPECT_EQ(2000, details.GetYear());
+
+    // details are handed out once
+    EXPECT_FALSE(prefetcher.TakeDetails(result.movies[0], details));
+  }
+
+  EXPECT_LE(m_lookup.m_maxRunning, 3u);
+}
+
+TEST_F(TestVideoInfoPrefetcher, UnknownLookup)
+{
+  CVideoInfoPrefetcher prefetcher(2, 0ms, Lookup());
+  EXPECT_TRUE(prefetcher.Prefetch(nullptr, "alpha", -1));
+  ASSERT_TRUE(m_lookup.WaitFinished(1));
+
+  SPrefetchResult result;
+  EXPECT_FALSE(prefetcher.Take(nullptr, "alpha", 1999, result));
+  EXPECT_FALSE(prefetcher.Take(nullptr, "bravo", -1, result));
+
+  CScraperUrl url;
+  url.AppendUrl(CScraperUrl::SUrlEntry("file://bravo.xml"));
+  CVideoInfoTag details;
+  EXPECT_FALSE(prefetcher.TakeDetails(url, details));
+
+  ASSERT_TRUE(prefetcher.Take(nullptr, "alpha", -1, result));
+  EXPECT_FALSE(prefetcher.TakeDetails(url, details));
+}
+
+TEST_F(TestVideoInfoPrefetcher, RateLimit)
+{
+  CVideoInfoPrefetcher prefetcher(4, 50ms, Lookup());
+  for (const auto& title : {"alpha", "bravo", "charlie"})
+    prefetcher.Prefetch(nullptr, title, -1);
+
+  ASSERT_TRUE(m_lookup.WaitFinished(3));
+
+  std::unique_lock<std::mutex> lock(m_lookup.m_mutex);
+  ASSERT_EQ(3u, m_lookup.m_starts.size());
+  std::sort(m_lookup.m_starts.begin(), m_lookup.m_starts.end());
+  EXPECT_GE(m_lookup.m_starts[2] - m_lookup.m_starts[0], 100ms);
+}